@@ -24,6 +24,7 @@
 //!   - boost::container::vector
 //!   - boost::container::stable_vector
 //!   - boost::container::static_vector
+//!   - boost::container::devector
 //!   - boost::container::slist
 //!   - boost::container::list
 //!   - boost::container::set
@@ -88,7 +89,8 @@ template<class T>
 class new_allocator;
 
 template <class T
-         ,class Allocator = new_allocator<T> >
+         ,class Allocator = new_allocator<T>
+         ,class Options = void>
 class vector;
 
 template <class T
@@ -102,6 +104,11 @@ template < class T, std::size_t N
          , class Allocator= new_allocator<T> >
 class small_vector;
 
+template <class T
+         ,class Allocator = new_allocator<T>
+         ,class Options = void>
+class devector;
+
 template <class T
          ,class Allocator = new_allocator<T> >
 class deque;
@@ -147,24 +154,24 @@ class multimap;
 
 template <class Key
          ,class Compare  = std::less<Key>
-         ,class Allocator = new_allocator<Key> >
+         ,class AllocatorOrContainer = new_allocator<Key> >
 class flat_set;
 
 template <class Key
          ,class Compare  = std::less<Key>
-         ,class Allocator = new_allocator<Key> >
+         ,class AllocatorOrContainer = new_allocator<Key> >
 class flat_multiset;
 
 template <class Key
          ,class T
          ,class Compare  = std::less<Key>
-         ,class Allocator = new_allocator<std::pair<Key, T> > >
+         ,class AllocatorOrContainer = new_allocator<std::pair<Key, T> > >
 class flat_map;
 
 template <class Key
          ,class T
          ,class Compare  = std::less<Key>
-         ,class Allocator = new_allocator<std::pair<Key, T> > >
+         ,class AllocatorOrContainer = new_allocator<std::pair<Key, T> > >
 class flat_multimap;
 
 template <class CharT
@@ -0,0 +1,105 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#ifndef BOOST_CONTAINER_DETAIL_CONTAINER_REBIND_HPP
+#define BOOST_CONTAINER_DETAIL_CONTAINER_REBIND_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+// container
+#include <boost/container/allocator_traits.hpp>
+#include <boost/container/container_fwd.hpp>
+// intrusive
+#include <boost/intrusive/detail/mpl.hpp>
+// other
+#include <cstddef>
+
+namespace boost {
+namespace container {
+namespace container_detail {
+
+BOOST_INTRUSIVE_INSTANTIATE_DEFAULT_TYPE_TMPLT(allocator_type)
+
+//! Sequence containers define a nested "allocator_type" whereas
+//! allocators don't, so that's what flat associative containers use
+//! to know if their "AllocatorOrContainer" argument is the storage itself.
+template<class AllocatorOrContainer>
+struct is_container
+{
+   static const bool value = boost::container::container_detail::
+      boost_intrusive_default_type_allocator_type<AllocatorOrContainer, void>::value;
+};
+
+//! Obtains the sequence that flat associative containers use to store
+//! elements of type Value: the argument itself if it's a container or
+//! a boost::container::vector if it's an allocator.
+template<class Value, class AllocatorOrContainer, bool = is_container<AllocatorOrContainer>::value>
+struct select_container_type
+{
+   typedef AllocatorOrContainer type;
+};
+
+template<class Value, class AllocatorOrContainer>
+struct select_container_type<Value, AllocatorOrContainer, false>
+{
+   typedef boost::container::vector<Value, AllocatorOrContainer> type;
+};
+
+//! Rebinds a supported sequence container to hold elements of type U.
+//! Only vector-based sequences are supported as flat_tree relies on
+//! vector extensions to implement ordered insertions.
+template<class Container, class U>
+struct container_rebind;
+
+template<class V, class A, class O, class U>
+struct container_rebind<boost::container::vector<V, A, O>, U>
+{
+   typedef boost::container::vector
+      < U
+      , typename allocator_traits<A>::template portable_rebind_alloc<U>::type
+      , O> type;
+};
+
+template<class V, std::size_t N, class A, class U>
+struct container_rebind<boost::container::small_vector<V, N, A>, U>
+{
+   typedef boost::container::small_vector
+      < U, N
+      , typename allocator_traits<A>::template portable_rebind_alloc<U>::type> type;
+};
+
+template<class V, std::size_t N, class U>
+struct container_rebind<boost::container::static_vector<V, N>, U>
+{
+   typedef boost::container::static_vector<U, N> type;
+};
+
+template<class AllocatorOrContainer, class U, bool = is_container<AllocatorOrContainer>::value>
+struct container_or_allocator_rebind
+   : container_rebind<AllocatorOrContainer, U>
+{};
+
+template<class AllocatorOrContainer, class U>
+struct container_or_allocator_rebind<AllocatorOrContainer, U, false>
+{
+   typedef typename allocator_traits<AllocatorOrContainer>::
+      template portable_rebind_alloc<U>::type type;
+};
+
+}  //namespace container_detail {
+}  //namespace container {
+}  //namespace boost {
+
+#endif   //#ifndef BOOST_CONTAINER_DETAIL_CONTAINER_REBIND_HPP
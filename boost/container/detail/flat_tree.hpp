@@ -28,6 +28,7 @@
 
 #include <boost/container/detail/pair.hpp>
 #include <boost/container/vector.hpp>
+#include <boost/container/detail/container_rebind.hpp>
 #include <boost/container/detail/value_init.hpp>
 #include <boost/container/detail/destroyers.hpp>
 #include <boost/container/detail/algorithm.hpp> //algo_equal(), algo_lexicographical_compare
@@ -98,13 +99,21 @@ struct get_flat_tree_iterators
    typedef boost::container::reverse_iterator<const_iterator>  const_reverse_iterator;
 };
 
+//!AllocatorOrContainer can be an allocator, in that case elements are stored
+//!in a boost::container::vector<Value, AllocatorOrContainer>, or a vector-like
+//!sequence (vector, small_vector or static_vector) holding Values.
 template <class Key, class Value, class KeyOfValue,
-          class Compare, class Allocator>
+          class Compare, class AllocatorOrContainer>
 class flat_tree
 {
-   typedef boost::container::vector<Value, Allocator>    vector_t;
-   typedef Allocator                                     allocator_t;
-   typedef allocator_traits<Allocator>                   allocator_traits_type;
+   public:
+   typedef typename select_container_type
+      <Value, AllocatorOrContainer>::type                container_type;
+
+   private:
+   typedef container_type                                vector_t;
+   typedef typename container_type::allocator_type       allocator_t;
+   typedef allocator_traits<allocator_t>                 allocator_traits_type;
 
    public:
    typedef flat_tree_value_compare<Compare, Value, KeyOfValue> value_compare;
@@ -129,11 +138,11 @@ class flat_tree
          : value_compare(boost::move(static_cast<value_compare&>(d))), m_vect(boost::move(d.m_vect))
       {}
 
-      Data(const Data &d, const Allocator &a)
+      Data(const Data &d, const allocator_t &a)
          : value_compare(static_cast<const value_compare&>(d)), m_vect(d.m_vect, a)
       {}
 
-      Data(BOOST_RV_REF(Data) d, const Allocator &a)
+      Data(BOOST_RV_REF(Data) d, const allocator_t &a)
          : value_compare(boost::move(static_cast<value_compare&>(d))), m_vect(boost::move(d.m_vect), a)
       {}
 
@@ -179,15 +188,15 @@ class flat_tree
    public:
 
    typedef typename vector_t::value_type              value_type;
-   typedef typename vector_t::pointer                 pointer;
-   typedef typename vector_t::const_pointer           const_pointer;
-   typedef typename vector_t::reference               reference;
-   typedef typename vector_t::const_reference         const_reference;
+   typedef typename allocator_traits_type::pointer    pointer;
+   typedef typename allocator_traits_type::const_pointer const_pointer;
+   typedef typename allocator_traits_type::reference  reference;
+   typedef typename allocator_traits_type::const_reference const_reference;
    typedef Key                                        key_type;
    typedef Compare                                    key_compare;
-   typedef typename vector_t::allocator_type          allocator_type;
-   typedef typename vector_t::size_type               size_type;
-   typedef typename vector_t::difference_type         difference_type;
+   typedef allocator_t                                allocator_type;
+   typedef typename allocator_traits_type::size_type  size_type;
+   typedef typename allocator_traits_type::difference_type difference_type;
    typedef typename vector_t::iterator                iterator;
    typedef typename vector_t::const_iterator          const_iterator;
    typedef typename vector_t::reverse_iterator        reverse_iterator;
@@ -1023,12 +1032,12 @@ class flat_tree
 //!has_trivial_destructor_after_move<> == true_type
 //!specialization for optimizations
 template <class Key, class T, class KeyOfValue,
-class Compare, class Allocator>
-struct has_trivial_destructor_after_move<boost::container::container_detail::flat_tree<Key, T, KeyOfValue, Compare, Allocator> >
+class Compare, class AllocatorOrContainer>
+struct has_trivial_destructor_after_move<boost::container::container_detail::flat_tree<Key, T, KeyOfValue, Compare, AllocatorOrContainer> >
 {
-   typedef typename ::boost::container::allocator_traits<Allocator>::pointer pointer;
-   static const bool value = ::boost::has_trivial_destructor_after_move<Allocator>::value &&
-                             ::boost::has_trivial_destructor_after_move<pointer>::value;
+   typedef typename boost::container::container_detail::select_container_type
+      <T, AllocatorOrContainer>::type container_type;
+   static const bool value = ::boost::has_trivial_destructor_after_move<container_type>::value;
 };
 
 }  //namespace boost {
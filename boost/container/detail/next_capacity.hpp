@@ -22,6 +22,8 @@
 #include <boost/container/throw_exception.hpp>
 // container/detail
 #include <boost/container/detail/min_max.hpp>
+// other
+#include <boost/static_assert.hpp>
 
 namespace boost {
 namespace container {
@@ -68,6 +70,32 @@ struct next_capacity_calculator<SizeType, NextCapacity60Percent>
    }
 };
 
+//Growth policy that multiplies the current capacity by Numerator/Denominator,
+//always covering the additional elements requested and never returning
+//less than Minimum elements. Used to implement the growth_factor option.
+template<unsigned Minimum, unsigned Numerator, unsigned Denominator>
+struct grow_factor_ratio
+{
+   BOOST_STATIC_ASSERT(Numerator > Denominator);
+   BOOST_STATIC_ASSERT(Numerator   < 100);
+   BOOST_STATIC_ASSERT(Denominator < 100);
+
+   template<class SizeType>
+   SizeType operator()(const SizeType cur_cap, const SizeType add_min_cap, const SizeType max_cap) const
+   {
+      const SizeType remaining = max_cap - cur_cap;
+      if ( remaining < add_min_cap )
+         boost::container::throw_length_error("get_next_capacity, allocator's max_size reached");
+      const SizeType overflow_limit = SizeType(-1)/Numerator;
+      if ( cur_cap > overflow_limit )
+         return max_cap;
+      const SizeType grown = SizeType(cur_cap*Numerator/Denominator);
+      const SizeType additional = max_value( SizeType(grown - cur_cap)
+                                           , max_value(add_min_cap, SizeType(Minimum)));
+      return ( remaining < additional ) ? max_cap : SizeType( cur_cap + additional );
+   }
+};
+
 }  //namespace container_detail {
 }  //namespace container {
 }  //namespace boost {
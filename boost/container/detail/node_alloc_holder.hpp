@@ -41,6 +41,7 @@
 #include <boost/intrusive/options.hpp>
 // move
 #include <boost/move/utility_core.hpp>
+#include <boost/move/iterator.hpp>
 #if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
 #include <boost/move/detail/fwd_macros.hpp>
 #endif
@@ -367,7 +368,86 @@ struct node_alloc_holder
       return this->icont().erase_and_dispose(k, comp, chain_holder.get_chain_builder());
    }
 
+   //Nodes obtained from the allocator in a single burst and handed out one by one.
+   //Version 2 allocators (e.g. adaptive_pool, node_allocator or allocator<T, 2>)
+   //allocate all of them with a single allocate_individual call, version 1 allocators
+   //allocate each node on demand. Nodes not used are returned to the allocator
+   //when this object is destroyed.
+   class preallocated_nodes
+   {
+      typedef typename node_allocator_version_traits_type::multiallocation_chain multiallocation_chain;
+
+      preallocated_nodes(const preallocated_nodes &);
+      preallocated_nodes &operator=(const preallocated_nodes &);
+
+      public:
+      preallocated_nodes(node_alloc_holder &holder, size_type n)
+         : m_holder(holder), m_chain()
+      {  this->priv_allocate(n, alloc_version());  }
+
+      ~preallocated_nodes()
+      {
+         if(!m_chain.empty()){
+            node_allocator_version_traits_type::deallocate_individual(m_holder.node_alloc(), m_chain);
+         }
+      }
+
+      template<class It>
+      NodePtr create_node_from_it(const It &it)
+      {
+         NodePtr p = m_chain.empty() ? m_holder.allocate_one() : NodePtr(m_chain.pop_front());
+         BOOST_TRY{
+            ::boost::container::construct_in_place
+               (m_holder.node_alloc(), container_detail::addressof(p->m_data), it);
+         }
+         BOOST_CATCH(...){
+            m_chain.push_front(p);
+            BOOST_RETHROW
+         }
+         BOOST_CATCH_END
+         //This does not throw
+         typedef typename Node::hook_type hook_type;
+         ::new(static_cast<hook_type*>(container_detail::to_raw_pointer(p)), boost_container_new_t()) hook_type;
+         return p;
+      }
+
+      private:
+      void priv_allocate(size_type, version_1)
+      {}
+
+      void priv_allocate(size_type n, version_2)
+      {
+         if(n){
+            node_allocator_version_traits_type::allocate_individual(m_holder.node_alloc(), n, m_chain);
+         }
+      }
+
+      node_alloc_holder &m_holder;
+      multiallocation_chain m_chain;
+   };
+
    protected:
+   //Clones nodes using nodes previously obtained by preallocated_nodes
+   template<bool DoMove>
+   struct preallocated_cloner
+   {
+      explicit preallocated_cloner(preallocated_nodes &nodes)
+         :  m_nodes(nodes)
+      {}
+
+      NodePtr operator()(const Node &other) const
+      {  return this->priv_clone(const_cast<Node&>(other).get_data(), bool_<DoMove>());  }
+
+      private:
+      NodePtr priv_clone(value_type &v, bool_<true>) const
+      {  return m_nodes.create_node_from_it(::boost::make_move_iterator(container_detail::addressof(v)));  }
+
+      NodePtr priv_clone(const value_type &v, bool_<false>) const
+      {  return m_nodes.create_node_from_it(container_detail::addressof(v));  }
+
+      preallocated_nodes &m_nodes;
+   };
+
    struct cloner
    {
       explicit cloner(node_alloc_holder &holder)
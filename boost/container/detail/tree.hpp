@@ -386,17 +386,18 @@ namespace container_detail {
 //This functor will be used with Intrusive clone functions to obtain
 //already allocated nodes from a intrusive container instead of
 //allocating new ones. When the intrusive container runs out of nodes
-//the node holder is used instead.
+//preallocated nodes are used instead.
 template<class AllocHolder, bool DoMove>
 class RecyclingCloner
 {
    typedef typename AllocHolder::intrusive_container  intrusive_container;
    typedef typename AllocHolder::Node                 node_type;
    typedef typename AllocHolder::NodePtr              node_ptr_type;
+   typedef typename AllocHolder::preallocated_nodes   preallocated_nodes;
 
    public:
-   RecyclingCloner(AllocHolder &holder, intrusive_container &itree)
-      :  m_holder(holder), m_icont(itree)
+   RecyclingCloner(AllocHolder &holder, intrusive_container &itree, preallocated_nodes &nodes)
+      :  m_holder(holder), m_icont(itree), m_nodes(nodes)
    {}
 
    static void do_assign(node_ptr_type &p, const node_type &other, bool_<true>)
@@ -425,12 +426,13 @@ class RecyclingCloner
          BOOST_CATCH_END
       }
       else{
-         return m_holder.create_node(other.m_data);
+         return m_nodes.create_node_from_it(container_detail::addressof(other.m_data));
       }
    }
 
    AllocHolder &m_holder;
    intrusive_container &m_icont;
+   preallocated_nodes &m_nodes;
 };
 
 template<class KeyValueCompare, class Node>
@@ -586,13 +588,8 @@ class tree
       : AllocHolder(value_compare(comp), a)
    {
       if(unique_insertion){
-         //Use cend() as hint to achieve linear time for
-         //ordered ranges as required by the standard
-         //for the constructor
-         const const_iterator end_it(this->cend());
-         for ( ; first != last; ++first){
-            this->insert_unique(end_it, *first);
-         }
+         //Optimized allocation, linear time for ordered ranges
+         this->priv_insert_unique_range(first, last, container_detail::false_type());
       }
       else{
          //Optimized allocation and construction
@@ -639,10 +636,7 @@ class tree
 
    tree(const tree& x)
       :  AllocHolder(x.value_comp(), x)
-   {
-      this->icont().clone_from
-         (x.icont(), typename AllocHolder::cloner(*this), Destroyer(this->node_alloc()));
-   }
+   {  this->priv_clone_from(x, container_detail::false_type());   }
 
    tree(BOOST_RV_REF(tree) x)
       :  AllocHolder(BOOST_MOVE_BASE(AllocHolder, x), x.value_comp())
@@ -650,10 +644,7 @@ class tree
 
    tree(const tree& x, const allocator_type &a)
       :  AllocHolder(x.value_comp(), a)
-   {
-      this->icont().clone_from
-         (x.icont(), typename AllocHolder::cloner(*this), Destroyer(this->node_alloc()));
-   }
+   {  this->priv_clone_from(x, container_detail::false_type());   }
 
    tree(BOOST_RV_REF(tree) x, const allocator_type &a)
       :  AllocHolder(x.value_comp(), a)
@@ -662,14 +653,52 @@ class tree
          this->icont().swap(x.icont());
       }
       else{
-         this->icont().clone_from
-            (x.icont(), typename AllocHolder::move_cloner(*this), Destroyer(this->node_alloc()));
+         this->priv_clone_from(x, container_detail::true_type());
       }
    }
 
    ~tree()
    {} //AllocHolder clears the tree
 
+   private:
+   template<bool DoMove>
+   void priv_clone_from(const tree &x, container_detail::bool_<DoMove>)
+   {
+      //All nodes are allocated in a single burst before cloning
+      typename AllocHolder::preallocated_nodes nodes(*this, x.size());
+      this->icont().clone_from
+         ( x.icont()
+         , typename AllocHolder::template preallocated_cloner<DoMove>(nodes)
+         , Destroyer(this->node_alloc()));
+   }
+
+   template<bool DoMove>
+   void priv_recycling_clone_from(const tree &x, container_detail::bool_<DoMove>)
+   {
+      //Transfer all the nodes to a temporary tree
+      //If anything goes wrong, all the nodes will be destroyed
+      //automatically
+      Icont other_tree(::boost::move(this->icont()));
+
+      //Nodes that can't be recycled are allocated in a single burst
+      const size_type recycled = other_tree.size();
+      typename AllocHolder::preallocated_nodes nodes(*this, x.size() > recycled ? x.size() - recycled : 0u);
+
+      //Now recreate the source tree reusing nodes stored by other_tree
+      this->icont().clone_from
+         (x.icont()
+         , RecyclingCloner<AllocHolder, DoMove>(*this, other_tree, nodes)
+         , Destroyer(this->node_alloc()));
+
+      //If there are remaining nodes, destroy them
+      NodePtr p;
+      while((p = other_tree.unlink_leftmost_without_rebalance())){
+         AllocHolder::destroy_node(p);
+      }
+   }
+
+   public:
+
    tree& operator=(BOOST_COPY_ASSIGN_REF(tree) x)
    {
       if (&x != this){
@@ -681,22 +710,7 @@ class tree
             this->clear();
          }
          this->AllocHolder::copy_assign_alloc(x);
-         //Transfer all the nodes to a temporary tree
-         //If anything goes wrong, all the nodes will be destroyed
-         //automatically
-         Icont other_tree(::boost::move(this->icont()));
-
-         //Now recreate the source tree reusing nodes stored by other_tree
-         this->icont().clone_from
-            (x.icont()
-            , RecyclingCloner<AllocHolder, false>(*this, other_tree)
-            , Destroyer(this->node_alloc()));
-
-         //If there are remaining nodes, destroy them
-         NodePtr p;
-         while((p = other_tree.unlink_leftmost_without_rebalance())){
-            AllocHolder::destroy_node(p);
-         }
+         this->priv_recycling_clone_from(x, container_detail::false_type());
       }
       return *this;
    }
@@ -723,22 +737,7 @@ class tree
       }
       //Else do a one by one move
       else{
-         //Transfer all the nodes to a temporary tree
-         //If anything goes wrong, all the nodes will be destroyed
-         //automatically
-         Icont other_tree(::boost::move(this->icont()));
-
-         //Now recreate the source tree reusing nodes stored by other_tree
-         this->icont().clone_from
-            (x.icont()
-            , RecyclingCloner<AllocHolder, true>(*this, other_tree)
-            , Destroyer(this->node_alloc()));
-
-         //If there are remaining nodes, destroy them
-         NodePtr p;
-         while((p = other_tree.unlink_leftmost_without_rebalance())){
-            AllocHolder::destroy_node(p);
-         }
+         this->priv_recycling_clone_from(x, container_detail::true_type());
       }
       return *this;
    }
@@ -1027,11 +1026,40 @@ class tree
 
    template <class InputIterator>
    void insert_unique(InputIterator first, InputIterator last)
+   {
+      this->priv_insert_unique_range(first, last, container_detail::bool_
+         < container_detail::is_input_iterator<InputIterator>::value
+         || container_detail::is_same<alloc_version, version_1>::value>());
+   }
+
+   private:
+   template <class InputIterator>
+   void priv_insert_unique_range(InputIterator first, InputIterator last, container_detail::true_type)
    {
       for( ; first != last; ++first)
          this->insert_unique(*first);
    }
 
+   template <class FwdIt>
+   void priv_insert_unique_range(FwdIt first, FwdIt last, container_detail::false_type)
+   {
+      //Nodes are allocated in a single burst, nodes not used
+      //because of duplicated keys are returned to the allocator
+      typename AllocHolder::preallocated_nodes nodes
+         (*this, boost::container::iterator_distance(first, last));
+      //Use cend() as hint to achieve linear time for ordered ranges
+      const const_iterator end_it(this->cend());
+      insert_commit_data data;
+      for( ; first != last; ++first){
+         if(this->insert_unique_check(end_it, KeyOfValue()(*first), data).second){
+            //This can't throw
+            this->icont().insert_unique_commit(*nodes.create_node_from_it(first), data);
+         }
+      }
+   }
+
+   public:
+
    iterator insert_equal(const value_type& v)
    {
       NodePtr tmp(AllocHolder::create_node(v));
@@ -1072,11 +1100,31 @@ class tree
 
    template <class InputIterator>
    void insert_equal(InputIterator first, InputIterator last)
+   {
+      this->priv_insert_equal_range(first, last, container_detail::bool_
+         < container_detail::is_input_iterator<InputIterator>::value
+         || container_detail::is_same<alloc_version, version_1>::value>());
+   }
+
+   private:
+   template <class InputIterator>
+   void priv_insert_equal_range(InputIterator first, InputIterator last, container_detail::true_type)
    {
       for( ; first != last; ++first)
          this->insert_equal(*first);
    }
 
+   template <class FwdIt>
+   void priv_insert_equal_range(FwdIt first, FwdIt last, container_detail::false_type)
+   {
+      //Optimized allocation and construction
+      this->allocate_many_and_construct
+         ( first, boost::container::iterator_distance(first, last)
+         , insert_equal_end_hint_functor<Node, Icont>(this->icont()));
+   }
+
+   public:
+
    iterator erase(const_iterator position)
    {  return iterator(this->icont().erase_and_dispose(position.get(), Destroyer(this->node_alloc()))); }
 
@@ -0,0 +1,2083 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_DEVECTOR_HPP
+#define BOOST_CONTAINER_DEVECTOR_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/detail/workaround.hpp>
+
+// container
+#include <boost/container/container_fwd.hpp>
+#include <boost/container/allocator_traits.hpp>
+#include <boost/container/new_allocator.hpp> //new_allocator
+#include <boost/container/options.hpp>
+#include <boost/container/throw_exception.hpp>
+#include <boost/container/vector.hpp>        //vec_iterator
+// container detail
+#include <boost/container/detail/addressof.hpp>
+#include <boost/container/detail/advanced_insert_int.hpp>
+#include <boost/container/detail/algorithm.hpp> //equal()
+#include <boost/container/detail/alloc_helpers.hpp>
+#include <boost/container/detail/copy_move_algo.hpp>
+#include <boost/container/detail/destroyers.hpp>
+#include <boost/container/detail/iterator.hpp>
+#include <boost/container/detail/iterators.hpp>
+#include <boost/container/detail/iterator_to_raw_pointer.hpp>
+#include <boost/container/detail/mpl.hpp>
+#include <boost/container/detail/next_capacity.hpp>
+#include <boost/container/detail/to_raw_pointer.hpp>
+#include <boost/container/detail/type_traits.hpp>
+// intrusive
+#include <boost/intrusive/pointer_traits.hpp>
+// move
+#include <boost/move/adl_move_swap.hpp>
+#include <boost/move/iterator.hpp>
+#include <boost/move/traits.hpp>
+#include <boost/move/utility_core.hpp>
+// move/detail
+#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+#include <boost/move/detail/fwd_macros.hpp>
+#endif
+#include <boost/move/detail/move_helpers.hpp>
+// other
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/assert.hpp>
+
+//std
+#if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
+#include <initializer_list>   //for std::initializer_list
+#endif
+
+namespace boost {
+namespace container {
+
+#ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+
+namespace container_detail {
+
+template<class GrowthType>
+struct devector_growth_factor
+{  typedef GrowthType type;  };
+
+template<>
+struct devector_growth_factor<void>
+{  typedef growth_factor_60 type;  };
+
+template<class Options>
+struct get_devector_opt
+{
+   typedef devector_opt
+      <typename devector_growth_factor<typename Options::growth_factor_type>::type> type;
+};
+
+template<>
+struct get_devector_opt<void>
+{
+   typedef devector_opt<growth_factor_60> type;
+};
+
+//!This struct holds the allocator and the buffer of a devector.
+//!The buffer is [m_start, m_start + m_capacity) and the
+//!constructed elements are [m_start + m_front, m_start + m_back)
+template <class Allocator>
+struct devector_alloc_holder
+   : public Allocator
+{
+   private:
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(devector_alloc_holder)
+
+   public:
+   typedef Allocator                                     allocator_type;
+   typedef boost::container::allocator_traits<Allocator> allocator_traits_type;
+   typedef typename allocator_traits_type::pointer       pointer;
+   typedef typename allocator_traits_type::size_type     size_type;
+   typedef typename allocator_traits_type::value_type    value_type;
+
+   //Constructor, does not throw
+   devector_alloc_holder()
+      BOOST_NOEXCEPT_IF(container_detail::is_nothrow_default_constructible<Allocator>::value)
+      : Allocator(), m_start(), m_capacity(), m_front(), m_back()
+   {}
+
+   //Constructor, does not throw
+   template<class AllocConvertible>
+   explicit devector_alloc_holder(BOOST_FWD_REF(AllocConvertible) a) BOOST_NOEXCEPT_OR_NOTHROW
+      : Allocator(boost::forward<AllocConvertible>(a)), m_start(), m_capacity(), m_front(), m_back()
+   {}
+
+   //Constructor, allocates memory for initial_capacity elements but
+   //does not construct them (the devector is still empty)
+   template<class AllocConvertible>
+   devector_alloc_holder(uninitialized_size_t, BOOST_FWD_REF(AllocConvertible) a, size_type initial_capacity)
+      : Allocator(boost::forward<AllocConvertible>(a)), m_start(), m_capacity(), m_front(), m_back()
+   {  this->priv_first_allocation(initial_capacity);  }
+
+   //Constructor, allocates memory for initial_capacity elements but
+   //does not construct them (the devector is still empty)
+   devector_alloc_holder(uninitialized_size_t, size_type initial_capacity)
+      : Allocator(), m_start(), m_capacity(), m_front(), m_back()
+   {  this->priv_first_allocation(initial_capacity);  }
+
+   devector_alloc_holder(BOOST_RV_REF(devector_alloc_holder) holder) BOOST_NOEXCEPT_OR_NOTHROW
+      : Allocator(BOOST_MOVE_BASE(Allocator, holder))
+      , m_start(holder.m_start), m_capacity(holder.m_capacity)
+      , m_front(holder.m_front), m_back(holder.m_back)
+   {
+      holder.m_start = pointer();
+      holder.m_capacity = holder.m_front = holder.m_back = 0;
+   }
+
+   ~devector_alloc_holder() BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      if(this->m_capacity){
+         this->alloc().deallocate(this->m_start, this->m_capacity);
+      }
+   }
+
+   void swap_resources(devector_alloc_holder &x) BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      boost::adl_move_swap(this->m_start, x.m_start);
+      boost::adl_move_swap(this->m_capacity, x.m_capacity);
+      boost::adl_move_swap(this->m_front, x.m_front);
+      boost::adl_move_swap(this->m_back, x.m_back);
+   }
+
+   void steal_resources(devector_alloc_holder &x) BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      this->m_start     = x.m_start;
+      this->m_capacity  = x.m_capacity;
+      this->m_front     = x.m_front;
+      this->m_back      = x.m_back;
+      x.m_start = pointer();
+      x.m_capacity = x.m_front = x.m_back = 0;
+   }
+
+   //Deallocates the buffer. Elements must be already destroyed
+   void deallocate_buffer() BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      if(this->m_capacity){
+         this->alloc().deallocate(this->m_start, this->m_capacity);
+      }
+      this->m_start = pointer();
+      this->m_capacity = this->m_front = this->m_back = 0;
+   }
+
+   Allocator &alloc() BOOST_NOEXCEPT_OR_NOTHROW
+   {  return *this;  }
+
+   const Allocator &alloc() const BOOST_NOEXCEPT_OR_NOTHROW
+   {  return *this;  }
+
+   value_type *raw_start() const BOOST_NOEXCEPT_OR_NOTHROW
+   {  return container_detail::to_raw_pointer(this->m_start);  }
+
+   pointer     m_start;
+   size_type   m_capacity;
+   size_type   m_front;
+   size_type   m_back;
+
+   private:
+   void priv_first_allocation(size_type cap)
+   {
+      if(cap){
+         m_start = allocator_traits_type::allocate(this->alloc(), cap);
+         m_capacity = cap;
+      }
+   }
+};
+
+}  //namespace container_detail {
+
+#endif   //#ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+
+//! A devector is a sequence that supports random access to elements, amortized constant time
+//! insertion and removal of elements at both ends, and linear time insertion and removal of
+//! elements in the middle. Unlike deque, elements are stored in a single contiguous buffer
+//! with free capacity kept at both ends, so it can be used where contiguous storage (e.g.
+//! <code>data()</code>) and cheap front erasure are needed at the same time.
+//!
+//! Extra capacity at the back or at the front can be reserved with reserve_back() and reserve_front(),
+//! and unsafe_push_back()/unsafe_push_front() can be used to insert elements without checking
+//! for free capacity when the caller has already reserved enough storage.
+//!
+//! \tparam T The type of object that is stored in the devector
+//! \tparam Allocator The allocator used for all internal memory management
+//! \tparam Options A type produced from \c boost::container::devector_options. Supported
+//!   option: \c boost::container::growth_factor. Defaults to \c growth_factor_60.
+template <class T, class Allocator BOOST_CONTAINER_DOCONLY(= new_allocator<T>), class Options BOOST_CONTAINER_DOCONLY(= void) >
+class devector
+{
+   #ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+
+   typedef boost::container::container_detail::devector_alloc_holder<Allocator> alloc_holder_t;
+   alloc_holder_t m_holder;
+   typedef allocator_traits<Allocator>                               allocator_traits_type;
+   typedef typename container_detail::get_devector_opt<Options>::type options_type;
+   typedef typename options_type::growth_factor_type                 growth_factor_type;
+
+   typedef typename allocator_traits_type::pointer                   pointer_impl;
+   typedef container_detail::vec_iterator<pointer_impl, false>       iterator_impl;
+   typedef container_detail::vec_iterator<pointer_impl, true >       const_iterator_impl;
+
+   #endif   //#ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+   public:
+   //////////////////////////////////////////////
+   //
+   //                    types
+   //
+   //////////////////////////////////////////////
+
+   typedef T                                                                           value_type;
+   typedef typename ::boost::container::allocator_traits<Allocator>::pointer           pointer;
+   typedef typename ::boost::container::allocator_traits<Allocator>::const_pointer     const_pointer;
+   typedef typename ::boost::container::allocator_traits<Allocator>::reference         reference;
+   typedef typename ::boost::container::allocator_traits<Allocator>::const_reference   const_reference;
+   typedef typename ::boost::container::allocator_traits<Allocator>::size_type         size_type;
+   typedef typename ::boost::container::allocator_traits<Allocator>::difference_type   difference_type;
+   typedef Allocator                                                                   allocator_type;
+   typedef Allocator                                                                   stored_allocator_type;
+   typedef BOOST_CONTAINER_IMPDEF(iterator_impl)                                       iterator;
+   typedef BOOST_CONTAINER_IMPDEF(const_iterator_impl)                                 const_iterator;
+   typedef BOOST_CONTAINER_IMPDEF(boost::container::reverse_iterator<iterator>)        reverse_iterator;
+   typedef BOOST_CONTAINER_IMPDEF(boost::container::reverse_iterator<const_iterator>)  const_reverse_iterator;
+
+   #ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+   private:
+   BOOST_COPYABLE_AND_MOVABLE(devector)
+   typedef container_detail::vector_value_traits<Allocator> value_traits;
+   typedef constant_iterator<T, difference_type>            cvalue_iterator;
+   #endif   //#ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+
+   public:
+   //////////////////////////////////////////////
+   //
+   //          construct/copy/destroy
+   //
+   //////////////////////////////////////////////
+
+   //! <b>Effects</b>: Constructs an empty devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   devector() BOOST_NOEXCEPT_OR_NOTHROW
+      : m_holder()
+   {}
+
+   //! <b>Effects</b>: Constructs an empty devector taking the allocator as parameter.
+   //!
+   //! <b>Throws</b>: Nothing
+   //!
+   //! <b>Complexity</b>: Constant.
+   explicit devector(const allocator_type& a) BOOST_NOEXCEPT_OR_NOTHROW
+      : m_holder(a)
+   {}
+
+   //! <b>Effects</b>: Constructs a devector and inserts n value initialized values.
+   //!
+   //! <b>Throws</b>: If allocator_type's allocation
+   //!   throws or T's value initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   explicit devector(size_type n)
+      : m_holder(container_detail::uninitialized_size, n)
+   {
+      boost::container::uninitialized_value_init_alloc_n(this->m_holder.alloc(), n, this->m_holder.raw_start());
+      this->m_holder.m_back = n;
+   }
+
+   //! <b>Effects</b>: Constructs a devector and inserts n default initialized values.
+   //!
+   //! <b>Throws</b>: If allocator_type's allocation
+   //!   throws or T's default initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   devector(size_type n, default_init_t)
+      : m_holder(container_detail::uninitialized_size, n)
+   {
+      boost::container::uninitialized_default_init_alloc_n(this->m_holder.alloc(), n, this->m_holder.raw_start());
+      this->m_holder.m_back = n;
+   }
+
+   //! <b>Effects</b>: Constructs a devector that will use a copy of allocator a
+   //!   and inserts n value initialized values.
+   //!
+   //! <b>Throws</b>: If allocator_type's allocation
+   //!   throws or T's value initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   explicit devector(size_type n, const allocator_type &a)
+      : m_holder(container_detail::uninitialized_size, a, n)
+   {
+      boost::container::uninitialized_value_init_alloc_n(this->m_holder.alloc(), n, this->m_holder.raw_start());
+      this->m_holder.m_back = n;
+   }
+
+   //! <b>Effects</b>: Constructs a devector that will use a copy of allocator a
+   //!   and inserts n default initialized values.
+   //!
+   //! <b>Throws</b>: If allocator_type's allocation
+   //!   throws or T's default initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   devector(size_type n, default_init_t, const allocator_type &a)
+      : m_holder(container_detail::uninitialized_size, a, n)
+   {
+      boost::container::uninitialized_default_init_alloc_n(this->m_holder.alloc(), n, this->m_holder.raw_start());
+      this->m_holder.m_back = n;
+   }
+
+   //! <b>Effects</b>: Constructs a devector and inserts n copies of value.
+   //!
+   //! <b>Throws</b>: If allocator_type's allocation
+   //!   throws or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   devector(size_type n, const T& value)
+      : m_holder(container_detail::uninitialized_size, n)
+   {
+      boost::container::uninitialized_fill_alloc_n(this->m_holder.alloc(), value, n, this->m_holder.raw_start());
+      this->m_holder.m_back = n;
+   }
+
+   //! <b>Effects</b>: Constructs a devector that will use a copy of allocator a
+   //!   and inserts n copies of value.
+   //!
+   //! <b>Throws</b>: If allocation
+   //!   throws or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   devector(size_type n, const T& value, const allocator_type& a)
+      : m_holder(container_detail::uninitialized_size, a, n)
+   {
+      boost::container::uninitialized_fill_alloc_n(this->m_holder.alloc(), value, n, this->m_holder.raw_start());
+      this->m_holder.m_back = n;
+   }
+
+   //! <b>Effects</b>: Constructs a devector
+   //!   and inserts a copy of the range [first, last) in the devector.
+   //!
+   //! <b>Throws</b>: If allocator_type's allocation
+   //!   throws or T's constructor taking a dereferenced InIt throws.
+   //!
+   //! <b>Complexity</b>: Linear to the range [first, last).
+   template <class InIt>
+   devector(InIt first, InIt last)
+      : m_holder()
+   {  this->assign(first, last); }
+
+   //! <b>Effects</b>: Constructs a devector that will use a copy of allocator a
+   //!   and inserts a copy of the range [first, last) in the devector.
+   //!
+   //! <b>Throws</b>: If allocator_type's allocation
+   //!   throws or T's constructor taking a dereferenced InIt throws.
+   //!
+   //! <b>Complexity</b>: Linear to the range [first, last).
+   template <class InIt>
+   devector(InIt first, InIt last, const allocator_type& a)
+      : m_holder(a)
+   {  this->assign(first, last); }
+
+   //! <b>Effects</b>: Copy constructs a devector.
+   //!
+   //! <b>Postcondition</b>: x == *this.
+   //!
+   //! <b>Throws</b>: If allocator_type's allocation
+   //!   throws or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the elements x contains.
+   devector(const devector &x)
+      : m_holder( container_detail::uninitialized_size
+                , allocator_traits_type::select_on_container_copy_construction(x.m_holder.alloc())
+                , x.size())
+   {
+      ::boost::container::uninitialized_copy_alloc_n
+         (this->m_holder.alloc(), x.priv_raw_begin(), x.size(), this->m_holder.raw_start());
+      this->m_holder.m_back = x.size();
+   }
+
+   //! <b>Effects</b>: Move constructor. Moves x's resources to *this.
+   //!
+   //! <b>Throws</b>: Nothing
+   //!
+   //! <b>Complexity</b>: Constant.
+   devector(BOOST_RV_REF(devector) x) BOOST_NOEXCEPT_OR_NOTHROW
+      : m_holder(boost::move(x.m_holder))
+   {}
+
+   #if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
+   //! <b>Effects</b>: Constructs a devector that will use a copy of allocator a
+   //!  and inserts a copy of the range [il.begin(), il.last()) in the devector
+   //!
+   //! <b>Throws</b>: If T's constructor taking a dereferenced initializer_list iterator throws.
+   //!
+   //! <b>Complexity</b>: Linear to the range [il.begin(), il.end()).
+   devector(std::initializer_list<value_type> il, const allocator_type& a = allocator_type())
+      : m_holder(a)
+   {
+      this->assign(il.begin(), il.end());
+   }
+   #endif
+
+   //! <b>Effects</b>: Copy constructs a devector using the specified allocator.
+   //!
+   //! <b>Postcondition</b>: x == *this.
+   //!
+   //! <b>Throws</b>: If allocation
+   //!   throws or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the elements x contains.
+   devector(const devector &x, const allocator_type &a)
+      : m_holder(container_detail::uninitialized_size, a, x.size())
+   {
+      ::boost::container::uninitialized_copy_alloc_n
+         (this->m_holder.alloc(), x.priv_raw_begin(), x.size(), this->m_holder.raw_start());
+      this->m_holder.m_back = x.size();
+   }
+
+   //! <b>Effects</b>: Move constructor using the specified allocator.
+   //!                 Moves x's resources to *this if a == allocator_type().
+   //!                 Otherwise copies values from x to *this.
+   //!
+   //! <b>Throws</b>: If allocation or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant if a == x.get_allocator(), linear otherwise.
+   devector(BOOST_RV_REF(devector) x, const allocator_type &a)
+      : m_holder(container_detail::uninitialized_size, a, allocator_traits_type::equal(x.m_holder.alloc(), a) ? 0 : x.size())
+   {
+      if(allocator_traits_type::equal(x.m_holder.alloc(), a)){
+         this->m_holder.steal_resources(x.m_holder);
+      }
+      else{
+         ::boost::container::uninitialized_move_alloc_n
+            (this->m_holder.alloc(), x.priv_raw_begin(), x.size(), this->m_holder.raw_start());
+         this->m_holder.m_back = x.size();
+      }
+   }
+
+   //! <b>Effects</b>: Destroys the devector. All stored values are destroyed
+   //!   and used memory is deallocated.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements.
+   ~devector() BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      boost::container::destroy_alloc_n(this->m_holder.alloc(), this->priv_raw_begin(), this->size());
+      //devector_alloc_holder deallocates the data
+   }
+
+   //! <b>Effects</b>: Makes *this contain the same elements as x.
+   //!
+   //! <b>Postcondition</b>: this->size() == x.size(). *this contains a copy
+   //! of each of x's elements.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's copy/move constructor/assignment throws.
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in x.
+   devector& operator=(BOOST_COPY_ASSIGN_REF(devector) x)
+   {
+      if (&x != this){
+         allocator_type &this_alloc     = this->m_holder.alloc();
+         const allocator_type &x_alloc  = x.m_holder.alloc();
+         container_detail::bool_<allocator_traits_type::
+            propagate_on_container_copy_assignment::value> flag;
+         if(flag && this_alloc != x_alloc){
+            this->clear();
+            this->m_holder.deallocate_buffer();
+         }
+         container_detail::assign_alloc(this_alloc, x_alloc, flag);
+         this->assign(x.priv_raw_begin(), x.priv_raw_end());
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Move assignment. All x's values are transferred to *this.
+   //!
+   //! <b>Postcondition</b>: x.empty(). *this contains a the elements x had
+   //!   before the function.
+   //!
+   //! <b>Throws</b>: If allocator_traits_type::propagate_on_container_move_assignment
+   //!   is false and (allocation throws or value_type's move constructor throws)
+   //!
+   //! <b>Complexity</b>: Constant if allocator_traits_type::
+   //!   propagate_on_container_move_assignment is true or
+   //!   this->get>allocator() == x.get_allocator(). Linear otherwise.
+   devector& operator=(BOOST_RV_REF(devector) x)
+      BOOST_NOEXCEPT_IF(allocator_traits_type::propagate_on_container_move_assignment::value
+                                  || allocator_traits_type::is_always_equal::value)
+   {
+      BOOST_ASSERT(this != &x);
+      allocator_type &this_alloc = this->m_holder.alloc();
+      allocator_type &x_alloc    = x.m_holder.alloc();
+      const bool propagate_alloc = allocator_traits_type::propagate_on_container_move_assignment::value;
+      //Resources can be transferred if both allocators are
+      //going to be equal after this function (either propagated or already equal)
+      if(propagate_alloc || allocator_traits_type::equal(this_alloc, x_alloc)){
+         this->clear();
+         this->m_holder.deallocate_buffer();
+         this->m_holder.steal_resources(x.m_holder);
+         //Move allocator if needed
+         container_detail::move_alloc(this_alloc, x_alloc, container_detail::bool_<propagate_alloc>());
+      }
+      //Else do a one by one move
+      else{
+         this->assign( boost::make_move_iterator(x.priv_raw_begin())
+                     , boost::make_move_iterator(x.priv_raw_end()));
+      }
+      return *this;
+   }
+
+   #if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
+   //! <b>Effects</b>: Make *this container contains elements from il.
+   //!
+   //! <b>Complexity</b>: Linear to the range [il.begin(), il.end()).
+   devector& operator=(std::initializer_list<value_type> il)
+   {
+      this->assign(il.begin(), il.end());
+      return *this;
+   }
+   #endif
+
+   //! <b>Effects</b>: Assigns the the range [first, last) to *this.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's copy/move constructor/assignment or
+   //!   T's constructor/assignment from dereferencing InpIt throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   template <class InIt>
+   void assign(InIt first, InIt last
+      BOOST_CONTAINER_DOCIGN(BOOST_MOVE_I typename container_detail::enable_if_c
+         < !container_detail::is_convertible<InIt BOOST_MOVE_I size_type>::value &&
+            container_detail::is_input_iterator<InIt>::value
+         >::type * = 0) )
+   {
+      //Overwrite all elements we can from [first, last)
+      T *cur = this->priv_raw_begin();
+      T *const end_ptr = this->priv_raw_end();
+      for ( ; first != last && cur != end_ptr; ++cur, ++first){
+         *cur = *first;
+      }
+
+      if (first == last){
+         //There are no more elements in the sequence, erase remaining
+         this->priv_destroy_last_n(static_cast<size_type>(end_ptr - cur));
+      }
+      else{
+         //There are more elements in the range, insert the remaining ones
+         for ( ; first != last; ++first){
+            this->emplace_back(*first);
+         }
+      }
+   }
+
+   #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+   template <class FwdIt>
+   void assign(FwdIt first, FwdIt last
+      , typename container_detail::enable_if_c
+         < !container_detail::is_convertible<FwdIt, size_type>::value &&
+            !container_detail::is_input_iterator<FwdIt>::value
+         >::type * = 0
+      )
+   {
+      const size_type n = static_cast<size_type>(boost::container::iterator_distance(first, last));
+      if(n > this->m_holder.m_capacity){
+         //Not enough memory, allocate a new buffer and construct
+         //elements at the start, so that the free capacity is at the back.
+         pointer const new_buf = allocator_traits_type::allocate(this->m_holder.alloc(), n);
+         typename value_traits::ArrayDeallocator new_buffer_deallocator(new_buf, this->m_holder.alloc(), n);
+         boost::container::uninitialized_copy_alloc_n_source
+            (this->m_holder.alloc(), first, n, container_detail::to_raw_pointer(new_buf));
+         new_buffer_deallocator.release();
+         this->clear();
+         this->m_holder.deallocate_buffer();
+         this->m_holder.m_start = new_buf;
+         this->m_holder.m_capacity = n;
+         this->m_holder.m_back = n;
+      }
+      else if(n <= (this->m_holder.m_capacity - this->m_holder.m_front)){
+         //Enough free capacity from the current front: overwrite
+         //the existing elements and construct/destroy the rest.
+         const size_type sz = this->size();
+         T *const begin_ptr = this->priv_raw_begin();
+         if(n <= sz){
+            boost::container::copy_n(first, n, begin_ptr);
+            this->priv_destroy_last_n(sz - n);
+         }
+         else{
+            first = boost::container::copy_n_source(first, sz, begin_ptr);
+            boost::container::uninitialized_copy_alloc_n
+               (this->m_holder.alloc(), first, n - sz, begin_ptr + sz);
+            this->m_holder.m_back += n - sz;
+         }
+      }
+      else{
+         //Enough capacity but not after the current front,
+         //restart the buffer from the beginning.
+         this->clear();
+         boost::container::uninitialized_copy_alloc_n
+            (this->m_holder.alloc(), first, n, this->m_holder.raw_start());
+         this->m_holder.m_back = n;
+      }
+   }
+   #endif
+
+   #if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
+   //! <b>Effects</b>: Assigns the the range [il.begin(), il.end()) to *this.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or
+   //!   T's constructor from dereferencing iniializer_list iterator throws.
+   //!
+   void assign(std::initializer_list<T> il)
+   {
+      this->assign(il.begin(), il.end());
+   }
+   #endif
+
+   //! <b>Effects</b>: Assigns the n copies of val to *this.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or
+   //!   T's copy/move constructor/assignment throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   void assign(size_type n, const value_type& val)
+   {  this->assign(cvalue_iterator(val, n), cvalue_iterator());   }
+
+   //! <b>Effects</b>: Returns a copy of the internal allocator.
+   //!
+   //! <b>Throws</b>: If allocator's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant.
+   allocator_type get_allocator() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->m_holder.alloc();  }
+
+   //! <b>Effects</b>: Returns a reference to the internal allocator.
+   //!
+   //! <b>Throws</b>: Nothing
+   //!
+   //! <b>Complexity</b>: Constant.
+   //!
+   //! <b>Note</b>: Non-standard extension.
+   stored_allocator_type &get_stored_allocator() BOOST_NOEXCEPT_OR_NOTHROW
+   {  return this->m_holder.alloc(); }
+
+   //! <b>Effects</b>: Returns a reference to the internal allocator.
+   //!
+   //! <b>Throws</b>: Nothing
+   //!
+   //! <b>Complexity</b>: Constant.
+   //!
+   //! <b>Note</b>: Non-standard extension.
+   const stored_allocator_type &get_stored_allocator() const BOOST_NOEXCEPT_OR_NOTHROW
+   {  return this->m_holder.alloc(); }
+
+   //////////////////////////////////////////////
+   //
+   //                iterators
+   //
+   //////////////////////////////////////////////
+
+   //! <b>Effects</b>: Returns an iterator to the first element contained in the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   iterator begin() BOOST_NOEXCEPT_OR_NOTHROW
+   { return iterator(this->m_holder.m_start + this->m_holder.m_front); }
+
+   //! <b>Effects</b>: Returns a const_iterator to the first element contained in the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_iterator begin() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->cbegin(); }
+
+   //! <b>Effects</b>: Returns an iterator to the end of the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   iterator end() BOOST_NOEXCEPT_OR_NOTHROW
+   { return iterator(this->m_holder.m_start + this->m_holder.m_back); }
+
+   //! <b>Effects</b>: Returns a const_iterator to the end of the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_iterator end() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->cend(); }
+
+   //! <b>Effects</b>: Returns a reverse_iterator pointing to the beginning
+   //! of the reversed devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   reverse_iterator rbegin() BOOST_NOEXCEPT_OR_NOTHROW
+   { return reverse_iterator(this->end());      }
+
+   //! <b>Effects</b>: Returns a const_reverse_iterator pointing to the beginning
+   //! of the reversed devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_reverse_iterator rbegin() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->crbegin(); }
+
+   //! <b>Effects</b>: Returns a reverse_iterator pointing to the end
+   //! of the reversed devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   reverse_iterator rend() BOOST_NOEXCEPT_OR_NOTHROW
+   { return reverse_iterator(this->begin());       }
+
+   //! <b>Effects</b>: Returns a const_reverse_iterator pointing to the end
+   //! of the reversed devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_reverse_iterator rend() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->crend(); }
+
+   //! <b>Effects</b>: Returns a const_iterator to the first element contained in the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_iterator cbegin() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return const_iterator(this->m_holder.m_start + this->m_holder.m_front); }
+
+   //! <b>Effects</b>: Returns a const_iterator to the end of the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_iterator cend() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return const_iterator(this->m_holder.m_start + this->m_holder.m_back); }
+
+   //! <b>Effects</b>: Returns a const_reverse_iterator pointing to the beginning
+   //! of the reversed devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_reverse_iterator crbegin() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return const_reverse_iterator(this->cend());}
+
+   //! <b>Effects</b>: Returns a const_reverse_iterator pointing to the end
+   //! of the reversed devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_reverse_iterator crend() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return const_reverse_iterator(this->cbegin()); }
+
+   //////////////////////////////////////////////
+   //
+   //                capacity
+   //
+   //////////////////////////////////////////////
+
+   //! <b>Effects</b>: Returns true if the devector contains no elements.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   bool empty() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->m_holder.m_front == this->m_holder.m_back; }
+
+   //! <b>Effects</b>: Returns the number of the elements contained in the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   size_type size() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->m_holder.m_back - this->m_holder.m_front; }
+
+   //! <b>Effects</b>: Returns the largest possible size of the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   size_type max_size() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return allocator_traits_type::max_size(this->m_holder.alloc()); }
+
+   //! <b>Effects</b>: Number of elements for which memory has been allocated,
+   //!   including the free capacity at both ends. capacity() is always greater
+   //!   than or equal to size().
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   size_type capacity() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->m_holder.m_capacity; }
+
+   //! <b>Effects</b>: Returns the number of elements that can be inserted
+   //!   with push_front() before a relocation or reallocation is needed.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   size_type front_free_capacity() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->m_holder.m_front; }
+
+   //! <b>Effects</b>: Returns the number of elements that can be inserted
+   //!   with push_back() before a relocation or reallocation is needed.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   size_type back_free_capacity() const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->m_holder.m_capacity - this->m_holder.m_back; }
+
+   //! <b>Effects</b>: Inserts or erases elements at the end such that
+   //!   the size becomes n. New elements are value initialized.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's copy/move or value initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to the difference between size() and new_size.
+   void resize(size_type new_size)
+   {  this->resize_back(new_size);  }
+
+   //! <b>Effects</b>: Inserts or erases elements at the end such that
+   //!   the size becomes n. New elements are default initialized.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's copy/move or default initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to the difference between size() and new_size.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   void resize(size_type new_size, default_init_t)
+   {  this->resize_back(new_size, default_init);  }
+
+   //! <b>Effects</b>: Inserts or erases elements at the end such that
+   //!   the size becomes n. New elements are copy constructed from x.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the difference between size() and new_size.
+   void resize(size_type new_size, const T& x)
+   {  this->resize_back(new_size, x);  }
+
+   //! <b>Effects</b>: Inserts or erases elements at the end such that
+   //!   the size becomes n. New elements are value initialized.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's copy/move or value initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to the difference between size() and new_size.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   void resize_back(size_type new_size)
+   {  this->priv_resize_back(new_size, value_init);  }
+
+   //! <b>Effects</b>: Inserts or erases elements at the end such that
+   //!   the size becomes n. New elements are default initialized.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's copy/move or default initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to the difference between size() and new_size.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   void resize_back(size_type new_size, default_init_t)
+   {  this->priv_resize_back(new_size, default_init);  }
+
+   //! <b>Effects</b>: Inserts or erases elements at the end such that
+   //!   the size becomes n. New elements are copy constructed from x.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the difference between size() and new_size.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   void resize_back(size_type new_size, const T& x)
+   {  this->priv_resize_back(new_size, x);  }
+
+   //! <b>Effects</b>: Inserts or erases elements at the beginning such that
+   //!   the size becomes n. New elements are value initialized.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's copy/move or value initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to the difference between size() and new_size.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   void resize_front(size_type new_size)
+   {  this->priv_resize_front(new_size, value_init);  }
+
+   //! <b>Effects</b>: Inserts or erases elements at the beginning such that
+   //!   the size becomes n. New elements are default initialized.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's copy/move or default initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to the difference between size() and new_size.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   void resize_front(size_type new_size, default_init_t)
+   {  this->priv_resize_front(new_size, default_init);  }
+
+   //! <b>Effects</b>: Inserts or erases elements at the beginning such that
+   //!   the size becomes n. New elements are copy constructed from x.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the difference between size() and new_size.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   void resize_front(size_type new_size, const T& x)
+   {  this->priv_resize_front(new_size, x);  }
+
+   //! <b>Effects</b>: If n is less than or equal to size() + back_free_capacity(), this
+   //!   call has no effect. Otherwise, it is a request for allocation of additional memory
+   //!   so that at least new_cap - size() elements can be pushed at the back without
+   //!   reallocating. In either case, size() is unchanged.
+   //!
+   //! <b>Throws</b>: If memory allocation allocation throws or T's copy/move constructor throws.
+   void reserve(size_type new_cap)
+   {  this->reserve_back(new_cap);  }
+
+   //! <b>Effects</b>: Ensures that at least new_cap - size() elements can be inserted
+   //!   at the back without reallocating. size() is unchanged.
+   //!
+   //! <b>Throws</b>: If memory allocation allocation throws or T's copy/move constructor throws.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   void reserve_back(size_type new_cap)
+   {
+      const size_type cur = this->size() + this->back_free_capacity();
+      if (cur < new_cap){
+         this->priv_reallocate(this->m_holder.m_front + new_cap, this->m_holder.m_front);
+      }
+   }
+
+   //! <b>Effects</b>: Ensures that at least new_cap - size() elements can be inserted
+   //!   at the front without reallocating. size() is unchanged.
+   //!
+   //! <b>Throws</b>: If memory allocation allocation throws or T's copy/move constructor throws.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   void reserve_front(size_type new_cap)
+   {
+      const size_type cur = this->size() + this->front_free_capacity();
+      if (cur < new_cap){
+         this->priv_reallocate(new_cap + this->back_free_capacity(), new_cap - this->size());
+      }
+   }
+
+   //! <b>Effects</b>: Tries to deallocate the excess of memory created
+   //!   with previous allocations. The size of the devector is unchanged
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to size().
+   void shrink_to_fit()
+   {
+      const size_type sz = this->size();
+      if(!sz){
+         this->m_holder.deallocate_buffer();
+      }
+      else if(sz < this->m_holder.m_capacity){
+         this->priv_reallocate(sz, 0u);
+      }
+   }
+
+   //////////////////////////////////////////////
+   //
+   //               element access
+   //
+   //////////////////////////////////////////////
+
+   //! <b>Requires</b>: !empty()
+   //!
+   //! <b>Effects</b>: Returns a reference to the first
+   //!   element of the container.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   reference         front() BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(!this->empty());
+      return this->m_holder.m_start[this->m_holder.m_front];
+   }
+
+   //! <b>Requires</b>: !empty()
+   //!
+   //! <b>Effects</b>: Returns a const reference to the first
+   //!   element of the container.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_reference   front() const BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(!this->empty());
+      return this->m_holder.m_start[this->m_holder.m_front];
+   }
+
+   //! <b>Requires</b>: !empty()
+   //!
+   //! <b>Effects</b>: Returns a reference to the last
+   //!   element of the container.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   reference         back() BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(!this->empty());
+      return this->m_holder.m_start[this->m_holder.m_back - 1];
+   }
+
+   //! <b>Requires</b>: !empty()
+   //!
+   //! <b>Effects</b>: Returns a const reference to the last
+   //!   element of the container.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_reference   back()  const BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(!this->empty());
+      return this->m_holder.m_start[this->m_holder.m_back - 1];
+   }
+
+   //! <b>Requires</b>: size() > n.
+   //!
+   //! <b>Effects</b>: Returns a reference to the nth element
+   //!   from the beginning of the container.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   reference operator[](size_type n) BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(this->size() > n);
+      return this->m_holder.m_start[this->m_holder.m_front + n];
+   }
+
+   //! <b>Requires</b>: size() > n.
+   //!
+   //! <b>Effects</b>: Returns a const reference to the nth element
+   //!   from the beginning of the container.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_reference operator[](size_type n) const BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(this->size() > n);
+      return this->m_holder.m_start[this->m_holder.m_front + n];
+   }
+
+   //! <b>Requires</b>: size() >= n.
+   //!
+   //! <b>Effects</b>: Returns an iterator to the nth element
+   //!   from the beginning of the container. Returns end()
+   //!   if n == size().
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   iterator nth(size_type n) BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(this->size() >= n);
+      return iterator(this->m_holder.m_start + this->m_holder.m_front + n);
+   }
+
+   //! <b>Requires</b>: size() >= n.
+   //!
+   //! <b>Effects</b>: Returns a const_iterator to the nth element
+   //!   from the beginning of the container. Returns end()
+   //!   if n == size().
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   const_iterator nth(size_type n) const BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(this->size() >= n);
+      return const_iterator(this->m_holder.m_start + this->m_holder.m_front + n);
+   }
+
+   //! <b>Requires</b>: begin() <= p <= end().
+   //!
+   //! <b>Effects</b>: Returns the index of the element pointed by p
+   //!   and size() if p == end().
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   size_type index_of(iterator p) BOOST_NOEXCEPT_OR_NOTHROW
+   {  return this->priv_index_of(p);  }
+
+   //! <b>Requires</b>: begin() <= p <= end().
+   //!
+   //! <b>Effects</b>: Returns the index of the element pointed by p
+   //!   and size() if p == end().
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   //!
+   //! <b>Note</b>: Non-standard extension
+   size_type index_of(const_iterator p) const BOOST_NOEXCEPT_OR_NOTHROW
+   {  return this->priv_index_of(p);  }
+
+   //! <b>Requires</b>: size() > n.
+   //!
+   //! <b>Effects</b>: Returns a reference to the nth element
+   //!   from the beginning of the container.
+   //!
+   //! <b>Throws</b>: std::range_error if n >= size()
+   //!
+   //! <b>Complexity</b>: Constant.
+   reference at(size_type n)
+   {  this->priv_check_range(n); return (*this)[n];  }
+
+   //! <b>Requires</b>: size() > n.
+   //!
+   //! <b>Effects</b>: Returns a const reference to the nth element
+   //!   from the beginning of the container.
+   //!
+   //! <b>Throws</b>: std::range_error if n >= size()
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_reference at(size_type n) const
+   {  this->priv_check_range(n); return (*this)[n];  }
+
+   //////////////////////////////////////////////
+   //
+   //                 data access
+   //
+   //////////////////////////////////////////////
+
+   //! <b>Returns</b>: A pointer such that [data(),data() + size()) is a valid range.
+   //!   For a non-empty devector, data() == &front().
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   T* data() BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->priv_raw_begin(); }
+
+   //! <b>Returns</b>: A pointer such that [data(),data() + size()) is a valid range.
+   //!   For a non-empty devector, data() == &front().
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const T * data()  const BOOST_NOEXCEPT_OR_NOTHROW
+   { return this->priv_raw_begin(); }
+
+   //////////////////////////////////////////////
+   //
+   //                modifiers
+   //
+   //////////////////////////////////////////////
+
+   #if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) || defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Inserts an object of type T constructed with
+   //!   std::forward<Args>(args)... in the beginning of the devector.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or the in-place constructor throws or
+   //!   T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Amortized constant time.
+   template <class... Args>
+   void emplace_front(BOOST_FWD_REF(Args)... args)
+   {
+      if (BOOST_LIKELY(this->m_holder.m_front != 0)){
+         allocator_traits_type::construct(this->m_holder.alloc(), this->priv_raw_begin() - 1, ::boost::forward<Args>(args)...);
+         --this->m_holder.m_front;
+      }
+      else{
+         typedef container_detail::insert_emplace_proxy<Allocator, T*, Args...> type;
+         this->priv_insert_no_room(0u, 1u, type(::boost::forward<Args>(args)...));
+      }
+   }
+
+   //! <b>Effects</b>: Inserts an object of type T constructed with
+   //!   std::forward<Args>(args)... in the end of the devector.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or the in-place constructor throws or
+   //!   T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Amortized constant time.
+   template <class... Args>
+   void emplace_back(BOOST_FWD_REF(Args)... args)
+   {
+      if (BOOST_LIKELY(this->m_holder.m_back != this->m_holder.m_capacity)){
+         allocator_traits_type::construct(this->m_holder.alloc(), this->priv_raw_end(), ::boost::forward<Args>(args)...);
+         ++this->m_holder.m_back;
+      }
+      else{
+         typedef container_detail::insert_emplace_proxy<Allocator, T*, Args...> type;
+         this->priv_insert_no_room(this->size(), 1u, type(::boost::forward<Args>(args)...));
+      }
+   }
+
+   //! <b>Requires</b>: position must be a valid iterator of *this.
+   //!
+   //! <b>Effects</b>: Inserts an object of type T constructed with
+   //!   std::forward<Args>(args)... before position
+   //!
+   //! <b>Throws</b>: If memory allocation throws or the in-place constructor throws or
+   //!   T's copy/move constructor/assignment throws.
+   //!
+   //! <b>Complexity</b>: If position is begin() or end(), amortized constant time.
+   //!   Linear time otherwise.
+   template<class ...Args>
+   iterator emplace(const_iterator position, BOOST_FWD_REF(Args) ...args)
+   {
+      typedef container_detail::insert_emplace_proxy<Allocator, T*, Args...> type;
+      return this->priv_insert(position, 1u, type(::boost::forward<Args>(args)...));
+   }
+
+   #else // !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+   #define BOOST_CONTAINER_DEVECTOR_EMPLACE_CODE(N) \
+   BOOST_MOVE_TMPL_LT##N BOOST_MOVE_CLASS##N BOOST_MOVE_GT##N \
+   void emplace_front(BOOST_MOVE_UREF##N)\
+   {\
+      if (BOOST_LIKELY(this->m_holder.m_front != 0)){\
+         allocator_traits_type::construct\
+            (this->m_holder.alloc(), this->priv_raw_begin() - 1 BOOST_MOVE_I##N BOOST_MOVE_FWD##N);\
+         --this->m_holder.m_front;\
+      }\
+      else{\
+         typedef container_detail::insert_emplace_proxy_arg##N<Allocator, T* BOOST_MOVE_I##N BOOST_MOVE_TARG##N> type;\
+         this->priv_insert_no_room(0u, 1u, type(BOOST_MOVE_FWD##N));\
+      }\
+   }\
+   \
+   BOOST_MOVE_TMPL_LT##N BOOST_MOVE_CLASS##N BOOST_MOVE_GT##N \
+   void emplace_back(BOOST_MOVE_UREF##N)\
+   {\
+      if (BOOST_LIKELY(this->m_holder.m_back != this->m_holder.m_capacity)){\
+         allocator_traits_type::construct\
+            (this->m_holder.alloc(), this->priv_raw_end() BOOST_MOVE_I##N BOOST_MOVE_FWD##N);\
+         ++this->m_holder.m_back;\
+      }\
+      else{\
+         typedef container_detail::insert_emplace_proxy_arg##N<Allocator, T* BOOST_MOVE_I##N BOOST_MOVE_TARG##N> type;\
+         this->priv_insert_no_room(this->size(), 1u, type(BOOST_MOVE_FWD##N));\
+      }\
+   }\
+   \
+   BOOST_MOVE_TMPL_LT##N BOOST_MOVE_CLASS##N BOOST_MOVE_GT##N \
+   iterator emplace(const_iterator pos BOOST_MOVE_I##N BOOST_MOVE_UREF##N)\
+   {\
+      typedef container_detail::insert_emplace_proxy_arg##N<Allocator, T* BOOST_MOVE_I##N BOOST_MOVE_TARG##N> type;\
+      return this->priv_insert(pos, 1u, type(BOOST_MOVE_FWD##N));\
+   }\
+   //
+   BOOST_MOVE_ITERATE_0TO9(BOOST_CONTAINER_DEVECTOR_EMPLACE_CODE)
+   #undef BOOST_CONTAINER_DEVECTOR_EMPLACE_CODE
+
+   #endif   // !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+   #if defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Inserts a copy of x at the beginning of the devector.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or
+   //!   T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Amortized constant time.
+   void push_front(const T &x);
+
+   //! <b>Effects</b>: Constructs a new element in the beginning of the devector
+   //!   and moves the resources of x to this new element.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or
+   //!   T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Amortized constant time.
+   void push_front(T &&x);
+   #else
+   BOOST_MOVE_CONVERSION_AWARE_CATCH(push_front, T, void, priv_push_front)
+   #endif
+
+   #if defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Inserts a copy of x at the end of the devector.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or
+   //!   T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Amortized constant time.
+   void push_back(const T &x);
+
+   //! <b>Effects</b>: Constructs a new element in the end of the devector
+   //!   and moves the resources of x to this new element.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or
+   //!   T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Amortized constant time.
+   void push_back(T &&x);
+   #else
+   BOOST_MOVE_CONVERSION_AWARE_CATCH(push_back, T, void, priv_push_back)
+   #endif
+
+   #if defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+   //! <b>Requires</b>: front_free_capacity() > 0.
+   //!
+   //! <b>Effects</b>: Inserts a copy of x at the beginning of the devector
+   //!   without checking for free capacity.
+   //!
+   //! <b>Throws</b>: If T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant time.
+   //!
+   //! <b>Note</b>: Non-standard extension.
+   void unsafe_push_front(const T &x);
+
+   //! <b>Requires</b>: front_free_capacity() > 0.
+   //!
+   //! <b>Effects</b>: Constructs a new element at the beginning of the devector
+   //!   moving the resources of x without checking for free capacity.
+   //!
+   //! <b>Throws</b>: If T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant time.
+   //!
+   //! <b>Note</b>: Non-standard extension.
+   void unsafe_push_front(T &&x);
+   #else
+   BOOST_MOVE_CONVERSION_AWARE_CATCH(unsafe_push_front, T, void, priv_unsafe_push_front)
+   #endif
+
+   #if defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+   //! <b>Requires</b>: back_free_capacity() > 0.
+   //!
+   //! <b>Effects</b>: Inserts a copy of x at the end of the devector
+   //!   without checking for free capacity.
+   //!
+   //! <b>Throws</b>: If T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant time.
+   //!
+   //! <b>Note</b>: Non-standard extension.
+   void unsafe_push_back(const T &x);
+
+   //! <b>Requires</b>: back_free_capacity() > 0.
+   //!
+   //! <b>Effects</b>: Constructs a new element at the end of the devector
+   //!   moving the resources of x without checking for free capacity.
+   //!
+   //! <b>Throws</b>: If T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant time.
+   //!
+   //! <b>Note</b>: Non-standard extension.
+   void unsafe_push_back(T &&x);
+   #else
+   BOOST_MOVE_CONVERSION_AWARE_CATCH(unsafe_push_back, T, void, priv_unsafe_push_back)
+   #endif
+
+   #if defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+   //! <b>Requires</b>: position must be a valid iterator of *this.
+   //!
+   //! <b>Effects</b>: Insert a copy of x before position.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's copy/move constructor/assignment throws.
+   //!
+   //! <b>Complexity</b>: If position is begin() or end(), amortized constant time.
+   //!   Linear time otherwise.
+   iterator insert(const_iterator position, const T &x);
+
+   //! <b>Requires</b>: position must be a valid iterator of *this.
+   //!
+   //! <b>Effects</b>: Insert a new element before position with x's resources.
+   //!
+   //! <b>Throws</b>: If memory allocation throws.
+   //!
+   //! <b>Complexity</b>: If position is begin() or end(), amortized constant time.
+   //!   Linear time otherwise.
+   iterator insert(const_iterator position, T &&x);
+   #else
+   BOOST_MOVE_CONVERSION_AWARE_CATCH_1ARG(insert, T, iterator, priv_insert_value, const_iterator, const_iterator)
+   #endif
+
+   //! <b>Requires</b>: p must be a valid iterator of *this.
+   //!
+   //! <b>Effects</b>: Insert n copies of x before pos.
+   //!
+   //! <b>Returns</b>: an iterator to the first inserted element or p if n is 0.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's copy/move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to n plus the minimum of the elements before and after p.
+   iterator insert(const_iterator p, size_type n, const T& x)
+   {
+      container_detail::insert_n_copies_proxy<Allocator, T*> proxy(x);
+      return this->priv_insert(p, n, proxy);
+   }
+
+   //! <b>Requires</b>: p must be a valid iterator of *this.
+   //!
+   //! <b>Effects</b>: Insert a copy of the [first, last) range before pos.
+   //!
+   //! <b>Returns</b>: an iterator to the first inserted element or pos if first == last.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, T's constructor from a
+   //!   dereferenced InpIt throws or T's copy/move constructor/assignment throws.
+   //!
+   //! <b>Complexity</b>: Linear to boost::container::iterator_distance [first, last)
+   //!   plus the minimum of the elements before and after p.
+   template <class InIt>
+   iterator insert(const_iterator pos, InIt first, InIt last
+      BOOST_CONTAINER_DOCIGN(BOOST_MOVE_I typename container_detail::enable_if_c
+         < !container_detail::is_convertible<InIt BOOST_MOVE_I size_type>::value
+            && container_detail::is_input_iterator<InIt>::value
+         >::type * = 0)
+      )
+   {
+      const size_type n_pos = this->priv_index_of(pos);
+      iterator it(this->nth(n_pos));
+      for(;first != last; ++first){
+         it = this->emplace(it, *first);
+         ++it;
+      }
+      return this->nth(n_pos);
+   }
+
+   #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+   template <class FwdIt>
+   iterator insert(const_iterator pos, FwdIt first, FwdIt last
+      , typename container_detail::enable_if_c
+         < !container_detail::is_convertible<FwdIt, size_type>::value
+            && !container_detail::is_input_iterator<FwdIt>::value
+         >::type * = 0
+      )
+   {
+      container_detail::insert_range_proxy<Allocator, FwdIt, T*> proxy(first);
+      return this->priv_insert(pos, static_cast<size_type>(boost::container::iterator_distance(first, last)), proxy);
+   }
+   #endif
+
+   #if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
+   //! <b>Requires</b>: position must be a valid iterator of *this.
+   //!
+   //! <b>Effects</b>: Insert a copy of the [il.begin(), il.end()) range before position.
+   //!
+   //! <b>Returns</b>: an iterator to the first inserted element or position if first == last.
+   //!
+   //! <b>Complexity</b>: Linear to the range [il.begin(), il.end()).
+   iterator insert(const_iterator position, std::initializer_list<value_type> il)
+   {
+      return this->insert(position, il.begin(), il.end());
+   }
+   #endif
+
+   //! <b>Requires</b>: !empty()
+   //!
+   //! <b>Effects</b>: Removes the first element from the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant time.
+   void pop_front() BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(!this->empty());
+      allocator_traits_type::destroy(this->m_holder.alloc(), this->priv_raw_begin());
+      ++this->m_holder.m_front;
+   }
+
+   //! <b>Requires</b>: !empty()
+   //!
+   //! <b>Effects</b>: Removes the last element from the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant time.
+   void pop_back() BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(!this->empty());
+      --this->m_holder.m_back;
+      allocator_traits_type::destroy(this->m_holder.alloc(), this->priv_raw_end());
+   }
+
+   //! <b>Effects</b>: Erases the element at position pos.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Linear to the minimum of the elements between pos and
+   //!   the first element and between pos and the last element.
+   iterator erase(const_iterator position)
+   {
+      const_iterator last(position);
+      ++last;
+      return this->erase(position, last);
+   }
+
+   //! <b>Effects</b>: Erases the elements pointed by [first, last).
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Linear to the distance between first and last
+   //!   plus linear to the minimum of the elements before first and after last.
+   iterator erase(const_iterator first, const_iterator last)
+   {
+      const size_type n_pos  = this->priv_index_of(first);
+      const size_type n      = static_cast<size_type>(last - first);
+      if (n){
+         T* const begin_ptr = this->priv_raw_begin();
+         T* const end_ptr   = this->priv_raw_end();
+         T* const first_ptr = begin_ptr + n_pos;
+         T* const last_ptr  = first_ptr + n;
+         if(n_pos < static_cast<size_type>(end_ptr - last_ptr)){
+            //Less elements before the erased range, shift them to the back
+            boost::container::move_backward(begin_ptr, first_ptr, last_ptr);
+            boost::container::destroy_alloc_n(this->m_holder.alloc(), begin_ptr, n);
+            this->m_holder.m_front += n;
+         }
+         else{
+            //Less elements after the erased range, shift them to the front
+            boost::container::move(last_ptr, end_ptr, first_ptr);
+            this->priv_destroy_last_n(n);
+         }
+      }
+      return this->nth(n_pos);
+   }
+
+   //! <b>Effects</b>: Swaps the contents of *this and x.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   void swap(devector& x)
+      BOOST_NOEXCEPT_IF( allocator_traits_type::propagate_on_container_swap::value
+                                || allocator_traits_type::is_always_equal::value)
+   {
+      const bool propagate_alloc = allocator_traits_type::propagate_on_container_swap::value;
+      BOOST_ASSERT(propagate_alloc || allocator_traits_type::equal(this->m_holder.alloc(), x.m_holder.alloc()));
+      this->m_holder.swap_resources(x.m_holder);
+      container_detail::swap_alloc(this->m_holder.alloc(), x.m_holder.alloc(), container_detail::bool_<propagate_alloc>());
+   }
+
+   //! <b>Effects</b>: Erases all the elements of the devector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in the container.
+   void clear() BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      boost::container::destroy_alloc_n(this->m_holder.alloc(), this->priv_raw_begin(), this->size());
+      this->m_holder.m_front = this->m_holder.m_back = 0;
+   }
+
+   //! <b>Effects</b>: Returns true if x and y are equal
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in the container.
+   friend bool operator==(const devector& x, const devector& y)
+   {  return x.size() == y.size() && ::boost::container::algo_equal(x.begin(), x.end(), y.begin());  }
+
+   //! <b>Effects</b>: Returns true if x and y are unequal
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in the container.
+   friend bool operator!=(const devector& x, const devector& y)
+   {  return !(x == y); }
+
+   //! <b>Effects</b>: Returns true if x is less than y
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in the container.
+   friend bool operator<(const devector& x, const devector& y)
+   {  return ::boost::container::algo_lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());  }
+
+   //! <b>Effects</b>: Returns true if x is greater than y
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in the container.
+   friend bool operator>(const devector& x, const devector& y)
+   {  return y < x;  }
+
+   //! <b>Effects</b>: Returns true if x is equal or less than y
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in the container.
+   friend bool operator<=(const devector& x, const devector& y)
+   {  return !(y < x);  }
+
+   //! <b>Effects</b>: Returns true if x is equal or greater than y
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in the container.
+   friend bool operator>=(const devector& x, const devector& y)
+   {  return !(x < y);  }
+
+   //! <b>Effects</b>: x.swap(y)
+   //!
+   //! <b>Complexity</b>: Constant.
+   friend void swap(devector& x, devector& y)
+   {  x.swap(y);  }
+
+   #ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+   private:
+
+   T* priv_raw_begin() const BOOST_NOEXCEPT_OR_NOTHROW
+   {  return this->m_holder.raw_start() + this->m_holder.m_front;  }
+
+   T* priv_raw_end() const BOOST_NOEXCEPT_OR_NOTHROW
+   {  return this->m_holder.raw_start() + this->m_holder.m_back;  }
+
+   size_type priv_index_of(const_iterator p) const BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(this->cbegin() <= p);
+      BOOST_ASSERT(p <= this->cend());
+      return static_cast<size_type>(p - this->cbegin());
+   }
+
+   bool priv_is_own_element(const T &x) const BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      const T *const px = container_detail::addressof(x);
+      return this->priv_raw_begin() <= px && px < this->priv_raw_end();
+   }
+
+   void priv_check_range(size_type n) const
+   {
+      //If n is out of range, throw an out_of_range exception
+      if (n >= this->size()){
+         throw_out_of_range("devector::at out of range");
+      }
+   }
+
+   void priv_destroy_last_n(const size_type n) BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(n <= this->size());
+      this->m_holder.m_back -= n;
+      boost::container::destroy_alloc_n(this->m_holder.alloc(), this->priv_raw_end(), n);
+   }
+
+   void priv_destroy_first_n(const size_type n) BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      BOOST_ASSERT(n <= this->size());
+      boost::container::destroy_alloc_n(this->m_holder.alloc(), this->priv_raw_begin(), n);
+      this->m_holder.m_front += n;
+   }
+
+   template <class U>
+   void priv_push_front(BOOST_FWD_REF(U) u)
+   {
+      if (BOOST_LIKELY(this->m_holder.m_front != 0)){
+         allocator_traits_type::construct(this->m_holder.alloc(), this->priv_raw_begin() - 1, ::boost::forward<U>(u));
+         --this->m_holder.m_front;
+      }
+      else if(this->priv_is_own_element(u)){
+         //u would be moved if elements were recentered, allocate a new buffer
+         this->priv_insert_new_allocation
+            (0u, 1u, container_detail::get_insert_value_proxy<T*, Allocator>(::boost::forward<U>(u)));
+      }
+      else{
+         this->priv_insert_no_room
+            (0u, 1u, container_detail::get_insert_value_proxy<T*, Allocator>(::boost::forward<U>(u)));
+      }
+   }
+
+   template <class U>
+   void priv_push_back(BOOST_FWD_REF(U) u)
+   {
+      if (BOOST_LIKELY(this->m_holder.m_back != this->m_holder.m_capacity)){
+         allocator_traits_type::construct(this->m_holder.alloc(), this->priv_raw_end(), ::boost::forward<U>(u));
+         ++this->m_holder.m_back;
+      }
+      else if(this->priv_is_own_element(u)){
+         //u would be moved if elements were recentered, allocate a new buffer
+         this->priv_insert_new_allocation
+            (this->size(), 1u, container_detail::get_insert_value_proxy<T*, Allocator>(::boost::forward<U>(u)));
+      }
+      else{
+         this->priv_insert_no_room
+            (this->size(), 1u, container_detail::get_insert_value_proxy<T*, Allocator>(::boost::forward<U>(u)));
+      }
+   }
+
+   template <class U>
+   void priv_unsafe_push_front(BOOST_FWD_REF(U) u)
+   {
+      BOOST_ASSERT(this->m_holder.m_front != 0);
+      allocator_traits_type::construct(this->m_holder.alloc(), this->priv_raw_begin() - 1, ::boost::forward<U>(u));
+      --this->m_holder.m_front;
+   }
+
+   template <class U>
+   void priv_unsafe_push_back(BOOST_FWD_REF(U) u)
+   {
+      BOOST_ASSERT(this->m_holder.m_back != this->m_holder.m_capacity);
+      allocator_traits_type::construct(this->m_holder.alloc(), this->priv_raw_end(), ::boost::forward<U>(u));
+      ++this->m_holder.m_back;
+   }
+
+   template<class U>
+   iterator priv_insert_value(const const_iterator &p, BOOST_FWD_REF(U) x)
+   {
+      return this->priv_insert
+         (p, 1u, container_detail::get_insert_value_proxy<T*, Allocator>(::boost::forward<U>(x)));
+   }
+
+   container_detail::insert_n_copies_proxy<Allocator, T*> priv_resize_proxy(const T &x)
+   {  return container_detail::insert_n_copies_proxy<Allocator, T*>(x);   }
+
+   container_detail::insert_default_initialized_n_proxy<Allocator, T*> priv_resize_proxy(default_init_t)
+   {  return container_detail::insert_default_initialized_n_proxy<Allocator, T*>();  }
+
+   container_detail::insert_value_initialized_n_proxy<Allocator, T*> priv_resize_proxy(value_init_t)
+   {  return container_detail::insert_value_initialized_n_proxy<Allocator, T*>(); }
+
+   template <class U>
+   void priv_resize_back(size_type new_size, const U& u)
+   {
+      const size_type sz = this->size();
+      if (new_size < sz){
+         this->priv_destroy_last_n(sz - new_size);
+      }
+      else if(new_size > sz){
+         //Value and default initialization proxies only support uninitialized
+         //construction, so make room at the back before constructing.
+         const size_type n = new_size - sz;
+         this->reserve_back(new_size);
+         this->priv_resize_proxy(u).uninitialized_copy_n_and_update(this->m_holder.alloc(), this->priv_raw_end(), n);
+         this->m_holder.m_back += n;
+      }
+   }
+
+   template <class U>
+   void priv_resize_front(size_type new_size, const U& u)
+   {
+      const size_type sz = this->size();
+      if (new_size < sz){
+         this->priv_destroy_first_n(sz - new_size);
+      }
+      else if(new_size > sz){
+         const size_type n = new_size - sz;
+         this->reserve_front(new_size);
+         this->priv_resize_proxy(u).uninitialized_copy_n_and_update(this->m_holder.alloc(), this->priv_raw_begin() - n, n);
+         this->m_holder.m_front -= n;
+      }
+   }
+
+   //Returns the capacity of a new buffer that can hold size() + additional_objects elements
+   size_type priv_next_capacity(size_type additional_objects) const
+   {
+      const size_type free_cap = this->m_holder.m_capacity - this->size();
+      return growth_factor_type()
+         ( this->m_holder.m_capacity
+         , additional_objects > free_cap ? size_type(additional_objects - free_cap) : size_type(0u)
+         , allocator_traits_type::max_size(this->m_holder.alloc()));
+   }
+
+   //Moves all elements to a new buffer of new_cap elements, placing the first element at new_front
+   void priv_reallocate(size_type new_cap, size_type new_front)
+   {
+      const size_type sz = this->size();
+      BOOST_ASSERT(new_front + sz <= new_cap);
+      pointer const new_buf = allocator_traits_type::allocate(this->m_holder.alloc(), new_cap);
+      typename value_traits::ArrayDeallocator new_buffer_deallocator(new_buf, this->m_holder.alloc(), new_cap);
+      ::boost::container::uninitialized_move_alloc_n
+         (this->m_holder.alloc(), this->priv_raw_begin(), sz, container_detail::to_raw_pointer(new_buf) + new_front);
+      new_buffer_deallocator.release();
+      this->priv_replace_buffer(new_buf, new_cap, new_front, new_front + sz);
+   }
+
+   //Destroys old elements, deallocates the old buffer and installs the new one
+   void priv_replace_buffer(pointer new_buf, size_type new_cap, size_type new_front, size_type new_back) BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      if(!value_traits::trivial_dctr_after_move){
+         boost::container::destroy_alloc_n(this->m_holder.alloc(), this->priv_raw_begin(), this->size());
+      }
+      this->m_holder.deallocate_buffer();
+      this->m_holder.m_start     = new_buf;
+      this->m_holder.m_capacity  = new_cap;
+      this->m_holder.m_front     = new_front;
+      this->m_holder.m_back      = new_back;
+   }
+
+   //Moves the elements inside the current buffer so that the first one is placed at new_front.
+   //Elements moved to already constructed positions are move assigned, the rest are move constructed
+   //and the moved-from elements that remain outside the new range are destroyed.
+   //Precondition: T's move constructor and move assignment don't throw, as
+   //an exception would leave the elements half-shifted.
+   void priv_relocate(size_type new_front)
+   {
+      BOOST_ASSERT(::boost::has_nothrow_move<T>::value);
+      const size_type old_front = this->m_holder.m_front;
+      const size_type sz = this->size();
+      T* const old_begin = this->priv_raw_begin();
+      T* const old_end   = this->priv_raw_end();
+      if(new_front < old_front){
+         const size_type d = old_front - new_front;
+         const size_type k = d < sz ? d : sz;
+         T* const new_begin = old_begin - d;
+         ::boost::container::uninitialized_move_alloc_n(this->m_holder.alloc(), old_begin, k, new_begin);
+         boost::container::move(old_begin + k, old_end, new_begin + k);
+         boost::container::destroy_alloc_n(this->m_holder.alloc(), old_end - k, k);
+      }
+      else if(new_front > old_front){
+         const size_type d = new_front - old_front;
+         const size_type k = d < sz ? d : sz;
+         ::boost::container::uninitialized_move_alloc_n(this->m_holder.alloc(), old_end - k, k, old_end - k + d);
+         boost::container::move_backward(old_begin, old_end - k, old_end - k + d);
+         boost::container::destroy_alloc_n(this->m_holder.alloc(), old_begin, k);
+      }
+      this->m_holder.m_front = new_front;
+      this->m_holder.m_back  = new_front + sz;
+   }
+
+   template <class InsertionProxy>
+   iterator priv_insert(const const_iterator &p, const size_type n, InsertionProxy proxy)
+   {
+      const size_type n_pos = this->priv_index_of(p);
+      if(n){
+         this->priv_insert_aux(n_pos, n, proxy);
+      }
+      return this->nth(n_pos);
+   }
+
+   template <class InsertionProxy>
+   void priv_insert_aux(const size_type n_pos, const size_type n, InsertionProxy proxy)
+   {
+      const size_type sz = this->size();
+      const size_type front_free = this->front_free_capacity();
+      const size_type back_free  = this->back_free_capacity();
+      //Shift the shortest side of the insertion point, if there is room there
+      const bool shift_front = n_pos < (sz - n_pos);
+      if(shift_front && front_free >= n){
+         this->priv_insert_shift_front(n_pos, n, proxy);
+      }
+      else if(back_free >= n){
+         this->priv_insert_shift_back(n_pos, n, proxy);
+      }
+      else if(front_free >= n){
+         this->priv_insert_shift_front(n_pos, n, proxy);
+      }
+      else{
+         this->priv_insert_no_room(n_pos, n, proxy);
+      }
+   }
+
+   //Called when there is not enough free capacity at the side that will grow
+   template <class InsertionProxy>
+   void priv_insert_no_room(const size_type n_pos, const size_type n, InsertionProxy proxy)
+   {
+      const size_type sz  = this->size();
+      const size_type cap = this->m_holder.m_capacity;
+      const size_type free_cap = cap - sz;
+      const bool shift_front = n_pos < (sz - n_pos);
+      //If after the insertion the buffer would be at most half full,
+      //the elements are recentered instead of reallocating. This costs O(size())
+      //but at least size()/2 insertions at that side are needed to fill it again,
+      //so insertions at both ends remain amortized constant time.
+      //Recentering can't be undone if a move throws, so types without
+      //nothrow move take the reallocation path, which offers the strong guarantee
+      //and recenters into a buffer of the same capacity.
+      if(::boost::has_nothrow_move<T>::value && this->priv_is_half_empty_after_insert(n)){
+         const size_type extra = (free_cap - n)/2;
+         this->priv_relocate(shift_front ? extra + n : extra);
+         if(shift_front){
+            this->priv_insert_shift_front(n_pos, n, proxy);
+         }
+         else{
+            this->priv_insert_shift_back(n_pos, n, proxy);
+         }
+      }
+      else{
+         this->priv_insert_new_allocation(n_pos, n, proxy);
+      }
+   }
+
+   //Returns true if after inserting n elements the buffer would be at most half full
+   bool priv_is_half_empty_after_insert(const size_type n) const
+   {
+      const size_type sz  = this->size();
+      const size_type cap = this->m_holder.m_capacity;
+      return (cap - sz) >= n && (sz + n) <= (cap - sz - n);
+   }
+
+   template <class InsertionProxy>
+   void priv_insert_new_allocation(const size_type n_pos, const size_type n, InsertionProxy proxy)
+   {
+      const size_type sz = this->size();
+      size_type new_cap;
+      size_type new_front;
+      if(this->priv_is_half_empty_after_insert(n)){
+         //Enough capacity, the free space is stranded at the other end (e.g. queue-like
+         //usage). Recenter into a buffer of the same capacity instead of growing.
+         new_cap = this->m_holder.m_capacity;
+         new_front = (new_cap - sz - n)/2;
+      }
+      else{
+         //Place the free capacity where the container is growing: at the back
+         //for back insertions, at the front for front insertions and split
+         //between both ends for insertions in the middle. Free space left at the
+         //other end of the old buffer is not carried over.
+         new_cap = this->priv_next_capacity(n);
+         const size_type new_free = new_cap - sz - n;
+         new_front = n_pos == sz ? 0u : n_pos == 0 ? new_free : new_free/2;
+      }
+
+      pointer const new_buf = allocator_traits_type::allocate(this->m_holder.alloc(), new_cap);
+      typename value_traits::ArrayDeallocator new_buffer_deallocator(new_buf, this->m_holder.alloc(), new_cap);
+      T* const new_begin = container_detail::to_raw_pointer(new_buf) + new_front;
+      T* const old_begin = this->priv_raw_begin();
+      //Construct new elements first, so that the proxy can still
+      //refer to elements of the old buffer.
+      proxy.uninitialized_copy_n_and_update(this->m_holder.alloc(), new_begin + n_pos, n);
+      typename value_traits::ArrayDestructor new_values_destroyer(new_begin + n_pos, this->m_holder.alloc(), n);
+      ::boost::container::uninitialized_move_alloc_n(this->m_holder.alloc(), old_begin, n_pos, new_begin);
+      new_values_destroyer.increment_size_backwards(n_pos);
+      ::boost::container::uninitialized_move_alloc_n
+         (this->m_holder.alloc(), old_begin + n_pos, sz - n_pos, new_begin + n_pos + n);
+      new_values_destroyer.release();
+      new_buffer_deallocator.release();
+      this->priv_replace_buffer(new_buf, new_cap, new_front, new_front + sz + n);
+   }
+
+   //Precondition: back_free_capacity() >= n
+   template <class InsertionProxy>
+   void priv_insert_shift_back(const size_type n_pos, const size_type n, InsertionProxy proxy)
+   {
+      BOOST_ASSERT(this->back_free_capacity() >= n);
+      T* const pos = this->priv_raw_begin() + n_pos;
+      T* const old_finish = this->priv_raw_end();
+      const size_type elems_after = static_cast<size_type>(old_finish - pos);
+
+      if (!elems_after){
+         proxy.uninitialized_copy_n_and_update(this->m_holder.alloc(), old_finish, n);
+         this->m_holder.m_back += n;
+      }
+      else if (elems_after >= n){
+         //Move to uninitialized memory last objects
+         ::boost::container::uninitialized_move_alloc
+            (this->m_holder.alloc(), old_finish - n, old_finish, old_finish);
+         this->m_holder.m_back += n;
+         //Copy previous to last objects to the initialized end
+         boost::container::move_backward(pos, old_finish - n, old_finish);
+         //Insert new objects in the pos
+         proxy.copy_n_and_update(this->m_holder.alloc(), pos, n);
+      }
+      else {
+         //The new elements don't fit in the [pos, end()) range.
+         //Copy old [pos, end()) elements to the uninitialized memory (a gap is created)
+         ::boost::container::uninitialized_move_alloc(this->m_holder.alloc(), pos, old_finish, pos + n);
+         BOOST_TRY{
+            //Copy first new elements in pos (gap is still there)
+            proxy.copy_n_and_update(this->m_holder.alloc(), pos, elems_after);
+            //Copy to the beginning of the unallocated zone the last new elements (the gap is closed).
+            proxy.uninitialized_copy_n_and_update(this->m_holder.alloc(), old_finish, n - elems_after);
+            this->m_holder.m_back += n;
+         }
+         BOOST_CATCH(...){
+            boost::container::destroy_alloc_n(this->m_holder.alloc(), pos + n, elems_after);
+            BOOST_RETHROW
+         }
+         BOOST_CATCH_END
+      }
+   }
+
+   //Precondition: front_free_capacity() >= n
+   template <class InsertionProxy>
+   void priv_insert_shift_front(const size_type n_pos, const size_type n, InsertionProxy proxy)
+   {
+      BOOST_ASSERT(this->front_free_capacity() >= n);
+      T* const old_start = this->priv_raw_begin();
+      T* const pos = old_start + n_pos;
+      const size_type elems_before = n_pos;
+
+      if (!elems_before){
+         proxy.uninitialized_copy_n_and_update(this->m_holder.alloc(), old_start - n, n);
+         this->m_holder.m_front -= n;
+      }
+      else if (elems_before >= n){
+         //Move to uninitialized memory first objects
+         ::boost::container::uninitialized_move_alloc
+            (this->m_holder.alloc(), old_start, old_start + n, old_start - n);
+         this->m_holder.m_front -= n;
+         //Move the rest of objects before pos to the initialized start
+         boost::container::move(old_start + n, pos, old_start);
+         //Insert new objects just before pos
+         proxy.copy_n_and_update(this->m_holder.alloc(), pos - n, n);
+      }
+      else {
+         //The new elements don't fit in the [begin(), pos) range.
+         //Move old [begin(), pos) elements to the uninitialized memory (a gap is created)
+         T* const new_start = old_start - n;
+         ::boost::container::uninitialized_move_alloc(this->m_holder.alloc(), old_start, pos, new_start);
+         BOOST_TRY{
+            //Fill the uninitialized part of the gap first, then the moved-from part
+            proxy.uninitialized_copy_n_and_update(this->m_holder.alloc(), new_start + elems_before, n - elems_before);
+            BOOST_TRY{
+               proxy.copy_n_and_update(this->m_holder.alloc(), old_start, elems_before);
+            }
+            BOOST_CATCH(...){
+               boost::container::destroy_alloc_n(this->m_holder.alloc(), new_start + elems_before, n - elems_before);
+               BOOST_RETHROW
+            }
+            BOOST_CATCH_END
+            this->m_holder.m_front -= n;
+         }
+         BOOST_CATCH(...){
+            boost::container::destroy_alloc_n(this->m_holder.alloc(), new_start, elems_before);
+            BOOST_RETHROW
+         }
+         BOOST_CATCH_END
+      }
+   }
+   #endif   //#ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+};
+
+}} //namespace boost::container
+
+#ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+
+namespace boost {
+
+//!has_trivial_destructor_after_move<> == true_type
+//!specialization for optimizations
+template <class T, class Allocator, class Options>
+struct has_trivial_destructor_after_move<boost::container::devector<T, Allocator, Options> >
+{
+   typedef typename ::boost::container::allocator_traits<Allocator>::pointer pointer;
+   static const bool value = ::boost::has_trivial_destructor_after_move<Allocator>::value &&
+                             ::boost::has_trivial_destructor_after_move<pointer>::value;
+};
+
+}
+
+#endif   //#ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif //   #ifndef  BOOST_CONTAINER_DEVECTOR_HPP
@@ -27,6 +27,7 @@
 #include <boost/container/throw_exception.hpp>
 // container/detail
 #include <boost/container/detail/flat_tree.hpp>
+#include <boost/container/detail/container_rebind.hpp>
 #include <boost/container/detail/type_traits.hpp>
 #include <boost/container/detail/mpl.hpp>
 #include <boost/container/detail/algorithm.hpp> //equal()
@@ -82,8 +83,9 @@ static D force_copy(S s)
 //!
 //! Compare is the ordering function for Keys (e.g. <i>std::less<Key></i>).
 //!
-//! Allocator is the allocator to allocate the value_types
-//! (e.g. <i>allocator< std::pair<Key, T> ></i>).
+//! AllocatorOrContainer is either the allocator to allocate the value_types
+//! (e.g. <i>allocator< std::pair<Key, T> ></i>) or the vector-like sequence
+//! used to store them (e.g. <i>small_vector< std::pair<Key, T>, 8 ></i>).
 //!
 //! flat_map is similar to std::map but it's implemented like an ordered vector.
 //! This means that inserting a new element into a flat_map invalidates
@@ -97,12 +99,15 @@ static D force_copy(S s)
 //! \tparam Key is the key_type of the map
 //! \tparam Value is the <code>mapped_type</code>
 //! \tparam Compare is the ordering function for Keys (e.g. <i>std::less<Key></i>).
-//! \tparam Allocator is the allocator to allocate the <code>value_type</code>s
-//!   (e.g. <i>allocator< std::pair<Key, T> > </i>).
+//! \tparam AllocatorOrContainer is either:
+//!   - The allocator to allocate <code>value_type</code>s (e.g. <i>allocator< std::pair<Key, T> > </i>).
+//!     (in this case <i>sequence_type</i> will be vector<value_type, AllocatorOrContainer>)
+//!   - The vector-like sequence container to use to store elements
+//!     (vector, small_vector or static_vector of <code>value_type</code>).
 #ifdef BOOST_CONTAINER_DOXYGEN_INVOKED
-template <class Key, class T, class Compare = std::less<Key>, class Allocator = new_allocator< std::pair< Key, T> > >
+template <class Key, class T, class Compare = std::less<Key>, class AllocatorOrContainer = new_allocator< std::pair< Key, T> > >
 #else
-template <class Key, class T, class Compare, class Allocator>
+template <class Key, class T, class Compare, class AllocatorOrContainer>
 #endif
 class flat_map
 {
@@ -114,15 +119,15 @@ class flat_map
                            std::pair<Key, T>,
                            container_detail::select1st< std::pair<Key, T> >,
                            Compare,
-                           Allocator> tree_t;
+                           AllocatorOrContainer> tree_t;
 
    //This is the real tree stored here. It's based on a movable pair
    typedef container_detail::flat_tree<Key,
                            container_detail::pair<Key, T>,
                            container_detail::select1st<container_detail::pair<Key, T> >,
                            Compare,
-                           typename allocator_traits<Allocator>::template portable_rebind_alloc
-                              <container_detail::pair<Key, T> >::type> impl_tree_t;
+                           typename container_detail::container_or_allocator_rebind
+                              <AllocatorOrContainer, container_detail::pair<Key, T> >::type> impl_tree_t;
    impl_tree_t m_flat_tree;  // flat tree representing flat_map
 
    typedef typename impl_tree_t::value_type              impl_value_type;
@@ -134,13 +139,13 @@ class flat_map
       , container_detail::select1st< std::pair<Key, T> >
       , std::pair<Key, T> >                                                         value_compare_impl;
    typedef typename container_detail::get_flat_tree_iterators
-         <typename allocator_traits<Allocator>::pointer>::iterator                  iterator_impl;
+         <typename tree_t::pointer>::iterator                                        iterator_impl;
    typedef typename container_detail::get_flat_tree_iterators
-      <typename allocator_traits<Allocator>::pointer>::const_iterator               const_iterator_impl;
+      <typename tree_t::pointer>::const_iterator                                     const_iterator_impl;
    typedef typename container_detail::get_flat_tree_iterators
-         <typename allocator_traits<Allocator>::pointer>::reverse_iterator          reverse_iterator_impl;
+         <typename tree_t::pointer>::reverse_iterator                                reverse_iterator_impl;
    typedef typename container_detail::get_flat_tree_iterators
-         <typename allocator_traits<Allocator>::pointer>::const_reverse_iterator    const_reverse_iterator_impl;
+         <typename tree_t::pointer>::const_reverse_iterator                          const_reverse_iterator_impl;
    public:
    typedef typename impl_tree_t::stored_allocator_type   impl_stored_allocator_type;
    private:
@@ -156,15 +161,16 @@ class flat_map
    typedef Key                                                                      key_type;
    typedef T                                                                        mapped_type;
    typedef std::pair<Key, T>                                                        value_type;
-   typedef ::boost::container::allocator_traits<Allocator>                          allocator_traits_type;
-   typedef typename boost::container::allocator_traits<Allocator>::pointer          pointer;
-   typedef typename boost::container::allocator_traits<Allocator>::const_pointer    const_pointer;
-   typedef typename boost::container::allocator_traits<Allocator>::reference        reference;
-   typedef typename boost::container::allocator_traits<Allocator>::const_reference  const_reference;
-   typedef typename boost::container::allocator_traits<Allocator>::size_type        size_type;
-   typedef typename boost::container::allocator_traits<Allocator>::difference_type  difference_type;
-   typedef Allocator                                                                allocator_type;
-   typedef BOOST_CONTAINER_IMPDEF(Allocator)                                        stored_allocator_type;
+   typedef typename BOOST_CONTAINER_IMPDEF(tree_t::allocator_type)                  allocator_type;
+   typedef ::boost::container::allocator_traits<allocator_type>                     allocator_traits_type;
+   typedef typename boost::container::allocator_traits<allocator_type>::pointer     pointer;
+   typedef typename boost::container::allocator_traits<allocator_type>::const_pointer const_pointer;
+   typedef typename boost::container::allocator_traits<allocator_type>::reference   reference;
+   typedef typename boost::container::allocator_traits<allocator_type>::const_reference const_reference;
+   typedef typename boost::container::allocator_traits<allocator_type>::size_type   size_type;
+   typedef typename boost::container::allocator_traits<allocator_type>::difference_type difference_type;
+   typedef BOOST_CONTAINER_IMPDEF(allocator_type)                                   stored_allocator_type;
+   typedef typename BOOST_CONTAINER_IMPDEF(tree_t::container_type)                  sequence_type;
    typedef BOOST_CONTAINER_IMPDEF(value_compare_impl)                               value_compare;
    typedef Compare                                                                  key_compare;
    typedef BOOST_CONTAINER_IMPDEF(iterator_impl)                                    iterator;
@@ -187,7 +193,7 @@ class flat_map
       : m_flat_tree()
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_map using the specified
@@ -198,7 +204,7 @@ class flat_map
       : m_flat_tree(comp, container_detail::force<impl_allocator_type>(a))
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_map using the specified allocator.
@@ -208,7 +214,7 @@ class flat_map
       : m_flat_tree(container_detail::force<impl_allocator_type>(a))
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_map using the specified comparison object and
@@ -222,7 +228,7 @@ class flat_map
       : m_flat_tree(true, first, last, comp, container_detail::force<impl_allocator_type>(a))
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_map using the specified
@@ -235,7 +241,7 @@ class flat_map
       : m_flat_tree(true, first, last, Compare(), container_detail::force<impl_allocator_type>(a))
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_map using the specified comparison object and
@@ -254,7 +260,7 @@ class flat_map
       : m_flat_tree(ordered_range, first, last, comp, a)
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
 #if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
@@ -268,7 +274,7 @@ class flat_map
      : m_flat_tree(true, il.begin(), il.end(), comp, container_detail::force<impl_allocator_type>(a))
    {
        //A type must be std::pair<Key, T>
-       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_map using the specified
@@ -280,7 +286,7 @@ class flat_map
      : m_flat_tree(true, il.begin(), il.end(), Compare(), container_detail::force<impl_allocator_type>(a))
    {
        //A type must be std::pair<Key, T>
-       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_map using the specified comparison object and
@@ -298,7 +304,7 @@ class flat_map
      : m_flat_tree(ordered_range, il.begin(), il.end(), comp, a)
    {
        //A type must be std::pair<Key, T>
-       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 #endif
 
@@ -309,7 +315,7 @@ class flat_map
       : m_flat_tree(x.m_flat_tree)
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Move constructs a flat_map.
@@ -322,7 +328,7 @@ class flat_map
       : m_flat_tree(boost::move(x.m_flat_tree))
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Copy constructs a flat_map using the specified allocator.
@@ -332,7 +338,7 @@ class flat_map
       : m_flat_tree(x.m_flat_tree, a)
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Move constructs a flat_map using the specified allocator.
@@ -343,7 +349,7 @@ class flat_map
       : m_flat_tree(boost::move(x.m_flat_tree), a)
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Makes *this a copy of x.
@@ -1082,12 +1088,12 @@ class flat_map
 
 //!has_trivial_destructor_after_move<> == true_type
 //!specialization for optimizations
-template <class Key, class T, class Compare, class Allocator>
-struct has_trivial_destructor_after_move<boost::container::flat_map<Key, T, Compare, Allocator> >
+template <class Key, class T, class Compare, class AllocatorOrContainer>
+struct has_trivial_destructor_after_move<boost::container::flat_map<Key, T, Compare, AllocatorOrContainer> >
 {
-   typedef typename ::boost::container::allocator_traits<Allocator>::pointer pointer;
-   static const bool value = ::boost::has_trivial_destructor_after_move<Allocator>::value &&
-                             ::boost::has_trivial_destructor_after_move<pointer>::value &&
+   typedef typename ::boost::container::container_detail::select_container_type
+      <std::pair<Key, T>, AllocatorOrContainer>::type container_type;
+   static const bool value = ::boost::has_trivial_destructor_after_move<container_type>::value &&
                              ::boost::has_trivial_destructor_after_move<Compare>::value;
 };
 
@@ -1107,8 +1113,9 @@ namespace container {
 //!
 //! Compare is the ordering function for Keys (e.g. <i>std::less<Key></i>).
 //!
-//! Allocator is the allocator to allocate the value_types
-//! (e.g. <i>allocator< std::pair<Key, T> ></i>).
+//! AllocatorOrContainer is either the allocator to allocate the value_types
+//! (e.g. <i>allocator< std::pair<Key, T> ></i>) or the vector-like sequence
+//! used to store them (e.g. <i>small_vector< std::pair<Key, T>, 8 ></i>).
 //!
 //! flat_multimap is similar to std::multimap but it's implemented like an ordered vector.
 //! This means that inserting a new element into a flat_map invalidates
@@ -1122,12 +1129,15 @@ namespace container {
 //! \tparam Key is the key_type of the map
 //! \tparam Value is the <code>mapped_type</code>
 //! \tparam Compare is the ordering function for Keys (e.g. <i>std::less<Key></i>).
-//! \tparam Allocator is the allocator to allocate the <code>value_type</code>s
-//!   (e.g. <i>allocator< std::pair<Key, T> > </i>).
+//! \tparam AllocatorOrContainer is either:
+//!   - The allocator to allocate <code>value_type</code>s (e.g. <i>allocator< std::pair<Key, T> > </i>).
+//!     (in this case <i>sequence_type</i> will be vector<value_type, AllocatorOrContainer>)
+//!   - The vector-like sequence container to use to store elements
+//!     (vector, small_vector or static_vector of <code>value_type</code>).
 #ifdef BOOST_CONTAINER_DOXYGEN_INVOKED
-template <class Key, class T, class Compare = std::less<Key>, class Allocator = new_allocator< std::pair< Key, T> > >
+template <class Key, class T, class Compare = std::less<Key>, class AllocatorOrContainer = new_allocator< std::pair< Key, T> > >
 #else
-template <class Key, class T, class Compare, class Allocator>
+template <class Key, class T, class Compare, class AllocatorOrContainer>
 #endif
 class flat_multimap
 {
@@ -1138,14 +1148,14 @@ class flat_multimap
                            std::pair<Key, T>,
                            container_detail::select1st< std::pair<Key, T> >,
                            Compare,
-                           Allocator> tree_t;
+                           AllocatorOrContainer> tree_t;
    //This is the real tree stored here. It's based on a movable pair
    typedef container_detail::flat_tree<Key,
                            container_detail::pair<Key, T>,
                            container_detail::select1st<container_detail::pair<Key, T> >,
                            Compare,
-                           typename allocator_traits<Allocator>::template portable_rebind_alloc
-                              <container_detail::pair<Key, T> >::type> impl_tree_t;
+                           typename container_detail::container_or_allocator_rebind
+                              <AllocatorOrContainer, container_detail::pair<Key, T> >::type> impl_tree_t;
    impl_tree_t m_flat_tree;  // flat tree representing flat_map
 
    typedef typename impl_tree_t::value_type              impl_value_type;
@@ -1157,13 +1167,13 @@ class flat_multimap
       , container_detail::select1st< std::pair<Key, T> >
       , std::pair<Key, T> >                                                         value_compare_impl;
    typedef typename container_detail::get_flat_tree_iterators
-         <typename allocator_traits<Allocator>::pointer>::iterator                  iterator_impl;
+         <typename tree_t::pointer>::iterator                                        iterator_impl;
    typedef typename container_detail::get_flat_tree_iterators
-      <typename allocator_traits<Allocator>::pointer>::const_iterator               const_iterator_impl;
+      <typename tree_t::pointer>::const_iterator                                     const_iterator_impl;
    typedef typename container_detail::get_flat_tree_iterators
-         <typename allocator_traits<Allocator>::pointer>::reverse_iterator          reverse_iterator_impl;
+         <typename tree_t::pointer>::reverse_iterator                                reverse_iterator_impl;
    typedef typename container_detail::get_flat_tree_iterators
-         <typename allocator_traits<Allocator>::pointer>::const_reverse_iterator    const_reverse_iterator_impl;
+         <typename tree_t::pointer>::const_reverse_iterator                          const_reverse_iterator_impl;
    public:
    typedef typename impl_tree_t::stored_allocator_type   impl_stored_allocator_type;
    private:
@@ -1179,15 +1189,16 @@ class flat_multimap
    typedef Key                                                                      key_type;
    typedef T                                                                        mapped_type;
    typedef std::pair<Key, T>                                                        value_type;
-   typedef ::boost::container::allocator_traits<Allocator>                          allocator_traits_type;
-   typedef typename boost::container::allocator_traits<Allocator>::pointer          pointer;
-   typedef typename boost::container::allocator_traits<Allocator>::const_pointer    const_pointer;
-   typedef typename boost::container::allocator_traits<Allocator>::reference        reference;
-   typedef typename boost::container::allocator_traits<Allocator>::const_reference  const_reference;
-   typedef typename boost::container::allocator_traits<Allocator>::size_type        size_type;
-   typedef typename boost::container::allocator_traits<Allocator>::difference_type  difference_type;
-   typedef Allocator                                                                allocator_type;
-   typedef BOOST_CONTAINER_IMPDEF(Allocator)                                        stored_allocator_type;
+   typedef typename BOOST_CONTAINER_IMPDEF(tree_t::allocator_type)                  allocator_type;
+   typedef ::boost::container::allocator_traits<allocator_type>                     allocator_traits_type;
+   typedef typename boost::container::allocator_traits<allocator_type>::pointer     pointer;
+   typedef typename boost::container::allocator_traits<allocator_type>::const_pointer const_pointer;
+   typedef typename boost::container::allocator_traits<allocator_type>::reference   reference;
+   typedef typename boost::container::allocator_traits<allocator_type>::const_reference const_reference;
+   typedef typename boost::container::allocator_traits<allocator_type>::size_type   size_type;
+   typedef typename boost::container::allocator_traits<allocator_type>::difference_type difference_type;
+   typedef BOOST_CONTAINER_IMPDEF(allocator_type)                                   stored_allocator_type;
+   typedef typename BOOST_CONTAINER_IMPDEF(tree_t::container_type)                  sequence_type;
    typedef BOOST_CONTAINER_IMPDEF(value_compare_impl)                               value_compare;
    typedef Compare                                                                  key_compare;
    typedef BOOST_CONTAINER_IMPDEF(iterator_impl)                                    iterator;
@@ -1209,7 +1220,7 @@ class flat_multimap
       : m_flat_tree()
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_multimap using the specified comparison
@@ -1221,7 +1232,7 @@ class flat_multimap
       : m_flat_tree(comp, container_detail::force<impl_allocator_type>(a))
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_multimap using the specified allocator.
@@ -1231,7 +1242,7 @@ class flat_multimap
       : m_flat_tree(container_detail::force<impl_allocator_type>(a))
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_multimap using the specified comparison object
@@ -1246,7 +1257,7 @@ class flat_multimap
       : m_flat_tree(false, first, last, comp, container_detail::force<impl_allocator_type>(a))
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_multimap using the specified
@@ -1259,7 +1270,7 @@ class flat_multimap
       : m_flat_tree(false, first, last, Compare(), container_detail::force<impl_allocator_type>(a))
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_multimap using the specified comparison object and
@@ -1278,7 +1289,7 @@ class flat_multimap
       : m_flat_tree(ordered_range, first, last, comp, a)
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
 #if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
@@ -1291,7 +1302,7 @@ class flat_multimap
       : m_flat_tree(false, il.begin(), il.end(), comp, container_detail::force<impl_allocator_type>(a))
    {
        //A type must be std::pair<Key, T>
-       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_map using the specified
@@ -1303,7 +1314,7 @@ class flat_multimap
       : m_flat_tree(false, il.begin(), il.end(), Compare(), container_detail::force<impl_allocator_type>(a))
    {
        //A type must be std::pair<Key, T>
-       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Constructs an empty flat_multimap using the specified comparison object and
@@ -1320,7 +1331,7 @@ class flat_multimap
       : m_flat_tree(ordered_range, il.begin(), il.end(), comp, a)
    {
        //A type must be std::pair<Key, T>
-       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+       BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 #endif
 
@@ -1331,7 +1342,7 @@ class flat_multimap
       : m_flat_tree(x.m_flat_tree)
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Move constructs a flat_multimap. Constructs *this using x's resources.
@@ -1343,7 +1354,7 @@ class flat_multimap
       : m_flat_tree(boost::move(x.m_flat_tree))
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Copy constructs a flat_multimap using the specified allocator.
@@ -1353,7 +1364,7 @@ class flat_multimap
       : m_flat_tree(x.m_flat_tree, a)
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Move constructs a flat_multimap using the specified allocator.
@@ -1364,7 +1375,7 @@ class flat_multimap
       : m_flat_tree(boost::move(x.m_flat_tree), a)
    {
       //A type must be std::pair<Key, T>
-      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename Allocator::value_type>::value));
+      BOOST_STATIC_ASSERT((container_detail::is_same<std::pair<Key, T>, typename allocator_type::value_type>::value));
    }
 
    //! <b>Effects</b>: Makes *this a copy of x.
@@ -1993,12 +2004,12 @@ namespace boost {
 
 //!has_trivial_destructor_after_move<> == true_type
 //!specialization for optimizations
-template <class Key, class T, class Compare, class Allocator>
-struct has_trivial_destructor_after_move< boost::container::flat_multimap<Key, T, Compare, Allocator> >
+template <class Key, class T, class Compare, class AllocatorOrContainer>
+struct has_trivial_destructor_after_move< boost::container::flat_multimap<Key, T, Compare, AllocatorOrContainer> >
 {
-   typedef typename ::boost::container::allocator_traits<Allocator>::pointer pointer;
-   static const bool value = ::boost::has_trivial_destructor_after_move<Allocator>::value &&
-                             ::boost::has_trivial_destructor_after_move<pointer>::value &&
+   typedef typename ::boost::container::container_detail::select_container_type
+      <std::pair<Key, T>, AllocatorOrContainer>::type container_type;
+   static const bool value = ::boost::has_trivial_destructor_after_move<container_type>::value &&
                              ::boost::has_trivial_destructor_after_move<Compare>::value;
 };
 
@@ -23,6 +23,7 @@
 
 #include <boost/container/detail/config_begin.hpp>
 #include <boost/container/container_fwd.hpp>
+#include <boost/container/detail/next_capacity.hpp>
 #include <boost/intrusive/pack_options.hpp>
 
 namespace boost {
@@ -72,6 +73,123 @@ struct tree_assoc_options
    typedef implementation_defined type;
 };
 
+//! This growth factor argument specifies that the container should increase its
+//! capacity a 50% when existing capacity is exhausted.
+struct growth_factor_50
+   : container_detail::grow_factor_ratio<0, 3, 2>
+{};
+
+//! This growth factor argument specifies that the container should increase its
+//! capacity a 60% when existing capacity is exhausted.
+struct growth_factor_60
+   : container_detail::grow_factor_ratio<0, 8, 5>
+{};
+
+//! This growth factor argument specifies that the container should double its
+//! capacity when existing capacity is exhausted.
+struct growth_factor_100
+   : container_detail::grow_factor_ratio<0, 2, 1>
+{};
+
+//!This option setter specifies the growth factor strategy of the underlying buffer
+//!of vector-like containers (\c boost::container::vector and \c boost::container::devector).
+//!Predefined growth factors are \c boost::container::growth_factor_50,
+//!\c boost::container::growth_factor_60 and \c boost::container::growth_factor_100.
+//!
+//!A user defined growth factor must be a default constructible function object with
+//!the following signature:
+//!
+//!\code
+//!template<class SizeType>
+//!SizeType operator()(SizeType cur_cap, SizeType add_min_cap, SizeType max_cap) const;
+//!\endcode
+//!
+//!where \c cur_cap is the current capacity, \c add_min_cap is the minimum additional capacity
+//!to be added and \c max_cap is the maximum capacity the allocator can hold. The returned
+//!value must be between cur_cap + add_min_cap and max_cap.
+BOOST_INTRUSIVE_OPTION_TYPE(growth_factor, GrowthFactor, GrowthFactor, growth_factor_type)
+
+//!This option setter specifies the unsigned integer type that a vector-like container
+//!uses internally to store its size and capacity. A type narrower than the allocator's
+//!\c size_type (e.g. \c unsigned int on 64 bit systems) reduces the size of the container
+//!header, but limits \c max_size() to the maximum value representable by that type.
+//!Defaults to the allocator's \c size_type.
+BOOST_INTRUSIVE_OPTION_TYPE(stored_size, StoredSizeType, StoredSizeType, stored_size_type)
+
+#if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+
+template<class GrowthType, class StoredSizeType>
+struct vector_opt
+{
+   typedef GrowthType      growth_factor_type;
+   typedef StoredSizeType  stored_size_type;
+};
+
+typedef vector_opt<void, void> vector_null_opt;
+
+#endif   //!defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+
+//! Helper metafunction to combine options into a single type to be used
+//! by \c boost::container::vector.
+//! Supported options are: \c boost::container::growth_factor and \c boost::container::stored_size
+#if defined(BOOST_CONTAINER_DOXYGEN_INVOKED) || defined(BOOST_CONTAINER_VARIADIC_TEMPLATES)
+template<class ...Options>
+#else
+template<class O1 = void, class O2 = void, class O3 = void, class O4 = void>
+#endif
+struct vector_options
+{
+   /// @cond
+   typedef typename ::boost::intrusive::pack_options
+      < vector_null_opt,
+      #if !defined(BOOST_CONTAINER_VARIADIC_TEMPLATES)
+      O1, O2, O3, O4
+      #else
+      Options...
+      #endif
+      >::type packed_options;
+   typedef vector_opt< typename packed_options::growth_factor_type
+                     , typename packed_options::stored_size_type> implementation_defined;
+   /// @endcond
+   typedef implementation_defined type;
+};
+
+#if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+
+template<class GrowthType>
+struct devector_opt
+{
+   typedef GrowthType growth_factor_type;
+};
+
+typedef devector_opt<void> devector_null_opt;
+
+#endif   //!defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+
+//! Helper metafunction to combine options into a single type to be used
+//! by \c boost::container::devector.
+//! Supported options are: \c boost::container::growth_factor
+#if defined(BOOST_CONTAINER_DOXYGEN_INVOKED) || defined(BOOST_CONTAINER_VARIADIC_TEMPLATES)
+template<class ...Options>
+#else
+template<class O1 = void, class O2 = void, class O3 = void, class O4 = void>
+#endif
+struct devector_options
+{
+   /// @cond
+   typedef typename ::boost::intrusive::pack_options
+      < devector_null_opt,
+      #if !defined(BOOST_CONTAINER_VARIADIC_TEMPLATES)
+      O1, O2, O3, O4
+      #else
+      Options...
+      #endif
+      >::type packed_options;
+   typedef devector_opt<typename packed_options::growth_factor_type> implementation_defined;
+   /// @endcond
+   typedef implementation_defined type;
+};
+
 }  //namespace container {
 }  //namespace boost {
 
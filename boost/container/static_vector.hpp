@@ -293,6 +293,22 @@ public:
         : base_t(BOOST_MOVE_BASE(typename static_vector<value_type BOOST_MOVE_I C>::base_t, other))
     {}
 
+    #ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+    //The internal allocator is stateless so these are equivalent to the
+    //allocator-less versions. Used by containers built on top of static_vector.
+    explicit static_vector(typename base_t::allocator_type const&) BOOST_NOEXCEPT_OR_NOTHROW
+        : base_t()
+    {}
+
+    static_vector(static_vector const& other, typename base_t::allocator_type const&)
+        : base_t(other)
+    {}
+
+    static_vector(BOOST_RV_REF(static_vector) other, typename base_t::allocator_type const&)
+        : base_t(BOOST_MOVE_BASE(base_t, other))
+    {}
+    #endif   //#ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
+
     //! @brief Copy assigns Values stored in the other static_vector to this one.
     //!
     //! @param other    The static_vector which content will be copied to this one.
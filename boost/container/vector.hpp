@@ -26,6 +26,7 @@
 #include <boost/container/container_fwd.hpp>
 #include <boost/container/allocator_traits.hpp>
 #include <boost/container/new_allocator.hpp> //new_allocator
+#include <boost/container/options.hpp>
 #include <boost/container/throw_exception.hpp>
 // container detail
 #include <boost/container/detail/advanced_insert_int.hpp>
@@ -57,6 +58,7 @@
 // other
 #include <boost/core/no_exceptions_support.hpp>
 #include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
 
 //std
 #if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
@@ -261,8 +263,26 @@ struct vector_value_traits
    typedef container_detail::scoped_array_deallocator<Allocator> ArrayDeallocator;
 };
 
+template<class Options, class AllocatorSizeType>
+struct get_vector_opt
+{
+   typedef typename Options::stored_size_type   opt_stored_size_type;
+   typedef typename if_c< is_same<opt_stored_size_type, void>::value
+                        , AllocatorSizeType, opt_stored_size_type>::type stored_size_type;
+   typedef typename if_c< is_same<typename Options::growth_factor_type, void>::value
+                        , growth_factor_100, typename Options::growth_factor_type>::type growth_factor_type;
+   typedef vector_opt<growth_factor_type, stored_size_type> type;
+};
+
+template<class AllocatorSizeType>
+struct get_vector_opt<void, AllocatorSizeType>
+{
+   typedef vector_opt<growth_factor_100, AllocatorSizeType> type;
+};
+
 //!This struct deallocates and allocated memory
 template < class Allocator
+         , class StoredSizeType = typename allocator_traits<Allocator>::size_type
          , class AllocatorVersion = typename container_detail::version<Allocator>::type
          >
 struct vector_alloc_holder
@@ -277,6 +297,10 @@ struct vector_alloc_holder
    typedef typename allocator_traits_type::pointer       pointer;
    typedef typename allocator_traits_type::size_type     size_type;
    typedef typename allocator_traits_type::value_type    value_type;
+   typedef StoredSizeType                                stored_size_type;
+
+   BOOST_STATIC_ASSERT_MSG(sizeof(stored_size_type) <= sizeof(size_type) && stored_size_type(-1) > stored_size_type(0)
+                          , "stored_size_type must be an unsigned integer type not wider than size_type");
 
    static bool is_propagable_from(const allocator_type &from_alloc, pointer p, const allocator_type &to_alloc, bool const propagate_allocator)
    {
@@ -312,12 +336,14 @@ struct vector_alloc_holder
    vector_alloc_holder(uninitialized_size_t, BOOST_FWD_REF(AllocConvertible) a, size_type initial_size)
       : Allocator(boost::forward<AllocConvertible>(a))
       , m_start()
-      , m_size(initial_size)  //Size is initialized here so vector should only call uninitialized_xxx after this
+      , m_size(static_cast<stored_size_type>(initial_size))  //Size is initialized here so vector should only call uninitialized_xxx after this
       , m_capacity()
    {
       if(initial_size){
          pointer reuse = 0;
-         m_start = this->allocation_command(allocate_new, initial_size, m_capacity = initial_size, reuse);
+         size_type final_cap = initial_size;
+         m_start = this->allocation_command(allocate_new, initial_size, final_cap, reuse);
+         this->capacity(final_cap);
       }
    }
 
@@ -325,12 +351,14 @@ struct vector_alloc_holder
    vector_alloc_holder(uninitialized_size_t, size_type initial_size)
       : Allocator()
       , m_start()
-      , m_size(initial_size)  //Size is initialized here so vector should only call uninitialized_xxx after this
+      , m_size(static_cast<stored_size_type>(initial_size))  //Size is initialized here so vector should only call uninitialized_xxx after this
       , m_capacity()
    {
       if(initial_size){
          pointer reuse = 0;
-         m_start = this->allocation_command(allocate_new, initial_size, m_capacity = initial_size, reuse);
+         size_type final_cap = initial_size;
+         m_start = this->allocation_command(allocate_new, initial_size, final_cap, reuse);
+         this->capacity(final_cap);
       }
    }
 
@@ -364,7 +392,9 @@ struct vector_alloc_holder
       else if(this->m_capacity < holder.m_size){
          size_type const n = holder.m_size;
          pointer reuse = pointer();
-         m_start = this->allocation_command(allocate_new, n, m_capacity = n, reuse);
+         size_type final_cap = n;
+         m_start = this->allocation_command(allocate_new, n, final_cap, reuse);
+         this->capacity(final_cap);
          #ifdef BOOST_CONTAINER_VECTOR_ALLOC_STATS
          this->num_alloc += n != 0;
          #endif
@@ -376,7 +406,7 @@ struct vector_alloc_holder
       : Allocator()
       , m_start(p)
       , m_size()
-      , m_capacity(n)
+      , m_capacity(static_cast<stored_size_type>(n))
    {}
 
    template<class AllocFwd>
@@ -384,7 +414,7 @@ struct vector_alloc_holder
       : Allocator(::boost::forward<AllocFwd>(a))
       , m_start(p)
       , m_size()
-      , m_capacity(n)
+      , m_capacity(static_cast<stored_size_type>(n))
    {}
 
    ~vector_alloc_holder() BOOST_NOEXCEPT_OR_NOTHROW
@@ -398,7 +428,26 @@ struct vector_alloc_holder
                               size_type limit_size, size_type &prefer_in_recvd_out_size, pointer &reuse)
    {
       typedef typename container_detail::version<Allocator>::type alloc_version;
-      return this->priv_allocation_command(alloc_version(), command, limit_size, prefer_in_recvd_out_size, reuse);
+      const size_type max = this->max_size();
+      if(limit_size > max){
+         boost::container::throw_length_error("vector: requested size exceeds max_size()");
+      }
+      if(prefer_in_recvd_out_size > max){
+         prefer_in_recvd_out_size = max;
+      }
+      pointer const ret = this->priv_allocation_command(alloc_version(), command, limit_size, prefer_in_recvd_out_size, reuse);
+      //Received sizes that can't be stored are truncated
+      if(prefer_in_recvd_out_size > max){
+         prefer_in_recvd_out_size = max;
+      }
+      return ret;
+   }
+
+   size_type max_size() const BOOST_NOEXCEPT_OR_NOTHROW
+   {
+      const size_type alloc_max  = allocator_traits_type::max_size(this->alloc());
+      const size_type stored_max = static_cast<size_type>(stored_size_type(-1));
+      return alloc_max < stored_max ? alloc_max : stored_max;
    }
 
    bool try_expand_fwd(size_type at_least)
@@ -418,17 +467,19 @@ struct vector_alloc_holder
       return success;
    }
 
+   //additional_objects is the number of elements to be inserted after m_size
+   template<class GrowthFactorType>
    size_type next_capacity(size_type additional_objects) const
    {
-      return next_capacity_calculator
-         <size_type, NextCapacityDouble //NextCapacity60Percent
-         >::get( allocator_traits_type::max_size(this->alloc())
-               , this->m_capacity, additional_objects );
+      BOOST_ASSERT(additional_objects > size_type(this->m_capacity - this->m_size));
+      const size_type min_additional_cap = additional_objects - size_type(this->m_capacity - this->m_size);
+      return GrowthFactorType()( static_cast<size_type>(this->m_capacity)
+                               , min_additional_cap, this->max_size());
    }
 
-   pointer     m_start;
-   size_type   m_size;
-   size_type   m_capacity;
+   pointer           m_start;
+   stored_size_type  m_size;
+   stored_size_type  m_capacity;
 
    void swap_resources(vector_alloc_holder &x) BOOST_NOEXCEPT_OR_NOTHROW
    {
@@ -453,9 +504,10 @@ struct vector_alloc_holder
    {  return *this;  }
 
    const pointer   &start() const     BOOST_NOEXCEPT_OR_NOTHROW {  return m_start;  }
-   const size_type &capacity() const  BOOST_NOEXCEPT_OR_NOTHROW {  return m_capacity;  }
+   size_type capacity() const         BOOST_NOEXCEPT_OR_NOTHROW {  return m_capacity;  }
    void start(const pointer &p)       BOOST_NOEXCEPT_OR_NOTHROW {  m_start = p;  }
-   void capacity(const size_type &c)  BOOST_NOEXCEPT_OR_NOTHROW {  m_capacity = c;  }
+   void capacity(const size_type &c)  BOOST_NOEXCEPT_OR_NOTHROW
+   {  BOOST_ASSERT(c <= this->max_size()); m_capacity = static_cast<stored_size_type>(c);  }
 
    private:
    void priv_first_allocation(size_type cap)
@@ -463,7 +515,7 @@ struct vector_alloc_holder
       if(cap){
          pointer reuse = 0;
          m_start = this->allocation_command(allocate_new, cap, cap, reuse);
-         m_capacity = cap;
+         this->capacity(cap);
          #ifdef BOOST_CONTAINER_VECTOR_ALLOC_STATS
          ++this->num_alloc;
          #endif
@@ -493,8 +545,8 @@ struct vector_alloc_holder
 };
 
 //!This struct deallocates and allocated memory
-template <class Allocator>
-struct vector_alloc_holder<Allocator, version_0>
+template <class Allocator, class StoredSizeType>
+struct vector_alloc_holder<Allocator, StoredSizeType, version_0>
    : public Allocator
 {
    private:
@@ -505,8 +557,9 @@ struct vector_alloc_holder<Allocator, version_0>
    typedef typename allocator_traits_type::pointer       pointer;
    typedef typename allocator_traits_type::size_type     size_type;
    typedef typename allocator_traits_type::value_type    value_type;
+   typedef StoredSizeType                                stored_size_type;
 
-   template <class OtherAllocator, class OtherAllocatorVersion>
+   template <class OtherAllocator, class OtherStoredSizeType, class OtherAllocatorVersion>
    friend struct vector_alloc_holder;
 
    //Constructor, does not throw
@@ -525,7 +578,7 @@ struct vector_alloc_holder<Allocator, version_0>
    template<class AllocConvertible>
    vector_alloc_holder(uninitialized_size_t, BOOST_FWD_REF(AllocConvertible) a, size_type initial_size)
       : Allocator(boost::forward<AllocConvertible>(a))
-      , m_size(initial_size)  //Size is initialized here...
+      , m_size(static_cast<stored_size_type>(initial_size))  //Size is initialized here...
    {
       //... and capacity here, so vector, must call uninitialized_xxx in the derived constructor
       this->priv_first_allocation(initial_size);
@@ -534,7 +587,7 @@ struct vector_alloc_holder<Allocator, version_0>
    //Constructor, does not throw
    vector_alloc_holder(uninitialized_size_t, size_type initial_size)
       : Allocator()
-      , m_size(initial_size)  //Size is initialized here...
+      , m_size(static_cast<stored_size_type>(initial_size))  //Size is initialized here...
    {
       //... and capacity here, so vector, must call uninitialized_xxx in the derived constructor
       this->priv_first_allocation(initial_size);
@@ -548,10 +601,10 @@ struct vector_alloc_holder<Allocator, version_0>
          (this->alloc(), container_detail::to_raw_pointer(holder.start()), m_size, container_detail::to_raw_pointer(this->start()));
    }
 
-   template<class OtherAllocator, class OtherAllocatorVersion>
-   vector_alloc_holder(BOOST_RV_REF_BEG vector_alloc_holder<OtherAllocator, OtherAllocatorVersion> BOOST_RV_REF_END holder)
+   template<class OtherAllocator, class OtherStoredSizeType, class OtherAllocatorVersion>
+   vector_alloc_holder(BOOST_RV_REF_BEG vector_alloc_holder<OtherAllocator, OtherStoredSizeType, OtherAllocatorVersion> BOOST_RV_REF_END holder)
       : Allocator()
-      , m_size(holder.m_size) //Initialize it to m_size as first_allocation can only succeed or abort
+      , m_size(static_cast<stored_size_type>(holder.m_size)) //Initialize it to m_size as first_allocation can only succeed or abort
    {
       //Different allocator type so we must check we have enough storage
       const size_type n = holder.m_size;
@@ -572,8 +625,8 @@ struct vector_alloc_holder<Allocator, version_0>
       this->priv_deep_swap(x);
    }
 
-   template<class OtherAllocator, class OtherAllocatorVersion>
-   void deep_swap(vector_alloc_holder<OtherAllocator, OtherAllocatorVersion> &x)
+   template<class OtherAllocator, class OtherStoredSizeType, class OtherAllocatorVersion>
+   void deep_swap(vector_alloc_holder<OtherAllocator, OtherStoredSizeType, OtherAllocatorVersion> &x)
    {
       if(this->m_size > OtherAllocator::internal_capacity || x.m_size > Allocator::internal_capacity){
          throw_bad_alloc();
@@ -603,12 +656,16 @@ struct vector_alloc_holder<Allocator, version_0>
 
    pointer start() const       BOOST_NOEXCEPT_OR_NOTHROW {  return Allocator::internal_storage();  }
    size_type  capacity() const BOOST_NOEXCEPT_OR_NOTHROW {  return Allocator::internal_capacity;  }
-   size_type   m_size;
+
+   size_type max_size() const BOOST_NOEXCEPT_OR_NOTHROW
+   {  return allocator_traits_type::max_size(this->alloc());  }
+
+   stored_size_type   m_size;
 
    private:
 
-   template<class OtherAllocator, class OtherAllocatorVersion>
-   void priv_deep_swap(vector_alloc_holder<OtherAllocator, OtherAllocatorVersion> &x)
+   template<class OtherAllocator, class OtherStoredSizeType, class OtherAllocatorVersion>
+   void priv_deep_swap(vector_alloc_holder<OtherAllocator, OtherStoredSizeType, OtherAllocatorVersion> &x)
    {
       const size_type MaxTmpStorage = sizeof(value_type)*Allocator::internal_capacity;
       value_type *const first_this = container_detail::to_raw_pointer(this->start());
@@ -620,7 +677,9 @@ struct vector_alloc_holder<Allocator, version_0>
       else{
          boost::container::deep_swap_alloc_n<MaxTmpStorage>(this->alloc(), first_x, x.m_size, first_this, this->m_size);
       }
-      boost::adl_move_swap(this->m_size, x.m_size);
+      const stored_size_type tmp_size = this->m_size;
+      this->m_size = static_cast<stored_size_type>(x.m_size);
+      x.m_size = static_cast<OtherStoredSizeType>(tmp_size);
    }
 };
 
@@ -635,16 +694,23 @@ struct vector_alloc_holder<Allocator, version_0>
 //!
 //! \tparam T The type of object that is stored in the vector
 //! \tparam Allocator The allocator used for all internal memory management
-template <class T, class Allocator BOOST_CONTAINER_DOCONLY(= new_allocator<T>) >
+//! \tparam Options A type produced from \c boost::container::vector_options. Supported
+//!   options are \c boost::container::growth_factor and \c boost::container::stored_size.
+template <class T, class Allocator BOOST_CONTAINER_DOCONLY(= new_allocator<T>), class Options BOOST_CONTAINER_DOCONLY(= void)>
 class vector
 {
    #ifndef BOOST_CONTAINER_DOXYGEN_INVOKED
 
    typedef typename container_detail::version<Allocator>::type alloc_version;
-   typedef boost::container::container_detail::vector_alloc_holder<Allocator> alloc_holder_t;
+   typedef typename container_detail::get_vector_opt
+      <Options, typename allocator_traits<Allocator>::size_type>::type   options_type;
+   typedef typename options_type::growth_factor_type                    growth_factor_type;
+   typedef typename options_type::stored_size_type                      stored_size_type;
+   typedef boost::container::container_detail::vector_alloc_holder
+      <Allocator, stored_size_type>                                     alloc_holder_t;
    alloc_holder_t m_holder;
    typedef allocator_traits<Allocator>                      allocator_traits_type;
-   template <class U, class UAllocator>
+   template <class U, class UAllocator, class UOptions>
    friend class vector;
 
    typedef typename allocator_traits_type::pointer  pointer_impl;
@@ -917,7 +983,7 @@ class vector
    //!
    //! <b>Note</b>: Non-standard extension to support static_vector
    template<class OtherAllocator>
-   vector(BOOST_RV_REF_BEG vector<T, OtherAllocator> BOOST_RV_REF_END x
+   vector(BOOST_RV_REF_BEG vector<T, OtherAllocator, Options> BOOST_RV_REF_END x
          , typename container_detail::enable_if_c
             < container_detail::is_version<OtherAllocator, 0>::value>::type * = 0
          )
@@ -1047,7 +1113,7 @@ class vector
                            < container_detail::is_version<OtherAllocator, 0>::value &&
                             !container_detail::is_same<OtherAllocator, allocator_type>::value
                            , vector& >::type
-      operator=(BOOST_RV_REF_BEG vector<value_type, OtherAllocator> BOOST_RV_REF_END x)
+      operator=(BOOST_RV_REF_BEG vector<value_type, OtherAllocator, Options> BOOST_RV_REF_END x)
    {
       this->priv_move_assign(boost::move(x));
       return *this;
@@ -1068,7 +1134,7 @@ class vector
                            < container_detail::is_version<OtherAllocator, 0>::value &&
                             !container_detail::is_same<OtherAllocator, allocator_type>::value
                            , vector& >::type
-      operator=(const vector<value_type, OtherAllocator> &x)
+      operator=(const vector<value_type, OtherAllocator, Options> &x)
    {
       this->priv_copy_assign(x);
       return *this;
@@ -1357,7 +1423,7 @@ class vector
    //!
    //! <b>Complexity</b>: Constant.
    size_type max_size() const BOOST_NOEXCEPT_OR_NOTHROW
-   { return allocator_traits_type::max_size(this->m_holder.alloc()); }
+   { return this->m_holder.max_size(); }
 
    //! <b>Effects</b>: Inserts or erases elements at the end such that
    //!   the size becomes n. New elements are value initialized.
@@ -1930,7 +1996,7 @@ class vector
    //!
    //! <b>Note</b>: Non-standard extension to support static_vector
    template<class OtherAllocator>
-   void swap(vector<T, OtherAllocator> & x
+   void swap(vector<T, OtherAllocator, Options> & x
             , typename container_detail::enable_if_c
                      < container_detail::is_version<OtherAllocator, 0>::value &&
                       !container_detail::is_same<OtherAllocator, allocator_type>::value >::type * = 0
@@ -2095,7 +2161,7 @@ class vector
    }
 
    template<class OtherAllocator>
-   void priv_move_assign(BOOST_RV_REF_BEG vector<T, OtherAllocator> BOOST_RV_REF_END x
+   void priv_move_assign(BOOST_RV_REF_BEG vector<T, OtherAllocator, Options> BOOST_RV_REF_END x
       , typename container_detail::enable_if_c
          < container_detail::is_version<OtherAllocator, 0>::value >::type * = 0)
    {
@@ -2112,7 +2178,7 @@ class vector
    }
 
    template<class OtherAllocator>
-   void priv_move_assign(BOOST_RV_REF_BEG vector<T, OtherAllocator> BOOST_RV_REF_END x
+   void priv_move_assign(BOOST_RV_REF_BEG vector<T, OtherAllocator, Options> BOOST_RV_REF_END x
       , typename container_detail::enable_if_c
          < !container_detail::is_version<OtherAllocator, 0>::value &&
            container_detail::is_same<OtherAllocator, allocator_type>::value>::type * = 0)
@@ -2150,7 +2216,7 @@ class vector
    }
 
    template<class OtherAllocator>
-   void priv_copy_assign(const vector<T, OtherAllocator> &x
+   void priv_copy_assign(const vector<T, OtherAllocator, Options> &x
       , typename container_detail::enable_if_c
          < container_detail::is_version<OtherAllocator, 0>::value >::type * = 0)
    {
@@ -2167,7 +2233,7 @@ class vector
    }
 
    template<class OtherAllocator>
-   void priv_copy_assign(const vector<T, OtherAllocator> &x
+   void priv_copy_assign(const vector<T, OtherAllocator, Options> &x
       , typename container_detail::enable_if_c
          < !container_detail::is_version<OtherAllocator, 0>::value &&
            container_detail::is_same<OtherAllocator, allocator_type>::value >::type * = 0)
@@ -2194,7 +2260,7 @@ class vector
    {
       const bool propagate_alloc = allocator_traits_type::propagate_on_container_swap::value;
       if(are_swap_propagable( this->get_stored_allocator(), this->m_holder.start()
-                            , x.get_stored_allocator(), this->m_holder.start(), propagate_alloc)){
+                            , x.get_stored_allocator(), x.m_holder.start(), propagate_alloc)){
          //Just swap internals
          this->m_holder.swap_resources(x.m_holder);
       }
@@ -2213,6 +2279,8 @@ class vector
                    , boost::make_move_iterator(container_detail::iterator_to_raw_pointer(big.nth(common_elements)))
                    , boost::make_move_iterator(container_detail::iterator_to_raw_pointer(big.end()))
                    );
+         //Destroy remaining, moved, elements
+         big.erase(big.nth(common_elements), big.cend());
       }
       //And now swap the allocator
       container_detail::swap_alloc(this->m_holder.alloc(), x.m_holder.alloc(), container_detail::bool_<propagate_alloc>());
@@ -2229,6 +2297,9 @@ class vector
 
    void priv_reserve_no_capacity(size_type new_cap, version_1)
    {
+      if(new_cap > this->max_size()){
+         boost::container::throw_length_error("vector::reserve max_size() exceeded");
+      }
       //There is not enough memory, allocate a new buffer
       //Pass the hint so that allocators can take advantage of this.
       pointer const p = allocator_traits_type::allocate(this->m_holder.alloc(), new_cap, this->m_holder.m_start);
@@ -2453,7 +2524,7 @@ class vector
       const size_type n_pos = pos - this->m_holder.start();
       T *const raw_pos = container_detail::to_raw_pointer(pos);
 
-      const size_type new_cap = this->m_holder.next_capacity(n);
+      const size_type new_cap = this->m_holder.template next_capacity<growth_factor_type>(n);
       //Pass the hint so that allocators can take advantage of this.
       T * const new_buf = container_detail::to_raw_pointer(allocator_traits_type::allocate(this->m_holder.alloc(), new_cap, this->m_holder.m_start));
       #ifdef BOOST_CONTAINER_VECTOR_ALLOC_STATS
@@ -2474,7 +2545,7 @@ class vector
 
       //There is not enough memory, allocate a new
       //buffer or expand the old one.
-      size_type real_cap = this->m_holder.next_capacity(n);
+      size_type real_cap = this->m_holder.template next_capacity<growth_factor_type>(n);
       pointer reuse(this->m_holder.start());
       pointer const ret (this->m_holder.allocation_command
          (allocate_new | expand_fwd | expand_bwd, this->m_holder.m_size + n, real_cap, reuse));
@@ -3144,8 +3215,8 @@ namespace boost {
 
 //!has_trivial_destructor_after_move<> == true_type
 //!specialization for optimizations
-template <class T, class Allocator>
-struct has_trivial_destructor_after_move<boost::container::vector<T, Allocator> >
+template <class T, class Allocator, class Options>
+struct has_trivial_destructor_after_move<boost::container::vector<T, Allocator, Options> >
 {
    typedef typename ::boost::container::allocator_traits<Allocator>::pointer pointer;
    static const bool value = ::boost::has_trivial_destructor_after_move<Allocator>::value &&
@@ -591,6 +591,30 @@ inline bool atomic_add_unless32
    return c != unless_this;
 }
 
+//! Full memory barrier, both for the processor and the compiler: no load or
+//! store is reordered across it, including a store followed by a load.
+inline void atomic_full_barrier()
+{
+#if defined(__GNUC__) && ( __GNUC__ * 100 + __GNUC_MINOR__ >= 401 )
+   __sync_synchronize();
+#elif defined(__GNUC__) && defined(__x86_64__)
+   __asm__ __volatile__("mfence" : : : "memory");
+#elif defined(__GNUC__) && defined(__i386__)
+   //A locked instruction is a full fence and, unlike mfence, needs no SSE2
+   __asm__ __volatile__("lock; addl $0,0(%%esp)" : : : "memory", "cc");
+#elif defined(BOOST_INTERPROCESS_WINDOWS) && defined(BOOST_INTERPROCESS_READ_WRITE_BARRIER)
+   //Interlocked operations are full processor fences, the compiler barriers
+   //keep the surrounding accesses in place
+   volatile boost::uint32_t local = 0;
+   BOOST_INTERPROCESS_READ_WRITE_BARRIER;
+   (void)atomic_cas32(&local, 0, 0);
+   BOOST_INTERPROCESS_READ_WRITE_BARRIER;
+#else
+   volatile boost::uint32_t local = 0;
+   (void)atomic_cas32(&local, 0, 0);
+#endif
+}
+
 }  //namespace ipcdetail
 }  //namespace interprocess
 }  //namespace boost
@@ -63,6 +63,7 @@ class file_wrapper
    //!Does not throw
    file_wrapper(BOOST_RV_REF(file_wrapper) moved)
       :  m_handle(file_handle_t(ipcdetail::invalid_file()))
+      ,  m_mode(read_only)
    {  this->swap(moved);   }
 
    //!Moves the ownership of "moved"'s file to *this.
@@ -119,6 +120,7 @@ class file_wrapper
 
 inline file_wrapper::file_wrapper()
    :  m_handle(file_handle_t(ipcdetail::invalid_file()))
+   ,  m_mode(read_only)
 {}
 
 inline file_wrapper::~file_wrapper()
@@ -110,10 +110,12 @@ class managed_open_or_create_impl
    };
 
    public:
+   //The header stores the initialization state and the number of
+   //pages reserved to grow the segment in place
    static const std::size_t
       ManagedOpenOrCreateUserOffset =
          ct_rounded_size
-            < sizeof(boost::uint32_t)
+            < sizeof(boost::uint32_t)*2
             , MemAlignment ? (MemAlignment) :
                (::boost::container::container_detail::alignment_of
                   < ::boost::container::container_detail::max_align_t >::value)
@@ -136,7 +138,8 @@ class managed_open_or_create_impl
          , mode
          , addr
          , perm
-         , null_mapped_region_function());
+         , null_mapped_region_function()
+         , 0);
    }
 
    managed_open_or_create_impl(open_only_t,
@@ -151,7 +154,8 @@ class managed_open_or_create_impl
          , mode
          , addr
          , permissions()
-         , null_mapped_region_function());
+         , null_mapped_region_function()
+         , 0);
    }
 
 
@@ -169,7 +173,8 @@ class managed_open_or_create_impl
          , mode
          , addr
          , perm
-         , null_mapped_region_function());
+         , null_mapped_region_function()
+         , 0);
    }
 
    template <class ConstructFunc>
@@ -179,7 +184,8 @@ class managed_open_or_create_impl
                  mode_t mode,
                  const void *addr,
                  const ConstructFunc &construct_func,
-                 const permissions &perm)
+                 const permissions &perm,
+                 std::size_t reserve = 0)
    {
       priv_open_or_create
          (DoCreate
@@ -188,7 +194,8 @@ class managed_open_or_create_impl
          , mode
          , addr
          , perm
-         , construct_func);
+         , construct_func
+         , reserve);
    }
 
    template <class ConstructFunc>
@@ -205,7 +212,8 @@ class managed_open_or_create_impl
          , mode
          , addr
          , permissions()
-         , construct_func);
+         , construct_func
+         , 0);
    }
 
    template <class ConstructFunc>
@@ -215,7 +223,8 @@ class managed_open_or_create_impl
                  mode_t mode,
                  const void *addr,
                  const ConstructFunc &construct_func,
-                 const permissions &perm)
+                 const permissions &perm,
+                 std::size_t reserve = 0)
    {
       priv_open_or_create
          ( DoOpenOrCreate
@@ -224,7 +233,8 @@ class managed_open_or_create_impl
          , mode
          , addr
          , perm
-         , construct_func);
+         , construct_func
+         , reserve);
    }
 
    managed_open_or_create_impl(BOOST_RV_REF(managed_open_or_create_impl) moved)
@@ -255,10 +265,39 @@ class managed_open_or_create_impl
    void swap(managed_open_or_create_impl &other)
    {
       this->m_mapped_region.swap(other.m_mapped_region);
+      if(StoreDevice){
+         this->DevHolder::get_device().swap(other.DevHolder::get_device());
+      }
    }
 
-   bool flush()
-   {  return m_mapped_region.flush();  }
+   //"real_size" bounds the operation to the first bytes of the mapped region
+   //that are backed by the device (the rest might be reserved address space).
+   //Zero means the whole mapped region.
+   bool flush(std::size_t real_size = 0)
+   {  return m_mapped_region.flush(0, real_size);  }
+
+   bool advise(mapped_region::advice_types advice)
+   {  return m_mapped_region.advise(advice);  }
+
+   bool prefault(std::size_t real_size = 0)
+   {  return m_mapped_region.prefault(0, real_size);  }
+
+   //Extends the device so that the first "real_size" bytes of the mapped region
+   //are backed. Returns false if "real_size" exceeds the mapped region.
+   bool extend_device(std::size_t real_size)
+   {
+      if(real_size > m_mapped_region.get_size())
+         return false;
+      DeviceAbstraction &dev = this->DevHolder::get_device();
+      offset_t device_size = 0;
+      if(!dev.get_size(device_size))
+         return false;
+      //Another process might have extended the device further
+      if(device_size < offset_t(real_size)){
+         truncate_device<FileBased>(dev, real_size, bool_<FileBased>());
+      }
+      return true;
+   }
 
    const mapped_region &get_mapped_region() const
    {  return m_mapped_region;  }
@@ -307,6 +346,28 @@ class managed_open_or_create_impl
       tmp.swap(dev);
    }
 
+   //Returns the number of pages to map when creating a segment of "size" bytes
+   //that can grow in place up to "reserve" bytes. Only files can be mapped beyond
+   //their size and Windows does not allow views bigger than the file.
+   static boost::uint32_t priv_reserved_pages(std::size_t size, std::size_t reserve)
+   {
+      #if defined(BOOST_INTERPROCESS_WINDOWS)
+      (void)size;
+      (void)reserve;
+      return 0;
+      #else
+      if(!FileBased || reserve <= size){
+         return 0;
+      }
+      const std::size_t page_size = mapped_region::get_page_size();
+      const std::size_t pages = reserve/page_size + std::size_t(reserve % page_size != 0);
+      if(pages > boost::uint32_t(-1)){
+         throw interprocess_exception(error_info(size_error));
+      }
+      return boost::uint32_t(pages);
+      #endif
+   }
+
    template <class ConstructFunc> inline
    void priv_open_or_create
       (create_enum_t type,
@@ -314,7 +375,8 @@ class managed_open_or_create_impl
        std::size_t size,
        mode_t mode, const void *addr,
        const permissions &perm,
-       ConstructFunc construct_func)
+       ConstructFunc construct_func,
+       std::size_t reserve)
    {
       typedef bool_<FileBased> file_like_t;
       (void)mode;
@@ -403,13 +465,17 @@ class managed_open_or_create_impl
             truncate_device<FileBased>(dev, size, file_like_t());
 
             //If the following throws, we will truncate the file to 1
-            mapped_region        region(dev, read_write, 0, 0, addr);
+            const boost::uint32_t reserved_pages = priv_reserved_pages(size, reserve);
+            mapped_region        region
+               (dev, read_write, 0, std::size_t(reserved_pages)*mapped_region::get_page_size(), addr);
             boost::uint32_t *patomic_word = 0;  //avoid gcc warning
             patomic_word = static_cast<boost::uint32_t*>(region.get_address());
             boost::uint32_t previous = atomic_cas32(patomic_word, InitializingSegment, UninitializedSegment);
 
             if(previous == UninitializedSegment){
                try{
+                  //Openers will map the reserved pages
+                  patomic_word[1] = reserved_pages;
                   construct_func( static_cast<char*>(region.get_address()) + ManagedOpenOrCreateUserOffset
                                 , size - ManagedOpenOrCreateUserOffset, true);
                   //All ok, just move resources to the external mapped region
@@ -453,7 +519,8 @@ class managed_open_or_create_impl
             }
          }
 
-         mapped_region  region(dev, ronly ? read_only : (cow ? copy_on_write : read_write), 0, 0, addr);
+         const mode_t map_mode = ronly ? read_only : (cow ? copy_on_write : read_write);
+         mapped_region  region(dev, map_mode, 0, 0, addr);
 
          boost::uint32_t *patomic_word = static_cast<boost::uint32_t*>(region.get_address());
          boost::uint32_t value = atomic_read32(patomic_word);
@@ -467,6 +534,19 @@ class managed_open_or_create_impl
          if(value != InitializedSegment)
             throw interprocess_exception(error_info(corrupted_error));
 
+         //If the creator reserved address space to grow the segment in place,
+         //map the whole reservation so that growth is visible in this process.
+         const std::size_t reserved_size =
+            std::size_t(patomic_word[1])*mapped_region::get_page_size();
+         if(FileBased && reserved_size > region.get_size()){
+            {  //Unmap first, "addr" might be fixed
+               mapped_region tmp;
+               region.swap(tmp);
+            }
+            mapped_region reserved_region(dev, map_mode, 0, reserved_size, addr);
+            region.swap(reserved_region);
+         }
+
          construct_func( static_cast<char*>(region.get_address()) + ManagedOpenOrCreateUserOffset
                         , region.get_size() - ManagedOpenOrCreateUserOffset
                         , false);
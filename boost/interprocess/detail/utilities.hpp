@@ -122,6 +122,15 @@ struct is_intrusive_index
    static const bool value = false;
 };
 
+//!Trait class to detect if an intrusive index can be searched
+//!without locking the segment. Such indexes offer "lock_free_find"
+//!and "publish" functions.
+template <class Index>
+struct is_lock_free_find_index
+{
+   static const bool value = false;
+};
+
 template <typename T> T*
 addressof(T& v)
 {
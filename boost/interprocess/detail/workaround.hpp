@@ -143,6 +143,13 @@
       #endif
    #endif
 
+   //////////////////////////////////////////////////////
+   // Linux futexes can be shared between processes
+   //////////////////////////////////////////////////////
+   #if defined(__linux__)
+      #define BOOST_INTERPROCESS_LINUX_FUTEX
+   #endif
+
    //////////////////////////////////////////////////////
    //64 bit offset
    //////////////////////////////////////////////////////
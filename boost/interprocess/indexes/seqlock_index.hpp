@@ -0,0 +1,393 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_SEQLOCK_INDEX_HPP
+#define BOOST_INTERPROCESS_SEQLOCK_INDEX_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+
+#include <boost/interprocess/indexes/iunordered_set_index.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+#include <boost/interprocess/sync/spin/wait.hpp>
+#include <boost/intrusive/pointer_traits.hpp>
+#include <boost/container/detail/minimal_char_traits_header.hpp>  //std::char_traits
+#include <boost/container/detail/placement_new.hpp>
+#include <boost/cstdint.hpp>
+
+//!\file
+//!Describes an index adaptor of boost::intrusive::unordered_set container that
+//!additionally maintains an open addressing table protected by a sequence counter,
+//!so that named objects can be searched without locking the segment.
+
+namespace boost { namespace interprocess {
+
+//!Index type based in boost::interprocess::iunordered_set_index that offers
+//!lock-free searches. Insertions and erasures are executed under the segment lock
+//!as with any other index, and they also update an open addressing hash table of
+//!(hash, node) pairs. Writers make a sequence counter odd while they modify
+//!that table, so a reader that searches the table without taking any lock just
+//!retries if the counter was odd or changed during the search. Readers never
+//!write shared memory, so they don't contend with allocations or other readers.
+//!
+//!Each slot of the table also stores the name and the address of the named object,
+//!so a search never reads the block header of a node, which might be freed or reused
+//!by a racing writer. All the memory read by a search is checked to be inside the
+//!segment before being accessed so that a search never reads unmapped memory.
+template <class MapConfig>
+class seqlock_index
+   :  public iunordered_set_index<MapConfig>
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   typedef iunordered_set_index<MapConfig>               base_t;
+   typedef iunordered_set_index_aux<MapConfig>           index_aux;
+   typedef typename index_aux::hash_function             hash_function;
+   typedef typename MapConfig::
+      intrusive_compare_key_type                         intrusive_compare_key_type;
+   typedef typename MapConfig::char_type                 char_type;
+   typedef typename index_aux::segment_manager_base      segment_manager_base;
+   typedef typename segment_manager_base::void_pointer   void_pointer;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef typename base_t::iterator                     iterator;
+   typedef typename base_t::const_iterator               const_iterator;
+   typedef typename base_t::insert_commit_data           insert_commit_data;
+   typedef typename base_t::value_type                   value_type;
+   typedef typename base_t::size_type                    size_type;
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   typedef typename boost::intrusive::pointer_traits<void_pointer>::template
+      rebind_pointer<value_type>::type                   value_ptr;
+   typedef typename boost::intrusive::pointer_traits<void_pointer>::template
+      rebind_pointer<const segment_manager_base>::type   segment_manager_base_ptr;
+   typedef typename value_type::size_type                header_size_type;
+   typedef ipcdetail::block_header<header_size_type>     block_header_t;
+   typedef typename boost::intrusive::pointer_traits<void_pointer>::template
+      rebind_pointer<const char_type>::type              const_char_ptr;
+
+   //An empty slot has a null node and a zero hash.
+   //An erased slot has a null node and a non-zero hash.
+   //The name and the object data are copied from the block header of the
+   //node when the slot is filled, so that searches only read the table.
+   struct slot_t
+   {
+      std::size_t       m_hash;
+      value_ptr         m_value;
+      const_char_ptr    m_name;
+      header_size_type  m_name_length;
+      void_pointer      m_object;
+      header_size_type  m_object_bytes;
+   };
+
+   typedef typename boost::intrusive::pointer_traits<void_pointer>::template
+      rebind_pointer<slot_t>::type                       slot_ptr;
+
+   static const size_type MinSlotCount = 16;
+
+   //Returns true if [ptr, ptr + bytes) is inside the segment
+   static bool priv_in_segment
+      (const void *ptr, std::size_t bytes, const char *seg_beg, std::size_t seg_size)
+   {
+      const char *p = static_cast<const char*>(ptr);
+      return p >= seg_beg && std::size_t(p - seg_beg) <= seg_size &&
+             bytes <= seg_size - std::size_t(p - seg_beg);
+   }
+
+   void priv_write_begin()
+   {
+      ipcdetail::atomic_write32(&m_seq, m_seq + 1u);
+      ipcdetail::atomic_full_barrier();
+   }
+
+   void priv_write_end()
+   {
+      ipcdetail::atomic_full_barrier();
+      ipcdetail::atomic_write32(&m_seq, m_seq + 1u);
+   }
+
+   //Places a node in the first free slot. The table must have room for it.
+   static bool priv_place(slot_t *slots, size_type count, value_type &val, std::size_t hash)
+   {
+      const block_header_t *hdr = val.get_block_header();
+      const size_type mask = count - 1;
+      for(size_type i = hash & mask; ; i = (i + 1) & mask){
+         slot_t &s = slots[i];
+         if(!s.m_value){
+            const bool was_empty = s.m_hash == 0;
+            s.m_hash          = hash;
+            s.m_value         = &val;
+            s.m_name          = hdr->template name<char_type>();
+            s.m_name_length   = hdr->name_length();
+            s.m_object        = hdr->value();
+            s.m_object_bytes  = hdr->value_bytes();
+            return was_empty;
+         }
+      }
+   }
+
+   //Builds a new table that can hold "n" published nodes without rehashing
+   //and moves the published nodes there. Nodes pending publication are not
+   //in the old table, so they remain unpublished. Can throw.
+   void priv_rehash(size_type n)
+   {
+      size_type count = MinSlotCount;
+      while(count/4*3 < n){
+         count *= 2;
+      }
+      segment_manager_base &mngr = const_cast<segment_manager_base&>(*mp_segment_mngr);
+      slot_t *slots = static_cast<slot_t*>(mngr.allocate(count*sizeof(slot_t)));
+      for(size_type i = 0; i != count; ++i){
+         slot_t *s = ::new(&slots[i], boost_container_new_t()) slot_t;
+         s->m_hash  = 0;
+         s->m_value = value_ptr();
+         s->m_name_length  = 0;
+         s->m_object_bytes = 0;
+      }
+      size_type used = 0;
+      slot_t *old_beg = ipcdetail::to_raw_pointer(m_slots);
+      for(slot_t *old = old_beg, *old_end = old_beg + m_slot_count; old != old_end; ++old){
+         if(old->m_value){
+            used += priv_place(slots, count, *old->m_value, old->m_hash);
+         }
+      }
+
+      //Now publish the new table
+      slot_ptr old_slots = m_slots;
+      this->priv_write_begin();
+      m_slots      = slots;
+      m_slot_count = count;
+      m_slot_used  = used;
+      this->priv_write_end();
+      if(old_slots){
+         mngr.deallocate(ipcdetail::to_raw_pointer(old_slots));
+      }
+   }
+
+   //Guarantees that the table can hold "n" published nodes
+   //without rehashing. Can throw.
+   void priv_reserve_slots(size_type n)
+   {
+      //Erased slots are also occupied until the next rehash
+      if(!m_slots || (m_slot_used - m_published) + n > m_slot_count/4*3){
+         this->priv_rehash(n);
+      }
+   }
+
+   void priv_unpublish(value_type &val)
+   {
+      if(!m_slots)
+         return;
+      slot_t *slots = ipcdetail::to_raw_pointer(m_slots);
+      const size_type mask = m_slot_count - 1;
+      for(size_type i = hash_function()(val) & mask, n = 0; n != m_slot_count; ++n, i = (i + 1) & mask){
+         slot_t &s = slots[i];
+         if(s.m_value == &val){
+            this->priv_write_begin();
+            s.m_value = value_ptr();
+            s.m_hash  = 1u;
+            this->priv_write_end();
+            --m_published;
+            return;
+         }
+         else if(!s.m_value && !s.m_hash){
+            return;
+         }
+      }
+   }
+
+   void priv_destroy_slots()
+   {
+      if(m_slots){
+         slot_ptr old_slots = m_slots;
+         this->priv_write_begin();
+         m_slots      = slot_ptr();
+         m_slot_count = 0;
+         m_slot_used  = 0;
+         m_published  = 0;
+         this->priv_write_end();
+         const_cast<segment_manager_base&>(*mp_segment_mngr).deallocate(ipcdetail::to_raw_pointer(old_slots));
+      }
+   }
+
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   //!Constructor. Takes a pointer to the
+   //!segment manager. Can throw
+   seqlock_index(segment_manager_base *mngr)
+      :  base_t(mngr)
+      ,  m_seq(0)
+      ,  mp_segment_mngr(mngr)
+      ,  m_slots()
+      ,  m_slot_count(0)
+      ,  m_slot_used(0)
+      ,  m_published(0)
+   {}
+
+   ~seqlock_index()
+   {  this->priv_destroy_slots();  }
+
+   //!This reserves memory to optimize the insertion of n
+   //!elements in the index
+   void reserve(size_type new_n)
+   {
+      base_t::reserve(new_n);
+      try{
+         this->priv_reserve_slots(new_n > this->base_t::size() ? new_n : this->base_t::size());
+      }
+      catch(...){
+      }
+   }
+
+   //!This tries to free unused memory
+   //!previously allocated.
+   void shrink_to_fit()
+   {
+      base_t::shrink_to_fit();
+      if(!this->base_t::size()){
+         this->priv_destroy_slots();
+      }
+   }
+
+   std::pair<iterator, bool> insert_check
+      (const intrusive_compare_key_type &key, insert_commit_data &commit_data)
+   {
+      //Make room in the table before the node is allocated so that
+      //insert_commit() and publish() don't throw. All nodes, published
+      //or pending publication, must fit. Can throw.
+      this->priv_reserve_slots(this->base_t::size() + 1u);
+      return base_t::insert_check(key, commit_data);
+   }
+
+   //!Makes a node inserted with insert_commit visible to lock_free_find.
+   //!This is called once the named object has been constructed, so
+   //!lock-free searches never return partially constructed objects.
+   //!Never throws.
+   void publish(value_type &val)
+   {
+      slot_t *slots = ipcdetail::to_raw_pointer(m_slots);
+      BOOST_ASSERT(slots);
+      const std::size_t hash = hash_function()(val);
+      this->priv_write_begin();
+      m_slot_used += priv_place(slots, m_slot_count, val, hash);
+      this->priv_write_end();
+      ++m_published;
+   }
+
+   void erase(iterator it)
+   {
+      this->priv_unpublish(*it);
+      base_t::erase(it);
+   }
+
+   //!Searches a published node without locking the segment. If found, returns the
+   //!address of the named object and the size of the object in "value_bytes".
+   //!Returns 0 otherwise. Never throws.
+   void *lock_free_find(const intrusive_compare_key_type &key, size_type &value_bytes) const
+   {
+      volatile boost::uint32_t *pseq = const_cast<volatile boost::uint32_t *>(&m_seq);
+      const std::size_t hash = hash_function()(key);
+      const char *const seg_beg = reinterpret_cast<const char*>(ipcdetail::to_raw_pointer(mp_segment_mngr));
+      spin_wait swait;
+      while(true){
+         const boost::uint32_t seq = ipcdetail::atomic_read32(pseq);
+         if(seq & 1u){
+            //A writer is modifying the table
+            swait.yield();
+            continue;
+         }
+         void *ret   = 0;
+         value_bytes = 0;
+         const std::size_t seg_size = mp_segment_mngr->get_size();
+         const slot_t *slots        = ipcdetail::to_raw_pointer(m_slots);
+         const size_type count      = m_slot_count;
+         if(count && !(count & (count - 1)) &&
+            priv_in_segment(slots, count*sizeof(slot_t), seg_beg, seg_size)){
+            const size_type mask = count - 1;
+            for(size_type i = hash & mask, n = 0; n != count; ++n, i = (i + 1) & mask){
+               const slot_t &s = slots[i];
+               const value_type *val = ipcdetail::to_raw_pointer(s.m_value);
+               if(!val){
+                  if(!s.m_hash)
+                     break;
+                  continue;
+               }
+               if(s.m_hash != hash || s.m_name_length != key.m_len){
+                  continue;
+               }
+               //The slot might be being modified and the name might be being
+               //freed: check the range before reading it, the result is
+               //discarded if the sequence changes.
+               const char_type *name = ipcdetail::to_raw_pointer(s.m_name);
+               if(!priv_in_segment(name, (key.m_len + 1)*sizeof(char_type), seg_beg, seg_size) ||
+                  std::char_traits<char_type>::compare(name, key.mp_str, key.m_len) != 0){
+                  continue;
+               }
+               value_bytes = s.m_object_bytes;
+               ret = ipcdetail::to_raw_pointer(s.m_object);
+               break;
+            }
+         }
+         //Validate the search
+         ipcdetail::atomic_full_barrier();
+         if(ipcdetail::atomic_read32(pseq) == seq){
+            return ret;
+         }
+      }
+   }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   boost::uint32_t            m_seq;
+   segment_manager_base_ptr   mp_segment_mngr;
+   slot_ptr                   m_slots;
+   size_type                  m_slot_count;
+   size_type                  m_slot_used;
+   size_type                  m_published;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+//!Trait class to detect if an index is an intrusive
+//!index
+template<class MapConfig>
+struct is_intrusive_index
+   <boost::interprocess::seqlock_index<MapConfig> >
+{
+   static const bool value = true;
+};
+
+//!Trait class to detect if an index can be
+//!searched without locking the segment
+template<class MapConfig>
+struct is_lock_free_find_index
+   <boost::interprocess::seqlock_index<MapConfig> >
+{
+   static const bool value = true;
+};
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+}}   //namespace boost { namespace interprocess {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_INTERPROCESS_SEQLOCK_INDEX_HPP
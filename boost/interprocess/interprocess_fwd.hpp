@@ -41,6 +41,8 @@
 //!   - boost::interprocess::named_semaphore;
 //!   - boost::interprocess::interprocess_sharable_mutex;
 //!   - boost::interprocess::interprocess_condition;
+//!   - boost::interprocess::interprocess_seqlock;
+//!   - boost::interprocess::versioned;
 //!   - boost::interprocess::scoped_lock;
 //!   - boost::interprocess::sharable_lock;
 //!   - boost::interprocess::upgradable_lock;
@@ -61,6 +63,7 @@
 //! The following allocation algorithms:
 //!   - boost::interprocess::simple_seq_fit;
 //!   - boost::interprocess::rbtree_best_fit;
+//!   - boost::interprocess::thread_cached_best_fit;
 //!
 //! The following index types:
 //!   - boost::interprocess::flat_map_index;
@@ -68,6 +71,7 @@
 //!   - boost::interprocess::iunordered_set_index;
 //!   - boost::interprocess::map_index;
 //!   - boost::interprocess::null_index;
+//!   - boost::interprocess::seqlock_index;
 //!   - boost::interprocess::unordered_map_index;
 //!
 //! The following managed memory types:
@@ -189,6 +193,10 @@ struct null_mutex_family;
 
 class interprocess_sharable_mutex;
 class interprocess_condition;
+class interprocess_seqlock;
+
+template<class T>
+class versioned;
 
 //////////////////////////////////////////////////////////////////////////////
 //                              Locks
@@ -253,6 +261,9 @@ class simple_seq_fit;
 template<class MutexFamily, class VoidMutex = offset_ptr<void>, std::size_t MemAlignment = 0>
 class rbtree_best_fit;
 
+template<class MutexFamily, class VoidMutex = offset_ptr<void>, std::size_t MemAlignment = 0>
+class thread_cached_best_fit;
+
 //////////////////////////////////////////////////////////////////////////////
 //                         Index Types
 //////////////////////////////////////////////////////////////////////////////
@@ -260,6 +271,7 @@ class rbtree_best_fit;
 template<class IndexConfig> class flat_map_index;
 template<class IndexConfig> class iset_index;
 template<class IndexConfig> class iunordered_set_index;
+template<class IndexConfig> class seqlock_index;
 template<class IndexConfig> class map_index;
 template<class IndexConfig> class null_index;
 template<class IndexConfig> class unordered_map_index;
@@ -0,0 +1,631 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_RING_QUEUE_HPP
+#define BOOST_INTERPROCESS_RING_QUEUE_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/detail/managed_open_or_create_impl.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/math_functions.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+#include <boost/interprocess/detail/posix_time_types_wrk.hpp>
+#include <boost/interprocess/sync/detail/futex.hpp>
+#include <boost/interprocess/creation_tags.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/permissions.hpp>
+#include <boost/container/detail/type_traits.hpp> //alignment_of, max_align_t
+#include <boost/cstdint.hpp>
+#include <cstddef>   //std::size_t
+#include <cstring>   //memcpy
+
+//!\file
+//!Describes an inter-process lock-free ring queue. This class allows sending
+//!fixed maximum size messages between processes in FIFO order without taking
+//!any lock, and allows blocking, non-blocking and timed sending and receiving.
+
+namespace boost{  namespace interprocess{
+
+namespace ipcdetail
+{
+   template<bool MultiProducer>
+   class ring_queue_initialization_func_t;
+}
+
+//!A lock-free queue that sends messages between processes through a ring of
+//!fixed-size slots placed in shared memory. Messages are received in FIFO
+//!order and priorities are not supported.
+//!
+//!Only one receiver (a single thread of a single process) may consume
+//!messages at a time. If "MultiProducer" is false, only one sender may be
+//!active at a time too; otherwise any number of threads and processes
+//!can send concurrently.
+//!
+//!Senders and receivers only wait in the kernel when the queue is full or
+//!empty (using futexes on Linux and spinning elsewhere), and the opposite side
+//!only issues a wakeup system call when someone is waiting.
+template<bool MultiProducer>
+class ring_queue_t
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   ring_queue_t();
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef std::size_t size_type;
+
+   //!Creates a process shared ring queue with name "name". The queue will have
+   //!"max_num_msg" slots (rounded up to the next power of two) and the maximum
+   //!message size will be "max_msg_size". Throws on error and if the queue
+   //!was previously created. Throws interprocess_exception if "max_num_msg" is
+   //!bigger than 2^31 or "max_msg_size" does not fit in 32 bits.
+   ring_queue_t(create_only_t create_only,
+                const char *name,
+                size_type max_num_msg,
+                size_type max_msg_size,
+                const permissions &perm = permissions());
+
+   //!Opens or creates a process shared ring queue with name "name".
+   //!If the queue is created, the number of slots will be "max_num_msg"
+   //!(rounded up to the next power of two) and the maximum message size will be
+   //!"max_msg_size". If queue was previously created the queue will be opened and
+   //!"max_num_msg" and "max_msg_size" parameters are ignored. Throws on error and
+   //!if "max_num_msg" or "max_msg_size" are out of range, as in the create_only
+   //!overload.
+   ring_queue_t(open_or_create_t open_or_create,
+                const char *name,
+                size_type max_num_msg,
+                size_type max_msg_size,
+                const permissions &perm = permissions());
+
+   //!Opens a previously created process shared ring queue with name "name".
+   //!If the queue was not previously created or there are no free resources,
+   //!throws an error.
+   ring_queue_t(open_only_t open_only,
+                const char *name);
+
+   //!Destroys *this and indicates that the calling process is finished using
+   //!the resource. The resource can still be opened again calling
+   //!the open constructor overload. To erase the ring queue from the system
+   //!use remove().
+   ~ring_queue_t();
+
+   //!Sends a message stored in buffer "buffer" with size "buffer_size".
+   //!If the queue is full the sender is blocked.
+   //!Throws interprocess_exception if "buffer_size" is bigger than
+   //!the maximum message size.
+   void send (const void *buffer, size_type buffer_size);
+
+   //!Sends a message stored in buffer "buffer" with size "buffer_size".
+   //!If the queue is full the sender is not blocked and returns false,
+   //!otherwise returns true. Throws interprocess_exception if "buffer_size"
+   //!is bigger than the maximum message size.
+   bool try_send (const void *buffer, size_type buffer_size);
+
+   //!Sends a message stored in buffer "buffer" with size "buffer_size".
+   //!If the queue is full the sender waits until time "abs_time" is reached.
+   //!Returns true if the message has been successfully sent. Returns false
+   //!if timeout is reached. Throws interprocess_exception if "buffer_size"
+   //!is bigger than the maximum message size.
+   bool timed_send (const void *buffer, size_type buffer_size,
+                    const boost::posix_time::ptime& abs_time);
+
+   //!Receives a message from the queue. The message is stored in buffer
+   //!"buffer", which has size "buffer_size". The received message has size
+   //!"recvd_size". If the queue is empty the receiver is blocked.
+   //!Throws interprocess_exception if "buffer_size" is smaller than the
+   //!maximum message size.
+   void receive (void *buffer, size_type buffer_size, size_type &recvd_size);
+
+   //!Receives a message from the queue. The message is stored in buffer
+   //!"buffer", which has size "buffer_size". The received message has size
+   //!"recvd_size". If the queue is empty the receiver is not blocked and
+   //!returns false, otherwise returns true. Throws interprocess_exception
+   //!if "buffer_size" is smaller than the maximum message size.
+   bool try_receive (void *buffer, size_type buffer_size, size_type &recvd_size);
+
+   //!Receives a message from the queue. The message is stored in buffer
+   //!"buffer", which has size "buffer_size". The received message has size
+   //!"recvd_size". If the queue is empty the receiver waits until time
+   //!"abs_time" is reached. Returns true if a message has been received.
+   //!Returns false if timeout is reached. Throws interprocess_exception
+   //!if "buffer_size" is smaller than the maximum message size.
+   bool timed_receive (void *buffer, size_type buffer_size, size_type &recvd_size,
+                       const boost::posix_time::ptime &abs_time);
+
+   //!Returns the number of slots of the queue. The queue must be opened
+   //!or created previously. Otherwise, returns 0. Never throws
+   size_type get_max_msg() const;
+
+   //!Returns the maximum size of message allowed by the queue. The queue
+   //!must be opened or created previously. Otherwise, returns 0. Never throws
+   size_type get_max_msg_size() const;
+
+   //!Returns the number of messages currently stored. As senders and
+   //!receivers don't synchronize with the caller, the value might be
+   //!outdated when returned. Never throws
+   size_type get_num_msg() const;
+
+   //!Removes the ring queue from the system.
+   //!Returns false on error. Never throws
+   static bool remove(const char *name);
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   typedef boost::posix_time::ptime ptime;
+
+   friend class ipcdetail::ring_queue_initialization_func_t<MultiProducer>;
+
+   bool do_send(bool wait, const void *buffer, size_type buffer_size, const ptime &abs_time);
+
+   bool do_receive(bool wait, void *buffer, size_type buffer_size,
+                   size_type &recvd_size, const ptime &abs_time);
+
+   //!Returns the needed memory size for the shared ring queue.
+   //!Never throws
+   static size_type get_mem_size(size_type max_msg_size, size_type max_num_msg);
+
+   //!Returns the needed memory size for the shared ring queue.
+   //!Throws interprocess_exception if the sizes are out of range.
+   static size_type priv_checked_mem_size(size_type max_msg_size, size_type max_num_msg);
+   typedef ipcdetail::managed_open_or_create_impl<shared_memory_object, 0, true, false> open_create_impl_t;
+   open_create_impl_t m_shmem;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+namespace ipcdetail {
+
+//!Each slot of the ring starts with this header, followed by
+//!the message data. "seq" tells the owner of the slot: a sender can
+//!fill it when seq equals its position and the receiver can read it when
+//!seq equals its position plus one.
+struct ring_slot_t
+{
+   volatile boost::uint32_t   seq;
+   boost::uint32_t            len;
+   void * data(){ return this+1; }
+};
+
+//!This header is placed at the beginning of the shared memory and
+//!contains the data to control the ring. Positions are free-running 32 bit
+//!counters, so the number of slots is always a power of two. The counters
+//!written by senders and the receiver live in different cache lines.
+//!
+//!The structure of the shared memory is:
+//!
+//![ring_hdr_t][slot 0][slot 1]...[slot N-1]
+//!
+//!where each slot is a ring_slot_t plus space for a message of the maximum
+//!size, rounded up so that the next slot header is properly aligned.
+class ring_hdr_t
+{
+   public:
+   typedef std::size_t size_type;
+
+   static const size_type CacheLineSize = 64u;
+
+   //!Positions are 32 bit counters and the number of slots must divide 2^32
+   static const size_type MaxNumSlots = size_type(1u) << 31u;
+
+   //!Constructor. This object must be constructed in the beginning of the
+   //!shared memory of the size returned by the function "get_mem_size".
+   ring_hdr_t(size_type max_num_msg, size_type max_msg_size)
+      : m_tail(0), m_head(0)
+      , m_recv_event(0), m_recv_waiters(0)
+      , m_send_event(0), m_send_waiters(0)
+      , m_num_slots(static_cast<boost::uint32_t>(ring_hdr_t::get_num_slots(max_num_msg)))
+      , m_max_msg_size(max_msg_size)
+      , m_slot_size(ring_hdr_t::get_slot_size(max_msg_size))
+   {
+      for(boost::uint32_t i = 0; i != m_num_slots; ++i){
+         this->slot(i).seq = i;
+      }
+   }
+
+   static size_type get_num_slots(size_type max_num_msg)
+   {  return upper_power_of_2(max_num_msg ? max_num_msg : size_type(1u));  }
+
+   static size_type get_slot_size(size_type max_msg_size)
+   {
+      return get_rounded_size( size_type(sizeof(ring_slot_t) + max_msg_size)
+                             , size_type(::boost::container::container_detail::alignment_of
+                                 < ::boost::container::container_detail::max_align_t>::value));
+   }
+
+   static size_type get_mem_size(size_type max_msg_size, size_type max_num_msg)
+   {
+      return get_rounded_size(size_type(sizeof(ring_hdr_t)), CacheLineSize) +
+             get_num_slots(max_num_msg)*get_slot_size(max_msg_size);
+   }
+
+   //!Returns true if the queue can be represented: the slot count fits in
+   //!the 32 bit positions, the message size fits in the 32 bit slot length and
+   //!get_mem_size() plus "extra_bytes" does not overflow.
+   static bool is_valid_size(size_type max_msg_size, size_type max_num_msg, size_type extra_bytes)
+   {
+      const size_type align = ::boost::container::container_detail::alignment_of
+         < ::boost::container::container_detail::max_align_t>::value;
+      if(max_num_msg > MaxNumSlots || max_msg_size > size_type(boost::uint32_t(-1)) ||
+         max_msg_size > size_type(-1) - sizeof(ring_slot_t) - align){
+         return false;
+      }
+      const size_type hdr_size = get_rounded_size(size_type(sizeof(ring_hdr_t)), CacheLineSize);
+      if(size_type(-1) - hdr_size < extra_bytes)
+         return false;
+      return get_slot_size(max_msg_size) <=
+         (size_type(-1) - hdr_size - extra_bytes)/get_num_slots(max_num_msg);
+   }
+
+   ring_slot_t &slot(boost::uint32_t pos)
+   {
+      char *const first = reinterpret_cast<char*>(this) +
+         get_rounded_size(size_type(sizeof(ring_hdr_t)), CacheLineSize);
+      return *reinterpret_cast<ring_slot_t*>(first + (pos & (m_num_slots - 1u))*m_slot_size);
+   }
+
+   bool try_push(const void *buffer, size_type buffer_size, bool multi_producer)
+   {
+      boost::uint32_t pos;
+      ring_slot_t *s;
+      if(!multi_producer){
+         //The only sender owns the tail
+         pos = m_tail;
+         s = &this->slot(pos);
+         if(atomic_read32(&s->seq) != pos){
+            return false;
+         }
+         m_tail = pos + 1u;
+      }
+      else{
+         //Senders compete to claim the next position
+         pos = atomic_read32(&m_tail);
+         for(;;){
+            s = &this->slot(pos);
+            const boost::int32_t dif = boost::int32_t(atomic_read32(&s->seq) - pos);
+            if(dif == 0){
+               const boost::uint32_t prev = atomic_cas32(&m_tail, pos + 1u, pos);
+               if(prev == pos){
+                  break;
+               }
+               pos = prev;
+            }
+            else if(dif < 0){
+               //The receiver has not freed this slot yet: full
+               return false;
+            }
+            else{
+               //Another sender claimed the slot, retry with the new tail
+               pos = atomic_read32(&m_tail);
+            }
+         }
+      }
+      s->len = static_cast<boost::uint32_t>(buffer_size);
+      std::memcpy(s->data(), buffer, buffer_size);
+      //Publish the message
+      atomic_write32(&s->seq, pos + 1u);
+      notify(m_recv_event, m_recv_waiters);
+      return true;
+   }
+
+   bool try_pop(void *buffer, size_type &recvd_size)
+   {
+      //The only receiver owns the head
+      const boost::uint32_t pos = m_head;
+      ring_slot_t &s = this->slot(pos);
+      if(atomic_read32(&s.seq) != boost::uint32_t(pos + 1u)){
+         return false;
+      }
+      recvd_size = s.len;
+      std::memcpy(buffer, s.data(), recvd_size);
+      //Hand the slot back to senders for the next lap
+      atomic_write32(&s.seq, pos + m_num_slots);
+      m_head = pos + 1u;
+      notify(m_send_event, m_send_waiters);
+      return true;
+   }
+
+   size_type num_msg() const
+   {
+      const boost::uint32_t head = atomic_read32(const_cast<volatile boost::uint32_t*>(&m_head));
+      const boost::uint32_t tail = atomic_read32(const_cast<volatile boost::uint32_t*>(&m_tail));
+      const boost::int32_t dif = boost::int32_t(tail - head);
+      return dif < 0 ? 0u : size_type(dif);
+   }
+
+   //!Wakes waiters on "event" if there is any. Waiters increment the counter
+   //!and then recheck the ring, while the notifier publishes the slot and then
+   //!reads the counter. Both sides need a StoreLoad fence between their store
+   //!and their load, or a wakeup can be lost: atomic_inc32 provides it for
+   //!waiters, but the publishing write does not order a later read on every
+   //!platform, so an explicit full fence is issued here.
+   static void notify(volatile boost::uint32_t &event, volatile boost::uint32_t &waiters)
+   {
+      atomic_full_barrier();
+      if(atomic_read32(&waiters)){
+         atomic_inc32(&event);
+         futex_wake_all(&event);
+      }
+   }
+
+   //Written by senders
+   volatile boost::uint32_t   m_tail;
+   char                       m_pad_tail[CacheLineSize - sizeof(boost::uint32_t)];
+   //Written by the receiver
+   volatile boost::uint32_t   m_head;
+   char                       m_pad_head[CacheLineSize - sizeof(boost::uint32_t)];
+   //Futex words used to block when the ring is empty or full
+   volatile boost::uint32_t   m_recv_event;
+   volatile boost::uint32_t   m_recv_waiters;
+   volatile boost::uint32_t   m_send_event;
+   volatile boost::uint32_t   m_send_waiters;
+   //Read-only after construction
+   const boost::uint32_t      m_num_slots;
+   const size_type            m_max_msg_size;
+   const size_type            m_slot_size;
+};
+
+//!This is the atomic functor to be executed when creating or opening
+//!shared memory. Never throws
+template<bool MultiProducer>
+class ring_queue_initialization_func_t
+{
+   public:
+   typedef std::size_t size_type;
+
+   ring_queue_initialization_func_t(size_type maxmsg = 0,
+                                    size_type maxmsgsize = 0)
+      : m_maxmsg (maxmsg), m_maxmsgsize(maxmsgsize) {}
+
+   bool operator()(void *address, size_type, bool created)
+   {
+      if(created){
+         //Construct the ring header at the beginning
+         ::new(address) ring_hdr_t(m_maxmsg, m_maxmsgsize);
+      }
+      return true;
+   }
+
+   std::size_t get_min_size() const
+   {  return ring_hdr_t::get_mem_size(m_maxmsgsize, m_maxmsg);  }
+
+   const size_type m_maxmsg;
+   const size_type m_maxmsgsize;
+};
+
+}  //namespace ipcdetail {
+
+template<bool MultiProducer>
+inline ring_queue_t<MultiProducer>::~ring_queue_t()
+{}
+
+template<bool MultiProducer>
+inline typename ring_queue_t<MultiProducer>::size_type ring_queue_t<MultiProducer>::get_mem_size
+   (size_type max_msg_size, size_type max_num_msg)
+{
+   return ipcdetail::ring_hdr_t::get_mem_size(max_msg_size, max_num_msg) +
+          open_create_impl_t::ManagedOpenOrCreateUserOffset;
+}
+
+template<bool MultiProducer>
+inline typename ring_queue_t<MultiProducer>::size_type ring_queue_t<MultiProducer>::priv_checked_mem_size
+   (size_type max_msg_size, size_type max_num_msg)
+{
+   if(!ipcdetail::ring_hdr_t::is_valid_size
+         (max_msg_size, max_num_msg, open_create_impl_t::ManagedOpenOrCreateUserOffset)){
+      throw interprocess_exception(size_error);
+   }
+   return get_mem_size(max_msg_size, max_num_msg);
+}
+
+template<bool MultiProducer>
+inline ring_queue_t<MultiProducer>::ring_queue_t(create_only_t,
+                                    const char *name,
+                                    size_type max_num_msg,
+                                    size_type max_msg_size,
+                                    const permissions &perm)
+      //Create shared memory and execute functor atomically
+   :  m_shmem(create_only,
+              name,
+              priv_checked_mem_size(max_msg_size, max_num_msg),
+              read_write,
+              static_cast<void*>(0),
+              //Prepare initialization functor
+              ipcdetail::ring_queue_initialization_func_t<MultiProducer> (max_num_msg, max_msg_size),
+              perm)
+{}
+
+template<bool MultiProducer>
+inline ring_queue_t<MultiProducer>::ring_queue_t(open_or_create_t,
+                                    const char *name,
+                                    size_type max_num_msg,
+                                    size_type max_msg_size,
+                                    const permissions &perm)
+      //Create shared memory and execute functor atomically
+   :  m_shmem(open_or_create,
+              name,
+              priv_checked_mem_size(max_msg_size, max_num_msg),
+              read_write,
+              static_cast<void*>(0),
+              //Prepare initialization functor
+              ipcdetail::ring_queue_initialization_func_t<MultiProducer> (max_num_msg, max_msg_size),
+              perm)
+{}
+
+template<bool MultiProducer>
+inline ring_queue_t<MultiProducer>::ring_queue_t(open_only_t, const char *name)
+   //Create shared memory and execute functor atomically
+   :  m_shmem(open_only,
+              name,
+              read_write,
+              static_cast<void*>(0),
+              //Prepare initialization functor
+              ipcdetail::ring_queue_initialization_func_t<MultiProducer> ())
+{}
+
+template<bool MultiProducer>
+inline void ring_queue_t<MultiProducer>::send
+   (const void *buffer, size_type buffer_size)
+{  this->do_send(true, buffer, buffer_size, ptime(boost::posix_time::pos_infin)); }
+
+template<bool MultiProducer>
+inline bool ring_queue_t<MultiProducer>::try_send
+   (const void *buffer, size_type buffer_size)
+{  return this->do_send(false, buffer, buffer_size, ptime()); }
+
+template<bool MultiProducer>
+inline bool ring_queue_t<MultiProducer>::timed_send
+   (const void *buffer, size_type buffer_size, const boost::posix_time::ptime &abs_time)
+{  return this->do_send(true, buffer, buffer_size, abs_time); }
+
+template<bool MultiProducer>
+inline bool ring_queue_t<MultiProducer>::do_send
+   (bool wait, const void *buffer, size_type buffer_size, const ptime &abs_time)
+{
+   ipcdetail::ring_hdr_t *p_hdr = static_cast<ipcdetail::ring_hdr_t*>(m_shmem.get_user_address());
+   //Check if the message fits in a slot
+   if (buffer_size > p_hdr->m_max_msg_size) {
+      throw interprocess_exception(size_error);
+   }
+
+   //Fast path: no system call at all
+   if(p_hdr->try_push(buffer, buffer_size, MultiProducer)){
+      return true;
+   }
+   else if(!wait){
+      return false;
+   }
+
+   //The ring is full. Announce ourselves as a waiter, take the event
+   //and recheck the ring before sleeping until a receiver frees a slot.
+   while(1){
+      ipcdetail::atomic_inc32(&p_hdr->m_send_waiters);
+      const boost::uint32_t event = ipcdetail::atomic_read32(&p_hdr->m_send_event);
+      bool sent = p_hdr->try_push(buffer, buffer_size, MultiProducer);
+      if(!sent && !ipcdetail::futex_timed_wait(&p_hdr->m_send_event, event, abs_time)){
+         //Timeout: last try
+         sent = p_hdr->try_push(buffer, buffer_size, MultiProducer);
+         ipcdetail::atomic_dec32(&p_hdr->m_send_waiters);
+         return sent;
+      }
+      ipcdetail::atomic_dec32(&p_hdr->m_send_waiters);
+      if(sent){
+         return true;
+      }
+      else if(p_hdr->try_push(buffer, buffer_size, MultiProducer)){
+         return true;
+      }
+   }
+}
+
+template<bool MultiProducer>
+inline void ring_queue_t<MultiProducer>::receive
+   (void *buffer, size_type buffer_size, size_type &recvd_size)
+{  this->do_receive(true, buffer, buffer_size, recvd_size, ptime(boost::posix_time::pos_infin)); }
+
+template<bool MultiProducer>
+inline bool ring_queue_t<MultiProducer>::try_receive
+   (void *buffer, size_type buffer_size, size_type &recvd_size)
+{  return this->do_receive(false, buffer, buffer_size, recvd_size, ptime()); }
+
+template<bool MultiProducer>
+inline bool ring_queue_t<MultiProducer>::timed_receive
+   (void *buffer, size_type buffer_size, size_type &recvd_size, const boost::posix_time::ptime &abs_time)
+{  return this->do_receive(true, buffer, buffer_size, recvd_size, abs_time); }
+
+template<bool MultiProducer>
+inline bool ring_queue_t<MultiProducer>::do_receive
+   (bool wait, void *buffer, size_type buffer_size, size_type &recvd_size, const ptime &abs_time)
+{
+   ipcdetail::ring_hdr_t *p_hdr = static_cast<ipcdetail::ring_hdr_t*>(m_shmem.get_user_address());
+   //Check if buffer is big enough for any message
+   if (buffer_size < p_hdr->m_max_msg_size) {
+      throw interprocess_exception(size_error);
+   }
+
+   //Fast path: no system call at all
+   if(p_hdr->try_pop(buffer, recvd_size)){
+      return true;
+   }
+   else if(!wait){
+      return false;
+   }
+
+   //The ring is empty. Same protocol as senders.
+   while(1){
+      ipcdetail::atomic_inc32(&p_hdr->m_recv_waiters);
+      const boost::uint32_t event = ipcdetail::atomic_read32(&p_hdr->m_recv_event);
+      bool received = p_hdr->try_pop(buffer, recvd_size);
+      if(!received && !ipcdetail::futex_timed_wait(&p_hdr->m_recv_event, event, abs_time)){
+         //Timeout: last try
+         received = p_hdr->try_pop(buffer, recvd_size);
+         ipcdetail::atomic_dec32(&p_hdr->m_recv_waiters);
+         return received;
+      }
+      ipcdetail::atomic_dec32(&p_hdr->m_recv_waiters);
+      if(received){
+         return true;
+      }
+      else if(p_hdr->try_pop(buffer, recvd_size)){
+         return true;
+      }
+   }
+}
+
+template<bool MultiProducer>
+inline typename ring_queue_t<MultiProducer>::size_type ring_queue_t<MultiProducer>::get_max_msg() const
+{
+   ipcdetail::ring_hdr_t *p_hdr = static_cast<ipcdetail::ring_hdr_t*>(m_shmem.get_user_address());
+   return p_hdr ? p_hdr->m_num_slots : 0;
+}
+
+template<bool MultiProducer>
+inline typename ring_queue_t<MultiProducer>::size_type ring_queue_t<MultiProducer>::get_max_msg_size() const
+{
+   ipcdetail::ring_hdr_t *p_hdr = static_cast<ipcdetail::ring_hdr_t*>(m_shmem.get_user_address());
+   return p_hdr ? p_hdr->m_max_msg_size : 0;
+}
+
+template<bool MultiProducer>
+inline typename ring_queue_t<MultiProducer>::size_type ring_queue_t<MultiProducer>::get_num_msg() const
+{
+   ipcdetail::ring_hdr_t *p_hdr = static_cast<ipcdetail::ring_hdr_t*>(m_shmem.get_user_address());
+   return p_hdr ? p_hdr->num_msg() : 0;
+}
+
+template<bool MultiProducer>
+inline bool ring_queue_t<MultiProducer>::remove(const char *name)
+{  return shared_memory_object::remove(name);  }
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+//!Typedef for a ring queue with a single sender and a single receiver
+typedef ring_queue_t<false> spsc_ring_queue;
+
+//!Typedef for a ring queue with multiple senders and a single receiver
+typedef ring_queue_t<true>  mpsc_ring_queue;
+
+}} //namespace boost{  namespace interprocess{
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_INTERPROCESS_RING_QUEUE_HPP
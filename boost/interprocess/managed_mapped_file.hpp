@@ -42,7 +42,7 @@ template<class AllocationAlgorithm>
 struct mfile_open_or_create
 {
    typedef  ipcdetail::managed_open_or_create_impl
-      < file_wrapper, AllocationAlgorithm::Alignment, true, false> type;
+      < file_wrapper, AllocationAlgorithm::Alignment, true, true> type;
 };
 
 }  //namespace ipcdetail {
@@ -94,23 +94,29 @@ class basic_managed_mapped_file
    {}
 
    //!Creates mapped file and creates and places the segment manager.
+   //!If "reserve_size" is bigger than "size", address space for "reserve_size"
+   //!bytes is reserved so that the file can be grown with grow_in_place().
+   //!Processes opening the file will also map the reserved size.
    //!This can throw.
    basic_managed_mapped_file(create_only_t, const char *name,
-                             size_type size, const void *addr = 0, const permissions &perm = permissions())
+                             size_type size, const void *addr = 0, const permissions &perm = permissions(),
+                             size_type reserve_size = 0)
       : m_mfile(create_only, name, size, read_write, addr,
-                create_open_func_t(get_this_pointer(), ipcdetail::DoCreate), perm)
+                create_open_func_t(get_this_pointer(), ipcdetail::DoCreate), perm, reserve_size)
    {}
 
    //!Creates mapped file and creates and places the segment manager if
    //!segment was not created. If segment was created it connects to the
-   //!segment.
+   //!segment. "reserve_size" is only used if the file is created (see the
+   //!create_only_t overload).
    //!This can throw.
    basic_managed_mapped_file (open_or_create_t,
                               const char *name, size_type size,
-                              const void *addr = 0, const permissions &perm = permissions())
+                              const void *addr = 0, const permissions &perm = permissions(),
+                              size_type reserve_size = 0)
       : m_mfile(open_or_create, name, size, read_write, addr,
                 create_open_func_t(get_this_pointer(),
-                ipcdetail::DoOpenOrCreate), perm)
+                ipcdetail::DoOpenOrCreate), perm, reserve_size)
    {}
 
    //!Connects to a created mapped file and its segment manager.
@@ -178,7 +184,44 @@ class basic_managed_mapped_file
    //!Flushes cached data to file.
    //!Never throws
    bool flush()
-   {  return m_mfile.flush();  }
+   {  return m_mfile.flush(this->get_size());  }
+
+   //!Advises the operating system about the expected access pattern of the
+   //!whole segment (e.g. mapped_region::advice_hugepage to back it with huge pages
+   //!or mapped_region::advice_random for hash-like lookups).
+   //!Returns false if the advice is not supported. Never throws.
+   bool advise(mapped_region::advice_types advice)
+   {  return m_mfile.advise(advice);  }
+
+   //!Faults in all the pages of the segment so that the first pass over the
+   //!segment does not stall on page faults. If huge pages are wanted,
+   //!call advise(mapped_region::advice_hugepage) first.
+   //!Only the bytes backed by the file are touched, not the address space
+   //!reserved to grow the segment in place.
+   //!Returns false if the operation could not be performed. Never throws.
+   bool prefault()
+   {  return m_mfile.prefault(this->get_size());  }
+
+   //!Extends the mapped file by "extra_bytes" and adds them to the free memory
+   //!of the segment without unmapping it, so addresses remain valid.
+   //!This function is synchronized and other threads and processes can use the
+   //!segment while it grows.
+   //!
+   //!The new size must fit in the address space reserved when the file
+   //!was created (see "reserve_size" in the create_only_t constructor).
+   //!Returns false if there is not enough reserved address space.
+   //!Throws if the file can't be extended.
+   bool grow_in_place(size_type extra_bytes)
+   {
+      grow_in_place_func func(*this, extra_bytes);
+      this->atomic_func(func);
+      return func.m_success;
+   }
+
+   //!Returns the number of bytes the segment can grow with
+   //!grow_in_place(). Never throws.
+   size_type get_reserved_free_size() const
+   {  return size_type(m_mfile.get_real_size() - this->get_size());  }
 
    //!Tries to resize mapped file so that we have room for
    //!more objects.
@@ -218,6 +261,32 @@ class basic_managed_mapped_file
    }
 
    private:
+   struct grow_in_place_func;
+   friend struct grow_in_place_func;
+
+   //Executed under the segment lock so that concurrent growers serialize
+   struct grow_in_place_func
+   {
+      grow_in_place_func(basic_managed_mapped_file &mfile, size_type extra_bytes)
+         : m_mfile(mfile), m_extra_bytes(extra_bytes), m_success(false)
+      {}
+
+      void operator()()
+      {
+         const size_type size = m_mfile.get_size();
+         if(size_type(-1) - size < m_extra_bytes)
+            return;
+         if(m_mfile.m_mfile.extend_device(size + m_extra_bytes)){
+            m_mfile.base_t::grow(m_extra_bytes);
+            m_success = true;
+         }
+      }
+
+      basic_managed_mapped_file &m_mfile;
+      size_type m_extra_bytes;
+      bool m_success;
+   };
+
    typename ipcdetail::mfile_open_or_create<AllocationAlgorithm>::type m_mfile;
    #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
 };
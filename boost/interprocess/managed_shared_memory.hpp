@@ -177,6 +177,20 @@ class basic_managed_shared_memory
       base2_t::swap(other);
    }
 
+   //!Advises the operating system about the expected access pattern of the
+   //!whole segment (e.g. mapped_region::advice_hugepage to back it with huge pages
+   //!or mapped_region::advice_random for hash-like lookups).
+   //!Returns false if the advice is not supported. Never throws.
+   bool advise(mapped_region::advice_types advice)
+   {  return base2_t::advise(advice);  }
+
+   //!Faults in all the pages of the segment so that the first pass over the
+   //!segment does not stall on page faults. If huge pages are wanted,
+   //!call advise(mapped_region::advice_hugepage) first.
+   //!Returns false if the operation could not be performed. Never throws.
+   bool prefault()
+   {  return base2_t::prefault();  }
+
    //!Tries to resize the managed shared memory object so that we have
    //!room for more objects.
    //!
@@ -212,7 +212,12 @@ class mapped_region
       advice_willneed,
       //!Specifies that the application expects that it will not access the region in the near future.
       //!The implementation can unload pages within the range to save system resources.
-      advice_dontneed
+      advice_dontneed,
+      //!Specifies that the region is worth backing with huge pages (transparent huge pages
+      //!in Linux). Less page faults and TLB misses are expected when accessing big regions.
+      advice_hugepage,
+      //!Specifies that the region should not be backed with huge pages.
+      advice_nohugepage
    };
 
    //!Advises the implementation on the expected behavior of the application with respect to the data
@@ -222,6 +227,13 @@ class mapped_region
    //!If the advise type is not known to the implementation, the function returns false. True otherwise.
    bool advise(advice_types advise);
 
+   //!Faults in the pages of a byte range of the mapped memory so that the first access
+   //!to those pages does not stall on the operating system's page fault handler.
+   //!If 'numbytes' is zero the range ends at the end of the region.
+   //!Pages are populated for reading so that pages of mapped files are not marked dirty.
+   //!Never throws. Returns false if operation could not be performed.
+   bool prefault(std::size_t mapping_offset = 0, std::size_t numbytes = 0);
+
    //!Returns the size of the page. This size is the minimum memory that
    //!will be used by the system when mapping a memory mappable source and
    //!will restrict the address and the offset to map.
@@ -236,6 +248,8 @@ class mapped_region
    std::size_t priv_map_size()  const;
    bool priv_flush_param_check(std::size_t mapping_offset, void *&addr, std::size_t &numbytes) const;
    bool priv_shrink_param_check(std::size_t bytes, bool from_back, void *&shrink_page_start, std::size_t &shrink_page_bytes);
+   static void priv_prefault_param_fixup(void *&addr, std::size_t &numbytes);
+   static void priv_touch_pages(void *addr, std::size_t numbytes);
    static void priv_size_from_mapping_size
       (offset_t mapping_size, offset_t offset, offset_t page_offset, std::size_t &size);
    static offset_t priv_page_offset_addr_fixup(offset_t page_offset, const void *&addr);
@@ -342,6 +356,28 @@ inline bool mapped_region::priv_shrink_param_check
    }
 }
 
+inline void mapped_region::priv_prefault_param_fixup(void *&addr, std::size_t &numbytes)
+{
+   //Round the start address down to the page boundary
+   const std::size_t page_size = mapped_region::get_page_size();
+   const std::size_t misalign  = reinterpret_cast<std::size_t>(addr) % page_size;
+   addr = static_cast<char*>(addr) - misalign;
+   numbytes += misalign;
+}
+
+inline void mapped_region::priv_touch_pages(void *addr, std::size_t numbytes)
+{
+   //Read a byte of every page, the volatile access avoids optimizing the loop away
+   const std::size_t page_size = mapped_region::get_page_size();
+   volatile const char *p   = static_cast<volatile const char*>(addr);
+   volatile const char *end = p + numbytes;
+   char dummy = 0;
+   for(; p < end; p += page_size){
+      dummy ^= *p;
+   }
+   (void)dummy;
+}
+
 inline void mapped_region::priv_size_from_mapping_size
    (offset_t mapping_size, offset_t offset, offset_t page_offset, std::size_t &size)
 {
@@ -552,6 +588,17 @@ inline bool mapped_region::advise(advice_types)
    return false;
 }
 
+inline bool mapped_region::prefault(std::size_t mapping_offset, std::size_t numbytes)
+{
+   void *addr;
+   if(!this->priv_flush_param_check(mapping_offset, addr, numbytes)){
+      return false;
+   }
+   mapped_region::priv_prefault_param_fixup(addr, numbytes);
+   mapped_region::priv_touch_pages(addr, numbytes);
+   return true;
+}
+
 inline void mapped_region::priv_close()
 {
    if(m_base){
@@ -802,6 +849,18 @@ inline bool mapped_region::advise(advice_types advice)
          mode = mode_madv;
          #endif
       break;
+      case advice_hugepage:
+         #if defined(MADV_HUGEPAGE)
+         unix_advice = MADV_HUGEPAGE;
+         mode = mode_madv;
+         #endif
+      break;
+      case advice_nohugepage:
+         #if defined(MADV_NOHUGEPAGE)
+         unix_advice = MADV_NOHUGEPAGE;
+         mode = mode_madv;
+         #endif
+      break;
       default:
       return false;
    }
@@ -824,6 +883,24 @@ inline bool mapped_region::advise(advice_types advice)
    }
 }
 
+inline bool mapped_region::prefault(std::size_t mapping_offset, std::size_t numbytes)
+{
+   void *addr;
+   if(!this->priv_flush_param_check(mapping_offset, addr, numbytes)){
+      return false;
+   }
+   mapped_region::priv_prefault_param_fixup(addr, numbytes);
+   #if defined(MADV_POPULATE_READ)
+   //Populate page tables in a single call if the kernel supports it (Linux 5.14),
+   //older kernels return EINVAL and pages are touched one by one.
+   if(!m_is_xsi && 0 == madvise(addr, numbytes, MADV_POPULATE_READ)){
+      return true;
+   }
+   #endif
+   mapped_region::priv_touch_pages(addr, numbytes);
+   return true;
+}
+
 inline void mapped_region::priv_close()
 {
    if(m_base != 0){
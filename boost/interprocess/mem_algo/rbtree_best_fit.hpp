@@ -336,7 +336,7 @@ class rbtree_best_fit
       : size_type(MemAlignment)
       ;
 
-   private:
+   protected:
    //Due to embedded bits in size, Alignment must be at least 4
    BOOST_STATIC_ASSERT((Alignment >= 4));
    //Due to rbtree size optimizations, Alignment must have at least pointer alignment
@@ -467,6 +467,9 @@ inline rbtree_best_fit<MutexFamily, VoidPointer, MemAlignment>::~rbtree_best_fit
 template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
 void rbtree_best_fit<MutexFamily, VoidPointer, MemAlignment>::grow(size_type extra_size)
 {
+   //-----------------------
+   boost::interprocess::scoped_lock<mutex_type> guard(m_header);
+   //-----------------------
    //Get the address of the first block
    block_ctrl *first_block = priv_first_block();
    block_ctrl *old_end_block = priv_end_block();
@@ -1383,6 +1386,16 @@ void rbtree_best_fit<MutexFamily, VoidPointer, MemAlignment>::priv_deallocate(vo
       else{
          //Block size increment didn't violate tree invariants so there is nothing to fix
       }
+
+      //Absorbed control structures are now in the middle of a free block. Clear them so
+      //that memory cleared by zero_free_memory remains zeroed after internal deallocations
+      //(e.g. the remainder of allocate_many or blocks returned by a caching algorithm).
+      if(merge_with_prev){
+         std::memset(static_cast<void*>(block), 0, AllocatedCtrlBytes);
+      }
+      if(merge_with_next){
+         std::memset(static_cast<void*>(next_block), 0, BlockCtrlBytes);
+      }
    }
    else{
       m_header.m_imultiset.insert(m_header.m_imultiset.begin(), *block_to_insert);
@@ -0,0 +1,383 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_MEM_ALGO_THREAD_CACHED_BEST_FIT_HPP
+#define BOOST_INTERPROCESS_MEM_ALGO_THREAD_CACHED_BEST_FIT_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+
+// interprocess
+#include <boost/interprocess/interprocess_fwd.hpp>
+#include <boost/interprocess/mem_algo/rbtree_best_fit.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+// interprocess/detail
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+// intrusive
+#include <boost/intrusive/pointer_traits.hpp>
+// std
+#include <cstddef>
+#include <cstring>
+
+//!\file
+//!Describes a best-fit algorithm that caches small blocks in several
+//!independently locked caches to avoid contention on the segment lock.
+
+namespace boost {
+namespace interprocess {
+
+//!This class implements the same algorithm as rbtree_best_fit but small
+//!blocks are not returned to the red-black tree when deallocated: they are
+//!kept in caches of blocks of the same size, placed in the segment header.
+//!
+//!There are several caches, each one protected by its own mutex, and each
+//!thread always uses the one selected by hashing its thread id, so threads
+//!of different processes allocating and deallocating small objects rarely
+//!compete for the same lock. The segment-wide lock is only taken to refill a
+//!cache with a batch of blocks or to return half of the cached blocks of a
+//!size when too many have been deallocated.
+//!
+//!This is transparent for segment_manager::construct<T>() and for all
+//!allocators and containers built on top of the segment manager.
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+class thread_cached_best_fit
+   : public rbtree_best_fit<MutexFamily, VoidPointer, MemAlignment>
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   thread_cached_best_fit();
+   thread_cached_best_fit(const thread_cached_best_fit &);
+   thread_cached_best_fit &operator=(const thread_cached_best_fit &);
+
+   typedef rbtree_best_fit<MutexFamily, VoidPointer, MemAlignment> base_t;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef typename base_t::mutex_family           mutex_family;
+   typedef typename base_t::void_pointer           void_pointer;
+   typedef typename base_t::multiallocation_chain  multiallocation_chain;
+   typedef typename base_t::difference_type        difference_type;
+   typedef typename base_t::size_type              size_type;
+
+   //!Number of independently locked caches
+   static const size_type NumCaches       = 8u;
+   //!Number of cached block sizes. Block sizes grow in Alignment units
+   //!starting from the minimum block size of the algorithm.
+   static const size_type NumSizeClasses  = 16u;
+   //!Maximum number of blocks of the same size held by a cache
+   static const size_type MaxCachedBlocks = 32u;
+   //!Number of blocks obtained from the segment when a cache is empty
+   static const size_type RefillBlocks    = 8u;
+
+   //!Constructor. "size" is the total size of the managed memory segment,
+   //!"extra_hdr_bytes" indicates the extra bytes beginning in the sizeof(thread_cached_best_fit)
+   //!offset that the allocator should not use at all.
+   thread_cached_best_fit(size_type size, size_type extra_hdr_bytes);
+
+   //!Obtains the minimum size needed by the algorithm
+   static size_type get_min_size (size_type extra_hdr_bytes);
+
+   //!Allocates bytes, returns 0 if there is not more memory
+   void* allocate(size_type nbytes);
+
+   //!Deallocates previously allocated bytes
+   void deallocate(void *addr);
+
+   //!Returns the number of free bytes of the segment, including cached blocks
+   size_type get_free_memory() const;
+
+   //!Initializes to zero all the memory that's not in use.
+   //!This function is normally used for security reasons.
+   void zero_free_memory();
+
+   //!Decreases managed memory as much as possible
+   void shrink_to_fit();
+
+   //!Returns true if all allocated memory has been deallocated
+   bool all_memory_deallocated();
+
+   //!Returns all cached blocks to the segment.
+   //!Returns true if any block was cached.
+   bool flush_caches();
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   typedef typename MutexFamily::mutex_type  mutex_type;
+
+   struct cache_node;
+   typedef typename boost::intrusive::
+      pointer_traits<VoidPointer>::template
+         rebind_pointer<cache_node>::type    cache_node_ptr;
+
+   //!Cached blocks are linked through their first bytes
+   struct cache_node
+   {
+      cache_node_ptr next;
+   };
+
+   struct size_class_t
+   {
+      cache_node_ptr m_first;
+      size_type      m_count;
+   };
+
+   //!Derives from mutex_type to allow EBO when using null mutex_type
+   struct cache_t : public mutex_type
+   {
+      cache_t()
+         : m_cached_bytes(0)
+      {
+         for(size_type i = 0; i != NumSizeClasses; ++i){
+            m_classes[i].m_first = cache_node_ptr();
+            m_classes[i].m_count = 0;
+         }
+      }
+
+      void push(size_type cls, void *addr, size_type block_bytes)
+      {
+         cache_node *n = ::new(addr, boost_container_new_t()) cache_node;
+         n->next = m_classes[cls].m_first;
+         m_classes[cls].m_first = n;
+         ++m_classes[cls].m_count;
+         m_cached_bytes += block_bytes;
+      }
+
+      void *pop(size_type cls)
+      {
+         cache_node *n = ipcdetail::to_raw_pointer(m_classes[cls].m_first);
+         m_classes[cls].m_first = n->next;
+         --m_classes[cls].m_count;
+         //Like the tree hook of free blocks, don't leave garbage
+         //in memory cleared with zero_free_memory
+         std::memset(static_cast<void*>(n), 0, sizeof(cache_node));
+         return n;
+      }
+
+      size_class_t   m_classes[NumSizeClasses];
+      size_type      m_cached_bytes;
+   };
+
+   //!Number of units (header included) of the block holding "addr"
+   size_type priv_block_units(const void *addr) const
+   {  return (base_t::size(addr) - base_t::UsableByPreviousChunk)/base_t::Alignment + base_t::AllocatedCtrlUnits;  }
+
+   //!Number of units (header included) a request of "nbytes" needs
+   static size_type priv_request_units(size_type nbytes)
+   {
+      if(nbytes < base_t::UsableByPreviousChunk)
+         nbytes = base_t::UsableByPreviousChunk;
+      const size_type units = ipcdetail::get_rounded_size(nbytes - base_t::UsableByPreviousChunk, base_t::Alignment)/base_t::Alignment
+                            + base_t::AllocatedCtrlUnits;
+      return units < base_t::BlockCtrlUnits ? size_type(base_t::BlockCtrlUnits) : units;
+   }
+
+   //!Number of bytes a user can store in a block of "units" units
+   static size_type priv_units_to_user_bytes(size_type units)
+   {  return (units - base_t::AllocatedCtrlUnits)*base_t::Alignment + base_t::UsableByPreviousChunk;  }
+
+   cache_t &priv_thread_cache()
+   {
+      //FNV-1a over the bytes of the thread id, which might not be an integer
+      const ipcdetail::OS_thread_id_t id = ipcdetail::get_current_thread_id();
+      const unsigned char *p = reinterpret_cast<const unsigned char *>(&id);
+      std::size_t h = 2166136261u;
+      for(std::size_t i = 0; i != sizeof(id); ++i){
+         h = (h ^ p[i])*16777619u;
+      }
+      return m_caches[h % NumCaches];
+   }
+
+   void *priv_cache_allocate(size_type cls);
+
+   void priv_cache_deallocate(size_type cls, void *addr);
+
+   cache_t m_caches[NumCaches];
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::
+   thread_cached_best_fit(size_type segment_size, size_type extra_hdr_bytes)
+   //The base algorithm must not use the bytes occupied by the caches
+   : base_t(segment_size, extra_hdr_bytes + (sizeof(thread_cached_best_fit) - sizeof(base_t)))
+   , m_caches()
+{}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline typename thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::size_type
+thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::
+   get_min_size (size_type extra_hdr_bytes)
+{  return base_t::get_min_size(extra_hdr_bytes + (sizeof(thread_cached_best_fit) - sizeof(base_t)));  }
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline void* thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::
+   allocate(size_type nbytes)
+{
+   const size_type cls = priv_request_units(nbytes) - base_t::BlockCtrlUnits;
+   void *ret = 0;
+   if(cls < NumSizeClasses){
+      ret = this->priv_cache_allocate(cls);
+   }
+   if(!ret){
+      ret = base_t::allocate(nbytes);
+      //Cached blocks might be preventing the allocation
+      if(!ret && this->flush_caches()){
+         ret = base_t::allocate(nbytes);
+      }
+   }
+   return ret;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline void thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::
+   deallocate(void *addr)
+{
+   if(!addr)   return;
+   //The size of an allocated block can only be changed by its owner
+   const size_type cls = priv_block_units(addr) - base_t::BlockCtrlUnits;
+   if(cls < NumSizeClasses){
+      this->priv_cache_deallocate(cls, addr);
+   }
+   else{
+      base_t::deallocate(addr);
+   }
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+void *thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::
+   priv_cache_allocate(size_type cls)
+{
+   cache_t &cache = this->priv_thread_cache();
+   //-----------------------
+   boost::interprocess::scoped_lock<mutex_type> guard(cache);
+   //-----------------------
+   const size_type units = cls + base_t::BlockCtrlUnits;
+   if(!cache.m_classes[cls].m_count){
+      //Refill the cache with a batch of contiguous blocks
+      //taking the segment lock only once
+      multiallocation_chain chain;
+      base_t::allocate_many(priv_units_to_user_bytes(units), RefillBlocks, chain);
+      if(chain.empty()){
+         return 0;
+      }
+      while(!chain.empty()){
+         void *addr = ipcdetail::to_raw_pointer(chain.pop_front());
+         cache.push(cls, addr, priv_block_units(addr)*base_t::Alignment);
+      }
+   }
+   void *ret = cache.pop(cls);
+   cache.m_cached_bytes -= priv_block_units(ret)*base_t::Alignment;
+   return ret;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+void thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::
+   priv_cache_deallocate(size_type cls, void *addr)
+{
+   cache_t &cache = this->priv_thread_cache();
+   //-----------------------
+   boost::interprocess::scoped_lock<mutex_type> guard(cache);
+   //-----------------------
+   if(cache.m_classes[cls].m_count < MaxCachedBlocks){
+      cache.push(cls, addr, priv_block_units(addr)*base_t::Alignment);
+   }
+   else{
+      //Too many blocks of this size: return the block
+      //and half of the cached ones in a single batch
+      multiallocation_chain chain;
+      chain.push_back(addr);
+      for(size_type i = 0; i != MaxCachedBlocks/2; ++i){
+         void *p = cache.pop(cls);
+         cache.m_cached_bytes -= priv_block_units(p)*base_t::Alignment;
+         chain.push_back(p);
+      }
+      base_t::deallocate_many(chain);
+   }
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+bool thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::flush_caches()
+{
+   bool flushed = false;
+   for(size_type c = 0; c != NumCaches; ++c){
+      cache_t &cache = m_caches[c];
+      multiallocation_chain chain;
+      {
+         //-----------------------
+         boost::interprocess::scoped_lock<mutex_type> guard(cache);
+         //-----------------------
+         for(size_type cls = 0; cls != NumSizeClasses; ++cls){
+            while(cache.m_classes[cls].m_count){
+               chain.push_back(cache.pop(cls));
+            }
+         }
+         cache.m_cached_bytes = 0;
+      }
+      if(!chain.empty()){
+         flushed = true;
+         base_t::deallocate_many(chain);
+      }
+   }
+   return flushed;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+typename thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::size_type
+thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::get_free_memory() const
+{
+   //Cached blocks are considered free memory. This is just a
+   //snapshot so caches are read without locking them.
+   size_type free_memory = base_t::get_free_memory();
+   for(size_type c = 0; c != NumCaches; ++c){
+      free_memory += m_caches[c].m_cached_bytes;
+   }
+   return free_memory;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline void thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::zero_free_memory()
+{
+   this->flush_caches();
+   base_t::zero_free_memory();
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline void thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::shrink_to_fit()
+{
+   this->flush_caches();
+   base_t::shrink_to_fit();
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline bool thread_cached_best_fit<MutexFamily, VoidPointer, MemAlignment>::all_memory_deallocated()
+{
+   this->flush_caches();
+   return base_t::all_memory_deallocated();
+}
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_INTERPROCESS_MEM_ALGO_THREAD_CACHED_BEST_FIT_HPP
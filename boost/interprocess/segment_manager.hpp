@@ -839,13 +839,20 @@ class segment_manager
       (void)is_intrusive;
       typedef IndexType<ipcdetail::index_config<CharT, MemoryAlgorithm> >         index_type;
       typedef typename index_type::iterator           index_it;
+      typedef ipcdetail::bool_<is_lock_free_find_index<index_type>::value> is_lock_free_t;
+
+      ipcdetail::intrusive_compare_key<CharT> key
+         (name, std::char_traits<CharT>::length(name));
+
+      //Indexes that support it are searched without locking the segment
+      if(is_lock_free_t::value){
+         return priv_lock_free_find(key, index, table, length, is_lock_free_t());
+      }
 
       //-------------------------------
       scoped_lock<rmutex> guard(priv_get_lock(use_lock));
       //-------------------------------
       //Find name in index
-      ipcdetail::intrusive_compare_key<CharT> key
-         (name, std::char_traits<CharT>::length(name));
       index_it it = index.find(key);
 
       //Initialize return values
@@ -866,6 +873,33 @@ class segment_manager
       return ret_ptr;
    }
 
+   template <class Key, class Index>
+   static void *priv_lock_free_find
+      (const Key &key, Index &index, ipcdetail::in_place_interface &table,
+       size_type &length, ipcdetail::true_ is_lock_free)
+   {
+      (void)is_lock_free;
+      typename Index::size_type value_bytes;
+      void *ret_ptr = index.lock_free_find(key, value_bytes);
+      //Sanity check
+      BOOST_ASSERT((value_bytes % table.size) == 0);
+      length = ret_ptr ? value_bytes/table.size : 0;
+      return ret_ptr;
+   }
+
+   template <class Key, class Index>
+   static void *priv_lock_free_find
+      (const Key &, Index &, ipcdetail::in_place_interface &, size_type &length, ipcdetail::false_)
+   {  length = 0; return 0;   }
+
+   template <class Index>
+   static void priv_publish(Index &index, typename Index::value_type &val, ipcdetail::true_ is_lock_free)
+   {  (void)is_lock_free; index.publish(val);   }
+
+   template <class Index>
+   static void priv_publish(Index &, typename Index::value_type &, ipcdetail::false_)
+   {}
+
    template <class CharT>
    void *priv_generic_find
       (const CharT* name,
@@ -1173,6 +1207,10 @@ class segment_manager
       //Release rollbacks since construction was successful
       v_eraser.release();
       mem.release();
+
+      //The object is constructed, lock-free searches can see it now
+      priv_publish(index, *intrusive_hdr
+         , ipcdetail::bool_<is_lock_free_find_index<index_type>::value>());
       return ptr;
    }
 
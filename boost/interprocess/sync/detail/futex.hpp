@@ -0,0 +1,137 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_SYNC_DETAIL_FUTEX_HPP
+#define BOOST_INTERPROCESS_SYNC_DETAIL_FUTEX_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/posix_time_types_wrk.hpp>
+#include <boost/cstdint.hpp>
+
+#if defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+#  include <boost/interprocess/sync/posix/ptime_to_timespec.hpp>
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <sys/types.h>
+#  include <signal.h>
+#  include <pthread.h>
+#  include <unistd.h>
+#  include <climits>
+#  include <cerrno>
+#else
+#  include <boost/interprocess/sync/spin/wait.hpp>
+#endif
+
+//!\file
+//!Describes wait/wake primitives on a 32 bit word placed in shared memory.
+//!On Linux they map to process-shared futexes, other systems emulate them
+//!spinning and yielding until the word changes.
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+#if defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+
+//!Blocks the calling thread while "*addr" equals "expected" or
+//!until "abs_time" (an absolute UTC time) is reached. Spurious wakeups
+//!are possible so the caller must recheck its condition.
+//!Returns false only if the timeout was reached.
+inline bool futex_timed_wait
+   (volatile boost::uint32_t *addr, boost::uint32_t expected, const boost::posix_time::ptime &abs_time)
+{
+   if(abs_time == boost::posix_time::pos_infin){
+      ::syscall(SYS_futex, addr, FUTEX_WAIT, expected, (const timespec*)0, 0, 0);
+      return true;
+   }
+   const timespec ts = ptime_to_timespec(abs_time);
+   const long ret = ::syscall( SYS_futex, addr, FUTEX_WAIT_BITSET | FUTEX_CLOCK_REALTIME
+                             , expected, &ts, 0, FUTEX_BITSET_MATCH_ANY);
+   return !(ret == -1 && errno == ETIMEDOUT);
+}
+
+//!Wakes all threads blocked in futex_timed_wait on "addr".
+inline void futex_wake_all(volatile boost::uint32_t *addr)
+{  ::syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, (const timespec*)0, 0, 0);  }
+
+//!Wakes at most one thread blocked in futex_timed_wait on "addr".
+inline void futex_wake_one(volatile boost::uint32_t *addr)
+{  ::syscall(SYS_futex, addr, FUTEX_WAKE, 1, (const timespec*)0, 0, 0);  }
+
+inline boost::uint32_t &futex_tid_cache()
+{
+   static __thread boost::uint32_t tid;
+   return tid;
+}
+
+//The only thread of a forked child must not use the tid of its parent
+inline void futex_reset_tid_cache()
+{  futex_tid_cache() = 0;  }
+
+//!Returns the kernel thread id of the calling thread. Thread ids are unique
+//!among all the threads of the system (of the same pid namespace) so they
+//!identify the owner of a futex shared between processes.
+inline boost::uint32_t futex_current_tid()
+{
+   boost::uint32_t &tid = futex_tid_cache();
+   if(!tid){
+      static const int atfork_registered = ::pthread_atfork(0, 0, &futex_reset_tid_cache);
+      (void)atfork_registered;
+      tid = static_cast<boost::uint32_t>(::syscall(SYS_gettid));
+   }
+   return tid;
+}
+
+//!Returns true if the thread identified by "tid" (obtained with
+//!futex_current_tid) no longer exists.
+inline bool futex_thread_dead(boost::uint32_t tid)
+{  return ::kill(static_cast<pid_t>(tid), 0) != 0 && errno == ESRCH;  }
+
+#else
+
+inline bool futex_timed_wait
+   (volatile boost::uint32_t *addr, boost::uint32_t expected, const boost::posix_time::ptime &abs_time)
+{
+   spin_wait swait;
+   while(atomic_read32(addr) == expected){
+      if(abs_time != boost::posix_time::pos_infin &&
+         microsec_clock::universal_time() >= abs_time){
+         return false;
+      }
+      swait.yield();
+   }
+   return true;
+}
+
+inline void futex_wake_all(volatile boost::uint32_t *)
+{}
+
+inline void futex_wake_one(volatile boost::uint32_t *)
+{}
+
+#endif   //#if defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+
+}  //namespace ipcdetail
+}  //namespace interprocess
+}  //namespace boost
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_SYNC_DETAIL_FUTEX_HPP
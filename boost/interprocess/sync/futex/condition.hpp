@@ -0,0 +1,138 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_DETAIL_FUTEX_CONDITION_HPP
+#define BOOST_INTERPROCESS_DETAIL_FUTEX_CONDITION_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/posix_time_types_wrk.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/futex/mutex.hpp>
+#include <boost/interprocess/sync/detail/futex.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+//!A process-shared condition variable built on a futex sequence word.
+//!Waiters sleep while the sequence is unchanged and notifiers increment
+//!it, only entering the kernel if there are waiters.
+class futex_condition
+{
+   futex_condition(const futex_condition &);
+   futex_condition &operator=(const futex_condition &);
+
+   public:
+   futex_condition();
+   ~futex_condition();
+
+   void notify_one();
+   void notify_all();
+
+   template <typename L>
+   void wait(L& lock)
+   {
+      if (!lock)
+         throw lock_exception();
+      this->do_timed_wait(boost::posix_time::pos_infin, *lock.mutex());
+   }
+
+   template <typename L, typename Pr>
+   void wait(L& lock, Pr pred)
+   {
+      if (!lock)
+         throw lock_exception();
+
+      while (!pred())
+         this->do_timed_wait(boost::posix_time::pos_infin, *lock.mutex());
+   }
+
+   template <typename L>
+   bool timed_wait(L& lock, const boost::posix_time::ptime &abs_time)
+   {
+      if (!lock)
+         throw lock_exception();
+      return this->do_timed_wait(abs_time, *lock.mutex());
+   }
+
+   template <typename L, typename Pr>
+   bool timed_wait(L& lock, const boost::posix_time::ptime &abs_time, Pr pred)
+   {
+      if (!lock)
+         throw lock_exception();
+      while (!pred()){
+         if (!this->do_timed_wait(abs_time, *lock.mutex()))
+            return pred();
+      }
+      return true;
+   }
+
+   bool do_timed_wait(const boost::posix_time::ptime &abs_time, futex_mutex &mut);
+
+   private:
+   volatile boost::uint32_t m_seq;
+   volatile boost::uint32_t m_waiters;
+};
+
+inline futex_condition::futex_condition()
+   : m_seq(0), m_waiters(0)
+{}
+
+inline futex_condition::~futex_condition()
+{}
+
+inline void futex_condition::notify_one()
+{
+   ipcdetail::atomic_inc32(&m_seq);
+   if(ipcdetail::atomic_read32(&m_waiters)){
+      futex_wake_one(&m_seq);
+   }
+}
+
+inline void futex_condition::notify_all()
+{
+   ipcdetail::atomic_inc32(&m_seq);
+   if(ipcdetail::atomic_read32(&m_waiters)){
+      futex_wake_all(&m_seq);
+   }
+}
+
+inline bool futex_condition::do_timed_wait
+   (const boost::posix_time::ptime &abs_time, futex_mutex &mut)
+{
+   //Register as waiter before reading the sequence so that
+   //a notifier that changes it after this point wakes us.
+   ipcdetail::atomic_inc32(&m_waiters);
+   const boost::uint32_t seq = ipcdetail::atomic_read32(&m_seq);
+   mut.unlock();
+   const bool ret = futex_timed_wait(&m_seq, seq, abs_time);
+   ipcdetail::atomic_dec32(&m_waiters);
+   mut.lock();
+   return ret;
+}
+
+}  //namespace ipcdetail
+}  //namespace interprocess
+}  //namespace boost
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_INTERPROCESS_DETAIL_FUTEX_CONDITION_HPP
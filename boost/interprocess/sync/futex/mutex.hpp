@@ -0,0 +1,189 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_DETAIL_FUTEX_MUTEX_HPP
+#define BOOST_INTERPROCESS_DETAIL_FUTEX_MUTEX_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/posix_time_types_wrk.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/detail/futex.hpp>
+#include <boost/interprocess/sync/spin/wait.hpp>
+#include <boost/cstdint.hpp>
+
+#if !defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+#  error "futex_mutex is only available on Linux"
+#endif
+
+//!Period in milliseconds a blocked thread waits before checking
+//!if the owner of a futex_mutex has died.
+#ifndef BOOST_INTERPROCESS_FUTEX_OWNER_CHECK_PERIOD_MS
+#  define BOOST_INTERPROCESS_FUTEX_OWNER_CHECK_PERIOD_MS 100
+#endif
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+class futex_condition;
+
+//!A process-shared mutex built directly on a futex word that stores
+//!the thread id of the owner. Lockers spin a few iterations before
+//!sleeping in the kernel, and unlock only enters the kernel if there
+//!are sleeping threads.
+//!
+//!If the owner dies without unlocking the mutex, a blocked locker detects it
+//!and takes the ownership of the mutex. previous_owner_dead() then returns true
+//!until consistent() is called, as the protected data might be inconsistent.
+class futex_mutex
+{
+   futex_mutex(const futex_mutex &);
+   futex_mutex &operator=(const futex_mutex &);
+   friend class futex_condition;
+   public:
+
+   futex_mutex();
+   ~futex_mutex();
+
+   void lock();
+   bool try_lock();
+   bool timed_lock(const boost::posix_time::ptime &abs_time);
+   void unlock();
+   void take_ownership(){};
+
+   //!Returns true if an owner of the mutex died while holding it
+   //!and consistent() has not been called since then.
+   bool previous_owner_dead() const;
+
+   //!Marks the state protected by the mutex as consistent again.
+   //!The calling thread must own the mutex.
+   void consistent();
+
+   private:
+   static const boost::uint32_t waiters_bit = 0x80000000u;
+   static const boost::uint32_t tid_mask    = 0x3FFFFFFFu;
+
+   bool priv_recover(boost::uint32_t s, boost::uint32_t tid);
+
+   volatile boost::uint32_t m_s;
+   volatile boost::uint32_t m_owner_dead;
+};
+
+inline futex_mutex::futex_mutex()
+   : m_s(0), m_owner_dead(0)
+{
+   //Note that this class is initialized to zero.
+   //So zeroed memory can be interpreted as an
+   //initialized mutex
+}
+
+inline futex_mutex::~futex_mutex()
+{
+   //Trivial destructor
+}
+
+inline void futex_mutex::lock()
+{  this->timed_lock(boost::posix_time::pos_infin); }
+
+inline bool futex_mutex::try_lock()
+{
+   return ipcdetail::atomic_cas32(&m_s, futex_current_tid(), 0) == 0;
+}
+
+inline bool futex_mutex::timed_lock(const boost::posix_time::ptime &abs_time)
+{
+   const boost::uint32_t tid = futex_current_tid();
+   //Spin a bit, as the owner might release the mutex soon
+   spin_wait swait;
+   while(swait.count() < spin_wait::nop_pause_limit){
+      if(ipcdetail::atomic_read32(&m_s) == 0 && ipcdetail::atomic_cas32(&m_s, tid, 0) == 0){
+         return true;
+      }
+      swait.yield();
+   }
+
+   while(true){
+      boost::uint32_t s = ipcdetail::atomic_read32(&m_s);
+      if(s == 0){
+         //Other threads might be sleeping, so keep the waiters bit
+         if(ipcdetail::atomic_cas32(&m_s, tid | waiters_bit, 0) == 0){
+            return true;
+         }
+         continue;
+      }
+      if(!(s & waiters_bit)){
+         if(ipcdetail::atomic_cas32(&m_s, s | waiters_bit, s) != s){
+            continue;
+         }
+         s |= waiters_bit;
+      }
+      const boost::posix_time::ptime now = microsec_clock::universal_time();
+      if(abs_time != boost::posix_time::pos_infin && now >= abs_time){
+         return false;
+      }
+      //Wake up periodically to check if the owner is alive
+      boost::posix_time::ptime wake_time = now +
+         boost::posix_time::milliseconds(BOOST_INTERPROCESS_FUTEX_OWNER_CHECK_PERIOD_MS);
+      if(abs_time < wake_time){
+         wake_time = abs_time;
+      }
+      if(!futex_timed_wait(&m_s, s, wake_time) && this->priv_recover(s, tid)){
+         return true;
+      }
+   }
+}
+
+inline void futex_mutex::unlock()
+{
+   boost::uint32_t s = ipcdetail::atomic_read32(&m_s);
+   while(true){
+      const boost::uint32_t prev = ipcdetail::atomic_cas32(&m_s, 0, s);
+      if(prev == s)
+         break;
+      s = prev;
+   }
+   if(s & waiters_bit){
+      futex_wake_one(&m_s);
+   }
+}
+
+inline bool futex_mutex::previous_owner_dead() const
+{  return ipcdetail::atomic_read32(const_cast<volatile boost::uint32_t*>(&m_owner_dead)) != 0;  }
+
+inline void futex_mutex::consistent()
+{  ipcdetail::atomic_write32(&m_owner_dead, 0);  }
+
+inline bool futex_mutex::priv_recover(boost::uint32_t s, boost::uint32_t tid)
+{
+   const boost::uint32_t owner = s & tid_mask;
+   if(owner && futex_thread_dead(owner) &&
+      ipcdetail::atomic_cas32(&m_s, tid | waiters_bit, s) == s){
+      ipcdetail::atomic_write32(&m_owner_dead, 1);
+      return true;
+   }
+   return false;
+}
+
+}  //namespace ipcdetail {
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_DETAIL_FUTEX_MUTEX_HPP
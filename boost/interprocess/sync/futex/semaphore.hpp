@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_DETAIL_FUTEX_SEMAPHORE_HPP
+#define BOOST_INTERPROCESS_DETAIL_FUTEX_SEMAPHORE_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/posix_time_types_wrk.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/detail/futex.hpp>
+#include <boost/interprocess/sync/spin/wait.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+//!A process-shared semaphore whose count is a futex word. Waiters spin
+//!a few iterations before sleeping and post only enters the kernel if
+//!there are sleeping waiters.
+class futex_semaphore
+{
+   futex_semaphore(const futex_semaphore &);
+   futex_semaphore &operator=(const futex_semaphore &);
+
+   public:
+   futex_semaphore(unsigned int initialCount);
+   ~futex_semaphore();
+
+   void post();
+   void wait();
+   bool try_wait();
+   bool timed_wait(const boost::posix_time::ptime &abs_time);
+
+   private:
+   volatile boost::uint32_t m_count;
+   volatile boost::uint32_t m_waiters;
+};
+
+inline futex_semaphore::futex_semaphore(unsigned int initialCount)
+   : m_count(boost::uint32_t(initialCount)), m_waiters(0)
+{}
+
+inline futex_semaphore::~futex_semaphore()
+{}
+
+inline void futex_semaphore::post()
+{
+   ipcdetail::atomic_inc32(&m_count);
+   if(ipcdetail::atomic_read32(&m_waiters)){
+      futex_wake_one(&m_count);
+   }
+}
+
+inline void futex_semaphore::wait()
+{  this->timed_wait(boost::posix_time::pos_infin);  }
+
+inline bool futex_semaphore::try_wait()
+{
+   return ipcdetail::atomic_add_unless32(&m_count, boost::uint32_t(-1), boost::uint32_t(0));
+}
+
+inline bool futex_semaphore::timed_wait(const boost::posix_time::ptime &abs_time)
+{
+   //Spin a bit, as the semaphore might be posted soon
+   spin_wait swait;
+   while(swait.count() < spin_wait::nop_pause_limit){
+      if(this->try_wait()){
+         return true;
+      }
+      swait.yield();
+   }
+
+   while(!this->try_wait()){
+      //Register as waiter before checking the count in the kernel
+      //so that a post that increments it after this point wakes us.
+      ipcdetail::atomic_inc32(&m_waiters);
+      const bool ret = futex_timed_wait(&m_count, 0, abs_time);
+      ipcdetail::atomic_dec32(&m_waiters);
+      if(!ret){
+         return this->try_wait();
+      }
+   }
+   return true;
+}
+
+}  //namespace ipcdetail {
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_DETAIL_FUTEX_SEMAPHORE_HPP
@@ -31,7 +31,11 @@
 #include <boost/limits.hpp>
 #include <boost/assert.hpp>
 
-#if !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined(BOOST_INTERPROCESS_POSIX_PROCESS_SHARED)
+#if !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && \
+   defined(BOOST_INTERPROCESS_ENABLE_FUTEX_SYNC) && defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+   #include <boost/interprocess/sync/futex/condition.hpp>
+   #define BOOST_INTERPROCESS_USE_FUTEX
+#elif !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined(BOOST_INTERPROCESS_POSIX_PROCESS_SHARED)
    #include <boost/interprocess/sync/posix/condition.hpp>
    #define BOOST_INTERPROCESS_USE_POSIX
 //Experimental...
@@ -144,6 +148,9 @@ class interprocess_condition
    #if defined (BOOST_INTERPROCESS_USE_GENERIC_EMULATION)
       #undef BOOST_INTERPROCESS_USE_GENERIC_EMULATION
       ipcdetail::spin_condition m_condition;
+   #elif defined(BOOST_INTERPROCESS_USE_FUTEX)
+      #undef BOOST_INTERPROCESS_USE_FUTEX
+      ipcdetail::futex_condition m_condition;
    #elif defined(BOOST_INTERPROCESS_USE_POSIX)
       #undef BOOST_INTERPROCESS_USE_POSIX
       ipcdetail::posix_condition m_condition;
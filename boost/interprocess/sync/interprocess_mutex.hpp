@@ -31,7 +31,11 @@
 #include <boost/interprocess/detail/posix_time_types_wrk.hpp>
 #include <boost/assert.hpp>
 
-#if !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined (BOOST_INTERPROCESS_POSIX_PROCESS_SHARED)
+#if !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && \
+   defined(BOOST_INTERPROCESS_ENABLE_FUTEX_SYNC) && defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+   #include <boost/interprocess/sync/futex/mutex.hpp>
+   #define BOOST_INTERPROCESS_USE_FUTEX
+#elif !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined (BOOST_INTERPROCESS_POSIX_PROCESS_SHARED)
    #include <boost/interprocess/sync/posix/mutex.hpp>
    #define BOOST_INTERPROCESS_USE_POSIX
 //Experimental...
@@ -83,6 +87,9 @@ class interprocess_mutex
       friend class ipcdetail::robust_emulation_helpers::mutex_traits<interprocess_mutex>;
       void take_ownership(){ m_mutex.take_ownership(); }
       public:
+   #elif defined(BOOST_INTERPROCESS_USE_FUTEX)
+      #undef BOOST_INTERPROCESS_USE_FUTEX
+      typedef ipcdetail::futex_mutex internal_mutex_type;
    #elif defined(BOOST_INTERPROCESS_USE_POSIX)
       #undef BOOST_INTERPROCESS_USE_POSIX
       typedef ipcdetail::posix_mutex internal_mutex_type;
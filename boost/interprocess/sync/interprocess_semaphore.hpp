@@ -29,6 +29,10 @@
 #include <boost/interprocess/detail/posix_time_types_wrk.hpp>
 
 #if !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && \
+   defined(BOOST_INTERPROCESS_ENABLE_FUTEX_SYNC) && defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+   #include <boost/interprocess/sync/futex/semaphore.hpp>
+   #define BOOST_INTERPROCESS_USE_FUTEX
+#elif !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && \
    (defined(BOOST_INTERPROCESS_POSIX_PROCESS_SHARED) && defined(BOOST_INTERPROCESS_POSIX_UNNAMED_SEMAPHORES))
    #include <boost/interprocess/sync/posix/semaphore.hpp>
    #define BOOST_INTERPROCESS_USE_POSIX
@@ -99,6 +103,9 @@ class interprocess_semaphore
    #elif defined(BOOST_INTERPROCESS_USE_WINDOWS)
       #undef BOOST_INTERPROCESS_USE_WINDOWS
       ipcdetail::windows_semaphore m_sem;
+   #elif defined(BOOST_INTERPROCESS_USE_FUTEX)
+      #undef BOOST_INTERPROCESS_USE_FUTEX
+      ipcdetail::futex_semaphore m_sem;
    #else
       #undef BOOST_INTERPROCESS_USE_POSIX
       ipcdetail::posix_semaphore m_sem;
@@ -0,0 +1,179 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_SEQLOCK_HPP
+#define BOOST_INTERPROCESS_SEQLOCK_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/posix_time_types_wrk.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/spin/wait.hpp>
+#include <boost/interprocess/sync/detail/common_algorithms.hpp>
+#include <boost/cstdint.hpp>
+
+//!\file
+//!Describes interprocess_seqlock class
+
+namespace boost {
+namespace interprocess {
+
+//!A sequence lock that can be placed in shared memory and can be shared
+//!between processes. Writers are mutually exclusive and make the sequence
+//!odd while they modify the protected data. Readers never write shared
+//!memory: they read the sequence before and after reading the data and retry
+//!if a writer was active meanwhile. Readers never block writers.
+//!
+//!The writer side offers the usual mutex interface so it can be used with
+//!scoped_lock. The protected data must be read in a way that tolerates concurrent
+//!modifications (e.g. copying trivially copyable objects) and must only be used
+//!once read_retry() returns false.
+//!
+//!Typical reader loop:
+//!
+//!<code>
+//!boost::uint32_t seq;
+//!do{
+//!   seq = seqlock.read_begin();
+//!   copy = data;
+//!} while(seqlock.read_retry(seq));
+//!</code>
+class interprocess_seqlock
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   interprocess_seqlock(const interprocess_seqlock &);
+   interprocess_seqlock &operator=(const interprocess_seqlock &);
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   //!Constructs the seqlock. Does not throw.
+   interprocess_seqlock();
+
+   //!Destroys the seqlock. Does not throw.
+   ~interprocess_seqlock();
+
+   //!Effects: The calling thread tries to obtain write ownership of the seqlock,
+   //!   and if another thread has it, waits until it can obtain it.
+   //!Throws: Nothing.
+   void lock();
+
+   //!Effects: The calling thread tries to obtain write ownership of the seqlock
+   //!   without waiting.
+   //!Returns: If the thread acquires ownership, returns true, otherwise false.
+   //!Throws: Nothing.
+   bool try_lock();
+
+   //!Effects: The calling thread tries to obtain write ownership of the seqlock
+   //!   waiting if necessary until abs_time is reached.
+   //!Returns: If the thread acquires ownership, returns true, if the timeout
+   //!   expires returns false.
+   //!Throws: Nothing.
+   bool timed_lock(const boost::posix_time::ptime &abs_time);
+
+   //!Precondition: The thread must have write ownership of the seqlock.
+   //!Effects: Publishes the modifications and releases the write ownership.
+   //!Throws: Nothing.
+   void unlock();
+
+   //!Effects: Waits until no writer owns the seqlock and returns
+   //!   the current sequence that must be passed to read_retry().
+   //!   Does not write shared memory.
+   //!Throws: Nothing.
+   boost::uint32_t read_begin() const;
+
+   //!Returns: true if a writer was active since read_begin() returned "seq",
+   //!   so the data read since then might be inconsistent and must be read again.
+   //!   Does not write shared memory.
+   //!Throws: Nothing.
+   bool read_retry(boost::uint32_t seq) const;
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   volatile boost::uint32_t *priv_seq() const
+   {  return const_cast<volatile boost::uint32_t *>(&m_seq);  }
+
+   volatile boost::uint32_t m_seq;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+inline interprocess_seqlock::interprocess_seqlock()
+   : m_seq(0)
+{}
+
+inline interprocess_seqlock::~interprocess_seqlock()
+{}
+
+inline void interprocess_seqlock::lock()
+{  ipcdetail::try_based_lock(*this);  }
+
+inline bool interprocess_seqlock::try_lock()
+{
+   const boost::uint32_t seq = ipcdetail::atomic_read32(&m_seq);
+   if(seq & 1u || ipcdetail::atomic_cas32(&m_seq, seq + 1u, seq) != seq){
+      return false;
+   }
+   //atomic_cas32 is a full barrier, so data modifications
+   //can't be seen before the odd sequence
+   return true;
+}
+
+inline bool interprocess_seqlock::timed_lock(const boost::posix_time::ptime &abs_time)
+{  return ipcdetail::try_based_timed_lock(*this, abs_time);  }
+
+inline void interprocess_seqlock::unlock()
+{
+   //Only the owner modifies the sequence, so it can be read before the fence
+   const boost::uint32_t seq = m_seq;
+   //Release: data modifications must be visible before the even sequence
+   ipcdetail::atomic_full_barrier();
+   ipcdetail::atomic_write32(&m_seq, seq + 1u);
+}
+
+inline boost::uint32_t interprocess_seqlock::read_begin() const
+{
+   boost::uint32_t seq = ipcdetail::atomic_read32(this->priv_seq());
+   if(seq & 1u){
+      spin_wait swait;
+      do{
+         swait.yield();
+         seq = ipcdetail::atomic_read32(this->priv_seq());
+      } while(seq & 1u);
+   }
+   return seq;
+}
+
+inline bool interprocess_seqlock::read_retry(boost::uint32_t seq) const
+{
+   //Acquire: data reads must be completed before the sequence is read again,
+   //otherwise a torn read could be validated by a stale sequence. The data
+   //is read with plain loads, so this must be a full processor and compiler fence.
+   ipcdetail::atomic_full_barrier();
+   return ipcdetail::atomic_read32(this->priv_seq()) != seq;
+}
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_SEQLOCK_HPP
@@ -0,0 +1,130 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_VERSIONED_HPP
+#define BOOST_INTERPROCESS_VERSIONED_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/sync/interprocess_seqlock.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/cstdint.hpp>
+#include <cstring>
+
+//!\file
+//!Describes versioned class
+
+namespace boost {
+namespace interprocess {
+
+//!A value of type T protected by an interprocess_seqlock that can be placed
+//!in shared memory. Readers obtain consistent snapshots of the value
+//!without writing shared memory, so many reader processes don't contend
+//!with each other, and writers are never blocked by readers.
+//!
+//!T must be trivially copyable, as readers copy its bytes while a
+//!writer might be modifying them and discard inconsistent copies.
+template<class T>
+class versioned
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   versioned(const versioned &);
+   versioned &operator=(const versioned &);
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef T value_type;
+
+   //!Value-initializes the value.
+   versioned()
+      : m_seqlock(), m_value()
+   {}
+
+   //!Initializes the value with a copy of "value".
+   explicit versioned(const T &value)
+      : m_seqlock(), m_value(value)
+   {}
+
+   //!Returns a consistent copy of the value. Does not write shared memory.
+   //!T must be default constructible, otherwise use load(T &).
+   //!Never throws.
+   T load() const
+   {
+      T ret;
+      this->load(ret);
+      return ret;
+   }
+
+   //!Copies the value in "ret" and returns the version of
+   //!the copied value. Does not write shared memory. Never throws.
+   boost::uint32_t load(T &ret) const
+   {
+      boost::uint32_t seq;
+      do{
+         seq = m_seqlock.read_begin();
+         std::memcpy(static_cast<void*>(&ret), const_cast<const T*>(&m_value), sizeof(T));
+      } while(m_seqlock.read_retry(seq));
+      return seq;
+   }
+
+   //!Returns the current version of the value. The version changes
+   //!each time the value is modified. Does not write shared memory.
+   //!Never throws.
+   boost::uint32_t version() const
+   {  return m_seqlock.read_begin();  }
+
+   //!Replaces the value with a copy of "value". Waits
+   //!for other writers but never for readers. Never throws.
+   void store(const T &value)
+   {
+      scoped_lock<interprocess_seqlock> lck(m_seqlock);
+      std::memcpy(static_cast<void*>(&m_value), &value, sizeof(T));
+   }
+
+   //!Calls "f(value)" with a reference to the value, so that it can be
+   //!modified in place. Waits for other writers but never for readers.
+   //!Readers see the modifications only when "f" returns.
+   template<class Modifier>
+   void modify(Modifier f)
+   {
+      scoped_lock<interprocess_seqlock> lck(m_seqlock);
+      f(m_value);
+   }
+
+   //!Returns the seqlock that protects the value of this object only. Each
+   //!versioned object has its own seqlock, so locking it does not make updates
+   //!of several versioned objects atomic: to update several values atomically,
+   //!group them in a single T and use modify(). Don't call store() or modify()
+   //!while holding this lock, as the seqlock is not recursive.
+   interprocess_seqlock &seqlock()
+   {  return m_seqlock;  }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   mutable interprocess_seqlock m_seqlock;
+   T m_value;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_VERSIONED_HPP
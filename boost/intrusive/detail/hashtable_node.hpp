@@ -39,6 +39,8 @@ template <class Slist>
 struct bucket_impl : public Slist
 {
    typedef Slist slist_type;
+   static const bool has_fingerprints = false;
+
    bucket_impl()
    {}
 
@@ -58,9 +60,92 @@ struct bucket_impl : public Slist
       //Slist::clear();
       return *this;
    }
+
+   //Plain buckets don't store fingerprints so they
+   //must always be searched
+   static std::size_t fingerprint_bit(std::size_t)
+   {  return 0u;  }
+
+   bool may_contain(std::size_t) const
+   {  return true;  }
+
+   void add_fingerprint(std::size_t)
+   {}
+
+   void merge_fingerprints(const bucket_impl &)
+   {}
+
+   void reset_fingerprints(std::size_t = 0u)
+   {}
+};
+
+template<std::size_t SizeOfSizeT = sizeof(std::size_t)>
+struct fingerprint_constants
+{
+   //Fibonacci hashing constant: 2^32/phi
+   static const std::size_t multiplier = 0x9E3779B9u;
+   static const std::size_t shift = 32u - 5u;
+};
+
+template<>
+struct fingerprint_constants<8u>
+{
+   //Fibonacci hashing constant: 2^64/phi
+   static const std::size_t multiplier = (std::size_t(0x9E3779B9u) << 32u) | std::size_t(0x7F4A7C15u);
+   static const std::size_t shift = 64u - 6u;
+};
+
+//A bucket that stores, next to the list header, a bitmask summarizing
+//the hash values of the elements linked in the bucket. A lookup whose
+//bit is not set can return without visiting any node.
+//
+//Bits are set on insertion and recomputed on rehash but only cleared when the
+//bucket is emptied, so the summary may give false positives, never false negatives.
+template <class Slist>
+struct fingerprint_bucket_impl : public bucket_impl<Slist>
+{
+   static const bool has_fingerprints = true;
+
+   fingerprint_bucket_impl()
+      : bucket_impl<Slist>(), fingerprints_(0u)
+   {}
+
+   fingerprint_bucket_impl(const fingerprint_bucket_impl &)
+      : bucket_impl<Slist>(), fingerprints_(0u)
+   {}
+
+   fingerprint_bucket_impl &operator=(const fingerprint_bucket_impl&x)
+   {
+      this->bucket_impl<Slist>::operator=(x);
+      fingerprints_ = 0u;
+      return *this;
+   }
+
+   static std::size_t fingerprint_bit(std::size_t hash_value)
+   {
+      //The upper bits of the product depend on all bits of the hash value,
+      //so hash functions that only fill the lower bits are also spread
+      typedef fingerprint_constants<> constants;
+      return std::size_t(1u) << ((hash_value*constants::multiplier) >> constants::shift);
+   }
+
+   bool may_contain(std::size_t hash_value) const
+   {  return 0 != (fingerprints_ & fingerprint_bit(hash_value));  }
+
+   void add_fingerprint(std::size_t hash_value)
+   {  fingerprints_ |= fingerprint_bit(hash_value);  }
+
+   void merge_fingerprints(const fingerprint_bucket_impl &x)
+   {  fingerprints_ |= x.fingerprints_;  }
+
+   void reset_fingerprints(std::size_t fingerprints = 0u)
+   {  fingerprints_ = fingerprints;  }
+
+   private:
+   std::size_t fingerprints_;
 };
 
-template<class Slist>
+template<class Slist, class Bucket = bucket_impl<Slist> >
 struct bucket_traits_impl
 {
    private:
@@ -69,9 +154,10 @@ struct bucket_traits_impl
    public:
    /// @cond
 
+   typedef Bucket                                                    bucket_type;
    typedef typename pointer_traits
       <typename Slist::pointer>::template rebind_pointer
-         < bucket_impl<Slist> >::type                                bucket_ptr;
+         < bucket_type >::type                                       bucket_ptr;
    typedef Slist slist;
    typedef typename Slist::size_type size_type;
    /// @endcond
@@ -173,7 +259,7 @@ class hashtable_iterator
       >::type                                                     slist_impl;
    typedef typename slist_impl::iterator                          siterator;
    typedef typename slist_impl::const_iterator                    const_siterator;
-   typedef detail::bucket_impl<slist_impl>                        bucket_type;
+   typedef typename BucketValueTraits::bucket_type                bucket_type;
 
    typedef typename pointer_traits
       <typename value_traits::pointer>::template rebind_pointer
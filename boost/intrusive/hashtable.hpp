@@ -128,6 +128,7 @@ struct hash_bool_flags
    static const std::size_t cache_begin_pos        = 8u;
    static const std::size_t compare_hash_pos       = 16u;
    static const std::size_t incremental_pos        = 32u;
+   static const std::size_t bucket_fingerprints_pos = 64u;
 };
 
 namespace detail {
@@ -154,6 +155,17 @@ struct unordered_bucket_impl
    typedef implementation_defined               type;
 };
 
+BOOST_INTRUSIVE_INSTANTIATE_DEFAULT_TYPE_TMPLT(bucket_type)
+
+//Obtains the type of the buckets held by BucketTraits. Bucket traits
+//not defining bucket_type are assumed to hold buckets without fingerprints.
+template<class BucketTraits, class Slist>
+struct get_bucket_type
+{
+   typedef typename boost_intrusive_default_type_bucket_type
+      <BucketTraits, bucket_impl<Slist> >::type         type;
+};
+
 template<class SupposedValueTraits>
 struct unordered_bucket_ptr_impl
 {
@@ -521,6 +533,7 @@ struct hashtable_defaults
    static const bool cache_begin          = false;
    static const bool compare_hash         = false;
    static const bool incremental          = false;
+   static const bool bucket_fingerprints  = false;
 };
 
 template<class ValueTraits, bool IsConst>
@@ -600,7 +613,8 @@ struct bucket_plus_vtraits : public ValueTraits
    typedef unordered_group_adapter<node_traits>          group_traits;
    typedef typename slist_impl::iterator                 siterator;
    typedef typename slist_impl::size_type                size_type;
-   typedef detail::bucket_impl<slist_impl>               bucket_type;
+   typedef typename detail::get_bucket_type
+      <bucket_traits, slist_impl>::type                  bucket_type;
    typedef detail::group_functions<node_traits>          group_functions_t;
    typedef typename slist_impl::node_algorithms          node_algorithms;
    typedef typename slist_impl::node_ptr                 slist_node_ptr;
@@ -616,8 +630,10 @@ struct bucket_plus_vtraits : public ValueTraits
       <typename value_traits::pointer>::
          template rebind_pointer
             <const bucket_plus_vtraits>::type            const_bucket_value_traits_ptr;
-   typedef typename detail::unordered_bucket_ptr_impl
-      <value_traits>::type                               bucket_ptr;
+   typedef typename pointer_traits
+      <typename node_traits::node_ptr>::
+         template rebind_pointer
+            <bucket_type>::type                          bucket_ptr;
    typedef detail::bool_<detail::optimize_multikey_is_true
       <node_traits>::value>                              optimize_multikey_t;
 
@@ -783,6 +799,7 @@ struct bucket_plus_vtraits : public ValueTraits
          else{
             buckets_it->clear();
          }
+         buckets_it->reset_fingerprints();
       }
    }
 
@@ -876,8 +893,8 @@ struct bucket_hash_equal_t
    typedef typename bucket_plus_vtraits_t::slist_impl       slist_impl;
    typedef typename slist_impl::size_type                   size_type;
    typedef typename slist_impl::iterator                    siterator;
-   typedef detail::bucket_impl<slist_impl>                  bucket_type;
-   typedef typename detail::unordered_bucket_ptr_impl<value_traits>::type bucket_ptr;
+   typedef typename bucket_plus_vtraits_t::bucket_type      bucket_type;
+   typedef typename bucket_plus_vtraits_t::bucket_ptr       bucket_ptr;
 
    template<class BucketTraitsType>
    bucket_hash_equal_t(const ValueTraits &val_traits, BOOST_FWD_REF(BucketTraitsType) b_traits, const hasher & h, const value_equal &e)
@@ -961,8 +978,7 @@ struct bucket_hash_equal_t<VoidOrKeyHash, VoidOrKeyEqual, ValueTraits, BucketTra
       , internal(val_traits, ::boost::forward<BucketTraitsType>(b_traits), h)
    {}
 
-   typedef typename detail::unordered_bucket_ptr_impl
-      <typename bucket_hash_type::value_traits>::type bucket_ptr;
+   typedef typename bucket_plus_vtraits_t::bucket_ptr      bucket_ptr;
 
    bucket_ptr &priv_get_cache()
    {  return cached_begin_;   }
@@ -1215,7 +1231,7 @@ class hashtable_impl
    typedef typename data_type::value_equal                           key_equal;
    typedef typename data_type::value_equal                           value_equal;
    typedef typename data_type::hasher                                hasher;
-   typedef detail::bucket_impl<slist_impl>                           bucket_type;
+   typedef typename bucket_plus_vtraits_t::bucket_type               bucket_type;
    typedef typename pointer_traits
       <pointer>::template rebind_pointer
          < bucket_type >::type                                       bucket_ptr;
@@ -1253,6 +1269,7 @@ class hashtable_impl
    static const bool compare_hash         = 0 != (BoolFlags & hash_bool_flags::compare_hash_pos);
    static const bool incremental          = 0 != (BoolFlags & hash_bool_flags::incremental_pos);
    static const bool power_2_buckets      = incremental || (0 != (BoolFlags & hash_bool_flags::power_2_buckets_pos));
+   static const bool bucket_fingerprints  = 0 != (BoolFlags & hash_bool_flags::bucket_fingerprints_pos);
 
    static const bool optimize_multikey
       = detail::optimize_multikey_is_true<node_traits>::value && !unique_keys;
@@ -1264,6 +1281,10 @@ class hashtable_impl
    //See documentation for more explanations
    BOOST_STATIC_ASSERT((!compare_hash || store_hash));
 
+   //Configuration error: bucket_fingerprints<> needs buckets that can store fingerprints.
+   //Custom bucket traits must define bucket_type as the bucket_type of the container.
+   BOOST_STATIC_ASSERT((!bucket_fingerprints || bucket_type::has_fingerprints));
+
    typedef typename slist_impl::node_ptr                             slist_node_ptr;
    typedef typename pointer_traits
       <slist_node_ptr>::template rebind_pointer
@@ -1590,6 +1611,7 @@ class hashtable_impl
                dst_buckets[constructed].clone_from
                   ( src_buckets[constructed]
                   , NodeCloner(cloner, &this->priv_value_traits()), node_disp);
+               dst_buckets[constructed].merge_fingerprints(src_buckets[constructed]);
             }
             if(src_bucket_count != dst_bucket_count){
                //Now insert the remaining ones using the modulo trick
@@ -1604,6 +1626,7 @@ class hashtable_impl
                      ; ++b){
                      dst_b.push_front(*(NodeCloner(cloner, &this->priv_value_traits())(*b.pointed_node())));
                   }
+                  dst_b.merge_fingerprints(src_b);
                }
             }
             this->priv_hasher() = src.priv_hasher();
@@ -1810,6 +1833,7 @@ class hashtable_impl
          BOOST_INTRUSIVE_SAFE_HOOK_DEFAULT_ASSERT(node_algorithms::unique(n));
       this->priv_insertion_update_cache(bucket_num);
       group_functions_t::insert_in_group(node_ptr(), n, optimize_multikey_t());
+      b.add_fingerprint(commit_data.hash);
       return iterator(b.insert_after(b.before_begin(), *n), &this->get_bucket_value_traits());
    }
 
@@ -2010,6 +2034,9 @@ class hashtable_impl
             this->priv_size_traits().decrement();
          }
          b.erase_after_and_dispose(prev, it, make_node_disposer(disposer));
+         if(b.empty()){
+            b.reset_fingerprints();
+         }
       }
       this->priv_erasure_update_cache();
       return cnt;
@@ -2049,6 +2076,7 @@ class hashtable_impl
          bucket_ptr b = this->priv_bucket_pointer();
          for(; num_buckets--; ++b){
             b->clear_and_dispose(make_node_disposer(disposer));
+            b->reset_fingerprints();
          }
          this->priv_size_traits().set_size(size_type(0));
       }
@@ -2563,6 +2591,8 @@ class hashtable_impl
             siterator before_i(old_bucket.before_begin());
             siterator end_sit(old_bucket.end());
             siterator i(old_bucket.begin());
+            //Fingerprints of the nodes that stay in old_bucket
+            std::size_t kept_fingerprints = 0u;
             for(;i != end_sit; ++i){
                const value_type &v = this->priv_value_from_slist_node(i.pointed_node());
                const std::size_t hash_value = this->priv_stored_or_compute_hash(v, store_hash_t());
@@ -2574,13 +2604,17 @@ class hashtable_impl
                      (detail::dcast_bucket_ptr<node>(i.pointed_node()), optimize_multikey_t()));
                if(same_buffer && new_n == n){
                   before_i = last;
+                  kept_fingerprints |= bucket_type::fingerprint_bit(hash_value);
                }
                else{
                   bucket_type &new_b = new_buckets[new_n];
                   new_b.splice_after(new_b.before_begin(), old_bucket, before_i, last);
+                  new_b.add_fingerprint(hash_value);
                }
                i = before_i;
             }
+            //Stale fingerprints of the moved nodes are discarded
+            old_bucket.reset_fingerprints(kept_fingerprints);
          }
          else{
             const size_type new_n = detail::hash_to_bucket_split<power_2_buckets, incremental>(n, new_bucket_count, new_bucket_count);
@@ -2592,6 +2626,8 @@ class hashtable_impl
                                  , old_bucket
                                  , old_bucket.before_begin()
                                  , hashtable_impl::priv_get_last(old_bucket));
+               new_b.merge_fingerprints(old_bucket);
+               old_bucket.reset_fingerprints();
             }
          }
       }
@@ -2639,6 +2675,7 @@ class hashtable_impl
          //elements are moved back to the original one.
          detail::incremental_rehash_rollback<bucket_type, split_traits> rollback
             ( buck_ptr[split_idx], old_bucket, this->priv_split_traits());
+         std::size_t kept_fingerprints = 0u;
          for(;i != end_sit; ++i){
             const value_type &v = this->priv_value_from_slist_node(i.pointed_node());
             const std::size_t hash_value = this->priv_stored_or_compute_hash(v, store_hash_t());
@@ -2648,13 +2685,16 @@ class hashtable_impl
                   (detail::dcast_bucket_ptr<node>(i.pointed_node()), optimize_multikey_t()));
             if(new_n == bucket_to_rehash){
                before_i = last;
+               kept_fingerprints |= bucket_type::fingerprint_bit(hash_value);
             }
             else{
                bucket_type &new_b = buck_ptr[new_n];
                new_b.splice_after(new_b.before_begin(), old_bucket, before_i, last);
+               new_b.add_fingerprint(hash_value);
             }
             i = before_i;
          }
+         old_bucket.reset_fingerprints(kept_fingerprints);
          rollback.release();
          this->priv_erasure_update_cache();
          return true;
@@ -2667,6 +2707,8 @@ class hashtable_impl
          bucket_type &target_bucket = buck_ptr[target_bucket_num];
          bucket_type &source_bucket = buck_ptr[split_idx-1];
          target_bucket.splice_after(target_bucket.cbefore_begin(), source_bucket);
+         target_bucket.merge_fingerprints(source_bucket);
+         source_bucket.reset_fingerprints();
          this->priv_split_traits().decrement();
          this->priv_insertion_update_cache(target_bucket_num);
          return true;
@@ -2717,6 +2759,8 @@ class hashtable_impl
             bucket_type &new_bucket = new_bucket_traits.bucket_begin()[n];
             bucket_type &old_bucket = old_buckets[n];
             new_bucket.splice_after(new_bucket.cbefore_begin(), old_bucket);
+            new_bucket.merge_fingerprints(old_bucket);
+            old_bucket.reset_fingerprints();
          }
          //Put cache to safe position
          this->priv_initialize_cache();
@@ -2903,6 +2947,9 @@ class hashtable_impl
             to_erase = b.erase_after_and_dispose(before_first_it, make_node_disposer(disposer));
             ++num_erased;
          }
+         if(b.empty()){
+            b.reset_fingerprints();
+         }
          this->priv_size_traits().set_size(this->priv_size_traits().get_size()-num_erased);
       }
    }
@@ -2927,6 +2974,7 @@ class hashtable_impl
             this->priv_size_traits().decrement();
             ++num_erased;
          }
+         b.reset_fingerprints();
       }
    }
 
@@ -2979,8 +3027,9 @@ class hashtable_impl
             ]).before_begin().pointed_node();
       }
       else{
-         f_bucket_end = this->priv_bucket_pointer()->cend().pointed_node();
-         l_bucket_end = f_bucket_end + this->priv_bucket_count() - 1;
+         const bucket_ptr f(this->priv_bucket_pointer()), l(f + this->priv_bucket_count() - 1);
+         f_bucket_end = f->cend().pointed_node();
+         l_bucket_end = l->cend().pointed_node();
       }
       node_ptr nxt_in_group;
       siterator prev = bucket_type::s_iterator_to
@@ -3001,6 +3050,9 @@ class hashtable_impl
       bucket_type &b = this->priv_bucket_pointer()[this->priv_get_bucket_num(to_erase)];
       siterator prev(this->priv_get_previous(b, to_erase));
       b.erase_after_and_dispose(prev, make_node_disposer(disposer));
+      if(b.empty()){
+         b.reset_fingerprints();
+      }
    }
 
    template<class KeyType, class KeyHasher, class KeyValueEqual>
@@ -3022,6 +3074,10 @@ class hashtable_impl
       if(constant_time_size && this->empty()){
          return this->priv_invalid_local_it();
       }
+      //Fingerprints avoid visiting nodes for most absent keys
+      if(!b.may_contain(h)){
+         return this->priv_invalid_local_it();
+      }
 
       siterator it = previt;
       ++it;
@@ -3083,6 +3139,7 @@ class hashtable_impl
       //Update cache and increment size if needed
       this->priv_insertion_update_cache(bucket_num);
       this->priv_size_traits().increment();
+      b.add_fingerprint(hash_value);
       //Insert the element in the bucket after it
       return iterator(b.insert_after(it, *n), &this->get_bucket_value_traits());
    }
@@ -3189,12 +3246,18 @@ struct make_bucket_traits
          <typename value_traits::node_traits>::type
       >::type                                            slist_impl;
 
+   typedef typename
+      detail::if_c< PackedOptions::bucket_fingerprints
+                  , detail::fingerprint_bucket_impl<slist_impl>
+                  , detail::bucket_impl<slist_impl>
+                  >::type                                bucket_type;
+
    typedef typename
       detail::if_c< detail::is_same
                      < specified_bucket_traits
                      , default_bucket_traits
                      >::value
-                  , detail::bucket_traits_impl<slist_impl>
+                  , detail::bucket_traits_impl<slist_impl, bucket_type>
                   , specified_bucket_traits
                   >::type                                type;
 };
@@ -3242,6 +3305,7 @@ struct make_hashtable
       |  (std::size_t(packed_options::cache_begin)*hash_bool_flags::cache_begin_pos)
       |  (std::size_t(packed_options::compare_hash)*hash_bool_flags::compare_hash_pos)
       |  (std::size_t(packed_options::incremental)*hash_bool_flags::incremental_pos)
+      |  (std::size_t(packed_options::bucket_fingerprints)*hash_bool_flags::bucket_fingerprints_pos)
       > implementation_defined;
 
    /// @endcond
@@ -224,6 +224,13 @@ BOOST_INTRUSIVE_OPTION_CONSTANT(compare_hash, bool, Enabled, compare_hash)
 //!(rehashing the whole bucket array) is not admisible.
 BOOST_INTRUSIVE_OPTION_CONSTANT(incremental, bool, Enabled, incremental)
 
+//!This option setter specifies if each bucket of the hash container will store
+//!a small summary of the hash values of its elements, next to the bucket list header.
+//!Lookups of most absent keys are resolved reading only the bucket array, without
+//!visiting any element. This is specially helpful when lookups frequently fail and
+//!elements are not in the cache, at the cost of a bigger bucket array.
+BOOST_INTRUSIVE_OPTION_CONSTANT(bucket_fingerprints, bool, Enabled, bucket_fingerprints)
+
 /// @cond
 
 struct hook_defaults
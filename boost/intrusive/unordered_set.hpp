@@ -44,7 +44,7 @@ namespace intrusive {
 //! The container supports the following options:
 //! \c base_hook<>/member_hook<>/value_traits<>,
 //! \c constant_time_size<>, \c size_type<>, \c hash<> and \c equal<>
-//! \c bucket_traits<>, \c power_2_buckets<> and \c cache_begin<>.
+//! \c bucket_traits<>, \c power_2_buckets<>, \c cache_begin<> and \c bucket_fingerprints<>.
 //!
 //! unordered_set only provides forward iterators but it provides 4 iterator types:
 //! iterator and const_iterator to navigate through the whole container and
@@ -1047,6 +1047,7 @@ struct make_unordered_set
       |  (std::size_t(packed_options::cache_begin)*hash_bool_flags::cache_begin_pos)
       |  (std::size_t(packed_options::compare_hash)*hash_bool_flags::compare_hash_pos)
       |  (std::size_t(packed_options::incremental)*hash_bool_flags::incremental_pos)
+      |  (std::size_t(packed_options::bucket_fingerprints)*hash_bool_flags::bucket_fingerprints_pos)
       > implementation_defined;
 
    /// @endcond
@@ -1138,7 +1139,7 @@ class unordered_set
 //! The container supports the following options:
 //! \c base_hook<>/member_hook<>/value_traits<>,
 //! \c constant_time_size<>, \c size_type<>, \c hash<> and \c equal<>
-//! \c bucket_traits<>, \c power_2_buckets<> and \c cache_begin<>.
+//! \c bucket_traits<>, \c power_2_buckets<>, \c cache_begin<> and \c bucket_fingerprints<>.
 //!
 //! unordered_multiset only provides forward iterators but it provides 4 iterator types:
 //! iterator and const_iterator to navigate through the whole container and
@@ -2084,6 +2085,7 @@ struct make_unordered_multiset
       |  (std::size_t(packed_options::cache_begin)*hash_bool_flags::cache_begin_pos)
       |  (std::size_t(packed_options::compare_hash)*hash_bool_flags::compare_hash_pos)
       |  (std::size_t(packed_options::incremental)*hash_bool_flags::incremental_pos)
+      |  (std::size_t(packed_options::bucket_fingerprints)*hash_bool_flags::bucket_fingerprints_pos)
       > implementation_defined;
 
    /// @endcond
@@ -30,6 +30,8 @@
 #include <boost/iostreams/detail/streambuf.hpp> // pubsync.
 #include <boost/iostreams/detail/wrap_unwrap.hpp>
 #include <boost/iostreams/device/null.hpp>
+#include <boost/iostreams/operations_fwd.hpp>   // is_custom.
+#include <boost/iostreams/optimal_buffer_size.hpp>
 #include <boost/iostreams/positioning.hpp>
 #include <boost/iostreams/traits.hpp>           // is_filter.
 #include <boost/iostreams/stream_buffer.hpp>
@@ -248,7 +250,7 @@ private:
         buffer_size =
             buffer_size != -1 ?
                 buffer_size :
-                iostreams::optimal_buffer_size(t);
+                default_buffer_size(t);
         pback_size =
             pback_size != -1 ?
                 pback_size :
@@ -271,6 +273,22 @@ private:
         notify();
     }
 
+    // Returns the buffer size of a component pushed without an explicit
+    // buffer size: its own optimal buffer size if it has one, otherwise
+    // the size set with set_device_buffer_size or set_filter_buffer_size.
+    template<typename T>
+    std::streamsize default_buffer_size(const T& t) const
+    {
+        typedef typename iostreams::category_of<T>::type  category;
+        typedef typename unwrap_ios<T>::type              component_type;
+        if ( is_custom<component_type>::value ||
+             is_convertible<category, optimally_buffered_tag>::value )
+            return iostreams::optimal_buffer_size(t);
+        return is_device<component_type>::value ?
+            pimpl_->device_buffer_size_ :
+            pimpl_->filter_buffer_size_;
+    }
+
     list_type& list() { return pimpl_->links_; }
     const list_type& list() const { return pimpl_->links_; }
     void register_client(client_type* client) { pimpl_->client_ = client; }
@@ -0,0 +1,32 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+// Adapted from <boost/iostreams/detail/config/zlib.hpp>. Boost does not
+// build libzstd from source, so the binary is only linked automatically if
+// BOOST_ZSTD_BINARY names it.
+
+#ifndef BOOST_IOSTREAMS_DETAIL_CONFIG_ZSTD_HPP_INCLUDED
+#define BOOST_IOSTREAMS_DETAIL_CONFIG_ZSTD_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <boost/config.hpp> // BOOST_STRINGIZE.
+
+#if defined(BOOST_ZSTD_BINARY)
+# if defined(BOOST_MSVC) || \
+     defined(__BORLANDC__) || \
+     (defined(__MWERKS__) && defined(_WIN32) && (__MWERKS__ >= 0x3000)) || \
+     (defined(__ICL) && defined(_MSC_EXTENSIONS) && (_MSC_VER >= 1200)) \
+     /**/
+
+// Specify the name of the .lib file.
+#  pragma comment(lib, BOOST_STRINGIZE(BOOST_ZSTD_BINARY))
+# endif
+#endif
+
+#endif // #ifndef BOOST_IOSTREAMS_DETAIL_CONFIG_ZSTD_HPP_INCLUDED
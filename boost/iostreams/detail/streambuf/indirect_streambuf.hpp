@@ -87,7 +87,9 @@ protected:
 #endif
     int_type underflow();
     int_type pbackfail(int_type c);
+    std::streamsize xsgetn(char_type* s, std::streamsize n);
     int_type overflow(int_type c);
+    std::streamsize xsputn(const char_type* s, std::streamsize n);
     int sync();
     pos_type seekoff( off_type off, BOOST_IOS::seekdir way,
                       BOOST_IOS::openmode which );
@@ -280,6 +282,48 @@ indirect_streambuf<T, Tr, Alloc, Mode>::pbackfail(int_type c)
     }
 }
 
+// Reads of at least a full buffer go directly from the component into s,
+// so that data passed between links of a chain is copied once per link;
+// the putback buffer is refilled from s.
+template<typename T, typename Tr, typename Alloc, typename Mode>
+std::streamsize indirect_streambuf<T, Tr, Alloc, Mode>::xsgetn
+    (char_type* s, std::streamsize n)
+{
+    if (!can_read() || shared_buffer())
+        return base_type::xsgetn(s, n);
+    if (!gptr()) init_get_area();
+    buffer_type& buf = in();
+    std::streamsize size = buf.size() - pback_size_;
+    std::streamsize result =
+        (std::min)(static_cast<std::streamsize>(egptr() - gptr()), n);
+    traits_type::copy(s, gptr(), result);
+    gbump(static_cast<int>(result));
+    if (n - result < size)
+        return result + base_type::xsgetn(s + result, n - result);
+
+    // Read from source.
+    bool done = false;
+    while (!done && n - result >= size) {
+        std::streamsize chars = obj().read(s + result, n - result, next_);
+        if (chars == -1) {
+            this->set_true_eof(true);
+            chars = 0;
+        }
+        done = chars == 0;
+        result += chars;
+    }
+
+    // Fill putback buffer.
+    std::streamsize keep = (std::min)(result, pback_size_);
+    traits_type::copy(buf.data() + (pback_size_ - keep), s + result - keep, keep);
+    setg( buf.data() + pback_size_ - keep,
+          buf.data() + pback_size_,
+          buf.data() + pback_size_ );
+    return !done && result < n ?
+        result + base_type::xsgetn(s + result, n - result) :
+        result;
+}
+
 template<typename T, typename Tr, typename Alloc, typename Mode>
 typename indirect_streambuf<T, Tr, Alloc, Mode>::int_type
 indirect_streambuf<T, Tr, Alloc, Mode>::overflow(int_type c)
@@ -307,6 +351,25 @@ indirect_streambuf<T, Tr, Alloc, Mode>::overflow(int_type c)
     return traits_type::not_eof(c);
 }
 
+// Writes of at least a full buffer go directly to the component once the
+// buffer has been flushed, as do all writes if output is unbuffered.
+template<typename T, typename Tr, typename Alloc, typename Mode>
+std::streamsize indirect_streambuf<T, Tr, Alloc, Mode>::xsputn
+    (const char_type* s, std::streamsize n)
+{
+    if (!can_write() || shared_buffer())
+        return base_type::xsputn(s, n);
+    if (output_buffered()) {
+        if (pptr() == 0) init_put_area();
+        if (n < static_cast<std::streamsize>(out().size()))
+            return base_type::xsputn(s, n);
+        sync_impl();
+        if (pptr() != pbase())
+            return base_type::xsputn(s, n);
+    }
+    return obj().write(s, n, next_);
+}
+
 template<typename T, typename Tr, typename Alloc, typename Mode>
 int indirect_streambuf<T, Tr, Alloc, Mode>::sync()
 {
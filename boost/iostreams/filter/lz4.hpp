@@ -0,0 +1,297 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+// Note: as with the bzip2 filters, the allocator template parameter is only
+// used for the filter's buffer; liblz4 allocates its own memory.
+
+#ifndef BOOST_IOSTREAMS_LZ4_HPP_INCLUDED
+#define BOOST_IOSTREAMS_LZ4_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <cstddef>           // size_t.
+#include <memory>            // allocator.
+#include <string>
+#include <boost/config.hpp>  // MSVC, DEDUCED_TYPENAME.
+#include <boost/iostreams/constants.hpp>   // buffer size.
+#include <boost/iostreams/detail/config/auto_link.hpp>
+#include <boost/iostreams/detail/config/dyn_link.hpp>
+#include <boost/iostreams/detail/config/lz4.hpp>
+#include <boost/iostreams/detail/ios.hpp>  // failure, streamsize.
+#include <boost/iostreams/filter/symmetric.hpp>
+#include <boost/iostreams/pipeline.hpp>
+#include <boost/throw_exception.hpp>
+
+// Must come last.
+#ifdef BOOST_MSVC
+# pragma warning(push)
+# pragma warning(disable:4251 4231 4660)
+#endif
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost { namespace iostreams {
+
+namespace lz4 {
+
+                    // Compression levels
+
+BOOST_IOSTREAMS_DECL extern const int default_compression;
+BOOST_IOSTREAMS_DECL extern const int high_compression;
+BOOST_IOSTREAMS_DECL extern const int best_compression;
+
+                    // Block sizes
+
+BOOST_IOSTREAMS_DECL extern const int block_64k;
+BOOST_IOSTREAMS_DECL extern const int block_256k;
+BOOST_IOSTREAMS_DECL extern const int block_1m;
+BOOST_IOSTREAMS_DECL extern const int block_4m;
+BOOST_IOSTREAMS_DECL extern const int default_block_size;
+
+                    // Error codes
+
+BOOST_IOSTREAMS_DECL extern const int generic_error;
+BOOST_IOSTREAMS_DECL extern const int frame_type_unknown;
+BOOST_IOSTREAMS_DECL extern const int header_checksum_invalid;
+BOOST_IOSTREAMS_DECL extern const int block_checksum_invalid;
+BOOST_IOSTREAMS_DECL extern const int content_checksum_invalid;
+BOOST_IOSTREAMS_DECL extern const int decompression_failed;
+BOOST_IOSTREAMS_DECL extern const int unexpected_eof;
+
+} // End namespace lz4.
+
+//
+// Class name: lz4_params.
+// Description: Encapsulates the parameters used to configure liblz4.
+//      Levels from 3 select the high compression mode; negative levels
+//      trade compression for speed. The dictionary, if any, must
+//      be the same for compression and decompression, and requires
+//      lz4 1.10 or later.
+//
+struct lz4_params {
+
+    // Non-explicit constructor.
+    lz4_params( int level              = lz4::default_compression,
+                int block_size         = lz4::default_block_size,
+                bool checksum          = false,
+                const std::string& dictionary = std::string() )
+        : level(level), block_size(block_size), checksum(checksum),
+          dictionary(dictionary)
+        { }
+    int          level;
+    int          block_size;
+    bool         checksum;
+    std::string  dictionary;
+};
+
+//
+// Class name: lz4_error.
+// Description: Subclass of std::ios_base::failure thrown to indicate
+//     lz4 errors other than out-of-memory conditions.
+//
+class BOOST_IOSTREAMS_DECL lz4_error : public BOOST_IOSTREAMS_FAILURE {
+public:
+    explicit lz4_error(int error);
+    int error() const { return error_; }
+
+    // Throws if result is a liblz4 error code.
+    static void check BOOST_PREVENT_MACRO_SUBSTITUTION(std::size_t result);
+private:
+    int error_;
+};
+
+namespace detail {
+
+class BOOST_IOSTREAMS_DECL lz4_base {
+public:
+    typedef char char_type;
+protected:
+    lz4_base(bool compress, const lz4_params& params);
+    ~lz4_base();
+    bool& ready() { return ready_; }
+    void init();
+
+    // Returns true once the end of the frame has been written.
+    bool compress( const char*& src_begin, const char* src_end,
+                   char*& dest_begin, char* dest_end, bool flush );
+
+    // Returns zero at the end of a frame.
+    std::size_t decompress( const char*& src_begin, const char* src_end,
+                            char*& dest_begin, char* dest_end );
+    void reset();
+private:
+    lz4_params  params_;
+    void*       stream_;   // Actual type: lz4_stream*.
+    bool        compress_;
+    bool        ready_;
+};
+
+//
+// Template name: lz4_compressor_impl
+// Description: Model of SymmetricFilter implementing compression by
+//      delegating to the liblz4 function LZ4F_compressUpdate.
+//
+template<typename Alloc = std::allocator<char> >
+class lz4_compressor_impl : public lz4_base {
+public:
+    lz4_compressor_impl(const lz4_params& = lz4::default_compression);
+    bool filter( const char*& src_begin, const char* src_end,
+                 char*& dest_begin, char* dest_end, bool flush );
+    void close();
+private:
+    bool eof_; // Guard to make sure filter() isn't called after it returns false.
+};
+
+//
+// Template name: lz4_decompressor_impl
+// Description: Model of SymmetricFilter implementing decompression by
+//      delegating to the liblz4 function LZ4F_decompress.
+//
+template<typename Alloc = std::allocator<char> >
+class lz4_decompressor_impl : public lz4_base {
+public:
+    lz4_decompressor_impl(const lz4_params& = lz4_params());
+    bool filter( const char*& begin_in, const char* end_in,
+                 char*& begin_out, char* end_out, bool flush );
+    void close();
+private:
+    bool eof_; // True at the end of a frame.
+};
+
+} // End namespace detail.
+
+//
+// Template name: lz4_compressor
+// Description: Model of InputFilter and OutputFilter implementing
+//      compression in the lz4 frame format using liblz4.
+//
+template<typename Alloc = std::allocator<char> >
+struct basic_lz4_compressor
+    : symmetric_filter<detail::lz4_compressor_impl<Alloc>, Alloc>
+{
+private:
+    typedef detail::lz4_compressor_impl<Alloc>  impl_type;
+    typedef symmetric_filter<impl_type, Alloc>  base_type;
+public:
+    typedef typename base_type::char_type       char_type;
+    typedef typename base_type::category        category;
+    basic_lz4_compressor( const lz4_params& = lz4::default_compression,
+                          int buffer_size = default_device_buffer_size );
+};
+BOOST_IOSTREAMS_PIPABLE(basic_lz4_compressor, 1)
+
+typedef basic_lz4_compressor<> lz4_compressor;
+
+//
+// Template name: lz4_decompressor
+// Description: Model of InputFilter and OutputFilter implementing
+//      decompression of the lz4 frame format using liblz4.
+//
+template<typename Alloc = std::allocator<char> >
+struct basic_lz4_decompressor
+    : symmetric_filter<detail::lz4_decompressor_impl<Alloc>, Alloc>
+{
+private:
+    typedef detail::lz4_decompressor_impl<Alloc>  impl_type;
+    typedef symmetric_filter<impl_type, Alloc>    base_type;
+public:
+    typedef typename base_type::char_type         char_type;
+    typedef typename base_type::category          category;
+    basic_lz4_decompressor( const lz4_params& = lz4_params(),
+                            int buffer_size = default_device_buffer_size );
+};
+BOOST_IOSTREAMS_PIPABLE(basic_lz4_decompressor, 1)
+
+typedef basic_lz4_decompressor<> lz4_decompressor;
+
+//----------------------------------------------------------------------------//
+
+//------------------Implementation of lz4_compressor_impl---------------------//
+
+namespace detail {
+
+template<typename Alloc>
+lz4_compressor_impl<Alloc>::lz4_compressor_impl(const lz4_params& p)
+    : lz4_base(true, p), eof_(false) { }
+
+template<typename Alloc>
+bool lz4_compressor_impl<Alloc>::filter
+    ( const char*& src_begin, const char* src_end,
+      char*& dest_begin, char* dest_end, bool flush )
+{
+    if (!ready()) init();
+    if (eof_) return false;
+    return !(eof_ = compress(src_begin, src_end, dest_begin, dest_end, flush));
+}
+
+template<typename Alloc>
+void lz4_compressor_impl<Alloc>::close()
+{
+    eof_ = false;
+    reset();
+}
+
+//------------------Implementation of lz4_decompressor_impl-------------------//
+
+template<typename Alloc>
+lz4_decompressor_impl<Alloc>::lz4_decompressor_impl(const lz4_params& p)
+    : lz4_base(false, p), eof_(false) { }
+
+template<typename Alloc>
+bool lz4_decompressor_impl<Alloc>::filter
+    ( const char*& src_begin, const char* src_end,
+      char*& dest_begin, char* dest_end, bool flush )
+{
+    // liblz4 starts the next frame by itself if there are more characters
+    if (eof_ && src_begin == src_end)
+        return false;
+    if (!ready())
+        init();
+    const char* src = src_begin;
+    char* dest = dest_begin;
+    std::size_t result = decompress(src_begin, src_end, dest_begin, dest_end);
+    if (flush && result != 0 && src == src_begin && dest == dest_begin)
+        boost::throw_exception(lz4_error(lz4::unexpected_eof));
+    eof_ = result == 0;
+    return true;
+}
+
+template<typename Alloc>
+void lz4_decompressor_impl<Alloc>::close()
+{
+    eof_ = false;
+    reset();
+}
+
+} // End namespace detail.
+
+//------------------Implementation of lz4_compressor--------------------------//
+
+template<typename Alloc>
+basic_lz4_compressor<Alloc>::basic_lz4_compressor
+        (const lz4_params& p, int buffer_size)
+    : base_type(buffer_size, p)
+    { }
+
+//------------------Implementation of lz4_decompressor------------------------//
+
+template<typename Alloc>
+basic_lz4_decompressor<Alloc>::basic_lz4_decompressor
+        (const lz4_params& p, int buffer_size)
+    : base_type(buffer_size, p)
+    { }
+
+//----------------------------------------------------------------------------//
+
+} } // End namespaces iostreams, boost.
+
+#include <boost/config/abi_suffix.hpp> // Pops abi_suffix.hpp pragmas.
+#ifdef BOOST_MSVC
+# pragma warning(pop)
+#endif
+
+#endif // #ifndef BOOST_IOSTREAMS_LZ4_HPP_INCLUDED
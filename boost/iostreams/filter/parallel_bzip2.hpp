@@ -0,0 +1,79 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+// Contains the definition of the class parallel_bzip2_compressor, which
+// writes files in the bzip2 format compressing blocks of the input in
+// several threads, like pbzip2. Each block is written as a complete bzip2
+// stream; bzip2 decompressors, including bzip2_decompressor, read the
+// concatenated streams as a single file.
+
+#ifndef BOOST_IOSTREAMS_PARALLEL_BZIP2_HPP_INCLUDED
+#define BOOST_IOSTREAMS_PARALLEL_BZIP2_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <cstddef>                                  // size_t.
+#include <string>
+#include <boost/iostreams/detail/config/auto_link.hpp>
+#include <boost/iostreams/detail/config/bzip2.hpp>
+#include <boost/iostreams/detail/config/dyn_link.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>         // bzip2_params.
+#include <boost/iostreams/filter/parallel_compressor.hpp>
+
+// Must come last.
+#include <boost/iostreams/detail/config/disable_warnings.hpp>  // MSVC.
+
+namespace boost { namespace iostreams {
+
+namespace detail {
+
+//
+// Class name: parallel_bzip2_codec.
+// Description: Model of Parallel Codec implementing the bzip2 format.
+//
+class BOOST_IOSTREAMS_DECL parallel_bzip2_codec {
+public:
+    typedef bzip2_params params_type;
+    explicit parallel_bzip2_codec(const bzip2_params& p) : params_(p) { }
+    std::size_t default_block_size() const
+    { return static_cast<std::size_t>(params_.block_size) * 100000; }
+    std::size_t dictionary_size() const { return 0; }
+    bool needs_last_block() const { return false; }
+    void header(std::string&) { }
+    void compress(parallel_block& b) const;
+    void consume(const parallel_block& b);
+    void trailer(std::string&) { }
+private:
+    bzip2_params  params_;
+};
+
+} // End namespace detail.
+
+//
+// Class name: parallel_bzip2_compressor.
+// Description: Model of OutputFilter implementing compression in the
+//      bzip2 format in several threads.
+//
+class parallel_bzip2_compressor
+    : public parallel_compressor<detail::parallel_bzip2_codec>
+{
+private:
+    typedef parallel_compressor<detail::parallel_bzip2_codec> base_type;
+public:
+    parallel_bzip2_compressor( const bzip2_params& p = bzip2::default_block_size,
+                               const parallel_params& pp = parallel_params() )
+        : base_type(p, pp)
+        { }
+};
+BOOST_IOSTREAMS_PIPABLE(parallel_bzip2_compressor, 0)
+
+} } // End namespaces iostreams, boost.
+
+#include <boost/iostreams/detail/config/enable_warnings.hpp>
+
+#endif // #ifndef BOOST_IOSTREAMS_PARALLEL_BZIP2_HPP_INCLUDED
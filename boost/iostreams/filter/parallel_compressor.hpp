@@ -0,0 +1,367 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+// Contains the definition of the class template parallel_compressor, which
+// models OutputFilter by splitting its input into blocks which are compressed
+// by a pool of threads and written to the sink in their original order.
+//
+// The compression format is defined by a Parallel Codec with the following
+// interface:
+//
+//   struct parallel_codec {
+//       typedef xxx params_type;
+//       explicit parallel_codec(const params_type&);
+//
+//       // Block size used if parallel_params::block_size is zero.
+//       std::size_t default_block_size() const;
+//
+//       // Number of trailing bytes of the previous block passed to
+//       // compress() as a preset dictionary.
+//       std::size_t dictionary_size() const;
+//
+//       // True if the stream must end with a block marked as last, even
+//       // if it is empty.
+//       bool needs_last_block() const;
+//
+//       // Appends the bytes preceding the first block to out and
+//       // prepares the codec for a new stream.
+//       void header(std::string& out);
+//
+//       // Called concurrently by the worker threads: compresses
+//       // b.input into b.output, or stores an error code in b.error.
+//       void compress(parallel_block& b) const;
+//
+//       // Called in stream order, before b.output is written: updates
+//       // checksums and throws if b.error is non-zero.
+//       void consume(const parallel_block& b);
+//
+//       // Appends the bytes following the last block to out.
+//       void trailer(std::string& out);
+//   };
+//
+
+#ifndef BOOST_IOSTREAMS_PARALLEL_COMPRESSOR_HPP_INCLUDED
+#define BOOST_IOSTREAMS_PARALLEL_COMPRESSOR_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <algorithm>                            // min, copy.
+#include <cstddef>                              // size_t.
+#include <deque>
+#include <new>                                  // bad_alloc.
+#include <string>
+#include <vector>
+#include <boost/config.hpp>                     // BOOST_DEDUCED_TYPENAME.
+#include <boost/cstdint.hpp>                    // uint32_t.
+#include <boost/iostreams/categories.hpp>
+#include <boost/iostreams/operations.hpp>       // write.
+#include <boost/iostreams/pipeline.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/throw_exception.hpp>
+
+// Must come last.
+#include <boost/iostreams/detail/config/disable_warnings.hpp>  // MSVC.
+
+namespace boost { namespace iostreams {
+
+//------------------Definition of parallel_params-----------------------------//
+
+//
+// Class name: parallel_params.
+// Description: Encapsulates the parameters of a parallel compressor.
+//      A zero block_size selects the default block size of the format;
+//      zero threads selects the number of hardware threads.
+//
+struct parallel_params {
+
+    // Non-explicit constructor.
+    parallel_params( std::size_t block_size = 0,
+                     unsigned int threads = 0 )
+        : block_size(block_size), threads(threads)
+        { }
+    std::size_t   block_size;
+    unsigned int  threads;
+};
+
+//------------------Definition of parallel_block------------------------------//
+
+//
+// Class name: parallel_block.
+// Description: A block of data compressed by one of the worker threads of
+//      a parallel_compressor.
+//
+struct parallel_block {
+    parallel_block() : last(false), done(false), out_of_memory(false),
+                       error(0), check(0) { }
+    std::vector<char>  input;
+    std::vector<char>  dictionary;
+    std::vector<char>  output;
+    bool               last;
+    bool               done;
+    bool               out_of_memory;
+    int                error;
+    boost::uint32_t    check;
+};
+
+//------------------Definition of parallel_compressor-------------------------//
+
+//
+// Template name: parallel_compressor.
+// Template parameters:
+//      Codec - A model of Parallel Codec.
+// Description: Model of OutputFilter which compresses blocks of its input
+//      in a pool of worker threads and writes the compressed blocks in
+//      order. Copies of a parallel_compressor share the same state.
+//
+template<typename Codec>
+class parallel_compressor {
+public:
+    typedef char                                     char_type;
+    typedef typename Codec::params_type              params_type;
+    struct category
+        : output,
+          filter_tag,
+          multichar_tag,
+          closable_tag
+        { };
+    explicit parallel_compressor( const params_type& p = params_type(),
+                                  const parallel_params& pp = parallel_params() )
+        : pimpl_(new impl(p, pp))
+        { }
+
+    template<typename Sink>
+    std::streamsize write(Sink& snk, const char_type* s, std::streamsize n)
+    {
+        impl& i = *pimpl_;
+        i.write_header(snk);
+        std::streamsize result = n;
+        while (n > 0) {
+            std::size_t amt =
+                (std::min)( static_cast<std::size_t>(n),
+                            i.block_size_ - i.current_.size() );
+            i.current_.insert(i.current_.end(), s, s + amt);
+            s += amt;
+            n -= static_cast<std::streamsize>(amt);
+            if (i.current_.size() == i.block_size_) {
+                i.submit(false);
+                i.write_blocks(snk, false);
+            }
+        }
+        return result;
+    }
+
+    template<typename Sink>
+    void close(Sink& snk)
+    {
+        impl& i = *pimpl_;
+        try {
+            i.write_header(snk);
+            if ( !i.current_.empty() || !i.submitted_ ||
+                 i.codec_.needs_last_block() )
+            {
+                i.submit(true);
+            }
+            i.write_blocks(snk, true);
+            std::string trailer;
+            i.codec_.trailer(trailer);
+            i.write_string(snk, trailer);
+        } catch (...) {
+            i.reset();
+            throw;
+        }
+        i.reset();
+    }
+private:
+    typedef boost::shared_ptr<parallel_block>  block_ptr;
+    struct impl {
+        impl(const params_type& p, const parallel_params& pp)
+            : codec_(p),
+              block_size_(pp.block_size ? pp.block_size : codec_.default_block_size()),
+              threads_(pp.threads ? pp.threads : boost::thread::hardware_concurrency()),
+              stop_(false), header_done_(false), submitted_(false)
+        {
+            if (!threads_)
+                threads_ = 1;
+        }
+        ~impl()
+        {
+            {
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            work_cond_.notify_all();
+            workers_.join_all();
+        }
+
+        template<typename Sink>
+        void write_string(Sink& snk, const std::string& s)
+        { write_buffer(snk, s.data(), s.size()); }
+
+        template<typename Sink>
+        void write_buffer(Sink& snk, const char* s, std::size_t n)
+        {
+            while (n > 0) {
+                std::streamsize amt =
+                    iostreams::write(snk, s, static_cast<std::streamsize>(n));
+                s += amt;
+                n -= static_cast<std::size_t>(amt);
+            }
+        }
+
+        template<typename Sink>
+        void write_header(Sink& snk)
+        {
+            if (!header_done_) {
+                std::string header;
+                codec_.header(header);
+                write_string(snk, header);
+                header_done_ = true;
+            }
+        }
+
+        // Hands the current block to the worker threads.
+        void submit(bool last)
+        {
+            block_ptr b(new parallel_block);
+            b->input.swap(current_);
+            b->last = last;
+            std::size_t dict = codec_.dictionary_size();
+            if (dict) {
+                b->dictionary.swap(dictionary_);
+                std::size_t size = b->input.size();
+                const char* end = size ? &b->input[0] + size : 0;
+                if (size >= dict) {
+                    dictionary_.assign(end - dict, end);
+                } else {
+                    // Keep the tail of the previous dictionary
+                    std::size_t keep =
+                        (std::min)(dict - size, b->dictionary.size());
+                    dictionary_.assign( b->dictionary.end() - keep,
+                                        b->dictionary.end() );
+                    dictionary_.insert(dictionary_.end(), end - size, end);
+                }
+            }
+            current_.reserve(block_size_);
+            {
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                if (workers_.size() == 0) {
+                    for (unsigned int i = 0; i < threads_; ++i)
+                        workers_.create_thread(worker(*this));
+                }
+                queue_.push_back(b);
+                pending_.push_back(b);
+            }
+            submitted_ = true;
+            work_cond_.notify_one();
+        }
+
+        // Writes compressed blocks in order. Waits for all pending blocks
+        // if all is true, otherwise only while too many blocks are pending.
+        template<typename Sink>
+        void write_blocks(Sink& snk, bool all)
+        {
+            const std::size_t max_pending = 2 * threads_;
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (!pending_.empty()) {
+                block_ptr b = pending_.front();
+                if (!b->done) {
+                    if (!all && pending_.size() <= max_pending)
+                        break;
+                    done_cond_.wait(lock);
+                    continue;
+                }
+                pending_.pop_front();
+                lock.unlock();
+                if (b->out_of_memory)
+                    boost::throw_exception(std::bad_alloc());
+                codec_.consume(*b);
+                if (!b->output.empty())
+                    write_buffer(snk, &b->output[0], b->output.size());
+                lock.lock();
+            }
+        }
+
+        // Discards pending blocks and prepares for a new stream.
+        void reset()
+        {
+            {
+                boost::unique_lock<boost::mutex> lock(mutex_);
+                for ( typename std::deque<block_ptr>::iterator it = queue_.begin();
+                      it != queue_.end(); ++it )
+                {
+                    (*it)->done = true;
+                }
+                queue_.clear();
+                while (!pending_.empty()) {
+                    if (pending_.front()->done)
+                        pending_.pop_front();
+                    else
+                        done_cond_.wait(lock);
+                }
+            }
+            current_.clear();
+            dictionary_.clear();
+            header_done_ = false;
+            submitted_ = false;
+        }
+
+        struct worker {
+            explicit worker(impl& i) : impl_(&i) { }
+            void operator()() const
+            {
+                impl& i = *impl_;
+                boost::unique_lock<boost::mutex> lock(i.mutex_);
+                while (true) {
+                    while (i.queue_.empty() && !i.stop_)
+                        i.work_cond_.wait(lock);
+                    if (i.queue_.empty())
+                        return;
+                    block_ptr b = i.queue_.front();
+                    i.queue_.pop_front();
+                    lock.unlock();
+                    try {
+                        i.codec_.compress(*b);
+                    } catch (const std::bad_alloc&) {
+                        b->out_of_memory = true;
+                    }
+                    lock.lock();
+                    b->done = true;
+                    i.done_cond_.notify_all();
+                }
+            }
+            impl* impl_;
+        };
+
+        Codec                      codec_;
+        std::size_t                block_size_;
+        unsigned int               threads_;
+        boost::mutex               mutex_;
+        boost::condition_variable  work_cond_;
+        boost::condition_variable  done_cond_;
+        std::deque<block_ptr>      queue_;    // Blocks waiting for a worker.
+        std::deque<block_ptr>      pending_;  // Blocks not written, in order.
+        boost::thread_group        workers_;
+        bool                       stop_;
+        std::vector<char>          current_;
+        std::vector<char>          dictionary_;
+        bool                       header_done_;
+        bool                       submitted_;
+    };
+    shared_ptr<impl> pimpl_;
+};
+BOOST_IOSTREAMS_PIPABLE(parallel_compressor, 1)
+
+} } // End namespaces iostreams, boost.
+
+#include <boost/iostreams/detail/config/enable_warnings.hpp>
+
+#endif // #ifndef BOOST_IOSTREAMS_PARALLEL_COMPRESSOR_HPP_INCLUDED
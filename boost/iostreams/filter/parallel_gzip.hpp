@@ -0,0 +1,81 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+// Contains the definition of the class parallel_gzip_compressor, which
+// writes files in the gzip format (RFC 1952) compressing blocks of the
+// input in several threads, like pigz. The output is a single gzip member
+// that any gzip decompressor can read: each block is a raw deflate stream
+// primed with the last 32KB of the previous block and ended with a sync
+// flush, so the blocks can be concatenated.
+
+#ifndef BOOST_IOSTREAMS_PARALLEL_GZIP_HPP_INCLUDED
+#define BOOST_IOSTREAMS_PARALLEL_GZIP_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <cstddef>                                  // size_t.
+#include <string>
+#include <boost/cstdint.hpp>                        // uint32_t.
+#include <boost/iostreams/detail/config/auto_link.hpp>
+#include <boost/iostreams/detail/config/dyn_link.hpp>
+#include <boost/iostreams/filter/gzip.hpp>          // gzip_params.
+#include <boost/iostreams/filter/parallel_compressor.hpp>
+
+// Must come last.
+#include <boost/iostreams/detail/config/disable_warnings.hpp>  // MSVC.
+
+namespace boost { namespace iostreams {
+
+namespace detail {
+
+//
+// Class name: parallel_gzip_codec.
+// Description: Model of Parallel Codec implementing the gzip format.
+//
+class BOOST_IOSTREAMS_DECL parallel_gzip_codec {
+public:
+    typedef gzip_params params_type;
+    explicit parallel_gzip_codec(const gzip_params& p);
+    std::size_t default_block_size() const { return 128 * 1024; }
+    std::size_t dictionary_size() const;
+    bool needs_last_block() const { return true; }
+    void header(std::string& out);
+    void compress(parallel_block& b) const;
+    void consume(const parallel_block& b);
+    void trailer(std::string& out);
+private:
+    gzip_params      params_;
+    boost::uint32_t  crc_;
+    boost::uint32_t  length_;
+};
+
+} // End namespace detail.
+
+//
+// Class name: parallel_gzip_compressor.
+// Description: Model of OutputFilter implementing compression in the
+//      gzip format in several threads.
+//
+class parallel_gzip_compressor
+    : public parallel_compressor<detail::parallel_gzip_codec>
+{
+private:
+    typedef parallel_compressor<detail::parallel_gzip_codec> base_type;
+public:
+    parallel_gzip_compressor( const gzip_params& p = gzip::default_compression,
+                              const parallel_params& pp = parallel_params() )
+        : base_type(p, pp)
+        { }
+};
+BOOST_IOSTREAMS_PIPABLE(parallel_gzip_compressor, 0)
+
+} } // End namespaces iostreams, boost.
+
+#include <boost/iostreams/detail/config/enable_warnings.hpp>
+
+#endif // #ifndef BOOST_IOSTREAMS_PARALLEL_GZIP_HPP_INCLUDED
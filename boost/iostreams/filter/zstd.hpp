@@ -0,0 +1,295 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+// Note: as with the bzip2 filters, the allocator template parameter is only
+// used for the filter's buffer; libzstd allocates its own memory.
+
+#ifndef BOOST_IOSTREAMS_ZSTD_HPP_INCLUDED
+#define BOOST_IOSTREAMS_ZSTD_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <cstddef>           // size_t.
+#include <memory>            // allocator.
+#include <string>
+#include <boost/config.hpp>  // MSVC, DEDUCED_TYPENAME.
+#include <boost/iostreams/constants.hpp>   // buffer size.
+#include <boost/iostreams/detail/config/auto_link.hpp>
+#include <boost/iostreams/detail/config/dyn_link.hpp>
+#include <boost/iostreams/detail/config/zstd.hpp>
+#include <boost/iostreams/detail/ios.hpp>  // failure, streamsize.
+#include <boost/iostreams/filter/symmetric.hpp>
+#include <boost/iostreams/pipeline.hpp>
+#include <boost/throw_exception.hpp>
+
+// Must come last.
+#ifdef BOOST_MSVC
+# pragma warning(push)
+# pragma warning(disable:4251 4231 4660)
+#endif
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost { namespace iostreams {
+
+namespace zstd {
+
+                    // Compression levels
+
+BOOST_IOSTREAMS_DECL extern const int best_speed;
+BOOST_IOSTREAMS_DECL extern const int best_compression;
+BOOST_IOSTREAMS_DECL extern const int default_compression;
+
+                    // Error codes
+
+BOOST_IOSTREAMS_DECL extern const int generic_error;
+BOOST_IOSTREAMS_DECL extern const int prefix_unknown;
+BOOST_IOSTREAMS_DECL extern const int frame_parameter_unsupported;
+BOOST_IOSTREAMS_DECL extern const int corruption_detected;
+BOOST_IOSTREAMS_DECL extern const int checksum_wrong;
+BOOST_IOSTREAMS_DECL extern const int dictionary_wrong;
+BOOST_IOSTREAMS_DECL extern const int parameter_unsupported;
+BOOST_IOSTREAMS_DECL extern const int unexpected_eof;
+
+                    // Flush codes
+
+BOOST_IOSTREAMS_DECL extern const int run;
+BOOST_IOSTREAMS_DECL extern const int finish;
+
+} // End namespace zstd.
+
+//
+// Class name: zstd_params.
+// Description: Encapsulates the parameters used to configure libzstd.
+//      The dictionary, if any, must be the same for compression and
+//      decompression; it may be a dictionary trained by zstd --train or
+//      arbitrary content used as a prefix.
+//
+struct zstd_params {
+
+    // Non-explicit constructor.
+    zstd_params( int level              = zstd::default_compression,
+                 bool checksum          = false,
+                 const std::string& dictionary = std::string() )
+        : level(level), checksum(checksum), dictionary(dictionary)
+        { }
+    int          level;
+    bool         checksum;
+    std::string  dictionary;
+};
+
+//
+// Class name: zstd_error.
+// Description: Subclass of std::ios_base::failure thrown to indicate
+//     zstd errors other than out-of-memory conditions.
+//
+class BOOST_IOSTREAMS_DECL zstd_error : public BOOST_IOSTREAMS_FAILURE {
+public:
+    explicit zstd_error(int error);
+    int error() const { return error_; }
+
+    // Throws if result is a libzstd error code.
+    static void check BOOST_PREVENT_MACRO_SUBSTITUTION(std::size_t result);
+private:
+    int error_;
+};
+
+namespace detail {
+
+class BOOST_IOSTREAMS_DECL zstd_base {
+public:
+    typedef char char_type;
+protected:
+    zstd_base(bool compress, const zstd_params& params);
+    ~zstd_base();
+    bool& ready() { return ready_; }
+    void init();
+    void before( const char*& src_begin, const char* src_end,
+                 char*& dest_begin, char* dest_end );
+    void after(const char*& src_begin, char*& dest_begin);
+    bool no_progress() const;
+    std::size_t compress(int flush);
+    std::size_t decompress();
+    void reset();
+private:
+    zstd_params  params_;
+    void*        stream_;   // Actual type: zstd_stream*.
+    bool         compress_;
+    bool         ready_;
+};
+
+//
+// Template name: zstd_compressor_impl
+// Description: Model of SymmetricFilter implementing compression by
+//      delegating to the libzstd function ZSTD_compressStream2.
+//
+template<typename Alloc = std::allocator<char> >
+class zstd_compressor_impl : public zstd_base {
+public:
+    zstd_compressor_impl(const zstd_params& = zstd::default_compression);
+    bool filter( const char*& src_begin, const char* src_end,
+                 char*& dest_begin, char* dest_end, bool flush );
+    void close();
+private:
+    bool eof_; // Guard to make sure filter() isn't called after it returns false.
+};
+
+//
+// Template name: zstd_decompressor_impl
+// Description: Model of SymmetricFilter implementing decompression by
+//      delegating to the libzstd function ZSTD_decompressStream.
+//
+template<typename Alloc = std::allocator<char> >
+class zstd_decompressor_impl : public zstd_base {
+public:
+    zstd_decompressor_impl(const zstd_params& = zstd_params());
+    bool filter( const char*& begin_in, const char* end_in,
+                 char*& begin_out, char* end_out, bool flush );
+    void close();
+private:
+    bool eof_; // True at the end of a frame.
+};
+
+} // End namespace detail.
+
+//
+// Template name: zstd_compressor
+// Description: Model of InputFilter and OutputFilter implementing
+//      compression using libzstd.
+//
+template<typename Alloc = std::allocator<char> >
+struct basic_zstd_compressor
+    : symmetric_filter<detail::zstd_compressor_impl<Alloc>, Alloc>
+{
+private:
+    typedef detail::zstd_compressor_impl<Alloc>  impl_type;
+    typedef symmetric_filter<impl_type, Alloc>   base_type;
+public:
+    typedef typename base_type::char_type        char_type;
+    typedef typename base_type::category         category;
+    basic_zstd_compressor( const zstd_params& = zstd::default_compression,
+                           int buffer_size = default_device_buffer_size );
+};
+BOOST_IOSTREAMS_PIPABLE(basic_zstd_compressor, 1)
+
+typedef basic_zstd_compressor<> zstd_compressor;
+
+//
+// Template name: zstd_decompressor
+// Description: Model of InputFilter and OutputFilter implementing
+//      decompression using libzstd.
+//
+template<typename Alloc = std::allocator<char> >
+struct basic_zstd_decompressor
+    : symmetric_filter<detail::zstd_decompressor_impl<Alloc>, Alloc>
+{
+private:
+    typedef detail::zstd_decompressor_impl<Alloc>  impl_type;
+    typedef symmetric_filter<impl_type, Alloc>     base_type;
+public:
+    typedef typename base_type::char_type          char_type;
+    typedef typename base_type::category           category;
+    basic_zstd_decompressor( const zstd_params& = zstd_params(),
+                             int buffer_size = default_device_buffer_size );
+};
+BOOST_IOSTREAMS_PIPABLE(basic_zstd_decompressor, 1)
+
+typedef basic_zstd_decompressor<> zstd_decompressor;
+
+//----------------------------------------------------------------------------//
+
+//------------------Implementation of zstd_compressor_impl--------------------//
+
+namespace detail {
+
+template<typename Alloc>
+zstd_compressor_impl<Alloc>::zstd_compressor_impl(const zstd_params& p)
+    : zstd_base(true, p), eof_(false) { }
+
+template<typename Alloc>
+bool zstd_compressor_impl<Alloc>::filter
+    ( const char*& src_begin, const char* src_end,
+      char*& dest_begin, char* dest_end, bool flush )
+{
+    if (!ready()) init();
+    if (eof_) return false;
+    before(src_begin, src_end, dest_begin, dest_end);
+    std::size_t result = compress(flush ? zstd::finish : zstd::run);
+    after(src_begin, dest_begin);
+    zstd_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(result);
+    return !(eof_ = flush && result == 0);
+}
+
+template<typename Alloc>
+void zstd_compressor_impl<Alloc>::close()
+{
+    eof_ = false;
+    reset();
+}
+
+//------------------Implementation of zstd_decompressor_impl------------------//
+
+template<typename Alloc>
+zstd_decompressor_impl<Alloc>::zstd_decompressor_impl(const zstd_params& p)
+    : zstd_base(false, p), eof_(false) { }
+
+template<typename Alloc>
+bool zstd_decompressor_impl<Alloc>::filter
+    ( const char*& src_begin, const char* src_end,
+      char*& dest_begin, char* dest_end, bool flush )
+{
+    // libzstd starts the next frame by itself if there are more characters
+    if (eof_ && src_begin == src_end)
+        return false;
+    if (!ready())
+        init();
+    before(src_begin, src_end, dest_begin, dest_end);
+    std::size_t result = decompress();
+    bool truncated = flush && result != 0 && no_progress();
+    after(src_begin, dest_begin);
+    zstd_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(result);
+    if (truncated)
+        boost::throw_exception(zstd_error(zstd::unexpected_eof));
+    eof_ = result == 0;
+    return true;
+}
+
+template<typename Alloc>
+void zstd_decompressor_impl<Alloc>::close()
+{
+    eof_ = false;
+    reset();
+}
+
+} // End namespace detail.
+
+//------------------Implementation of zstd_compressor-------------------------//
+
+template<typename Alloc>
+basic_zstd_compressor<Alloc>::basic_zstd_compressor
+        (const zstd_params& p, int buffer_size)
+    : base_type(buffer_size, p)
+    { }
+
+//------------------Implementation of zstd_decompressor-----------------------//
+
+template<typename Alloc>
+basic_zstd_decompressor<Alloc>::basic_zstd_decompressor
+        (const zstd_params& p, int buffer_size)
+    : base_type(buffer_size, p)
+    { }
+
+//----------------------------------------------------------------------------//
+
+} } // End namespaces iostreams, boost.
+
+#include <boost/config/abi_suffix.hpp> // Pops abi_suffix.hpp pragmas.
+#ifdef BOOST_MSVC
+# pragma warning(pop)
+#endif
+
+#endif // #ifndef BOOST_IOSTREAMS_ZSTD_HPP_INCLUDED
@@ -15,6 +15,7 @@
 #ifndef BOOST_LOG_CORE_CORE_HPP_INCLUDED_
 #define BOOST_LOG_CORE_CORE_HPP_INCLUDED_
 
+#include <string>
 #include <utility>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/move/core.hpp>
@@ -44,6 +45,12 @@ class sink;
 
 } // namespace sinks
 
+namespace aux {
+
+struct module_severity_threshold;
+
+} // namespace aux
+
 #endif // BOOST_LOG_DOXYGEN_PASS
 
 class core;
@@ -57,6 +64,12 @@ typedef shared_ptr< core > core_ptr;
  * a number of basic features, like global filtering and global and thread-specific attribute storage.
  *
  * The logging core is a singleton. Users can acquire the core instance by calling the static method <tt>get</tt>.
+ *
+ * Threads that write log records do not lock the core. Instead, they use an immutable snapshot of the core
+ * configuration, which includes the sinks, the global filter and the global attributes. Every modification
+ * of the configuration publishes a new snapshot and waits until the threads that are opening records with
+ * the previous snapshot complete. Therefore, when a method that modifies the configuration returns, no new
+ * log records are opened with the previous configuration.
  */
 class core
 {
@@ -111,6 +124,53 @@ public:
      */
     BOOST_LOG_API bool get_logging_enabled() const;
 
+    /*!
+     * The method sets the severity level threshold. Severity loggers with integral or enumeration severity level
+     * types discard log records with levels below the threshold before any attribute values are acquired or filters
+     * are invoked. Unlike filters, the threshold check involves only a single atomic read, which makes disabled
+     * log statements cheap.
+     *
+     * By default there is no threshold.
+     *
+     * \param level The minimum severity level of log records, converted to \c int.
+     */
+    BOOST_LOG_API void set_severity_threshold(int level);
+    /*!
+     * The method removes the severity level threshold.
+     */
+    BOOST_LOG_API void reset_severity_threshold();
+    /*!
+     * The method returns the current severity level threshold. If no threshold is set, returns the minimum value of \c int.
+     */
+    BOOST_LOG_API int get_severity_threshold() const;
+
+    /*!
+     * The method sets the severity level threshold for the named module. Severity loggers that were constructed
+     * with the \c module named argument equal to \a module discard log records with levels below this threshold,
+     * regardless of the global threshold. The check costs the same as the check of the global threshold.
+     *
+     * \param module The module name.
+     * \param level The minimum severity level of log records, converted to \c int.
+     */
+    BOOST_LOG_API void set_severity_threshold(std::string const& module, int level);
+    /*!
+     * The method removes the severity level threshold of the named module. Loggers of the module will use
+     * the global threshold.
+     */
+    BOOST_LOG_API void reset_severity_threshold(std::string const& module);
+    /*!
+     * The method returns the severity level threshold that is applied to the loggers of the named module.
+     * If no threshold is set for the module, returns the global threshold.
+     */
+    BOOST_LOG_API int get_severity_threshold(std::string const& module) const;
+
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    //! The method returns the threshold of the named module, registering the module if needed. For internal use only.
+    BOOST_LOG_API aux::module_severity_threshold const* get_module_severity_threshold(std::string const& module);
+    //! The method returns the severity level threshold that applies to the module. For internal use only.
+    BOOST_LOG_API int get_severity_threshold(aux::module_severity_threshold const* module) const;
+#endif // BOOST_LOG_DOXYGEN_PASS
+
     /*!
      * The method sets the global logging filter. The filter is applied to every log record that is processed.
      *
@@ -145,7 +205,7 @@ public:
      * The method performs flush on all registered sinks.
      *
      * \note This method may take long time to complete as it may block until all sinks manage to process all buffered log records.
-     *       The call will also block all logging attempts until the operation completes.
+     *       Log records that are made while the operation is in progress may or may not be flushed.
      */
     BOOST_LOG_API void flush();
 
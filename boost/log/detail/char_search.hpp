@@ -0,0 +1,96 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   char_search.hpp
+ * \author Andrey Semashev
+ * \date   25.07.2015
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/doc/libs/release/libs/log/doc/html/index.html.
+ */
+
+#ifndef BOOST_LOG_DETAIL_CHAR_SEARCH_HPP_INCLUDED_
+#define BOOST_LOG_DETAIL_CHAR_SEARCH_HPP_INCLUDED_
+
+#include <cstddef>
+#include <cstring>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+/*!
+ * A set of characters to search for. A character belongs to the set if the masks selected by its low and high
+ * nibbles have a common bit. Every distinct high nibble of the set characters is assigned its own bit,
+ * therefore the set can contain characters with up to 8 distinct high nibbles.
+ */
+struct char_search_set
+{
+    //! Bit masks indexed by the low nibble of a character
+    unsigned char low_nibble_masks[16];
+    //! Bit masks indexed by the high nibble of a character
+    unsigned char high_nibble_masks[16];
+
+    //! Checks if the character code belongs to the set
+    bool contains(unsigned int c) const
+    {
+        return c < 256u && (low_nibble_masks[c & 0x0Fu] & high_nibble_masks[c >> 4]) != 0u;
+    }
+};
+
+/*!
+ * The function initializes the set with the characters. Returns \c false if the characters cannot be represented by the set.
+ */
+template< typename CharT >
+inline bool init_char_search_set(char_search_set& set, const CharT* chars, std::size_t count)
+{
+    std::memset(&set, 0, sizeof(set));
+    unsigned int next_bit = 1u;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const unsigned int c = static_cast< unsigned int >(chars[i]) & (sizeof(CharT) == 1u ? 0xFFu : ~0u);
+        if (c >= 256u)
+            return false;
+
+        unsigned char& high_mask = set.high_nibble_masks[c >> 4];
+        if (high_mask == 0u)
+        {
+            if (next_bit > 0x80u)
+                return false;
+            high_mask = static_cast< unsigned char >(next_bit);
+            next_bit <<= 1;
+        }
+        set.low_nibble_masks[c & 0x0Fu] |= high_mask;
+    }
+
+    return true;
+}
+
+/*!
+ * The function returns a pointer to the first character in [begin, end) that belongs to the set, or \a end if there is none.
+ * The pointer is initialized to an implementation that is optimal for the current CPU.
+ */
+typedef const char* find_first_of_char_t(const char* begin, const char* end, char_search_set const& set);
+extern BOOST_LOG_API find_first_of_char_t* find_first_of_char;
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_DETAIL_CHAR_SEARCH_HPP_INCLUDED_
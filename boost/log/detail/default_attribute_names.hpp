@@ -39,6 +39,7 @@ BOOST_LOG_API attribute_name line_id();
 BOOST_LOG_API attribute_name timestamp();
 BOOST_LOG_API attribute_name process_id();
 BOOST_LOG_API attribute_name thread_id();
+BOOST_LOG_API attribute_name suppressed();
 
 } // namespace default_attribute_names
 
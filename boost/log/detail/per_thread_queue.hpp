@@ -0,0 +1,99 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   per_thread_queue.hpp
+ * \author Andrey Semashev
+ * \date   21.06.2015
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/doc/libs/release/libs/log/doc/html/index.html.
+ */
+
+#ifndef BOOST_LOG_DETAIL_PER_THREAD_QUEUE_HPP_INCLUDED_
+#define BOOST_LOG_DETAIL_PER_THREAD_QUEUE_HPP_INCLUDED_
+
+#include <boost/log/detail/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#ifndef BOOST_LOG_NO_THREADS
+
+#include <cstddef>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+/*!
+ * \brief A log record queue made of per-thread rings
+ *
+ * Every thread that pushes records to the queue is given its own bounded single-producer
+ * single-consumer ring, so that producers never contend with each other. Each record is
+ * marked with a timestamp when it is pushed. The consumer merges the rings by picking the
+ * oldest record at the heads of the rings, which preserves the order of records made by
+ * every thread and approximates the global order of records.
+ *
+ * Any number of threads may push records concurrently, but only one thread at a time may pop them.
+ * Rings of the threads that have terminated are released once they are drained.
+ */
+class per_thread_record_queue
+{
+private:
+    struct implementation;
+
+private:
+    //! Queue implementation
+    implementation* m_pImpl;
+
+public:
+    /*!
+     * Constructor
+     *
+     * \param ring_capacity Capacity of every ring, in records. Will be rounded up to a power of 2.
+     */
+    BOOST_LOG_API explicit per_thread_record_queue(std::size_t ring_capacity);
+    //! Destructor
+    BOOST_LOG_API ~per_thread_record_queue();
+
+    //! Pushes a record to the ring of the current thread. Returns \c false if the ring is full.
+    BOOST_LOG_API bool try_push(record_view const& rec);
+    //! Pops the oldest record from the rings. Returns \c false if all rings are empty.
+    BOOST_LOG_API bool try_pop(record_view& rec);
+    //! Pops the oldest record from the rings, blocks if all rings are empty. Returns \c false if interrupted.
+    BOOST_LOG_API bool pop(record_view& rec);
+    //! Wakes the thread blocked in the \c pop method
+    BOOST_LOG_API void interrupt();
+
+    //! Registers a producer that is about to block because its ring is full
+    BOOST_LOG_API void add_blocked_producer();
+    //! Unregisters a blocked producer
+    BOOST_LOG_API void remove_blocked_producer();
+    //! Returns the number of blocked producers. Must be called by the consumer after popping a record.
+    BOOST_LOG_API std::size_t blocked_producers() const;
+
+    //  Copying prohibited
+    BOOST_DELETED_FUNCTION(per_thread_record_queue(per_thread_record_queue const&))
+    BOOST_DELETED_FUNCTION(per_thread_record_queue& operator= (per_thread_record_queue const&))
+};
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_NO_THREADS
+
+#endif // BOOST_LOG_DETAIL_PER_THREAD_QUEUE_HPP_INCLUDED_
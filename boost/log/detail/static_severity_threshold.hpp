@@ -0,0 +1,110 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   static_severity_threshold.hpp
+ * \author Andrey Semashev
+ * \date   16.08.2015
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/doc/libs/release/libs/log/doc/html/index.html.
+ */
+
+#ifndef BOOST_LOG_DETAIL_STATIC_SEVERITY_THRESHOLD_HPP_INCLUDED_
+#define BOOST_LOG_DETAIL_STATIC_SEVERITY_THRESHOLD_HPP_INCLUDED_
+
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+/*
+ * If BOOST_LOG_STATIC_SEVERITY_THRESHOLD is defined to a constant expression, the logging macros
+ * with severity levels expand into a loop that is not executed if the level is below the threshold.
+ * When the level is a constant, the compiler removes the whole statement, including the evaluation
+ * of the streaming expression.
+ *
+ * The level is evaluated once and stored in a holder, which is then used to attach the level to the record.
+ * The holder is bound to a reference to its base class because the level type cannot be named in C++03.
+ * The level type is recovered from the level expression placed in the unevaluated branch of a conditional operator.
+ */
+#if defined(BOOST_LOG_STATIC_SEVERITY_THRESHOLD)
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+//! Base class for the severity level holder
+struct static_severity_holder_base
+{
+    //! The flag indicates that the log statement is to be executed
+    mutable bool m_enabled;
+
+    explicit static_severity_holder_base(bool enabled) : m_enabled(enabled) {}
+};
+
+//! Severity level holder
+template< typename LevelT >
+struct static_severity_holder :
+    public static_severity_holder_base
+{
+    LevelT m_level;
+
+    static_severity_holder(LevelT const& level, bool enabled) : static_severity_holder_base(enabled), m_level(level) {}
+};
+
+/*!
+ * The function compares the level with the threshold. The threshold is converted to the level type,
+ * and the comparison is performed with the level type ordering.
+ */
+template< typename LevelT, typename ThresholdT >
+inline static_severity_holder< LevelT > make_static_severity_holder(LevelT const& level, ThresholdT const& threshold)
+{
+    return static_severity_holder< LevelT >(level, !(level < static_cast< LevelT >(threshold)));
+}
+
+//! The function is only used to deduce the level type, it is never called
+template< typename LevelT >
+inline static_severity_holder< LevelT >* static_severity_holder_tag(LevelT const&)
+{
+    return 0;
+}
+
+//! Returns the stored severity level
+template< typename LevelT >
+inline LevelT const& get_static_severity(static_severity_holder_base const& holder, static_severity_holder< LevelT >*)
+{
+    return static_cast< static_severity_holder< LevelT > const& >(holder).m_level;
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#define BOOST_LOG_IF_SEVERITY_ENABLED_INTERNAL(lvl)\
+    for (::boost::log::aux::static_severity_holder_base const& _boost_log_severity =\
+            ::boost::log::aux::make_static_severity_holder((lvl), (BOOST_LOG_STATIC_SEVERITY_THRESHOLD));\
+        _boost_log_severity.m_enabled; _boost_log_severity.m_enabled = false)
+
+#define BOOST_LOG_SEVERITY_INTERNAL(lvl)\
+    ::boost::log::aux::get_static_severity(_boost_log_severity, (true ? 0 : ::boost::log::aux::static_severity_holder_tag((lvl))))
+
+#else // defined(BOOST_LOG_STATIC_SEVERITY_THRESHOLD)
+
+#define BOOST_LOG_IF_SEVERITY_ENABLED_INTERNAL(lvl)
+#define BOOST_LOG_SEVERITY_INTERNAL(lvl) (lvl)
+
+#endif // defined(BOOST_LOG_STATIC_SEVERITY_THRESHOLD)
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_DETAIL_STATIC_SEVERITY_THRESHOLD_HPP_INCLUDED_
@@ -42,8 +42,10 @@ public:
 
 #if defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
     int64_t milliseconds() const { return m_ticks; }
+    int64_t microseconds() const { return m_ticks * 1000LL; }
 #else
     BOOST_LOG_API int64_t milliseconds() const;
+    BOOST_LOG_API int64_t microseconds() const;
 #endif
 };
 
@@ -61,6 +63,11 @@ public:
     {
         return duration(m_ticks - that.m_ticks);
     }
+
+    bool operator< (timestamp that) const
+    {
+        return m_ticks < that.m_ticks;
+    }
 };
 
 /*!
@@ -72,6 +72,20 @@ public:
         strm << val;
         return strm;
     }
+
+    //! Flushes the referenced stream
+    BOOST_FORCEINLINE StreamT& flush() const
+    {
+        StreamT& strm = this->get();
+        strm.flush();
+        return strm;
+    }
+
+    //! Returns the stream buffer of the referenced stream
+    BOOST_FORCEINLINE typename StreamT::streambuf_type* rdbuf() const
+    {
+        return this->get().rdbuf();
+    }
 };
 
 //! Default log record message formatter
@@ -214,7 +214,7 @@ public:
                 std::size_t n = traits_type::print_escaped(buf, c);
                 std::size_t pos = it - str.begin();
                 str.replace(pos, 1, buf, n);
-                it = str.begin() + n - 1;
+                it = str.begin() + pos + n - 1;
                 end = str.end();
             }
         }
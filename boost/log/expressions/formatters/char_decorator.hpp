@@ -42,6 +42,7 @@
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/custom_terminal_spec.hpp>
 #include <boost/log/detail/deduce_char_type.hpp>
+#include <boost/log/detail/char_search.hpp>
 #include <boost/log/utility/formatting_ostream.hpp>
 #include <boost/log/detail/header.hpp>
 
@@ -73,6 +74,10 @@ struct string_const_iterator< const wchar_t* > { typedef const wchar_t* type; };
 /*!
  * A simple character decorator implementation. This implementation replaces string patterns in the source string with
  * the fixed replacements. Source patterns and replacements can be specified at the object construction.
+ *
+ * If all source patterns are single characters, and the replacements do not introduce characters that
+ * would be replaced by the subsequent patterns, all replacements are applied in a single pass over the string.
+ * For narrow character strings the search for the characters to replace is vectorized, if supported by the CPU.
  */
 template< typename CharT >
 class pattern_replacer
@@ -101,6 +106,12 @@ private:
     string_type m_decoration_chars;
     //! List of the decorations to apply
     string_lengths_list m_string_lengths;
+    //! The set of the source pattern characters, valid if \c m_single_pass is \c true
+    boost::log::aux::char_search_set m_search_set;
+    //! Indicates that the replacements can be applied in a single pass
+    bool m_single_pass;
+    //! Indicates that the single pass can update the string in place, valid if \c m_single_pass is \c true
+    bool m_in_place;
 
 public:
     /*!
@@ -129,6 +140,8 @@ public:
             }
             m_string_lengths.push_back(lens);
         }
+
+        init_single_pass();
     }
     /*!
      * Initializing constructor. Creates a pattern replacer with decorations specified
@@ -163,9 +176,16 @@ public:
         // Both sequences should be of the same size
         BOOST_ASSERT(it1 == end1);
         BOOST_ASSERT(it2 == end2);
+
+        init_single_pass();
     }
     //! Copy constructor
-    pattern_replacer(pattern_replacer const& that) : m_decoration_chars(that.m_decoration_chars), m_string_lengths(that.m_string_lengths)
+    pattern_replacer(pattern_replacer const& that) :
+        m_decoration_chars(that.m_decoration_chars),
+        m_string_lengths(that.m_string_lengths),
+        m_search_set(that.m_search_set),
+        m_single_pass(that.m_single_pass),
+        m_in_place(that.m_in_place)
     {
     }
 
@@ -174,6 +194,15 @@ public:
     {
         typedef typename string_type::size_type size_type;
 
+        if (m_single_pass)
+        {
+            if (m_in_place)
+                replace_chars(str, start_pos);
+            else
+                replace_chars_copy(str, start_pos);
+            return;
+        }
+
         const char_type* from_chars = m_decoration_chars.c_str();
         for (typename string_lengths_list::const_iterator it = m_string_lengths.begin(), end = m_string_lengths.end(); it != end; ++it)
         {
@@ -189,6 +218,180 @@ public:
     }
 
 private:
+    //! Checks if the replacements can be applied in a single pass and initializes the set of the source characters
+    void init_single_pass()
+    {
+        m_single_pass = false;
+        m_in_place = false;
+
+        // Every source pattern has to be a single character
+        string_type from_chars;
+        const char_type* p = m_decoration_chars.c_str();
+        for (typename string_lengths_list::const_iterator it = m_string_lengths.begin(), end = m_string_lengths.end(); it != end; ++it)
+        {
+            if (it->from_len != 1u)
+                return;
+            from_chars.push_back(*p);
+            p += it->from_len + it->to_len;
+        }
+
+        // Characters inserted by a replacement must not be replaced by the subsequent patterns.
+        // The string can be updated in place only if either no replacement shrinks the string or none extends it,
+        // otherwise moving the characters in one direction may overwrite the characters that are yet to be moved.
+        bool extending = false, shrinking = false;
+        p = m_decoration_chars.c_str();
+        for (typename string_lengths_list::const_iterator it = m_string_lengths.begin(), end = m_string_lengths.end(); it != end; ++it)
+        {
+            extending |= it->to_len > 1u;
+            shrinking |= it->to_len < 1u;
+
+            const typename string_type::size_type index = it - m_string_lengths.begin();
+            for (const char_type *to = p + 1, *to_end = to + it->to_len; to != to_end; ++to)
+            {
+                if (from_chars.find(*to, index + 1u) != string_type::npos)
+                    return;
+            }
+            p += it->from_len + it->to_len;
+        }
+
+        m_single_pass = !from_chars.empty() && boost::log::aux::init_char_search_set(m_search_set, from_chars.data(), from_chars.size());
+        m_in_place = !(extending && shrinking);
+    }
+
+    //! Description of a character to be replaced
+    struct replacement
+    {
+        typename string_type::size_type pos;
+        const char_type* chars;
+        unsigned int len;
+    };
+
+    //! Replaces the source characters with the replacements in a single pass, updating the string in place
+    void replace_chars(string_type& str, typename string_type::size_type start_pos) const
+    {
+        typedef typename string_type::size_type size_type;
+        typedef typename string_type::traits_type traits_type;
+
+        const char_type* const begin = str.data();
+        const char_type* const end = begin + str.size();
+        const char_type* found = find_first_of(begin + start_pos, end, m_search_set);
+        if (found == end)
+            return;
+
+        // Collect the replacements so that the string can be updated in place
+        enum { max_replacements = 32u };
+        replacement replacements[max_replacements];
+        unsigned int count = 0u;
+        size_type new_size = str.size();
+        do
+        {
+            if (count == max_replacements)
+            {
+                replace_chars_copy(str, start_pos);
+                return;
+            }
+
+            replacement& r = replacements[count++];
+            r.pos = static_cast< size_type >(found - begin);
+            find_replacement(*found, r);
+            new_size += r.len;
+            --new_size;
+
+            found = find_first_of(found + 1, end, m_search_set);
+        }
+        while (found != end);
+
+        const size_type old_size = str.size();
+        if (new_size >= old_size)
+        {
+            // Move the characters towards the end, starting from the last replacement
+            str.resize(new_size);
+            char_type* const p = &str[0];
+            size_type src_end = old_size, dst_end = new_size;
+            for (unsigned int i = count; i > 0u;)
+            {
+                replacement const& r = replacements[--i];
+                const size_type tail_size = src_end - r.pos - 1u;
+                dst_end -= tail_size;
+                traits_type::move(p + dst_end, p + r.pos + 1u, tail_size);
+                dst_end -= r.len;
+                traits_type::copy(p + dst_end, r.chars, r.len);
+                src_end = r.pos;
+            }
+        }
+        else
+        {
+            // Move the characters towards the beginning, starting from the first replacement
+            char_type* const p = &str[0];
+            size_type dst = replacements[0].pos;
+            for (unsigned int i = 0u; i < count; ++i)
+            {
+                replacement const& r = replacements[i];
+                traits_type::copy(p + dst, r.chars, r.len);
+                dst += r.len;
+                const size_type tail_end = i + 1u < count ? replacements[i + 1u].pos : old_size;
+                const size_type tail_size = tail_end - r.pos - 1u;
+                traits_type::move(p + dst, p + r.pos + 1u, tail_size);
+                dst += tail_size;
+            }
+            str.resize(new_size);
+        }
+    }
+
+    //! Replaces the source characters with the replacements in a single pass, composing the result in a separate string
+    void replace_chars_copy(string_type& str, typename string_type::size_type start_pos) const
+    {
+        const char_type* p = str.data() + start_pos;
+        const char_type* const end = str.data() + str.size();
+        const char_type* found = find_first_of(p, end, m_search_set);
+
+        string_type decorated;
+        decorated.reserve((end - p) + (end - p) / 4u);
+        while (found != end)
+        {
+            decorated.append(p, found - p);
+
+            replacement r;
+            find_replacement(*found, r);
+            decorated.append(r.chars, r.len);
+
+            p = found + 1;
+            found = find_first_of(p, end, m_search_set);
+        }
+
+        decorated.append(p, end - p);
+        str.replace(start_pos, string_type::npos, decorated);
+    }
+
+    //! Finds the replacement for the source character
+    void find_replacement(char_type c, replacement& r) const
+    {
+        const char_type* from_chars = m_decoration_chars.c_str();
+        typename string_lengths_list::const_iterator it = m_string_lengths.begin();
+        while (*from_chars != c)
+        {
+            from_chars += it->from_len + it->to_len;
+            ++it;
+        }
+        r.chars = from_chars + 1;
+        r.len = it->to_len;
+    }
+
+    static const char* find_first_of(const char* begin, const char* end, boost::log::aux::char_search_set const& set)
+    {
+        return boost::log::aux::find_first_of_char(begin, end, set);
+    }
+    template< typename T >
+    static const T* find_first_of(const T* begin, const T* end, boost::log::aux::char_search_set const& set)
+    {
+        for (; begin != end; ++begin)
+        {
+            if (set.contains(static_cast< unsigned int >(*begin)))
+                break;
+        }
+        return begin;
+    }
+
     static char_type* string_begin(char_type* p)
     {
         return p;
@@ -27,6 +27,7 @@
 #include <boost/log/sinks/unbounded_ordering_queue.hpp>
 #include <boost/log/sinks/bounded_fifo_queue.hpp>
 #include <boost/log/sinks/bounded_ordering_queue.hpp>
+#include <boost/log/sinks/per_thread_fifo_queue.hpp>
 #include <boost/log/sinks/drop_on_overflow.hpp>
 #include <boost/log/sinks/block_on_overflow.hpp>
 #endif // !defined(BOOST_LOG_NO_THREADS)
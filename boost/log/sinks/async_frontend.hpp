@@ -25,7 +25,10 @@
 #error Boost.Log: Asynchronous sink frontend is only supported in multithreaded environment
 #endif
 
+#include <cstddef>
+#include <vector>
 #include <boost/bind.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/smart_ptr/make_shared_object.hpp>
@@ -43,6 +46,11 @@
 #include <boost/log/keywords/start_thread.hpp>
 #include <boost/log/detail/header.hpp>
 
+#ifndef BOOST_LOG_ASYNC_SINK_MAX_BATCH_SIZE
+//! The macro specifies the maximum number of log records the asynchronous sink frontend passes to the backend in one batch
+#define BOOST_LOG_ASYNC_SINK_MAX_BATCH_SIZE 256
+#endif
+
 namespace boost {
 
 BOOST_LOG_OPEN_NAMESPACE
@@ -82,6 +90,9 @@ namespace sinks {
  *
  * The frontend starts a separate thread on construction. All logging records are passed
  * to the backend in this dedicated thread only.
+ *
+ * If the backend supports batched records, the frontend passes the records that are available
+ * in the queue to the backend in batches of up to \c BOOST_LOG_ASYNC_SINK_MAX_BATCH_SIZE records.
  */
 template< typename SinkBackendT, typename QueueingStrategyT = unbounded_fifo_queue >
 class asynchronous_sink :
@@ -96,6 +107,8 @@ private:
     typedef boost::recursive_mutex backend_mutex_type;
     //! Frontend synchronization mutex type
     typedef typename base_type::mutex_type frontend_mutex_type;
+    //! The tag indicates whether the backend supports batched records
+    typedef typename has_requirement< typename SinkBackendT::frontend_requirements, batched_records >::type batching_tag;
 
     //! A scope guard that implements thread ID management
     class scoped_thread_id
@@ -213,6 +226,9 @@ private:
     //! The flag indicates that queue flush has been requested
     volatile bool m_FlushRequested; // TODO: make it a real atomic
 
+    //! Dequeued records that are pending to be passed to the backend in a batch
+    std::vector< record_view > m_Batch;
+
 public:
     /*!
      * Default constructor. Constructs the sink backend instance.
@@ -324,7 +340,7 @@ public:
                 // Block until new record is available
                 record_view rec;
                 if (queue_base_type::dequeue_ready(rec))
-                    base_type::feed_record(rec, m_BackendMutex, *m_pBackend);
+                    feed_dequeued_record(rec, batching_tag());
             }
             else
                 break;
@@ -435,17 +451,49 @@ private:
                 dequeued = queue_base_type::try_dequeue(rec);
 
             if (dequeued)
-                base_type::feed_record(rec, m_BackendMutex, *m_pBackend);
+                feed_dequeued_record(rec, batching_tag());
             else
                 break;
         }
 
+        feed_batch(batching_tag());
+
         if (m_FlushRequested)
         {
             scoped_flag guard(base_type::frontend_mutex(), m_BlockCond, m_FlushRequested);
             base_type::flush_backend(m_BackendMutex, *m_pBackend);
         }
     }
+
+    //! Feeds the dequeued record to the backend
+    void feed_dequeued_record(record_view& rec, mpl::false_)
+    {
+        base_type::feed_record(rec, m_BackendMutex, *m_pBackend);
+    }
+
+    //! Adds the dequeued record to the batch, feeds the batch to the backend if it is full
+    void feed_dequeued_record(record_view& rec, mpl::true_)
+    {
+        m_Batch.push_back(record_view());
+        m_Batch.back().swap(rec);
+        if (m_Batch.size() >= static_cast< std::size_t >(BOOST_LOG_ASYNC_SINK_MAX_BATCH_SIZE))
+            feed_batch(mpl::true_());
+    }
+
+    //! Does nothing for backends that do not support batched records
+    void feed_batch(mpl::false_)
+    {
+    }
+
+    //! Feeds the pending batch of records to the backend
+    void feed_batch(mpl::true_)
+    {
+        if (!m_Batch.empty())
+        {
+            boost::log::aux::cleanup_guard< std::vector< record_view > > cleanup(m_Batch);
+            base_type::feed_record_batch(m_Batch, m_BackendMutex, *m_pBackend);
+        }
+    }
 #endif // BOOST_LOG_DOXYGEN_PASS
 };
 
@@ -15,6 +15,8 @@
 #ifndef BOOST_LOG_SINKS_BASIC_SINK_FRONTEND_HPP_INCLUDED_
 #define BOOST_LOG_SINKS_BASIC_SINK_FRONTEND_HPP_INCLUDED_
 
+#include <cstddef>
+#include <vector>
 #include <boost/mpl/bool.hpp>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/cleanup_scope_guard.hpp>
@@ -213,6 +215,30 @@ protected:
         return true;
     }
 
+    //! Feeds a batch of log records to the backend. The backend must support batched records.
+    template< typename BackendMutexT, typename BackendT >
+    void feed_record_batch(std::vector< record_view >& records, BackendMutexT& backend_mutex, BackendT& backend)
+    {
+        try
+        {
+            BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< BackendMutexT > lock(backend_mutex);)
+            backend.consume_batch(static_cast< std::vector< record_view > const& >(records));
+        }
+#if !defined(BOOST_LOG_NO_THREADS)
+        catch (thread_interrupted&)
+        {
+            throw;
+        }
+#endif
+        catch (...)
+        {
+            BOOST_LOG_EXPR_IF_MT(boost::log::aux::shared_lock_guard< mutex_type > lock(m_Mutex);)
+            if (m_ExceptionHandler.empty())
+                throw;
+            m_ExceptionHandler();
+        }
+    }
+
     //! Flushes record buffers in the backend, if one supports it
     template< typename BackendMutexT, typename BackendT >
     void flush_backend(BackendMutexT& backend_mutex, BackendT& backend)
@@ -290,6 +316,8 @@ private:
         stream_type m_FormattingStream;
         //! Formatter functor
         formatter_type m_Formatter;
+        //! Formatted log records storage for batched feeding
+        std::vector< string_type > m_FormattedRecords;
 
         formatting_context() :
 #if !defined(BOOST_LOG_NO_THREADS)
@@ -415,21 +443,7 @@ protected:
     template< typename BackendMutexT, typename BackendT >
     void feed_record(record_view const& rec, BackendMutexT& backend_mutex, BackendT& backend)
     {
-        formatting_context* context;
-
-#if !defined(BOOST_LOG_NO_THREADS)
-        context = m_pContext.get();
-        if (!context || context->m_Version != m_Version)
-        {
-            {
-                boost::log::aux::shared_lock_guard< mutex_type > lock(this->frontend_mutex());
-                context = new formatting_context(m_Version, m_Locale, m_Formatter);
-            }
-            m_pContext.reset(context);
-        }
-#else
-        context = &m_Context;
-#endif
+        formatting_context* context = get_formatting_context();
 
         boost::log::aux::cleanup_guard< stream_type > cleanup1(context->m_FormattingStream);
         boost::log::aux::cleanup_guard< string_type > cleanup2(context->m_FormattedRecord);
@@ -490,6 +504,96 @@ protected:
         feed_record(rec, m, backend);
         return true;
     }
+
+    //! Feeds a batch of log records to the backend. The backend must support batched records.
+    template< typename BackendMutexT, typename BackendT >
+    void feed_record_batch(std::vector< record_view >& records, BackendMutexT& backend_mutex, BackendT& backend)
+    {
+        formatting_context* context = get_formatting_context();
+        std::vector< string_type >& formatted_records = context->m_FormattedRecords;
+        formatted_records.resize(records.size());
+
+        // Format the records. The records that fail to be formatted are removed from the batch.
+        std::size_t count = 0;
+        for (std::size_t i = 0, n = records.size(); i < n; ++i)
+        {
+            boost::log::aux::cleanup_guard< stream_type > cleanup1(context->m_FormattingStream);
+            boost::log::aux::cleanup_guard< string_type > cleanup2(context->m_FormattedRecord);
+
+            try
+            {
+                context->m_Formatter(records[i], context->m_FormattingStream);
+                context->m_FormattingStream.flush();
+            }
+#if !defined(BOOST_LOG_NO_THREADS)
+            catch (thread_interrupted&)
+            {
+                throw;
+            }
+#endif
+            catch (...)
+            {
+                BOOST_LOG_EXPR_IF_MT(boost::log::aux::shared_lock_guard< mutex_type > lock(this->frontend_mutex());)
+                if (this->exception_handler().empty())
+                    throw;
+                this->exception_handler()();
+                continue;
+            }
+
+            // Swap the strings instead of copying so that the storage is reused for the next batches
+            formatted_records[count].swap(context->m_FormattedRecord);
+            if (count != i)
+                records[count].swap(records[i]);
+            ++count;
+        }
+
+        if (count == 0)
+            return;
+
+        records.resize(count);
+        formatted_records.resize(count);
+
+        try
+        {
+            BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< BackendMutexT > lock(backend_mutex);)
+            backend.consume_batch(
+                static_cast< std::vector< record_view > const& >(records),
+                static_cast< std::vector< string_type > const& >(formatted_records));
+        }
+#if !defined(BOOST_LOG_NO_THREADS)
+        catch (thread_interrupted&)
+        {
+            throw;
+        }
+#endif
+        catch (...)
+        {
+            BOOST_LOG_EXPR_IF_MT(boost::log::aux::shared_lock_guard< mutex_type > lock(this->frontend_mutex());)
+            if (this->exception_handler().empty())
+                throw;
+            this->exception_handler()();
+        }
+    }
+
+private:
+    //! Returns the formatting context for the current thread
+    formatting_context* get_formatting_context()
+    {
+#if !defined(BOOST_LOG_NO_THREADS)
+        formatting_context* context = m_pContext.get();
+        if (!context || context->m_Version != m_Version)
+        {
+            {
+                boost::log::aux::shared_lock_guard< mutex_type > lock(this->frontend_mutex());
+                context = new formatting_context(m_Version, m_Locale, m_Formatter);
+            }
+            m_pContext.reset(context);
+        }
+        return context;
+#else
+        return &m_Context;
+#endif
+    }
 };
 
 namespace aux {
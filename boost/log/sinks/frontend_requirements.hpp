@@ -75,6 +75,15 @@ struct formatted_records {};
  */
 struct flushing {};
 
+/*!
+ * The sink backend supports consuming log records in batches. Besides the \c consume method,
+ * the backend must provide the \c consume_batch method, which receives a vector of records and,
+ * if the backend also requires formatting, a vector of the formatted strings of the same size.
+ * Frontends that dequeue records in bulk (e.g. the asynchronous sink frontend) will pass records
+ * to the backend in batches.
+ */
+struct batched_records {};
+
 #ifdef BOOST_LOG_DOXYGEN_PASS
 
 /*!
@@ -0,0 +1,168 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   per_thread_fifo_queue.hpp
+ * \author Andrey Semashev
+ * \date   21.06.2015
+ *
+ * The header contains implementation of per-thread FIFO queueing strategy for
+ * the asynchronous sink frontend.
+ */
+
+#ifndef BOOST_LOG_SINKS_PER_THREAD_FIFO_QUEUE_HPP_INCLUDED_
+#define BOOST_LOG_SINKS_PER_THREAD_FIFO_QUEUE_HPP_INCLUDED_
+
+#include <boost/log/detail/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if defined(BOOST_LOG_NO_THREADS)
+#error Boost.Log: This header content is only supported in multithreaded environment
+#endif
+
+#include <cstddef>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/log/detail/per_thread_queue.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+/*!
+ * \brief Per-thread FIFO log record queueing strategy
+ *
+ * The \c per_thread_fifo_queue class is intended to be used with
+ * the \c asynchronous_sink frontend as a log record queueing strategy.
+ *
+ * This strategy gives every logging thread its own lock-free ring of the capacity
+ * specified in the \c RingCapacityV template parameter, so that threads writing
+ * log records do not contend with each other. The dedicated sink thread drains
+ * the rings, picking the oldest record of all rings each time. The records of every
+ * thread are processed in the order they were enqueued, and the records of different
+ * threads are ordered by the time of enqueueing, up to the timer resolution.
+ *
+ * When the ring of a thread is full, the enqueue operation will invoke the overflow
+ * handling strategy specified in the \c OverflowStrategyT template parameter, same as
+ * \c bounded_fifo_queue does.
+ */
+template< std::size_t RingCapacityV, typename OverflowStrategyT >
+class per_thread_fifo_queue :
+    private OverflowStrategyT
+{
+private:
+    typedef OverflowStrategyT overflow_strategy;
+    typedef boost::log::aux::per_thread_record_queue queue_type;
+    typedef boost::mutex mutex_type;
+
+private:
+    //! Per-thread rings
+    queue_type m_queue;
+    //! Synchronization primitive for the overflow handling
+    mutex_type m_mutex;
+
+protected:
+    //! Default constructor
+    per_thread_fifo_queue() : m_queue(RingCapacityV)
+    {
+    }
+    //! Initializing constructor
+    template< typename ArgsT >
+    explicit per_thread_fifo_queue(ArgsT const&) : m_queue(RingCapacityV)
+    {
+    }
+
+    //! Enqueues log record to the queue
+    void enqueue(record_view const& rec)
+    {
+        if (m_queue.try_push(rec))
+            return;
+
+        unique_lock< mutex_type > lock(m_mutex);
+        m_queue.add_blocked_producer();
+        while (!m_queue.try_push(rec))
+        {
+            if (!overflow_strategy::on_overflow(rec, lock))
+                break;
+        }
+        m_queue.remove_blocked_producer();
+    }
+
+    //! Attempts to enqueue log record to the queue
+    bool try_enqueue(record_view const& rec)
+    {
+        // Do not invoke the bounding strategy in case of overflow as it may block
+        return m_queue.try_push(rec);
+    }
+
+    //! Attempts to dequeue a log record ready for processing from the queue, does not block if the queue is empty
+    bool try_dequeue_ready(record_view& rec)
+    {
+        return try_dequeue(rec);
+    }
+
+    //! Attempts to dequeue log record from the queue, does not block if the queue is empty
+    bool try_dequeue(record_view& rec)
+    {
+        if (m_queue.try_pop(rec))
+        {
+            on_dequeued();
+            return true;
+        }
+
+        return false;
+    }
+
+    //! Dequeues log record from the queue, blocks if the queue is empty
+    bool dequeue_ready(record_view& rec)
+    {
+        if (m_queue.pop(rec))
+        {
+            on_dequeued();
+            return true;
+        }
+
+        return false;
+    }
+
+    //! Wakes a thread possibly blocked in the \c dequeue method
+    void interrupt_dequeue()
+    {
+        lock_guard< mutex_type > lock(m_mutex);
+        overflow_strategy::interrupt();
+        m_queue.interrupt();
+    }
+
+private:
+    //! Wakes producers possibly blocked on ring overflow
+    void on_dequeued()
+    {
+        if (m_queue.blocked_producers() > 0u)
+        {
+            // The space has appeared in one of the rings, but we don't know which of the blocked producers owns it
+            lock_guard< mutex_type > lock(m_mutex);
+            for (std::size_t n = m_queue.blocked_producers(); n > 0u; --n)
+                overflow_strategy::on_queue_space_available();
+        }
+    }
+};
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_SINKS_PER_THREAD_FIFO_QUEUE_HPP_INCLUDED_
@@ -24,10 +24,13 @@
 #ifndef BOOST_LOG_WITHOUT_SYSLOG
 
 #include <string>
+#include <vector>
 #include <boost/log/detail/asio_fwd.hpp>
 #include <boost/log/detail/light_function.hpp>
 #include <boost/log/detail/parameter_tools.hpp>
+#include <boost/log/core/record_view.hpp>
 #include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/frontend_requirements.hpp>
 #include <boost/log/sinks/syslog_constants.hpp>
 #include <boost/log/sinks/attribute_mapping.hpp>
 #include <boost/log/attributes/attribute_value_set.hpp>
@@ -148,10 +151,10 @@ namespace syslog {
  * on platforms with no native support for POSIX syslog API will have no effect.
  */
 class syslog_backend :
-    public basic_formatted_sink_backend< char >
+    public basic_formatted_sink_backend< char, combine_requirements< synchronized_feeding, batched_records >::type >
 {
     //! Base type
-    typedef basic_formatted_sink_backend< char > base_type;
+    typedef basic_formatted_sink_backend< char, combine_requirements< synchronized_feeding, batched_records >::type > base_type;
     //! Implementation type
     struct implementation;
 
@@ -254,6 +257,11 @@ public:
      */
     BOOST_LOG_API void consume(record_view const& rec, string_type const& formatted_message);
 
+    /*!
+     * The method passes a batch of formatted messages to the syslog API or sends them to a syslog server
+     */
+    BOOST_LOG_API void consume_batch(std::vector< record_view > const& records, std::vector< string_type > const& formatted_messages);
+
 private:
 #ifndef BOOST_LOG_DOXYGEN_PASS
     //! The method creates the backend implementation
@@ -17,6 +17,7 @@
 
 #include <ios>
 #include <string>
+#include <vector>
 #include <ostream>
 #include <boost/limits.hpp>
 #include <boost/cstdint.hpp>
@@ -33,10 +34,12 @@
 #include <boost/log/keywords/open_mode.hpp>
 #include <boost/log/keywords/auto_flush.hpp>
 #include <boost/log/keywords/rotation_size.hpp>
+#include <boost/log/keywords/mapping_chunk_size.hpp>
 #include <boost/log/keywords/time_based_rotation.hpp>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/light_function.hpp>
 #include <boost/log/detail/parameter_tools.hpp>
+#include <boost/log/core/record_view.hpp>
 #include <boost/log/sinks/basic_sink_backend.hpp>
 #include <boost/log/sinks/frontend_requirements.hpp>
 #include <boost/log/detail/header.hpp>
@@ -316,13 +319,13 @@ public:
 class text_file_backend :
     public basic_formatted_sink_backend<
         char,
-        combine_requirements< synchronized_feeding, flushing >::type
+        combine_requirements< synchronized_feeding, flushing, batched_records >::type
     >
 {
     //! Base type
     typedef basic_formatted_sink_backend<
         char,
-        combine_requirements< synchronized_feeding, flushing >::type
+        combine_requirements< synchronized_feeding, flushing, batched_records >::type
     > base_type;
 
 public:
@@ -341,6 +344,9 @@ public:
     //! Predicate that defines the time-based condition for file rotation
     typedef boost::log::aux::light_function< bool () > time_based_rotation_predicate;
 
+    //! Rotated file compressor. Receives the rotated file name and returns the name of the compressed file.
+    typedef boost::log::aux::light_function< filesystem::path (filesystem::path const&) > file_compressor_type;
+
 private:
     //! \cond
 
@@ -378,6 +384,9 @@ public:
      *                              No time-based file rotations will be performed, if not specified.
      * \li \c auto_flush - Specifies a flag, whether or not to automatically flush the file after each
      *                     written log record. By default, is \c false.
+     * \li \c mapping_chunk_size - Specifies the size of the chunks, in bytes, in which the file is preallocated
+     *                             and mapped into memory. If not specified or zero, the file is written
+     *                             through a file stream. See \c set_mapping_chunk_size.
      *
      * \note Read the caution note regarding file name pattern in the <tt>sinks::file::collector::scan_for_files</tt>
      *       documentation.
@@ -439,6 +448,34 @@ public:
      */
     BOOST_LOG_API void set_close_handler(close_handler_type const& handler);
 
+    /*!
+     * The method enables writing files through memory mapping. The file is preallocated in chunks
+     * of the specified size, the chunks are mapped into memory and the log records are copied into
+     * the mapped memory. When the file is closed, it is truncated to the size of the written contents.
+     * If the application terminates before the file is closed, the file may end with a sequence of zero bytes,
+     * which are removed if the file is opened again in \c app mode.
+     *
+     * \note The setting takes effect when the next file is opened.
+     *
+     * \param size The size of the chunk, in bytes. The size is rounded up to a multiple of the memory page
+     *             size. If zero, the files are written through a file stream, which is the default.
+     */
+    BOOST_LOG_API void set_mapping_chunk_size(uintmax_t size);
+
+    /*!
+     * The method sets the compressor for rotated files. The compressor is called for every rotated
+     * file before the file is passed to the file collector. The compressor is expected to write the
+     * compressed file, remove the original file and return the compressed file name. In multithreaded
+     * builds the compressor is called in a background thread, so that logging is not stalled while
+     * the file is being compressed.
+     *
+     * \note If the compressor throws, the original file is passed to the file collector. Exceptions
+     *       thrown by the file collector when the compressor is used are ignored.
+     *
+     * \param compressor The file compressor function object. If empty, rotated files are not compressed.
+     */
+    BOOST_LOG_API void set_file_compressor(file_compressor_type const& compressor);
+
     /*!
      * The method sets maximum file size. When the size is reached, file rotation is performed.
      *
@@ -492,6 +529,13 @@ public:
      */
     BOOST_LOG_API void consume(record_view const& rec, string_type const& formatted_message);
 
+    /*!
+     * The method writes a batch of messages to the sink. If auto-flush is enabled, the file
+     * is flushed once after the whole batch is written. If writing a message throws, the rest
+     * of the batch is still written, after which the first exception is propagated.
+     */
+    BOOST_LOG_API void consume_batch(std::vector< record_view > const& records, std::vector< string_type > const& formatted_messages);
+
     /*!
      * The method flushes the currently open log file
      */
@@ -513,7 +557,8 @@ private:
             args[keywords::open_mode | (std::ios_base::trunc | std::ios_base::out)],
             args[keywords::rotation_size | (std::numeric_limits< uintmax_t >::max)()],
             args[keywords::time_based_rotation | time_based_rotation_predicate()],
-            args[keywords::auto_flush | false]);
+            args[keywords::auto_flush | false],
+            args[keywords::mapping_chunk_size | static_cast< uintmax_t >(0u)]);
     }
     //! Constructor implementation
     BOOST_LOG_API void construct(
@@ -521,13 +566,20 @@ private:
         std::ios_base::openmode mode,
         uintmax_t rotation_size,
         time_based_rotation_predicate const& time_based_rotation,
-        bool auto_flush);
+        bool auto_flush,
+        uintmax_t mapping_chunk_size);
 
     //! The method sets file name mask
     BOOST_LOG_API void set_file_name_pattern_internal(filesystem::path const& pattern);
 
+    //! Opens a new file
+    void open_file(bool no_new_filename);
     //! Closes the currently open file
     void close_file();
+    //! Passes the closed file to the file collector
+    void store_file();
+    //! Writes the message to the file, rotates the file if needed
+    void write_message(string_type const& formatted_message);
 #endif // BOOST_LOG_DOXYGEN_PASS
 };
 
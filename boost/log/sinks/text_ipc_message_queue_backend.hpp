@@ -0,0 +1,159 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   text_ipc_message_queue_backend.hpp
+ * \author Andrey Semashev
+ * \date   09.08.2015
+ *
+ * The header contains implementation of a text interprocess message queue sink backend.
+ */
+
+#ifndef BOOST_LOG_SINKS_TEXT_IPC_MESSAGE_QUEUE_BACKEND_HPP_INCLUDED_
+#define BOOST_LOG_SINKS_TEXT_IPC_MESSAGE_QUEUE_BACKEND_HPP_INCLUDED_
+
+#include <string>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/parameter_tools.hpp>
+#include <boost/log/exceptions.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/frontend_requirements.hpp>
+#include <boost/log/utility/ipc/reliable_message_queue.hpp>
+#include <boost/log/keywords/open_mode.hpp>
+#include <boost/log/keywords/name.hpp>
+#include <boost/log/keywords/capacity.hpp>
+#include <boost/log/keywords/overflow_policy.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+/*!
+ * \brief An implementation of a text interprocess message queue sink backend
+ *
+ * The sink backend sends formatted log messages to an interprocess message queue, which can be
+ * received and processed by a separate process, such as a log collector. By default the sink frontend
+ * formats only the message text, so formatting of the other attribute values and writing the messages
+ * to files is left to the receiving process.
+ *
+ * The backend does not need synchronization, since the queue is synchronized internally.
+ */
+template< typename QueueT = ipc::reliable_message_queue >
+class text_ipc_message_queue_backend :
+    public basic_formatted_sink_backend< char, concurrent_feeding >
+{
+    //! Base type
+    typedef basic_formatted_sink_backend< char, concurrent_feeding > base_type;
+
+public:
+    //! Character type
+    typedef base_type::char_type char_type;
+    //! String type to be used as a message text holder
+    typedef base_type::string_type string_type;
+    //! Interprocess message queue type
+    typedef QueueT queue_type;
+
+private:
+    //! Interprocess queue
+    queue_type m_queue;
+
+public:
+    /*!
+     * Default constructor. The method constructs the backend with a queue that is not opened.
+     * The queue can be opened later through the \c message_queue method.
+     */
+    text_ipc_message_queue_backend()
+    {
+    }
+
+    /*!
+     * Constructor. The method constructs the backend and opens the queue with the specified named parameters.
+     * The following named parameters are supported:
+     *
+     * \li \c name - The queue name. Mandatory.
+     * \li \c open_mode - The queue opening mode, see \c queue_type::open_mode. If not specified, \c open_or_create is used.
+     * \li \c capacity - The size of the queue storage, in bytes, if the queue is created. If not specified, 64 KiB is used.
+     * \li \c overflow_policy - The action to take when the queue is full, see \c queue_type::overflow_policy.
+     *                           If not specified, \c block_on_overflow is used.
+     */
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    BOOST_LOG_PARAMETRIZED_CONSTRUCTORS_CALL(text_ipc_message_queue_backend, construct)
+#else
+    template< typename... ArgsT >
+    explicit text_ipc_message_queue_backend(ArgsT... const& args);
+#endif
+
+    /*!
+     * The method returns a reference to the managed \c queue_type object.
+     *
+     * \return A reference to the managed \c queue_type object.
+     */
+    queue_type& message_queue() BOOST_NOEXCEPT { return m_queue; }
+
+    /*!
+     * The method returns a constant reference to the managed \c queue_type object.
+     *
+     * \return A constant reference to the managed \c queue_type object.
+     */
+    queue_type const& message_queue() const BOOST_NOEXCEPT { return m_queue; }
+
+    /*!
+     * Tests whether the object is associated with any message queue.
+     *
+     * \return \c true if the object is associated with a message queue, and \c false otherwise.
+     */
+    bool is_open() const BOOST_NOEXCEPT { return m_queue.is_open(); }
+
+    /*!
+     * The method sends the formatted message to the queue. Messages that do not fit into the queue
+     * are handled according to the overflow policy of the queue. If the queue is not opened,
+     * the message is discarded.
+     *
+     * \throws \c limitation_error if the message is larger than the maximum message size of the queue.
+     */
+    void consume(record_view const&, string_type const& formatted_message)
+    {
+        if (m_queue.is_open())
+        {
+            typedef typename queue_type::size_type size_type;
+            if (formatted_message.size() > static_cast< typename string_type::size_type >(m_queue.max_message_size()))
+                BOOST_LOG_THROW_DESCR(limitation_error, "Message too long to send to an interprocess queue");
+            m_queue.send(formatted_message.data(), static_cast< size_type >(formatted_message.size()));
+        }
+    }
+
+private:
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    //! The method opens the queue with the named parameters
+    template< typename ArgsT >
+    void construct(ArgsT const& args)
+    {
+        m_queue.open(
+            args[keywords::open_mode | queue_type::open_or_create],
+            args[keywords::name],
+            args[keywords::capacity | static_cast< typename queue_type::size_type >(64u * 1024u)],
+            args[keywords::overflow_policy | queue_type::block_on_overflow]);
+    }
+#endif // BOOST_LOG_DOXYGEN_PASS
+};
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_SINKS_TEXT_IPC_MESSAGE_QUEUE_BACKEND_HPP_INCLUDED_
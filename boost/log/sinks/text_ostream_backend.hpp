@@ -15,9 +15,11 @@
 #ifndef BOOST_LOG_SINKS_TEXT_OSTREAM_BACKEND_HPP_INCLUDED_
 #define BOOST_LOG_SINKS_TEXT_OSTREAM_BACKEND_HPP_INCLUDED_
 
+#include <vector>
 #include <ostream>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/log/detail/config.hpp>
+#include <boost/log/core/record_view.hpp>
 #include <boost/log/sinks/basic_sink_backend.hpp>
 #include <boost/log/sinks/frontend_requirements.hpp>
 #include <boost/log/detail/header.hpp>
@@ -41,13 +43,13 @@ template< typename CharT >
 class basic_text_ostream_backend :
     public basic_formatted_sink_backend<
         CharT,
-        combine_requirements< synchronized_feeding, flushing >::type
+        combine_requirements< synchronized_feeding, flushing, batched_records >::type
     >
 {
     //! Base type
     typedef basic_formatted_sink_backend<
         CharT,
-        combine_requirements< synchronized_feeding, flushing >::type
+        combine_requirements< synchronized_feeding, flushing, batched_records >::type
     > base_type;
 
 public:
@@ -100,6 +102,13 @@ public:
      */
     BOOST_LOG_API void consume(record_view const& rec, string_type const& formatted_message);
 
+    /*!
+     * The method writes a batch of messages to the sink. If auto-flush is enabled, the streams
+     * are flushed once after the whole batch is written. If writing to a stream throws, the batch
+     * is still written to the other streams, after which the exception is propagated.
+     */
+    BOOST_LOG_API void consume_batch(std::vector< record_view > const& records, std::vector< string_type > const& formatted_messages);
+
     /*!
      * The method flushes the associated streams
      */
@@ -0,0 +1,342 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   call_site_limit_feature.hpp
+ * \author Andrey Semashev
+ * \date   18.07.2015
+ *
+ * The header contains implementation of a feature that limits the number of records
+ * produced by individual logging statements, either by rate or by random sampling.
+ */
+
+#ifndef BOOST_LOG_SOURCES_CALL_SITE_LIMIT_FEATURE_HPP_INCLUDED_
+#define BOOST_LOG_SOURCES_CALL_SITE_LIMIT_FEATURE_HPP_INCLUDED_
+
+#include <boost/cstdint.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/move/core.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/preprocessor/facilities/empty.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/timestamp.hpp>
+#include <boost/log/detail/default_attribute_names.hpp>
+#include <boost/log/detail/static_severity_threshold.hpp>
+#include <boost/log/keywords/call_site_limit.hpp>
+#include <boost/log/keywords/severity.hpp>
+#include <boost/log/attributes/attribute_value_impl.hpp>
+#include <boost/log/core/record.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sources {
+
+/*!
+ * \brief Rate limit of a logging statement
+ *
+ * The limit implements a token bucket: the bucket holds up to \c burst tokens and is refilled
+ * at the rate of \c records_per_second tokens per second. Each admitted record consumes one token,
+ * records that find the bucket empty are suppressed. The implementation keeps the bucket state in a single
+ * atomic word (the theoretical arrival time of the next record), so the limit can be shared by multiple
+ * threads without locking.
+ */
+class rate_limit
+{
+    BOOST_DELETED_FUNCTION(rate_limit(rate_limit const&))
+    BOOST_DELETED_FUNCTION(rate_limit& operator= (rate_limit const&))
+
+private:
+    //! The time at which the bucket becomes full, in microseconds
+    boost::atomic< uint64_t > m_ArrivalTime;
+    //! The number of suppressed records since the last admitted one
+    boost::atomic< uintmax_t > m_Suppressed;
+    //! The time needed to refill one token, in microseconds
+    const uint64_t m_Interval;
+    //! The amount of time the arrival time is allowed to advance ahead of the current time, in microseconds
+    const uint64_t m_Tolerance;
+
+public:
+    /*!
+     * Constructor
+     *
+     * \param records_per_second The sustained number of records per second to admit. Must be positive.
+     * \param burst The maximum number of records that can be admitted at once after a period of inactivity.
+     */
+    explicit rate_limit(double records_per_second, unsigned int burst = 1u) :
+        m_ArrivalTime(0u),
+        m_Suppressed(0u),
+        m_Interval(records_per_second < 1000000.0 ? static_cast< uint64_t >(1000000.0 / records_per_second) : 1u),
+        m_Tolerance(m_Interval * (burst > 0u ? burst - 1u : 0u))
+    {
+    }
+
+    /*!
+     * The method decides whether the next record should be admitted. If not, the suppressed records counter is incremented.
+     */
+    bool admit()
+    {
+        const uint64_t now = static_cast< uint64_t >((boost::log::aux::get_timestamp() - boost::log::aux::timestamp()).microseconds());
+        uint64_t arrival = m_ArrivalTime.load(boost::memory_order_relaxed);
+        while (true)
+        {
+            const uint64_t base = arrival > now ? arrival : now;
+            if (base - now > m_Tolerance)
+            {
+                m_Suppressed.fetch_add(1u, boost::memory_order_relaxed);
+                return false;
+            }
+            if (m_ArrivalTime.compare_exchange_weak(arrival, base + m_Interval, boost::memory_order_relaxed, boost::memory_order_relaxed))
+                return true;
+        }
+    }
+
+    /*!
+     * The method returns the number of suppressed records since the previous call and resets the counter
+     */
+    uintmax_t take_suppressed_count()
+    {
+        return m_Suppressed.exchange(0u, boost::memory_order_relaxed);
+    }
+};
+
+/*!
+ * \brief Random sampling of a logging statement
+ *
+ * The limit admits every record with the given probability. The decision is made with a counter-based
+ * pseudo-random generator: the atomic counter is advanced by a constant for every record and the result
+ * is scrambled with a mixing function. This keeps the decision lock-free and avoids thread-specific storage.
+ */
+class sampling_limit
+{
+    BOOST_DELETED_FUNCTION(sampling_limit(sampling_limit const&))
+    BOOST_DELETED_FUNCTION(sampling_limit& operator= (sampling_limit const&))
+
+private:
+    //! Generator state
+    boost::atomic< uint32_t > m_State;
+    //! The number of suppressed records since the last admitted one
+    boost::atomic< uintmax_t > m_Suppressed;
+    //! The record is admitted if the generated number is less than the threshold
+    const uint64_t m_Threshold;
+
+public:
+    /*!
+     * Constructor
+     *
+     * \param probability The probability of a record to be admitted, in the range [0, 1].
+     */
+    explicit sampling_limit(double probability) :
+        m_State(static_cast< uint32_t >(reinterpret_cast< uintptr_t >(this))),
+        m_Suppressed(0u),
+        m_Threshold(probability >= 1.0 ? 0x100000000ull : (probability > 0.0 ? static_cast< uint64_t >(probability * 4294967296.0) : 0u))
+    {
+    }
+
+    /*!
+     * The method decides whether the next record should be admitted. If not, the suppressed records counter is incremented.
+     */
+    bool admit()
+    {
+        // The golden ratio increment and the MurmurHash3 finalizer
+        uint32_t n = m_State.fetch_add(0x9E3779B9u, boost::memory_order_relaxed);
+        n ^= n >> 16;
+        n *= 0x85EBCA6Bu;
+        n ^= n >> 13;
+        n *= 0xC2B2AE35u;
+        n ^= n >> 16;
+        if (n < m_Threshold)
+            return true;
+
+        m_Suppressed.fetch_add(1u, boost::memory_order_relaxed);
+        return false;
+    }
+
+    /*!
+     * The method returns the number of suppressed records since the previous call and resets the counter
+     */
+    uintmax_t take_suppressed_count()
+    {
+        return m_Suppressed.exchange(0u, boost::memory_order_relaxed);
+    }
+};
+
+/*!
+ * \brief Call site limiting feature implementation
+ */
+template< typename BaseT >
+class basic_call_site_limit_logger :
+    public BaseT
+{
+    //! Base type
+    typedef BaseT base_type;
+    typedef basic_call_site_limit_logger this_type;
+    BOOST_COPYABLE_AND_MOVABLE_ALT(this_type)
+
+public:
+    //! Character type
+    typedef typename base_type::char_type char_type;
+    //! Final type
+    typedef typename base_type::final_type final_type;
+    //! Threading model being used
+    typedef typename base_type::threading_model threading_model;
+
+#if defined(BOOST_LOG_DOXYGEN_PASS)
+    //! Lock requirement for the open_record_unlocked method
+    typedef typename strictest_lock<
+        typename base_type::open_record_lock,
+        no_lock< threading_model >
+    >::type open_record_lock;
+#endif // defined(BOOST_LOG_DOXYGEN_PASS)
+
+public:
+    /*!
+     * Default constructor
+     */
+    basic_call_site_limit_logger() : base_type()
+    {
+    }
+    /*!
+     * Copy constructor
+     */
+    basic_call_site_limit_logger(basic_call_site_limit_logger const& that) :
+        base_type(static_cast< base_type const& >(that))
+    {
+    }
+    /*!
+     * Move constructor
+     */
+    basic_call_site_limit_logger(BOOST_RV_REF(basic_call_site_limit_logger) that) :
+        base_type(boost::move(static_cast< base_type& >(that)))
+    {
+    }
+    /*!
+     * Constructor with arguments. Passes arguments to other features.
+     */
+    template< typename ArgsT >
+    explicit basic_call_site_limit_logger(ArgsT const& args) :
+        base_type(args)
+    {
+    }
+
+protected:
+    /*!
+     * Unlocked \c open_record
+     */
+    template< typename ArgsT >
+    record open_record_unlocked(ArgsT const& args)
+    {
+        return open_record_with_limit_unlocked(args, args[keywords::call_site_limit | parameter::void_()]);
+    }
+
+private:
+    //! The \c open_record implementation for the case when the limit is specified in log statement
+    template< typename ArgsT, typename LimitT >
+    record open_record_with_limit_unlocked(ArgsT const& args, LimitT& limit)
+    {
+        if (!limit.admit())
+            return record();
+
+        record rec = base_type::open_record_unlocked(args);
+        if (!!rec)
+        {
+            const uintmax_t suppressed = limit.take_suppressed_count();
+            if (suppressed > 0u)
+            {
+                rec.attribute_values().insert(
+                    boost::log::aux::default_attribute_names::suppressed(),
+                    attributes::make_attribute_value(suppressed));
+            }
+        }
+        return boost::move(rec);
+    }
+    //! The \c open_record implementation for the case when the limit is not specified in log statement
+    template< typename ArgsT >
+    record open_record_with_limit_unlocked(ArgsT const& args, parameter::void_)
+    {
+        return base_type::open_record_unlocked(args);
+    }
+};
+
+/*!
+ * \brief Call site limiting feature
+ *
+ * The feature allows logging statements to limit the number of records they produce. The limit object
+ * (\c rate_limit or \c sampling_limit) is normally created by the logging macro as a static variable, so
+ * that every statement has its own limit. The decision is made before the record is constructed, so
+ * suppressed records do not reach the logging core. The number of records suppressed since the previous
+ * admitted record is attached to the next admitted record as the "Suppressed" attribute value.
+ *
+ * The feature should be specified first in the features list so that the limit is checked before other features
+ * are involved.
+ */
+struct call_site_limit
+{
+    template< typename BaseT >
+    struct apply
+    {
+        typedef basic_call_site_limit_logger< BaseT > type;
+    };
+};
+
+} // namespace sources
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+//! \cond
+
+#define BOOST_LOG_STREAM_WITH_CALL_SITE_LIMIT_INTERNAL(logger, limit_type, limit_args, params_seq)\
+    for (bool _boost_log_call_site_once = true; _boost_log_call_site_once; _boost_log_call_site_once = false)\
+        for (static limit_type _boost_log_call_site_limit limit_args; _boost_log_call_site_once; _boost_log_call_site_once = false)\
+            BOOST_LOG_STREAM_WITH_PARAMS((logger), params_seq(::boost::log::keywords::call_site_limit = _boost_log_call_site_limit))
+
+//! \endcond
+
+//! The macro writes a record into log, unless the statement exceeds the specified rate of records per second
+#define BOOST_LOG_STREAM_RATE_LIMITED(logger, records_per_second, burst)\
+    BOOST_LOG_STREAM_WITH_CALL_SITE_LIMIT_INTERNAL(logger, ::boost::log::sources::rate_limit, ((records_per_second), (burst)), BOOST_PP_EMPTY())
+
+//! The macro writes a record with a specific severity level into log, unless the statement exceeds the specified rate of records per second
+#define BOOST_LOG_STREAM_SEV_RATE_LIMITED(logger, lvl, records_per_second, burst)\
+    BOOST_LOG_IF_SEVERITY_ENABLED_INTERNAL(lvl)\
+        BOOST_LOG_STREAM_WITH_CALL_SITE_LIMIT_INTERNAL(logger, ::boost::log::sources::rate_limit, ((records_per_second), (burst)), (::boost::log::keywords::severity = BOOST_LOG_SEVERITY_INTERNAL(lvl)))
+
+//! The macro writes a record into log with the specified probability
+#define BOOST_LOG_STREAM_SAMPLED(logger, probability)\
+    BOOST_LOG_STREAM_WITH_CALL_SITE_LIMIT_INTERNAL(logger, ::boost::log::sources::sampling_limit, ((probability)), BOOST_PP_EMPTY())
+
+//! The macro writes a record with a specific severity level into log with the specified probability
+#define BOOST_LOG_STREAM_SEV_SAMPLED(logger, lvl, probability)\
+    BOOST_LOG_IF_SEVERITY_ENABLED_INTERNAL(lvl)\
+        BOOST_LOG_STREAM_WITH_CALL_SITE_LIMIT_INTERNAL(logger, ::boost::log::sources::sampling_limit, ((probability)), (::boost::log::keywords::severity = BOOST_LOG_SEVERITY_INTERNAL(lvl)))
+
+#ifndef BOOST_LOG_NO_SHORTHAND_NAMES
+
+//! An equivalent to BOOST_LOG_STREAM_RATE_LIMITED(logger, records_per_second, burst)
+#define BOOST_LOG_RATE_LIMITED(logger, records_per_second, burst) BOOST_LOG_STREAM_RATE_LIMITED(logger, records_per_second, burst)
+
+//! An equivalent to BOOST_LOG_STREAM_SEV_RATE_LIMITED(logger, lvl, records_per_second, burst)
+#define BOOST_LOG_SEV_RATE_LIMITED(logger, lvl, records_per_second, burst) BOOST_LOG_STREAM_SEV_RATE_LIMITED(logger, lvl, records_per_second, burst)
+
+//! An equivalent to BOOST_LOG_STREAM_SAMPLED(logger, probability)
+#define BOOST_LOG_SAMPLED(logger, probability) BOOST_LOG_STREAM_SAMPLED(logger, probability)
+
+//! An equivalent to BOOST_LOG_STREAM_SEV_SAMPLED(logger, lvl, probability)
+#define BOOST_LOG_SEV_SAMPLED(logger, lvl, probability) BOOST_LOG_STREAM_SEV_SAMPLED(logger, lvl, probability)
+
+#endif // BOOST_LOG_NO_SHORTHAND_NAMES
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_SOURCES_CALL_SITE_LIMIT_FEATURE_HPP_INCLUDED_
@@ -0,0 +1,466 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   deferred_record.hpp
+ * \author Andrey Semashev
+ * \date   14.06.2015
+ *
+ * This header contains tools for writing log records with deferred message formatting. Instead of
+ * composing the message text with a streaming expression, the arguments are captured in binary form
+ * along with the format string, and the message is only formatted when a sink requests its text.
+ */
+
+#ifndef BOOST_LOG_SOURCES_DEFERRED_RECORD_HPP_INCLUDED_
+#define BOOST_LOG_SOURCES_DEFERRED_RECORD_HPP_INCLUDED_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include <boost/assert.hpp>
+#include <boost/move/core.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_enum.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/type_traits/remove_pointer.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/utility/addressof.hpp>
+#include <boost/preprocessor/seq/enum.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/unhandled_exception_count.hpp>
+#include <boost/log/detail/default_attribute_names.hpp>
+#include <boost/log/detail/static_severity_threshold.hpp>
+#include <boost/log/core/record.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/utility/type_dispatch/type_dispatcher.hpp>
+#include <boost/log/utility/once_block.hpp>
+#include <boost/log/utility/string_literal_fwd.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include <boost/log/utility/deferred_message.hpp>
+#include <boost/log/utility/unique_identifier_name.hpp>
+#include <boost/log/keywords/severity.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+//! The trait checks if the type is a character type
+template< typename T >
+struct is_deferred_character :
+    public mpl::bool_<
+        is_same< T, char >::value || is_same< T, signed char >::value || is_same< T, unsigned char >::value ||
+        is_same< T, wchar_t >::value
+#if !defined(BOOST_NO_CXX11_CHAR16_T)
+        || is_same< T, char16_t >::value
+#endif
+#if !defined(BOOST_NO_CXX11_CHAR32_T)
+        || is_same< T, char32_t >::value
+#endif
+    >
+{
+};
+
+} // namespace aux
+
+/*!
+ * \brief The trait tells whether an argument of deferred log records can be captured by copying its bytes
+ *
+ * Arguments that are captured by copying are formatted later, when the message text is requested, so their
+ * output must not depend on any external data. By default arithmetic types, enums and non-character pointers
+ * are captured by copying. Arguments of other types, except strings, are formatted right away, when they are
+ * passed to the record. Users may specialize the trait for their trivially copyable types to defer their formatting.
+ */
+template< typename T >
+struct deferred_by_copy :
+    public mpl::bool_<
+        is_arithmetic< T >::value || is_enum< T >::value ||
+        (is_pointer< T >::value && !aux::is_deferred_character< typename remove_cv< typename remove_pointer< T >::type >::type >::value)
+    >
+{
+};
+
+namespace aux {
+
+//! Internal class that provides argument buffers for deferred record pumps
+struct deferred_buffer_provider
+{
+    //! Argument buffer compound
+    struct buffer_compound
+    {
+        buffer_compound* next;
+
+        //! Encoded arguments
+        std::vector< unsigned char > buffer;
+
+        buffer_compound() : next(NULL) {}
+    };
+
+    //! The method returns an allocated buffer compound
+    BOOST_LOG_API static buffer_compound* allocate_compound();
+    //! The method releases a compound
+    BOOST_LOG_API static void release_compound(buffer_compound* compound) BOOST_NOEXCEPT;
+
+    //  Non-constructible, non-copyable, non-assignable
+    BOOST_DELETED_FUNCTION(deferred_buffer_provider())
+    BOOST_DELETED_FUNCTION(deferred_buffer_provider(deferred_buffer_provider const&))
+    BOOST_DELETED_FUNCTION(deferred_buffer_provider& operator= (deferred_buffer_provider const&))
+};
+
+//! Argument capturing implementation for the types that are captured by copying
+template< typename T, typename CharT, bool ByCopyV = deferred_by_copy< T >::value >
+struct deferred_argument_impl
+{
+    typedef basic_deferred_message< CharT > message_type;
+    typedef typename message_type::stream_type stream_type;
+
+    static void capture(std::vector< unsigned char >& buf, T const& arg)
+    {
+        message_type::encode_argument(buf, &deferred_argument_impl::decode, boost::addressof(arg), sizeof(T));
+    }
+
+    static void decode(stream_type& strm, const void* data, std::size_t)
+    {
+        typename aligned_storage< sizeof(T), alignment_of< T >::value >::type storage;
+        std::memcpy(&storage, data, sizeof(T));
+        strm << *static_cast< const T* >(static_cast< const void* >(&storage));
+    }
+};
+
+//! Argument capturing implementation for the types that have to be formatted immediately
+template< typename T, typename CharT >
+struct deferred_argument_impl< T, CharT, false >
+{
+    typedef basic_deferred_message< CharT > message_type;
+    typedef typename message_type::stream_type stream_type;
+    typedef typename message_type::string_type string_type;
+
+    static void capture(std::vector< unsigned char >& buf, T const& arg)
+    {
+        string_type str;
+        stream_type strm(str);
+        strm << arg;
+        strm.flush();
+        message_type::encode_argument(buf, &deferred_argument_impl::decode, str.data(), str.size() * sizeof(CharT));
+    }
+
+    static void decode(stream_type& strm, const void* data, std::size_t size)
+    {
+        strm.write(static_cast< const CharT* >(data), static_cast< std::streamsize >(size / sizeof(CharT)));
+    }
+};
+
+//! Argument capturing implementation
+template< typename T, typename CharT >
+struct deferred_argument :
+    public deferred_argument_impl< T, CharT >
+{
+};
+
+//! Argument capturing implementation for C-style strings
+template< typename CharT >
+struct deferred_argument< const CharT*, CharT >
+{
+    typedef basic_deferred_message< CharT > message_type;
+    typedef typename message_type::stream_type stream_type;
+
+    static void capture(std::vector< unsigned char >& buf, const CharT* arg)
+    {
+        if (arg)
+            message_type::encode_argument(buf, &deferred_argument< std::basic_string< CharT >, CharT >::decode, arg, std::char_traits< CharT >::length(arg) * sizeof(CharT));
+        else
+            deferred_argument_impl< const void*, CharT >::capture(buf, arg);
+    }
+};
+
+//! Argument capturing implementation for C-style strings
+template< typename CharT >
+struct deferred_argument< CharT*, CharT > :
+    public deferred_argument< const CharT*, CharT >
+{
+};
+
+//! Argument capturing implementation for character arrays, which are treated as C-style strings
+template< typename CharT, std::size_t N >
+struct deferred_argument< CharT[N], CharT > :
+    public deferred_argument< const CharT*, CharT >
+{
+};
+
+//! Argument capturing implementation for strings
+template< typename CharT, typename TraitsT, typename AllocatorT >
+struct deferred_argument< std::basic_string< CharT, TraitsT, AllocatorT >, CharT >
+{
+    typedef basic_deferred_message< CharT > message_type;
+    typedef typename message_type::stream_type stream_type;
+
+    static void capture(std::vector< unsigned char >& buf, std::basic_string< CharT, TraitsT, AllocatorT > const& arg)
+    {
+        message_type::encode_argument(buf, &deferred_argument::decode, arg.data(), arg.size() * sizeof(CharT));
+    }
+
+    static void decode(stream_type& strm, const void* data, std::size_t size)
+    {
+        strm.write(static_cast< const CharT* >(data), static_cast< std::streamsize >(size / sizeof(CharT)));
+    }
+};
+
+//! Argument capturing implementation for string literals. Only the pointer to the literal is captured.
+template< typename CharT, typename TraitsT >
+struct deferred_argument< basic_string_literal< CharT, TraitsT >, CharT >
+{
+    typedef basic_deferred_message< CharT > message_type;
+    typedef typename message_type::stream_type stream_type;
+    typedef basic_string_literal< CharT, TraitsT > literal_type;
+
+    //! Captured literal
+    struct literal_ref
+    {
+        const CharT* str;
+        std::size_t size;
+    };
+
+    static void capture(std::vector< unsigned char >& buf, literal_type const& arg)
+    {
+        const literal_ref ref = { arg.c_str(), arg.size() };
+        message_type::encode_argument(buf, &deferred_argument::decode, &ref, sizeof(ref));
+    }
+
+    static void decode(stream_type& strm, const void* data, std::size_t)
+    {
+        const literal_ref* ref = static_cast< const literal_ref* >(data);
+        strm.write(ref->str, static_cast< std::streamsize >(ref->size));
+    }
+};
+
+/*!
+ * \brief Deferred message attribute value
+ *
+ * The attribute value is dispatched as a \c basic_deferred_message object to the visitors that support it.
+ * Other visitors receive the formatted message string. The string is composed on the first such request,
+ * which normally happens in a sink, and is cached afterwards.
+ */
+template< typename CharT >
+class deferred_message_value :
+    public attribute_value::impl
+{
+public:
+    //! Message type
+    typedef basic_deferred_message< CharT > message_type;
+    //! String type
+    typedef typename message_type::string_type string_type;
+
+private:
+    //! Deferred message
+    const message_type m_message;
+    //! The flag indicates whether the message has been formatted
+    once_block_flag m_formatted;
+    //! Formatted message
+    string_type m_text;
+
+public:
+    //! Initializing constructor. Takes over the encoded arguments, \a data is left empty.
+    deferred_message_value(const CharT* fmt, std::size_t fmt_size, std::vector< unsigned char >& data) :
+        m_message(fmt, fmt_size, data),
+        m_formatted()
+    {
+    }
+
+    //! Attribute value dispatching method
+    virtual bool dispatch(type_dispatcher& dispatcher)
+    {
+        type_dispatcher::callback< message_type > message_callback = dispatcher.get_callback< message_type >();
+        if (message_callback)
+        {
+            message_callback(m_message);
+            return true;
+        }
+
+        type_dispatcher::callback< string_type > callback = dispatcher.get_callback< string_type >();
+        if (callback)
+        {
+            BOOST_LOG_ONCE_BLOCK_FLAG(m_formatted)
+            {
+                m_text = m_message.str();
+            }
+            callback(m_text);
+            return true;
+        }
+        else
+            return false;
+    }
+
+    //! The method returns the type of the formatted message
+    type_info_wrapper get_type() const { return type_info_wrapper(typeid(string_type)); }
+};
+
+/*!
+ * \brief Logging record pump implementation for deferred messages
+ *
+ * The pump captures the message arguments into a buffer and then pushes the record
+ * to the logging core. It is constructed on each attempt to write a log record and
+ * destroyed afterwards.
+ */
+template< typename LoggerT, typename CharT >
+class deferred_record_pump
+{
+    BOOST_MOVABLE_BUT_NOT_COPYABLE(deferred_record_pump)
+
+private:
+    //! Logger type
+    typedef LoggerT logger_type;
+    //! Character type
+    typedef CharT char_type;
+    //! Buffer compound type
+    typedef deferred_buffer_provider::buffer_compound buffer_compound;
+
+    //! Buffer compound release guard
+    class auto_release
+    {
+        buffer_compound* m_pCompound;
+
+    public:
+        explicit auto_release(buffer_compound* p) BOOST_NOEXCEPT : m_pCompound(p) {}
+        ~auto_release() BOOST_NOEXCEPT { deferred_buffer_provider::release_compound(m_pCompound); }
+    };
+
+private:
+    //! A reference to the logger
+    logger_type* m_pLogger;
+    //! A reference to the record
+    record* m_pRecord;
+    //! Buffer compound
+    buffer_compound* m_pCompound;
+    //! Format string
+    const char_type* m_pFormat;
+    //! Format string length
+    std::size_t m_FormatSize;
+    //! Exception state
+    const unsigned int m_ExceptionCount;
+
+public:
+    //! Constructor
+    deferred_record_pump(logger_type& lg, record& rec, const char_type* fmt, std::size_t fmt_size) :
+        m_pLogger(boost::addressof(lg)),
+        m_pRecord(boost::addressof(rec)),
+        m_pCompound(deferred_buffer_provider::allocate_compound()),
+        m_pFormat(fmt),
+        m_FormatSize(fmt_size),
+        m_ExceptionCount(unhandled_exception_count())
+    {
+    }
+    //! Move constructor
+    deferred_record_pump(BOOST_RV_REF(deferred_record_pump) that) BOOST_NOEXCEPT :
+        m_pLogger(that.m_pLogger),
+        m_pRecord(that.m_pRecord),
+        m_pCompound(that.m_pCompound),
+        m_pFormat(that.m_pFormat),
+        m_FormatSize(that.m_FormatSize),
+        m_ExceptionCount(that.m_ExceptionCount)
+    {
+        that.m_pLogger = 0;
+        that.m_pCompound = 0;
+    }
+    //! Destructor. Attaches the message to the record and pushes it to log.
+    ~deferred_record_pump() BOOST_NOEXCEPT_IF(false)
+    {
+        if (m_pLogger)
+        {
+            auto_release cleanup(m_pCompound); // destructor doesn't throw
+            // Only push the record if no exception has been thrown in the argument expressions (if possible)
+            if (m_ExceptionCount >= unhandled_exception_count())
+            {
+                // The message takes over the pooled buffer. The compound receives a fresh buffer
+                // of the same size so that the next record does not have to grow it again.
+                std::vector< unsigned char >& buf = m_pCompound->buffer;
+                std::vector< unsigned char > next_buf;
+                next_buf.reserve(buf.size());
+                attribute_value value(new deferred_message_value< char_type >(m_pFormat, m_FormatSize, buf));
+                buf.swap(next_buf);
+
+                // This may fail if the record already has Message attribute
+                std::pair< attribute_value_set::const_iterator, bool > res =
+                    m_pRecord->attribute_values().insert(default_attribute_names::message(), value);
+                if (!res.second)
+                    const_cast< attribute_value& >(res.first->second).swap(value);
+
+                m_pLogger->push_record(boost::move(*m_pRecord));
+            }
+        }
+    }
+
+    //! Captures the next message argument
+    template< typename T >
+    deferred_record_pump& operator% (T const& arg)
+    {
+        BOOST_ASSERT(m_pCompound != 0);
+        deferred_argument< T, char_type >::capture(m_pCompound->buffer, arg);
+        return *this;
+    }
+};
+
+template< typename LoggerT, typename CharT, std::size_t N >
+BOOST_FORCEINLINE deferred_record_pump< LoggerT, CharT > make_deferred_record_pump(LoggerT& lg, record& rec, const CharT (&fmt)[N])
+{
+    return deferred_record_pump< LoggerT, CharT >(lg, rec, fmt, N - 1u);
+}
+
+} // namespace aux
+
+#ifndef BOOST_LOG_DOXYGEN_PASS
+
+#define BOOST_LOG_DEFERRED_INTERNAL(logger, rec_var, fmt)\
+    for (::boost::log::record rec_var = (logger).open_record(); !!rec_var;)\
+        ::boost::log::aux::make_deferred_record_pump((logger), rec_var, fmt)
+
+#define BOOST_LOG_DEFERRED_WITH_PARAMS_INTERNAL(logger, rec_var, params_seq, fmt)\
+    for (::boost::log::record rec_var = (logger).open_record((BOOST_PP_SEQ_ENUM(params_seq))); !!rec_var;)\
+        ::boost::log::aux::make_deferred_record_pump((logger), rec_var, fmt)
+
+#endif // BOOST_LOG_DOXYGEN_PASS
+
+/*!
+ * The macro writes a record with a deferred message to the log. The format string must be a string literal,
+ * the message arguments are passed with <tt>operator%</tt>, similar to the \c format formatter:
+ *
+ * <code>
+ * BOOST_LOG_DEFERRED(lg, "Received %1% bytes from %2%") % size % peer;
+ * </code>
+ */
+#define BOOST_LOG_DEFERRED(logger, fmt)\
+    BOOST_LOG_DEFERRED_INTERNAL(logger, BOOST_LOG_UNIQUE_IDENTIFIER_NAME(_boost_log_record_), fmt)
+
+//! The macro writes a record with a deferred message to the log and allows to pass additional named arguments to the logger
+#define BOOST_LOG_DEFERRED_WITH_PARAMS(logger, params_seq, fmt)\
+    BOOST_LOG_DEFERRED_WITH_PARAMS_INTERNAL(logger, BOOST_LOG_UNIQUE_IDENTIFIER_NAME(_boost_log_record_), params_seq, fmt)
+
+//! The macro writes a record with a deferred message and the specified severity level to the log
+#define BOOST_LOG_DEFERRED_SEV(logger, lvl, fmt)\
+    BOOST_LOG_IF_SEVERITY_ENABLED_INTERNAL(lvl)\
+        BOOST_LOG_DEFERRED_WITH_PARAMS((logger), (::boost::log::keywords::severity = BOOST_LOG_SEVERITY_INTERNAL(lvl)), fmt)
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_SOURCES_DEFERRED_RECORD_HPP_INCLUDED_
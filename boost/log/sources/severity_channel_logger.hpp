@@ -295,7 +295,8 @@ BOOST_LOG_CLOSE_NAMESPACE // namespace log
 
 //! The macro allows to put a record with a specific channel name into log
 #define BOOST_LOG_STREAM_CHANNEL_SEV(logger, chan, lvl)\
-    BOOST_LOG_STREAM_WITH_PARAMS((logger), (::boost::log::keywords::channel = (chan))(::boost::log::keywords::severity = (lvl)))
+    BOOST_LOG_IF_SEVERITY_ENABLED_INTERNAL(lvl)\
+        BOOST_LOG_STREAM_WITH_PARAMS((logger), (::boost::log::keywords::channel = (chan))(::boost::log::keywords::severity = BOOST_LOG_SEVERITY_INTERNAL(lvl)))
 
 #ifndef BOOST_LOG_NO_SHORTHAND_NAMES
 
@@ -15,20 +15,28 @@
 #ifndef BOOST_LOG_SOURCES_SEVERITY_FEATURE_HPP_INCLUDED_
 #define BOOST_LOG_SOURCES_SEVERITY_FEATURE_HPP_INCLUDED_
 
+#include <string>
 #include <boost/cstdint.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 #include <boost/move/core.hpp>
 #include <boost/move/utility.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_enum.hpp>
+#include <boost/type_traits/is_integral.hpp>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/locks.hpp>
 #include <boost/log/detail/default_attribute_names.hpp>
+#include <boost/log/detail/static_severity_threshold.hpp>
 #include <boost/log/attributes/attribute.hpp>
 #include <boost/log/attributes/attribute_cast.hpp>
 #include <boost/log/attributes/attribute_value_impl.hpp>
 #include <boost/log/utility/strictest_lock.hpp>
 #include <boost/log/utility/type_dispatch/type_dispatcher.hpp>
 #include <boost/log/keywords/severity.hpp>
+#include <boost/log/keywords/module.hpp>
+#include <boost/log/core/core.hpp>
 #include <boost/log/core/record.hpp>
 #include <boost/log/detail/header.hpp>
 
@@ -186,6 +194,8 @@ private:
     severity_level m_DefaultSeverity;
     //! Severity attribute
     severity_attribute m_SeverityAttr;
+    //! Severity threshold of the module the logger belongs to, or \c NULL if the logger does not belong to a module
+    boost::log::aux::module_severity_threshold const* m_pModuleThreshold;
 
 public:
     /*!
@@ -194,7 +204,8 @@ public:
      */
     basic_severity_logger() :
         base_type(),
-        m_DefaultSeverity(static_cast< severity_level >(0))
+        m_DefaultSeverity(static_cast< severity_level >(0)),
+        m_pModuleThreshold(NULL)
     {
         base_type::add_attribute_unlocked(boost::log::aux::default_attribute_names::severity(), m_SeverityAttr);
     }
@@ -204,7 +215,8 @@ public:
     basic_severity_logger(basic_severity_logger const& that) :
         base_type(static_cast< base_type const& >(that)),
         m_DefaultSeverity(that.m_DefaultSeverity),
-        m_SeverityAttr(that.m_SeverityAttr)
+        m_SeverityAttr(that.m_SeverityAttr),
+        m_pModuleThreshold(that.m_pModuleThreshold)
     {
         base_type::attributes()[boost::log::aux::default_attribute_names::severity()] = m_SeverityAttr;
     }
@@ -214,7 +226,8 @@ public:
     basic_severity_logger(BOOST_RV_REF(basic_severity_logger) that) :
         base_type(boost::move(static_cast< base_type& >(that))),
         m_DefaultSeverity(boost::move(that.m_DefaultSeverity)),
-        m_SeverityAttr(boost::move(that.m_SeverityAttr))
+        m_SeverityAttr(boost::move(that.m_SeverityAttr)),
+        m_pModuleThreshold(that.m_pModuleThreshold)
     {
         base_type::attributes()[boost::log::aux::default_attribute_names::severity()] = m_SeverityAttr;
     }
@@ -223,11 +236,15 @@ public:
      *
      * \param args A set of named arguments. The following arguments are supported:
      *             \li \c severity - default severity value
+     *             \li \c module - the name of the module the logger belongs to. The logger will use the severity threshold
+     *                              of the module, see <tt>core::set_severity_threshold</tt>. By default the logger
+     *                              does not belong to a module and uses the global threshold.
      */
     template< typename ArgsT >
     explicit basic_severity_logger(ArgsT const& args) :
         base_type(args),
-        m_DefaultSeverity(args[keywords::severity | severity_level()])
+        m_DefaultSeverity(args[keywords::severity | severity_level()]),
+        m_pModuleThreshold(get_module_threshold(args[keywords::module | std::string()]))
     {
         base_type::add_attribute_unlocked(boost::log::aux::default_attribute_names::severity(), m_SeverityAttr);
     }
@@ -249,7 +266,12 @@ protected:
     template< typename ArgsT >
     record open_record_unlocked(ArgsT const& args)
     {
-        m_SeverityAttr.set_value(args[keywords::severity | m_DefaultSeverity]);
+        severity_level level = args[keywords::severity | m_DefaultSeverity];
+        typedef typename mpl::or_< is_integral< severity_level >, is_enum< severity_level > >::type has_threshold;
+        if (is_below_threshold(level, has_threshold()))
+            return record();
+
+        m_SeverityAttr.set_value(level);
         return base_type::open_record_unlocked(args);
     }
 
@@ -261,6 +283,29 @@ protected:
         m_DefaultSeverity = that.m_DefaultSeverity;
         that.m_DefaultSeverity = t;
         m_SeverityAttr.swap(that.m_SeverityAttr);
+        boost::log::aux::module_severity_threshold const* p = m_pModuleThreshold;
+        m_pModuleThreshold = that.m_pModuleThreshold;
+        that.m_pModuleThreshold = p;
+    }
+
+private:
+    //! The method checks the level against the severity threshold of the logging core or the module
+    bool is_below_threshold(severity_level level, mpl::true_) const
+    {
+        if (m_pModuleThreshold)
+            return static_cast< int >(level) < this->core()->get_severity_threshold(m_pModuleThreshold);
+        return static_cast< int >(level) < this->core()->get_severity_threshold();
+    }
+    //! The severity threshold is not applicable to non-integral severity levels
+    static bool is_below_threshold(severity_level const&, mpl::false_)
+    {
+        return false;
+    }
+
+    //! The method returns the severity threshold of the module
+    boost::log::aux::module_severity_threshold const* get_module_threshold(std::string const& module) const
+    {
+        return module.empty() ? NULL : this->core()->get_module_severity_threshold(module);
     }
 };
 
@@ -294,9 +339,15 @@ BOOST_LOG_CLOSE_NAMESPACE // namespace log
 
 } // namespace boost
 
-//! The macro allows to put a record with a specific severity level into log
+/*!
+ * The macro allows to put a record with a specific severity level into log.
+ *
+ * If \c BOOST_LOG_STATIC_SEVERITY_THRESHOLD is defined to a constant expression, the statements with levels below
+ * the threshold are removed by the compiler, including the evaluation of the streaming expression.
+ */
 #define BOOST_LOG_STREAM_SEV(logger, lvl)\
-    BOOST_LOG_STREAM_WITH_PARAMS((logger), (::boost::log::keywords::severity = (lvl)))
+    BOOST_LOG_IF_SEVERITY_ENABLED_INTERNAL(lvl)\
+        BOOST_LOG_STREAM_WITH_PARAMS((logger), (::boost::log::keywords::severity = BOOST_LOG_SEVERITY_INTERNAL(lvl)))
 
 #ifndef BOOST_LOG_NO_SHORTHAND_NAMES
 
@@ -110,8 +110,9 @@ struct logger
  * \endcode
  */
 #define BOOST_LOG_TRIVIAL(lvl)\
-    BOOST_LOG_STREAM_WITH_PARAMS(::boost::log::trivial::logger::get(),\
-        (::boost::log::keywords::severity = ::boost::log::trivial::lvl))
+    BOOST_LOG_IF_SEVERITY_ENABLED_INTERNAL(::boost::log::trivial::lvl)\
+        BOOST_LOG_STREAM_WITH_PARAMS(::boost::log::trivial::logger::get(),\
+            (::boost::log::keywords::severity = BOOST_LOG_SEVERITY_INTERNAL(::boost::log::trivial::lvl)))
 
 } // namespace trivial
 
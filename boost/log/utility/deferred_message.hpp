@@ -0,0 +1,199 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   deferred_message.hpp
+ * \author Andrey Semashev
+ * \date   14.06.2015
+ *
+ * The header contains definition of the deferred message, which holds the format string and
+ * the raw argument bytes of a log record message that is to be formatted later.
+ */
+
+#ifndef BOOST_LOG_UTILITY_DEFERRED_MESSAGE_HPP_INCLUDED_
+#define BOOST_LOG_UTILITY_DEFERRED_MESSAGE_HPP_INCLUDED_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <iosfwd>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/utility/formatting_ostream_fwd.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+/*!
+ * \brief A log record message with deferred formatting
+ *
+ * The deferred message stores a pointer to the format string and a buffer of encoded arguments.
+ * Each argument is encoded as a pointer to the decoder function, the argument size and the argument
+ * bytes. The decoder is called when the message is formatted, which normally happens in the sink.
+ *
+ * The format string must have static storage duration, its address is used as an identifier
+ * of the call site. Each format string is parsed once per thread, on the first formatting request,
+ * and the parsed description is reused afterwards. The format string syntax is the same as with the \c format formatter, i.e.
+ * placeholders in the form "%N%" refer to the arguments, starting from 1.
+ */
+template< typename CharT >
+class basic_deferred_message
+{
+public:
+    //! Character type
+    typedef CharT char_type;
+    //! String type
+    typedef std::basic_string< char_type > string_type;
+    //! Stream type
+    typedef basic_formatting_ostream< char_type > stream_type;
+    //! Argument decoder type. The decoder receives a pointer to the argument bytes and their size.
+    typedef void (*decoder_type)(stream_type& strm, const void* data, std::size_t size);
+
+    /*!
+     * Encoded argument header. The header is followed by the argument bytes, padded so that the next
+     * header is suitably aligned.
+     */
+    struct argument_header
+    {
+        //! Argument decoder
+        decoder_type decoder;
+        //! Size of the argument bytes
+        std::size_t size;
+    };
+
+private:
+    //! Format string
+    const char_type* m_format;
+    //! Format string length
+    std::size_t m_format_size;
+    //! Encoded arguments
+    std::vector< unsigned char > m_data;
+
+public:
+    /*!
+     * Default constructor. Creates an empty message.
+     */
+    basic_deferred_message() : m_format(NULL), m_format_size(0) {}
+    /*!
+     * Initializing constructor.
+     *
+     * \param fmt Format string. The string must stay valid for the whole lifetime of the message.
+     * \param fmt_size Format string length.
+     * \param data Pointer to the encoded arguments.
+     * \param size Size of the encoded arguments, in bytes.
+     */
+    basic_deferred_message(const char_type* fmt, std::size_t fmt_size, const void* data, std::size_t size) :
+        m_format(fmt),
+        m_format_size(fmt_size),
+        m_data(static_cast< const unsigned char* >(data), static_cast< const unsigned char* >(data) + size)
+    {
+    }
+    /*!
+     * Initializing constructor. Takes over the encoded arguments without copying them.
+     *
+     * \param fmt Format string. The string must stay valid for the whole lifetime of the message.
+     * \param fmt_size Format string length.
+     * \param data Buffer with the encoded arguments. The buffer is left empty after the call.
+     */
+    basic_deferred_message(const char_type* fmt, std::size_t fmt_size, std::vector< unsigned char >& data) :
+        m_format(fmt),
+        m_format_size(fmt_size)
+    {
+        m_data.swap(data);
+    }
+
+    //! Returns the format string
+    const char_type* format() const BOOST_NOEXCEPT { return m_format; }
+    //! Returns the format string length
+    std::size_t format_size() const BOOST_NOEXCEPT { return m_format_size; }
+    //! Returns the pointer to the encoded arguments
+    const unsigned char* data() const BOOST_NOEXCEPT { return m_data.empty() ? NULL : &m_data[0]; }
+    //! Returns the size of the encoded arguments, in bytes
+    std::size_t size() const BOOST_NOEXCEPT { return m_data.size(); }
+
+    /*!
+     * Formats the message into the stream. Placeholders that refer to missing arguments are
+     * formatted as empty strings, excessive arguments are ignored.
+     *
+     * \throws parse_error If the format string is invalid.
+     */
+    BOOST_LOG_API void format_to(stream_type& strm) const;
+
+    /*!
+     * \return The formatted message
+     */
+    BOOST_LOG_API string_type str() const;
+
+    /*!
+     * Encodes an argument and appends it to the buffer
+     *
+     * \param buf Buffer with encoded arguments
+     * \param decoder Argument decoder
+     * \param data Argument bytes
+     * \param size Size of the argument bytes
+     */
+    static void encode_argument(std::vector< unsigned char >& buf, decoder_type decoder, const void* data, std::size_t size)
+    {
+        const argument_header header = { decoder, size };
+        const std::size_t pos = buf.size();
+        buf.resize(pos + sizeof(argument_header) + aligned_size(size));
+        unsigned char* p = &buf[pos];
+        std::memcpy(p, &header, sizeof(argument_header));
+        if (size > 0)
+            std::memcpy(p + sizeof(argument_header), data, size);
+    }
+
+    /*!
+     * \return The size of the argument bytes, including padding
+     */
+    static std::size_t aligned_size(std::size_t size) BOOST_NOEXCEPT
+    {
+        const std::size_t alignment = alignment_of< argument_header >::value;
+        return (size + (alignment - 1u)) & ~(alignment - 1u);
+    }
+};
+
+#ifdef BOOST_LOG_USE_CHAR
+typedef basic_deferred_message< char > deferred_message;        //!< Convenience typedef for narrow-character messages
+#endif
+#ifdef BOOST_LOG_USE_WCHAR_T
+typedef basic_deferred_message< wchar_t > wdeferred_message;    //!< Convenience typedef for wide-character messages
+#endif
+
+/*!
+ * Formats the deferred message into the stream
+ */
+template< typename CharT >
+inline basic_formatting_ostream< CharT >& operator<< (basic_formatting_ostream< CharT >& strm, basic_deferred_message< CharT > const& msg)
+{
+    msg.format_to(strm);
+    return strm;
+}
+
+/*!
+ * Formats the deferred message into the stream
+ */
+template< typename CharT, typename TraitsT >
+inline std::basic_ostream< CharT, TraitsT >& operator<< (std::basic_ostream< CharT, TraitsT >& strm, basic_deferred_message< CharT > const& msg)
+{
+    strm << msg.str();
+    return strm;
+}
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_UTILITY_DEFERRED_MESSAGE_HPP_INCLUDED_
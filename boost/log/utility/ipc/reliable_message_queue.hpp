@@ -0,0 +1,290 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   utility/ipc/reliable_message_queue.hpp
+ * \author Andrey Semashev
+ * \date   09.08.2015
+ *
+ * The header contains declaration of a reliable interprocess message queue.
+ */
+
+#ifndef BOOST_LOG_UTILITY_IPC_RELIABLE_MESSAGE_QUEUE_HPP_INCLUDED_
+#define BOOST_LOG_UTILITY_IPC_RELIABLE_MESSAGE_QUEUE_HPP_INCLUDED_
+
+#include <string>
+#include <cstddef>
+#include <boost/cstdint.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/utility/explicit_operator_bool.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace ipc {
+
+/*!
+ * \brief A reliable interprocess message queue
+ *
+ * The queue is a ring buffer of messages placed in a named shared memory segment. Any number of processes
+ * can open the queue by its name and send or receive messages concurrently. Every message is received by
+ * exactly one receiver, in the order the messages were sent. Messages are arbitrary byte sequences of variable size,
+ * each message occupies its size plus a 4 byte header in the queue storage.
+ *
+ * The queue is protected by an interprocess mutex placed in the shared memory. If a process terminates while holding
+ * the mutex the queue may become unusable, unless the interprocess synchronization primitives are configured
+ * to detect dead owners (see \c BOOST_INTERPROCESS_ENABLE_FUTEX_SYNC in Boost.Interprocess).
+ *
+ * The shared memory segment persists until it is removed by the \c remove method, even if no process has the queue
+ * opened. Typically, the receiving process creates the queue and removes it when it terminates.
+ */
+class reliable_message_queue
+{
+public:
+    //! Queue opening modes
+    enum open_mode
+    {
+        create_only,    //!< Create a new queue, fail if a queue with the same name already exists
+        open_or_create, //!< Open the existing queue or create a new one if there is none
+        open_only       //!< Open the existing queue, fail if there is none
+    };
+
+    //! The action to take when a message is sent to a full queue
+    enum overflow_policy
+    {
+        block_on_overflow,  //!< Block until the queue has enough free space for the message
+        drop_on_overflow,   //!< Discard the message and return \c dropped
+        throw_on_overflow   //!< Throw \c limitation_error
+    };
+
+    //! Results of the queue operations
+    enum operation_result
+    {
+        succeeded,  //!< The operation has completed successfully
+        dropped,    //!< The message was not sent because the queue is full and the overflow policy is \c drop_on_overflow
+        aborted     //!< The blocking operation was interrupted by the \c stop_local method
+    };
+
+    //! Size type
+    typedef uint32_t size_type;
+
+private:
+    //! Implementation type
+    struct implementation;
+
+private:
+    //! Pointer to the implementation
+    implementation* m_pImpl;
+
+public:
+    /*!
+     * Default constructor. Creates an object that is not associated with any queue.
+     *
+     * \post <tt>is_open() == false</tt>
+     */
+    reliable_message_queue() BOOST_NOEXCEPT : m_pImpl(NULL)
+    {
+    }
+
+    /*!
+     * Constructor. Opens or creates the queue with the specified name.
+     *
+     * \param mode The queue opening mode.
+     * \param name The queue name. The name must be a valid name of a shared memory object on the target system.
+     * \param capacity The size of the queue storage, in bytes. Only used when the queue is created, otherwise
+     *                 the capacity of the existing queue is used.
+     * \param policy The overflow policy. The policy is local for this object, different processes may use different policies
+     *               with the same queue.
+     *
+     * \post <tt>is_open() == true</tt>
+     *
+     * \throws \c setup_error if the queue cannot be opened or created, \c limitation_error if \a capacity is too small or too large.
+     */
+    BOOST_LOG_API reliable_message_queue
+    (
+        open_mode mode,
+        std::string const& name,
+        size_type capacity = 64u * 1024u,
+        overflow_policy policy = block_on_overflow
+    );
+
+    /*!
+     * Destructor. Closes the queue, if opened. The queue is not removed from the system.
+     */
+    BOOST_LOG_API ~reliable_message_queue();
+
+    /*!
+     * Swaps the two queue objects.
+     */
+    void swap(reliable_message_queue& that) BOOST_NOEXCEPT
+    {
+        implementation* p = m_pImpl;
+        m_pImpl = that.m_pImpl;
+        that.m_pImpl = p;
+    }
+
+    /*!
+     * Opens or creates the queue. If the object is already associated with a queue, that queue is closed first.
+     * The parameters have the same meaning as the parameters of the corresponding constructor.
+     */
+    BOOST_LOG_API void open
+    (
+        open_mode mode,
+        std::string const& name,
+        size_type capacity = 64u * 1024u,
+        overflow_policy policy = block_on_overflow
+    );
+
+    /*!
+     * \return \c true if the object is associated with a queue, \c false otherwise.
+     */
+    bool is_open() const BOOST_NOEXCEPT
+    {
+        return m_pImpl != NULL;
+    }
+
+    /*!
+     * Closes the queue. The queue is not removed from the system and can be opened again by its name.
+     *
+     * \post <tt>is_open() == false</tt>
+     */
+    BOOST_LOG_API void close() BOOST_NOEXCEPT;
+
+    /*!
+     * \return The name of the queue.
+     *
+     * \pre <tt>is_open() == true</tt>
+     */
+    BOOST_LOG_API std::string const& name() const;
+
+    /*!
+     * \return The size of the queue storage, in bytes.
+     *
+     * \pre <tt>is_open() == true</tt>
+     */
+    BOOST_LOG_API size_type capacity() const;
+
+    /*!
+     * \return The maximum size of a message that can be sent to the queue, in bytes. This is the queue capacity
+     *         less the message header size.
+     *
+     * \pre <tt>is_open() == true</tt>
+     */
+    BOOST_LOG_API size_type max_message_size() const;
+
+    /*!
+     * Sends a message to the queue. If the queue does not have enough free space for the message, the action
+     * specified by the overflow policy is taken.
+     *
+     * \pre <tt>is_open() == true</tt>
+     *
+     * \param message_data Pointer to the message contents.
+     * \param message_size The message size, in bytes.
+     * \return \c succeeded if the message has been sent, \c dropped if the message was discarded due to the overflow policy,
+     *         \c aborted if the operation was interrupted by \c stop_local.
+     *
+     * \throws \c limitation_error if the message can never fit into the queue or if the queue is full
+     *         and the overflow policy is \c throw_on_overflow.
+     */
+    BOOST_LOG_API operation_result send(void const* message_data, size_type message_size);
+
+    /*!
+     * Attempts to send a message to the queue without blocking.
+     *
+     * \pre <tt>is_open() == true</tt>
+     *
+     * \return \c true if the message has been sent, \c false if the queue does not have enough free space for the message.
+     *
+     * \throws \c limitation_error if the message can never fit into the queue.
+     */
+    BOOST_LOG_API bool try_send(void const* message_data, size_type message_size);
+
+    /*!
+     * Receives a message from the queue, blocking until a message is available. The received message replaces
+     * the contents of \a message.
+     *
+     * \pre <tt>is_open() == true</tt>
+     *
+     * \return \c succeeded if a message has been received, \c aborted if the operation was interrupted by \c stop_local.
+     */
+    BOOST_LOG_API operation_result receive(std::string& message);
+
+    /*!
+     * Attempts to receive a message from the queue without blocking. The received message replaces
+     * the contents of \a message.
+     *
+     * \pre <tt>is_open() == true</tt>
+     *
+     * \return \c true if a message has been received, \c false if the queue is empty.
+     */
+    BOOST_LOG_API bool try_receive(std::string& message);
+
+    /*!
+     * Wakes up all threads of the current process that are blocked in \c send or \c receive on this object
+     * and makes them return \c aborted. Subsequent blocking operations on this object also return \c aborted
+     * instead of blocking, until \c reset_local is called. Other processes using the queue are not affected.
+     *
+     * \pre <tt>is_open() == true</tt>
+     */
+    BOOST_LOG_API void stop_local();
+
+    /*!
+     * Resets the effect of \c stop_local, so that the blocking operations block again.
+     *
+     * \pre <tt>is_open() == true</tt>
+     */
+    BOOST_LOG_API void reset_local();
+
+    /*!
+     * Discards all messages in the queue.
+     *
+     * \pre <tt>is_open() == true</tt>
+     */
+    BOOST_LOG_API void clear();
+
+    /*!
+     * Removes the queue with the specified name from the system. Processes that have the queue opened
+     * can continue using it, but the name is no longer associated with it.
+     *
+     * \return \c true if the queue has been removed, \c false otherwise.
+     */
+    BOOST_LOG_API static bool remove(std::string const& name);
+
+    BOOST_EXPLICIT_OPERATOR_BOOL_NOEXCEPT()
+
+    /*!
+     * \return \c true if the object is not associated with a queue, \c false otherwise.
+     */
+    bool operator! () const BOOST_NOEXCEPT
+    {
+        return !is_open();
+    }
+
+    BOOST_DELETED_FUNCTION(reliable_message_queue(reliable_message_queue const&))
+    BOOST_DELETED_FUNCTION(reliable_message_queue& operator= (reliable_message_queue const&))
+};
+
+//! Swaps the two queue objects
+inline void swap(reliable_message_queue& left, reliable_message_queue& right) BOOST_NOEXCEPT
+{
+    left.swap(right);
+}
+
+} // namespace ipc
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_UTILITY_IPC_RELIABLE_MESSAGE_QUEUE_HPP_INCLUDED_
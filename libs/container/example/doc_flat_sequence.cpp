@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/detail/workaround.hpp>
+//[doc_flat_sequence
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
+#include <cassert>
+#include <utility>
+
+int main ()
+{
+   using namespace boost::container;
+
+   //A flat_map that stores up to 8 elements in an internal buffer
+   //and only allocates memory when that capacity is exceeded.
+   typedef small_vector<std::pair<int, int>, 8> small_seq_t;
+   typedef flat_map<int, int, std::less<int>, small_seq_t> small_flat_map_t;
+
+   small_flat_map_t small_map;
+   for(int i = 0; i != 8; ++i){
+      small_map.insert(std::pair<int, int>(i, i));
+   }
+   //Elements are still placed in the storage embedded in the object
+   const void *const first_elem = &*small_map.begin();
+   assert(first_elem >= (void*)&small_map && first_elem < (void*)(&small_map+1));
+
+   //A flat_set that never allocates memory: its capacity is fixed at compile time
+   typedef flat_set<int, std::less<int>, static_vector<int, 16> > static_flat_set_t;
+   static_flat_set_t static_set;
+   static_set.insert(3);
+   static_set.insert(1);
+   static_set.insert(2);
+   assert(static_set.size() == 3 && *static_set.begin() == 1);
+   assert(static_set.capacity() == 16);
+   return 0;
+}
+//]
+#include <boost/container/detail/config_end.hpp>
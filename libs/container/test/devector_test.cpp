@@ -0,0 +1,400 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/container/detail/config_begin.hpp>
+#include <memory>
+#include <deque>
+#include <iostream>
+#include <list>
+#include <string>
+
+#include <boost/container/devector.hpp>
+#include <boost/container/allocator.hpp>
+#include <boost/container/node_allocator.hpp>
+#include <boost/container/adaptive_pool.hpp>
+
+#include "print_container.hpp"
+#include "check_equal_containers.hpp"
+#include "dummy_test_allocator.hpp"
+#include "movable_int.hpp"
+#include <boost/move/utility_core.hpp>
+#include <boost/move/iterator.hpp>
+#include <boost/container/detail/mpl.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include "emplace_test.hpp"
+#include "propagate_allocator_test.hpp"
+#include "vector_test.hpp"
+#include "default_init_test.hpp"
+
+using namespace boost::container;
+
+namespace boost {
+namespace container {
+
+//Explicit instantiation to detect compilation errors
+template class boost::container::devector
+ < test::movable_and_copyable_int
+ , test::simple_allocator<test::movable_and_copyable_int> >;
+
+template class boost::container::devector
+ < test::movable_and_copyable_int
+ , test::dummy_test_allocator<test::movable_and_copyable_int> >;
+
+template class boost::container::devector
+ < test::movable_and_copyable_int
+ , std::allocator<test::movable_and_copyable_int> >;
+
+template class boost::container::devector
+   < test::movable_and_copyable_int
+   , allocator<test::movable_and_copyable_int> >;
+
+template class boost::container::devector
+   < test::movable_and_copyable_int
+   , std::allocator<test::movable_and_copyable_int>
+   , devector_options< growth_factor<growth_factor_100> >::type >;
+
+}}
+
+//Test recursive structures
+class recursive_devector
+{
+public:
+
+   recursive_devector & operator=(const recursive_devector &x)
+   {  this->devector_ = x.devector_;   return *this; }
+
+   int id_;
+   devector<recursive_devector> devector_;
+   devector<recursive_devector>::iterator it_;
+   devector<recursive_devector>::const_iterator cit_;
+   devector<recursive_devector>::reverse_iterator rit_;
+   devector<recursive_devector>::const_reverse_iterator crit_;
+};
+
+template<class IntType>
+bool do_test()
+{
+   //Test for recursive types
+   {
+      devector<recursive_devector> recursive_devector_devector;
+   }
+
+   {
+      //Now test move semantics
+      devector<recursive_devector> original;
+      devector<recursive_devector> move_ctor(boost::move(original));
+      devector<recursive_devector> move_assign;
+      move_assign = boost::move(move_ctor);
+      move_assign.swap(original);
+   }
+
+   //Alias devector types
+   typedef devector<IntType>  MyCntDevector;
+   typedef std::deque<int>    MyStdDeque;
+   const int max = 100;
+   {
+      MyCntDevector cntdevector;
+      MyStdDeque stddeque;
+
+      //Alternate insertions at both ends
+      for(int i = 0; i < max*100; ++i){
+         IntType move_me(i);
+         if(i % 3){
+            cntdevector.push_back(boost::move(move_me));
+            stddeque.push_back(i);
+         }
+         else{
+            cntdevector.push_front(boost::move(move_me));
+            stddeque.push_front(i);
+         }
+      }
+      if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+
+      cntdevector.clear();
+      stddeque.clear();
+
+      for(int i = 0; i < max*100; ++i){
+         IntType move_me(i);
+         cntdevector.push_front(boost::move(move_me));
+         stddeque.push_front(i);
+      }
+      if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+
+      //Erase from both ends
+      cntdevector.erase(cntdevector.begin());
+      stddeque.erase(stddeque.begin());
+      cntdevector.erase(cntdevector.end()-1);
+      stddeque.erase(stddeque.end()-1);
+      if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+
+      //Erase ranges closer to the front and closer to the back
+      cntdevector.erase(cntdevector.begin()+10, cntdevector.begin()+20);
+      stddeque.erase(stddeque.begin()+10, stddeque.begin()+20);
+      cntdevector.erase(cntdevector.end()-20, cntdevector.end()-10);
+      stddeque.erase(stddeque.end()-20, stddeque.end()-10);
+      if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+
+      //Insert in the middle, near the front and near the back
+      for(int i = 0; i < max; ++i){
+         IntType move_me(-i);
+         const std::size_t pos = (i % 3 == 0) ? 1u : (i % 3 == 1) ? cntdevector.size()/2 : cntdevector.size()-1;
+         cntdevector.insert(cntdevector.nth(pos), boost::move(move_me));
+         stddeque.insert(stddeque.begin()+pos, -i);
+      }
+      if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+
+      //FIFO usage must not grow the buffer indefinitely
+      cntdevector.clear();
+      stddeque.clear();
+      for(int i = 0; i < max; ++i){
+         IntType move_me(i);
+         cntdevector.push_back(boost::move(move_me));
+         stddeque.push_back(i);
+      }
+      const std::size_t cap = cntdevector.capacity();
+      for(int i = 0; i < max*100; ++i){
+         IntType move_me(i);
+         cntdevector.push_back(boost::move(move_me));
+         stddeque.push_back(i);
+         cntdevector.pop_front();
+         stddeque.pop_front();
+      }
+      if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+      if(cntdevector.capacity() > 2*cap) return false;
+
+      //Test insertion from list
+      {
+         std::list<int> l(50, int(1));
+         cntdevector.insert(cntdevector.begin(), l.begin(), l.end());
+         stddeque.insert(stddeque.begin(), l.begin(), l.end());
+         if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+         cntdevector.assign(l.begin(), l.end());
+         stddeque.assign(l.begin(), l.end());
+         if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+      }
+
+      cntdevector.resize_front(100);
+      stddeque.insert(stddeque.begin(), 50, 0);
+      if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+
+      cntdevector.resize_front(60);
+      stddeque.erase(stddeque.begin(), stddeque.begin()+40);
+      if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+
+      cntdevector.resize(200);
+      stddeque.resize(200);
+      if(!test::CheckEqualContainers(cntdevector, stddeque)) return false;
+   }
+
+   std::cout << std::endl << "Test OK!" << std::endl;
+   return true;
+}
+
+bool test_capacity_operations()
+{
+   typedef devector<int> devector_t;
+   devector_t d;
+   d.reserve_front(10);
+   if(d.front_free_capacity() < 10 || d.size() != 0)
+      return false;
+   const int *const buf = d.data();
+   for(int i = 0; i < 10; ++i){
+      d.unsafe_push_front(i);
+   }
+   if(d.data() != buf - 10 || d.front() != 9 || d.back() != 0)
+      return false;
+
+   d.reserve_back(20);
+   if(d.back_free_capacity() < 10 || d.front_free_capacity() != 0)
+      return false;
+   for(int i = 10; i < 20; ++i){
+      d.unsafe_push_back(i);
+   }
+   if(d.size() != 20 || d.back() != 19)
+      return false;
+
+   //Inserting an own element when reallocation is needed
+   d.shrink_to_fit();
+   if(d.capacity() != d.size())
+      return false;
+   d.push_back(d.front());
+   d.push_front(d.back());
+   if(d.size() != 22 || d.front() != 9 || d.back() != 9)
+      return false;
+
+   d.clear();
+   d.shrink_to_fit();
+   if(d.capacity() != 0)
+      return false;
+
+   //Custom growth factors are honored
+   typedef devector_options< growth_factor<growth_factor_100> >::type growth_100_option_t;
+   devector<int, new_allocator<int>, growth_100_option_t> d100;
+   d100.reserve(100);
+   d100.resize(100);
+   d100.push_back(1);
+   if(d100.capacity() != 200)
+      return false;
+   return true;
+}
+
+//Queue-like usage must not grow the buffer indefinitely even
+//if the value type can't be recentered in place (no nothrow move)
+bool test_queue_capacity()
+{
+   typedef devector<std::string> devector_t;
+   devector_t d;
+   for(int i = 0; i < 10; ++i){
+      d.push_back(std::string(20, char('a' + i)));
+   }
+   const std::size_t cap = d.capacity();
+   for(int i = 0; i < 100000; ++i){
+      d.push_back(std::string(20, char('a' + i % 10)));
+      d.pop_front();
+   }
+   if(d.size() != 10 || d.capacity() > 4*cap)
+      return false;
+   for(int i = 0; i < 10; ++i){
+      if(d[i] != std::string(20, char('a' + i)))
+         return false;
+   }
+   //Same usage through the front
+   for(int i = 0; i < 100000; ++i){
+      d.push_front(std::string(20, char('a' + i % 10)));
+      d.pop_back();
+   }
+   return d.size() == 10 && d.capacity() <= 4*cap;
+}
+
+template<class VoidAllocator>
+struct GetAllocatorCont
+{
+   template<class ValueType>
+   struct apply
+   {
+      typedef devector< ValueType
+                    , typename allocator_traits<VoidAllocator>
+                        ::template portable_rebind_alloc<ValueType>::type
+                    > type;
+   };
+};
+
+template<class VoidAllocator>
+int test_cont_variants()
+{
+   typedef typename GetAllocatorCont<VoidAllocator>::template apply<int>::type MyCont;
+   typedef typename GetAllocatorCont<VoidAllocator>::template apply<test::movable_int>::type MyMoveCont;
+   typedef typename GetAllocatorCont<VoidAllocator>::template apply<test::movable_and_copyable_int>::type MyCopyMoveCont;
+   typedef typename GetAllocatorCont<VoidAllocator>::template apply<test::copyable_int>::type MyCopyCont;
+
+   if(test::vector_test<MyCont>())
+      return 1;
+   if(test::vector_test<MyMoveCont>())
+      return 1;
+   if(test::vector_test<MyCopyMoveCont>())
+      return 1;
+   if(test::vector_test<MyCopyCont>())
+      return 1;
+   return 0;
+}
+
+struct boost_container_devector;
+
+namespace boost { namespace container {   namespace test {
+
+template<>
+struct alloc_propagate_base<boost_container_devector>
+{
+   template <class T, class Allocator>
+   struct apply
+   {
+      typedef boost::container::devector<T, Allocator> type;
+   };
+};
+
+}}}   //namespace boost::container::test
+
+int main ()
+{
+   if(!do_test<int>())
+      return 1;
+
+   if(!do_test<test::movable_int>())
+      return 1;
+
+   if(!do_test<test::movable_and_copyable_int>())
+      return 1;
+
+   if(!do_test<test::copyable_int>())
+      return 1;
+
+   if(!test_capacity_operations())
+      return 1;
+
+   if(!test_queue_capacity())
+      return 1;
+
+   ////////////////////////////////////
+   //    Allocator implementations
+   ////////////////////////////////////
+   //       std:allocator
+   if(test_cont_variants< std::allocator<void> >()){
+      std::cerr << "test_cont_variants< std::allocator<void> > failed" << std::endl;
+      return 1;
+   }
+   //       boost::container::allocator
+   if(test_cont_variants< allocator<void> >()){
+      std::cerr << "test_cont_variants< allocator<void> > failed" << std::endl;
+      return 1;
+   }
+   //       boost::container::node_allocator
+   if(test_cont_variants< node_allocator<void> >()){
+      std::cerr << "test_cont_variants< node_allocator<void> > failed" << std::endl;
+      return 1;
+   }
+   //       boost::container::adaptive_pool
+   if(test_cont_variants< adaptive_pool<void> >()){
+      std::cerr << "test_cont_variants< adaptive_pool<void> > failed" << std::endl;
+      return 1;
+   }
+   ////////////////////////////////////
+   //    Default init test
+   ////////////////////////////////////
+   if(!test::default_init_test< devector<int, test::default_init_allocator<int> > >()){
+      std::cerr << "Default init test failed" << std::endl;
+      return 1;
+   }
+
+   ////////////////////////////////////
+   //    Emplace testing
+   ////////////////////////////////////
+   const test::EmplaceOptions Options = (test::EmplaceOptions)(test::EMPLACE_BACK | test::EMPLACE_FRONT | test::EMPLACE_BEFORE);
+
+   if(!boost::container::test::test_emplace
+      < devector<test::EmplaceInt>, Options>())
+      return 1;
+   ////////////////////////////////////
+   //    Allocator propagation testing
+   ////////////////////////////////////
+   if(!boost::container::test::test_propagate_allocator<boost_container_devector>())
+      return 1;
+
+   ////////////////////////////////////
+   //    Initializer lists testing
+   ////////////////////////////////////
+   if(!boost::container::test::test_vector_methods_with_initializer_list_as_argument_for
+      < boost::container::devector<int> >()) {
+      return 1;
+   }
+
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
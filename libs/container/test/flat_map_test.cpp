@@ -13,6 +13,8 @@
 #include <boost/container/allocator.hpp>
 #include <boost/container/node_allocator.hpp>
 #include <boost/container/adaptive_pool.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
 #include <boost/container/detail/flat_tree.hpp>
 
 #include "print_container.hpp"
@@ -411,6 +413,19 @@ int test_map_variants()
    return 0;
 }
 
+template<class MyMap, class MyMultiMap>
+int test_map_sequence()
+{
+   typedef std::map<int, int>       MyStdMap;
+   typedef std::multimap<int, int>  MyStdMultiMap;
+
+   if (0 != test::map_test<MyMap, MyStdMap, MyMultiMap, MyStdMultiMap>()){
+      std::cout << "Error in map_test<MyBoostMap>" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
 int main()
 {
    using namespace boost::container::test;
@@ -473,6 +488,44 @@ int main()
       return 1;
    }
 
+   ////////////////////////////////////
+   //    Testing sequence container implementations
+   ////////////////////////////////////
+   //       boost::container::vector
+   if(test_map_sequence
+         < flat_map<int, int, std::less<int>, vector<std::pair<int, int> > >
+         , flat_multimap<int, int, std::less<int>, vector<std::pair<int, int> > > >()){
+      std::cerr << "test_map_sequence< vector > failed" << std::endl;
+      return 1;
+   }
+   //       boost::container::small_vector
+   if(test_map_sequence
+         < flat_map<int, int, std::less<int>, small_vector<std::pair<int, int>, 10> >
+         , flat_multimap<int, int, std::less<int>, small_vector<std::pair<int, int>, 10> > >()){
+      std::cerr << "test_map_sequence< small_vector > failed" << std::endl;
+      return 1;
+   }
+   //       boost::container::static_vector
+   if(test_map_sequence
+         < flat_map<int, int, std::less<int>, static_vector<std::pair<int, int>, 1000> >
+         , flat_multimap<int, int, std::less<int>, static_vector<std::pair<int, int>, 1000> > >()){
+      std::cerr << "test_map_sequence< static_vector > failed" << std::endl;
+      return 1;
+   }
+   {
+      //Elements are stored in the small_vector's internal buffer
+      typedef flat_map<int, int, std::less<int>, small_vector<std::pair<int, int>, 10> > small_flat_map_t;
+      small_flat_map_t m;
+      for(int i = 0; i != 10; ++i){
+         m.insert(std::pair<int, int>(9-i, i));
+      }
+      const void *const beg = &*m.begin();
+      if(beg < (void*)&m || beg >= (void*)(&m + 1))
+         return 1;
+      if(m.begin()->first != 0 || m.nth(9)->first != 9)
+         return 1;
+   }
+
    if(!boost::container::test::test_map_support_for_initialization_list_for<flat_map<int, int> >())
       return 1;
 
@@ -14,6 +14,8 @@
 #include <boost/container/allocator.hpp>
 #include <boost/container/node_allocator.hpp>
 #include <boost/container/adaptive_pool.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
 
 #include "print_container.hpp"
 #include "dummy_test_allocator.hpp"
@@ -455,6 +457,19 @@ int test_set_variants()
    return 0;
 }
 
+template<class MySet, class MyMultiSet>
+int test_set_sequence()
+{
+   typedef std::set<int>         MyStdSet;
+   typedef std::multiset<int>    MyStdMultiSet;
+
+   if (0 != test::set_test<MySet, MyStdSet, MyMultiSet, MyStdMultiSet>()){
+      std::cout << "Error in set_test<MyBoostSet>" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
 
 template<typename FlatSetType>
 bool test_support_for_initialization_list_for()
@@ -580,6 +595,31 @@ int main()
       return 1;
    }
 
+   ////////////////////////////////////
+   //    Testing sequence container implementations
+   ////////////////////////////////////
+   //       boost::container::vector
+   if(test_set_sequence
+         < flat_set<int, std::less<int>, vector<int> >
+         , flat_multiset<int, std::less<int>, vector<int> > >()){
+      std::cerr << "test_set_sequence< vector > failed" << std::endl;
+      return 1;
+   }
+   //       boost::container::small_vector
+   if(test_set_sequence
+         < flat_set<int, std::less<int>, small_vector<int, 10> >
+         , flat_multiset<int, std::less<int>, small_vector<int, 10> > >()){
+      std::cerr << "test_set_sequence< small_vector > failed" << std::endl;
+      return 1;
+   }
+   //       boost::container::static_vector
+   if(test_set_sequence
+         < flat_set<int, std::less<int>, static_vector<int, 1000> >
+         , flat_multiset<int, std::less<int>, static_vector<int, 1000> > >()){
+      std::cerr << "test_set_sequence< static_vector > failed" << std::endl;
+      return 1;
+   }
+
    ////////////////////////////////////
    //    Emplace testing
    ////////////////////////////////////
@@ -322,6 +322,43 @@ int test_set_variants()
    return 0;
 }
 
+//Range insertions, copies and assignments obtain nodes from the allocator
+//in bursts. Test they work with duplicated keys and partially recycled trees.
+template<class VoidAllocator>
+bool test_burst_allocation()
+{
+   typedef typename GetAllocatorSet<VoidAllocator, red_black_tree>::template apply<int>::set_type      set_t;
+   typedef typename GetAllocatorSet<VoidAllocator, red_black_tree>::template apply<int>::multiset_type multiset_t;
+   const int values[] = { 5, 1, 9, 1, 3, 5, 7, 9, 2, 8, 0, 3 };
+   const std::size_t num_values = sizeof(values)/sizeof(values[0]);
+   const std::set<int>       stdset(&values[0], &values[0] + num_values);
+   const std::multiset<int>  stdmultiset(&values[0], &values[0] + num_values);
+
+   set_t s(&values[0], &values[0] + num_values);
+   multiset_t ms(&values[0], &values[0] + num_values);
+   if(!test::CheckEqualContainers(s, stdset) || !test::CheckEqualContainers(ms, stdmultiset))
+      return false;
+
+   set_t s2;
+   s2.insert(3);
+   s2.insert(&values[0], &values[0] + num_values);
+   multiset_t ms2;
+   ms2.insert(&values[0], &values[0] + num_values/2);
+   ms2.insert(&values[0] + num_values/2, &values[0] + num_values);
+   if(!test::CheckEqualContainers(s2, stdset) || !test::CheckEqualContainers(ms2, stdmultiset))
+      return false;
+
+   //Copy assignment recycles existing nodes and allocates the rest
+   set_t s3;
+   s3.insert(100);
+   s3 = s;
+   multiset_t ms3(ms);
+   ms3.insert(&values[0], &values[0] + num_values);
+   ms3 = ms;
+   if(!test::CheckEqualContainers(s3, stdset) || !test::CheckEqualContainers(ms3, stdmultiset))
+      return false;
+   return true;
+}
 
 int main ()
 {
@@ -359,6 +396,12 @@ int main ()
       std::cerr << "test_set_variants< node_allocator<void> > failed" << std::endl;
       return 1;
    }
+   if(!test_burst_allocation< node_allocator<void> >() ||
+      !test_burst_allocation< adaptive_pool<void> >() ||
+      !test_burst_allocation< std::allocator<void> >()){
+      std::cerr << "test_burst_allocation failed" << std::endl;
+      return 1;
+   }
    //       boost::container::adaptive_pool
    if(test_set_variants< adaptive_pool<void>, red_black_tree>()){
       std::cerr << "test_set_variants< adaptive_pool<void> > failed" << std::endl;
@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/vector.hpp>
+#include <boost/container/allocator.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <stdexcept>
+#include "vector_test.hpp"
+#include "movable_int.hpp"
+
+using namespace boost::container;
+
+//Explicit instantiation to detect compilation errors
+template class boost::container::vector
+   < test::movable_and_copyable_int
+   , new_allocator<test::movable_and_copyable_int>
+   , vector_options< growth_factor<growth_factor_50>, stored_size<unsigned short> >::type >;
+
+template<class Unsigned, class VectorType>
+void test_stored_size_type_impl()
+{
+   VectorType v;
+   typedef typename VectorType::size_type    size_type;
+   typedef typename VectorType::value_type   value_type;
+   size_type const max = Unsigned(-1);
+   v.resize(5);
+   v.resize(max);
+   BOOST_TEST(v.max_size() == max);
+   BOOST_TRY{
+      v.resize(max+1);
+      BOOST_TEST(false);
+   }
+   BOOST_CATCH(std::length_error &){}
+   BOOST_CATCH_END
+   BOOST_TRY{
+      v.push_back(value_type(1));
+      BOOST_TEST(false);
+   }
+   BOOST_CATCH(std::length_error &){}
+   BOOST_CATCH_END
+   BOOST_TEST(v.size() == max);
+   v.clear();
+   v.shrink_to_fit();
+   BOOST_TRY{
+      v.reserve(max+1);
+      BOOST_TEST(false);
+   }
+   BOOST_CATCH(std::length_error &){}
+   BOOST_CATCH_END
+}
+
+template<class Unsigned>
+void test_stored_size_type()
+{
+   typedef typename vector_options< stored_size<Unsigned> >::type options_t;
+   //Test first with a typical allocator
+   {
+      typedef vector<unsigned char, new_allocator<unsigned char>, options_t> vector_t;
+      BOOST_TEST(sizeof(vector_t) < sizeof(vector<unsigned char>));
+      test_stored_size_type_impl<Unsigned, vector_t>();
+   }
+   //Test with a V2 allocator
+   {
+      typedef vector<unsigned char, allocator<unsigned char>, options_t> vector_t;
+      test_stored_size_type_impl<Unsigned, vector_t>();
+   }
+}
+
+template<class GrowthFactorType>
+void test_growth_factor(std::size_t first, std::size_t second)
+{
+   typedef typename vector_options< growth_factor<GrowthFactorType> >::type options_t;
+   vector<int, new_allocator<int>, options_t> v;
+   v.resize(100);
+   v.shrink_to_fit();
+   BOOST_TEST(v.capacity() == 100u);
+   v.push_back(0);
+   BOOST_TEST(v.capacity() == first);
+   v.resize(v.capacity());
+   v.push_back(0);
+   BOOST_TEST(v.capacity() == second);
+}
+
+int main()
+{
+   test_growth_factor<growth_factor_50>(150u, 225u);
+   test_growth_factor<growth_factor_60>(160u, 256u);
+   test_growth_factor<growth_factor_100>(200u, 400u);
+   test_stored_size_type<unsigned char>();
+   test_stored_size_type<unsigned short>();
+
+   //Default options must behave like a default vector
+   {
+      typedef vector_options<>::type options_t;
+      typedef vector<int, new_allocator<int>, options_t> vector_t;
+      BOOST_TEST(sizeof(vector_t) == sizeof(vector<int>));
+      if(test::vector_test<vector_t>())
+         return 1;
+   }
+   //Full vector test with non-default options
+   {
+      typedef vector_options< growth_factor<growth_factor_50>, stored_size<unsigned short> >::type options_t;
+      if(test::vector_test< vector<int, new_allocator<int>, options_t> >())
+         return 1;
+      if(test::vector_test< vector<int, allocator<int>, options_t> >())
+         return 1;
+   }
+   return ::boost::report_errors();
+}
+
+#include <boost/container/detail/config_end.hpp>
@@ -8,14 +8,19 @@
 //
 //////////////////////////////////////////////////////////////////////////////
 
+#include <boost/interprocess/detail/workaround.hpp>
+
 #if defined(BOOST_INTERPROCESS_MAPPED_FILES)
 
 #include <boost/interprocess/detail/config_begin.hpp>
 #include <boost/interprocess/allocators/allocator.hpp>
 #include <boost/interprocess/containers/vector.hpp>
 #include <boost/interprocess/managed_mapped_file.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
 #include <cstdio>
+#include <cstring>
 #include <string>
+#include <vector>
 #include "get_process_id_name.hpp"
 
 using namespace boost::interprocess;
@@ -28,6 +33,120 @@ inline std::string get_filename()
    return ret;
 }
 
+struct allocator_thread
+{
+   explicit allocator_thread(managed_mapped_file &mfile)
+      : mfile_(mfile)
+   {}
+
+   void operator()()
+   {
+      //Allocate and deallocate while the main thread grows the file
+      std::vector<void*> ptrs;
+      for(std::size_t i = 0; i != 10000; ++i){
+         void *p = mfile_.allocate(128, std::nothrow);
+         if(p){
+            ptrs.push_back(p);
+         }
+         if(ptrs.size() > 100 || (!p && !ptrs.empty())){
+            mfile_.deallocate(ptrs.back());
+            ptrs.pop_back();
+         }
+      }
+      for(std::size_t i = 0; i != ptrs.size(); ++i){
+         mfile_.deallocate(ptrs[i]);
+      }
+   }
+
+   managed_mapped_file &mfile_;
+};
+
+bool test_grow_in_place(const char *FileName)
+{
+   const std::size_t FileSize    = 65536;
+   const std::size_t ReserveSize = FileSize*16;
+   file_mapping::remove(FileName);
+   {
+      managed_mapped_file mfile(create_only, FileName, FileSize, 0, permissions(), ReserveSize);
+      //Another mapping of the same file, also maps the reserved space
+      managed_mapped_file mfile2(open_only, FileName);
+
+      if(mfile.get_reserved_free_size() != (ReserveSize - FileSize))
+         return false;
+      if(mfile2.get_reserved_free_size() != (ReserveSize - FileSize))
+         return false;
+
+      //Fill the segment
+      std::vector<void*> ptrs;
+      while(void *p = mfile.allocate(1024, std::nothrow)){
+         ptrs.push_back(p);
+      }
+      const std::size_t old_count = ptrs.size();
+      void *const first_ptr = ptrs.front();
+
+      //Grow while other threads allocate
+      {
+         ipcdetail::OS_thread_t thread;
+         ipcdetail::thread_launch(thread, allocator_thread(mfile2));
+         for(std::size_t i = 0; i != 8; ++i){
+            if(!mfile.grow_in_place(FileSize))
+               return false;
+         }
+         ipcdetail::thread_join(thread);
+      }
+      if(mfile.get_size() != FileSize*9 || mfile2.get_size() != FileSize*9)
+         return false;
+      if(!mfile.check_sanity())
+         return false;
+
+      //New memory is usable through both mappings and old addresses remain valid
+      std::vector<void*> ptrs2;
+      while(void *p = mfile2.allocate(1024, std::nothrow)){
+         ptrs2.push_back(p);
+      }
+      if(ptrs2.size() <= old_count*7 || ptrs.front() != first_ptr)
+         return false;
+      for(std::size_t i = 0; i != ptrs.size(); ++i){
+         std::memset(ptrs[i], 0xFF, 1024);
+         mfile.deallocate(ptrs[i]);
+      }
+      for(std::size_t i = 0; i != ptrs2.size(); ++i){
+         std::memset(ptrs2[i], 0xFF, 1024);
+         mfile2.deallocate(ptrs2[i]);
+      }
+
+      //Growth beyond the reservation fails
+      if(mfile.grow_in_place(ReserveSize))
+         return false;
+      if(!mfile.grow_in_place(mfile.get_reserved_free_size()))
+         return false;
+      if(mfile.get_size() != ReserveSize || mfile.get_reserved_free_size() != 0)
+         return false;
+      if(!mfile.all_memory_deallocated())
+         return false;
+   }
+   {
+      //Reopen the file, the reservation is still there
+      managed_mapped_file mfile(open_only, FileName);
+      if(mfile.get_size() != ReserveSize)
+         return false;
+      if(mfile.grow_in_place(FileSize))
+         return false;
+   }
+   {
+      //Prefaulting and flushing must not touch the reserved pages past
+      //the end of the file
+      file_mapping::remove(FileName);
+      managed_mapped_file mfile(create_only, FileName, FileSize, 0, permissions(), FileSize*1024);
+      if(!mfile.grow_in_place(FileSize))
+         return false;
+      if(!mfile.prefault() || !mfile.flush())
+         return false;
+   }
+   file_mapping::remove(FileName);
+   return true;
+}
+
 int main ()
 {
    const int FileSize          = 65536*10;
@@ -93,6 +212,11 @@ int main ()
       //Map preexisting file again in memory
       managed_mapped_file mfile(open_only, FileName);
 
+      //Warm up the segment
+      mfile.advise(mapped_region::advice_willneed);
+      if(!mfile.prefault())
+         return -1;
+
       //Check vector is still there
       MyVect *mfile_vect = mfile.find<MyVect>("MyVector").first;
       if(!mfile_vect)
@@ -222,6 +346,9 @@ int main ()
    }
 
    file_mapping::remove(FileName);
+
+   if(!test_grow_in_place(FileName))
+      return -1;
    return 0;
 }
 
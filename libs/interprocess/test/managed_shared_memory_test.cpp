@@ -79,6 +79,11 @@ int main ()
       //Map preexisting shmem again in memory
       managed_shared_memory shmem(open_only, ShmemName);
 
+      //Warm up the segment
+      shmem.advise(mapped_region::advice_willneed);
+      if(!shmem.prefault())
+         return -1;
+
       //Check vector is still there
       MyVect *shmem_vect = shmem.find<MyVect>("MyVector").first;
       if(!shmem_vect)
@@ -12,6 +12,8 @@
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/interprocess/mem_algo/simple_seq_fit.hpp>
 #include <boost/interprocess/mem_algo/rbtree_best_fit.hpp>
+#include <boost/interprocess/mem_algo/thread_cached_best_fit.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
 #include <boost/interprocess/indexes/null_index.hpp>
 #include <boost/interprocess/sync/mutex_family.hpp>
 #include <boost/interprocess/detail/type_traits.hpp>
@@ -19,6 +21,7 @@
 #include "memory_algorithm_test_template.hpp"
 #include <iostream>
 #include <string>
+#include <vector>
 #include "get_process_id_name.hpp"
 
 using namespace boost::interprocess;
@@ -67,6 +70,83 @@ int test_rbtree_best_fit()
    return 0;
 }
 
+template<std::size_t Alignment>
+int test_thread_cached_best_fit()
+{
+   //A shared memory with cached red-black tree best fit algorithm
+   typedef basic_managed_shared_memory
+      <char
+      ,thread_cached_best_fit<mutex_family, offset_ptr<void>, Alignment>
+      ,null_index
+      > my_managed_shared_memory;
+
+   //Create shared memory
+   shared_memory_object::remove(shMemName);
+   my_managed_shared_memory segment(create_only, shMemName, Memsize);
+
+   //Now take the segment manager and launch memory test
+   if(!test::test_all_allocation(*segment.get_segment_manager())){
+      return 1;
+   }
+   return 0;
+}
+
+//Several threads allocate and deallocate small blocks
+//concurrently so that all caches are used
+typedef basic_managed_shared_memory
+   <char, thread_cached_best_fit<mutex_family>, null_index> cached_managed_shared_memory;
+
+static cached_managed_shared_memory *global_segment = 0;
+static const int NumThreads = 8;
+static const int NumIterations = 2000;
+
+static void allocate_deallocate()
+{
+   std::vector<char*> buffers;
+   for(int i = 0; i < NumIterations; ++i){
+      const std::size_t size = std::size_t(i % 200) + 1;
+      char *p = static_cast<char*>(global_segment->allocate(size));
+      std::memset(p, i, size);
+      buffers.push_back(p);
+      if(buffers.size() == 64){
+         for(std::size_t j = 0; j != buffers.size(); ++j){
+            global_segment->deallocate(buffers[j]);
+         }
+         buffers.clear();
+      }
+   }
+   for(std::size_t j = 0; j != buffers.size(); ++j){
+      global_segment->deallocate(buffers[j]);
+   }
+}
+
+int test_thread_cached_best_fit_threads()
+{
+   shared_memory_object::remove(shMemName);
+   {
+      cached_managed_shared_memory segment(create_only, shMemName, Memsize*32);
+      global_segment = &segment;
+      const cached_managed_shared_memory::size_type free_memory = segment.get_free_memory();
+
+      std::vector<boost::interprocess::ipcdetail::OS_thread_t> threads(NumThreads);
+      for(int i = 0; i < NumThreads; ++i){
+         boost::interprocess::ipcdetail::thread_launch(threads[i], &allocate_deallocate);
+      }
+      for(int i = 0; i < NumThreads; ++i){
+         boost::interprocess::ipcdetail::thread_join(threads[i]);
+      }
+
+      if(segment.get_free_memory() != free_memory)
+         return 1;
+      if(!segment.all_memory_deallocated() || !segment.check_sanity())
+         return 1;
+      if(segment.get_free_memory() != free_memory)
+         return 1;
+   }
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
+
 int main ()
 {
    const std::size_t void_ptr_align = ::boost::container::container_detail::alignment_of<offset_ptr<void> >::value;
@@ -83,6 +163,15 @@ int main ()
    if(test_rbtree_best_fit<4*void_ptr_align>()){
       return 1;
    }
+   if(test_thread_cached_best_fit<void_ptr_align>()){
+      return 1;
+   }
+   if(test_thread_cached_best_fit<4*void_ptr_align>()){
+      return 1;
+   }
+   if(test_thread_cached_best_fit_threads()){
+      return 1;
+   }
 
    shared_memory_object::remove(shMemName);
    return 0;
@@ -18,6 +18,44 @@
 #include <boost/interprocess/sync/spin/mutex.hpp>
 #endif
 
+#if defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+#include <boost/interprocess/sync/futex/mutex.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+
+static boost::interprocess::ipcdetail::futex_mutex *global_futex_mutex = 0;
+
+struct lock_and_exit
+{
+   void operator()()
+   {  global_futex_mutex->lock();   }
+};
+
+//A thread that dies owning the mutex must not block other lockers forever
+bool test_futex_mutex_owner_death()
+{
+   using namespace boost::interprocess;
+   ipcdetail::futex_mutex mtx;
+   global_futex_mutex = &mtx;
+   ipcdetail::OS_thread_t thread;
+   ipcdetail::thread_launch(thread, lock_and_exit());
+   ipcdetail::thread_join(thread);
+
+   if(mtx.try_lock() || mtx.previous_owner_dead())
+      return false;
+   mtx.lock();
+   if(!mtx.previous_owner_dead())
+      return false;
+   mtx.consistent();
+   if(mtx.previous_owner_dead())
+      return false;
+   mtx.unlock();
+   if(!mtx.try_lock())
+      return false;
+   mtx.unlock();
+   return true;
+}
+#endif
+
 int main ()
 {
    using namespace boost::interprocess;
@@ -29,6 +67,13 @@ int main ()
       test::test_all_mutex<ipcdetail::spin_mutex>();
    #endif
 
+   #if defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+      test::test_all_lock<ipcdetail::futex_mutex>();
+      test::test_all_mutex<ipcdetail::futex_mutex>();
+      if(!test_futex_mutex_owner_death())
+         return 1;
+   #endif
+
    test::test_all_lock<interprocess_mutex>();
    test::test_all_mutex<interprocess_mutex>();
    return 0;
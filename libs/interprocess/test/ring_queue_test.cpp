@@ -0,0 +1,212 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/ipc/ring_queue.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "get_process_id_name.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+//  This example tests the process shared lock-free ring queue.               //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace boost::interprocess;
+
+template<class RingQueue>
+bool test_fifo_order()
+{
+   RingQueue::remove(test::get_process_id_name());
+   {
+      RingQueue rq1
+         (open_or_create, test::get_process_id_name(), 100, sizeof(std::size_t)),
+         rq2
+         (open_only, test::get_process_id_name());
+
+      //Slots are rounded to a power of two
+      if(rq1.get_max_msg() != 128u || rq2.get_max_msg() != 128u)
+         return false;
+      if(rq2.get_max_msg_size() != sizeof(std::size_t))
+         return false;
+
+      std::size_t msg, recvd;
+      typename RingQueue::size_type recvd_size;
+
+      //Empty queue
+      if(rq2.try_receive(&recvd, sizeof(recvd), recvd_size))
+         return false;
+      if(rq2.timed_receive(&recvd, sizeof(recvd), recvd_size,
+            boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(10)))
+         return false;
+
+      //Fill the queue
+      for(std::size_t i = 0; i < rq1.get_max_msg(); ++i){
+         msg = i;
+         if(!rq1.try_send(&msg, sizeof(msg)))
+            return false;
+      }
+      if(rq1.get_num_msg() != rq1.get_max_msg())
+         return false;
+
+      //Full queue
+      if(rq1.try_send(&msg, sizeof(msg)))
+         return false;
+      if(rq1.timed_send(&msg, sizeof(msg),
+            boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(10)))
+         return false;
+
+      //Messages are received in FIFO order
+      for(std::size_t i = 0; i < rq1.get_max_msg(); ++i){
+         rq2.receive(&recvd, sizeof(recvd), recvd_size);
+         if(recvd != i || recvd_size != sizeof(recvd))
+            return false;
+      }
+      if(rq2.get_num_msg() != 0)
+         return false;
+
+      //Several laps around the ring with variable size messages
+      for(std::size_t i = 0; i < 1000u; ++i){
+         msg = i;
+         rq1.send(&msg, i % (sizeof(msg)+1));
+         rq2.receive(&recvd, sizeof(recvd), recvd_size);
+         if(recvd_size != i % (sizeof(msg)+1))
+            return false;
+      }
+
+      //Size errors
+      try{
+         rq1.send(&msg, sizeof(msg)+1);
+         return false;
+      }
+      catch(interprocess_exception &){}
+      try{
+         char small_buf;
+         rq2.receive(&small_buf, sizeof(small_buf), recvd_size);
+         return false;
+      }
+      catch(interprocess_exception &){}
+   }
+   RingQueue::remove(test::get_process_id_name());
+
+   //Sizes that don't fit in the 32 bit slot header and positions are rejected
+   try{
+      RingQueue rq(create_only, test::get_process_id_name(), 1, std::size_t(-1));
+      return false;
+   }
+   catch(interprocess_exception &){}
+   try{
+      RingQueue rq(open_or_create, test::get_process_id_name(), std::size_t(-1), sizeof(std::size_t));
+      return false;
+   }
+   catch(interprocess_exception &){}
+   RingQueue::remove(test::get_process_id_name());
+   return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Several senders (or a single one) and a single receiver that checks
+// that messages from each sender arrive in order and none is lost.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void *global_queue = 0;
+static const std::size_t NUM_MSG_PER_SENDER = 100000;
+static const std::size_t QUEUE_SIZE = 16;
+static const std::size_t MAX_THREAD_COUNT = 4;
+
+struct thread_msg
+{
+   std::size_t sender;
+   std::size_t seq;
+};
+
+template<class RingQueue>
+struct sender
+{
+   explicit sender(std::size_t id)
+      : id_(id)
+   {}
+
+   void operator()()
+   {
+      RingQueue &rq = *static_cast<RingQueue*>(global_queue);
+      thread_msg msg;
+      msg.sender = id_;
+      for(std::size_t i = 0; i < NUM_MSG_PER_SENDER; ++i){
+         msg.seq = i;
+         rq.send(&msg, sizeof(msg));
+      }
+   }
+
+   std::size_t id_;
+};
+
+template<class RingQueue>
+bool test_senders_receiver(std::size_t num_senders)
+{
+   RingQueue::remove(test::get_process_id_name());
+   bool ret = true;
+   {
+      RingQueue rq(create_only, test::get_process_id_name(), QUEUE_SIZE, sizeof(thread_msg));
+      global_queue = &rq;
+      std::vector<boost::interprocess::ipcdetail::OS_thread_t> threads(num_senders);
+      for(std::size_t i = 0; i != num_senders; ++i){
+         boost::interprocess::ipcdetail::thread_launch(threads[i], sender<RingQueue>(i));
+      }
+
+      std::size_t next_seq[MAX_THREAD_COUNT] = {};
+      thread_msg msg;
+      typename RingQueue::size_type recvd_size;
+      for(std::size_t i = 0, max = num_senders*NUM_MSG_PER_SENDER; i != max; ++i){
+         rq.receive(&msg, sizeof(msg), recvd_size);
+         if(recvd_size != sizeof(msg) || msg.sender >= num_senders ||
+            msg.seq != next_seq[msg.sender]++){
+            ret = false;
+            break;
+         }
+      }
+
+      for(std::size_t i = 0; i != num_senders; ++i){
+         boost::interprocess::ipcdetail::thread_join(threads[i]);
+      }
+   }
+   RingQueue::remove(test::get_process_id_name());
+   return ret;
+}
+
+int main ()
+{
+   if(!test_fifo_order<spsc_ring_queue>()){
+      return 1;
+   }
+
+   if(!test_fifo_order<mpsc_ring_queue>()){
+      return 1;
+   }
+
+   if(!test_senders_receiver<spsc_ring_queue>(1)){
+      return 1;
+   }
+
+   if(!test_senders_receiver<mpsc_ring_queue>(MAX_THREAD_COUNT)){
+      return 1;
+   }
+
+   return 0;
+}
+
+#include <boost/interprocess/detail/config_end.hpp>
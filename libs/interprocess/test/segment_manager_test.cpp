@@ -4,8 +4,10 @@
 #include <boost/interprocess/indexes/unordered_map_index.hpp>
 #include <boost/interprocess/indexes/iset_index.hpp>
 #include <boost/interprocess/indexes/iunordered_set_index.hpp>
+#include <boost/interprocess/indexes/seqlock_index.hpp>
 
 #include <boost/interprocess/mem_algo/simple_seq_fit.hpp>
+#include <boost/interprocess/mem_algo/thread_cached_best_fit.hpp>
 #include <boost/interprocess/mem_algo/rbtree_best_fit.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/segment_manager.hpp>
@@ -193,7 +195,7 @@ bool test_segment_manager()
       seg_mgr->destroy_ptr(int_object);
       int const int_array_values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
       int *int_array  = seg_mgr->template construct_it<int>(anonymous_instance, std::nothrow)[10](&int_array_values[0]);
-      if(10 != seg_mgr->get_instance_length(int_object))
+      if(10 != seg_mgr->get_instance_length(int_array))
          return false;
       if(anonymous_type != seg_mgr->get_instance_type(int_array))
          return false;
@@ -464,6 +466,11 @@ bool test_each_algo()
       if(!test_segment_manager<segment_manager_t>())
          return false;
    }
+   {
+      typedef segment_manager< char, MemoryAlgorithm, seqlock_index > segment_manager_t;
+      if(!test_segment_manager<segment_manager_t>())
+         return false;
+   }
    return true;
 }
 
@@ -473,6 +480,8 @@ int main()
       return 1;
    if(!test_each_algo< rbtree_best_fit< null_mutex_family > >())
       return 1;
+   if(!test_each_algo< thread_cached_best_fit< null_mutex_family > >())
+      return 1;
 
    return 0;
 }
@@ -9,7 +9,11 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
 #include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#if defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+#include <boost/interprocess/sync/futex/semaphore.hpp>
+#endif
 #include <boost/interprocess/exceptions.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include "named_creation_template.hpp"
@@ -20,12 +24,13 @@ static const std::size_t RecSemCount   = 100;
 
 //This wrapper is necessary to plug this class
 //in named creation tests and interprocess_mutex tests
+template<class Semaphore>
 class semaphore_test_wrapper
-   : public boost::interprocess::interprocess_semaphore
+   : public Semaphore
 {
    public:
    semaphore_test_wrapper()
-      :  boost::interprocess::interprocess_semaphore(SemCount)
+      :  Semaphore(SemCount)
    {}
 
    void lock()
@@ -42,28 +47,40 @@ class semaphore_test_wrapper
 
    protected:
    semaphore_test_wrapper(int initial_count)
-      :  boost::interprocess::interprocess_semaphore(initial_count)
+      :  Semaphore(initial_count)
    {}
 };
 
 //This wrapper is necessary to plug this class
 //in recursive tests
+template<class Semaphore>
 class recursive_semaphore_test_wrapper
-   :  public semaphore_test_wrapper
+   :  public semaphore_test_wrapper<Semaphore>
 {
    public:
    recursive_semaphore_test_wrapper()
-      :  semaphore_test_wrapper(RecSemCount)
+      :  semaphore_test_wrapper<Semaphore>(RecSemCount)
    {}
 };
 
+template<class Semaphore>
+void test_all_semaphore()
+{
+   using namespace boost::interprocess;
+
+   test::test_all_lock<semaphore_test_wrapper<Semaphore> >();
+   test::test_all_recursive_lock<recursive_semaphore_test_wrapper<Semaphore> >();
+   test::test_all_mutex<semaphore_test_wrapper<Semaphore> >();
+}
+
 int main ()
 {
    using namespace boost::interprocess;
 
-   test::test_all_lock<semaphore_test_wrapper>();
-   test::test_all_recursive_lock<recursive_semaphore_test_wrapper>();
-   test::test_all_mutex<semaphore_test_wrapper>();
+   #if defined(BOOST_INTERPROCESS_LINUX_FUTEX)
+      test_all_semaphore<ipcdetail::futex_semaphore>();
+   #endif
+   test_all_semaphore<interprocess_semaphore>();
    return 0;
 }
 
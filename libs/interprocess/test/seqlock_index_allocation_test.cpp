@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/indexes/seqlock_index.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include "named_allocation_test_template.hpp"
+#include "get_process_id_name.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace boost::interprocess;
+
+typedef basic_managed_shared_memory
+   <char, rbtree_best_fit<mutex_family>, seqlock_index> my_managed_shared_memory;
+
+static my_managed_shared_memory *global_segment = 0;
+static volatile boost::uint32_t global_stop = 0;
+static volatile boost::uint32_t global_error = 0;
+static const std::size_t NumPermanent = 64;
+static const std::size_t NumIterations = 2000;
+static const std::size_t NumReaders = 3;
+
+static void make_name(char *buf, const char *prefix, std::size_t i)
+{  std::sprintf(buf, "%s%u", prefix, static_cast<unsigned>(i));  }
+
+//Readers search permanent objects, which must always be found with their
+//value, and temporary ones, which can be found or not but never half constructed.
+struct reader
+{
+   void operator()()
+   {
+      char name[32];
+      for(std::size_t i = 0; !ipcdetail::atomic_read32(&global_stop); ++i){
+         make_name(name, "permanent", i % NumPermanent);
+         std::pair<std::size_t*, std::size_t> r = global_segment->find<std::size_t>(name);
+         if(!r.first || r.second != 1 || *r.first != i % NumPermanent){
+            ipcdetail::atomic_write32(&global_error, 1);
+         }
+         make_name(name, "temporary", i % 8);
+         r = global_segment->find<std::size_t>(name);
+         if(r.first && (r.second != 4 || r.first[3] != i % 8)){
+            ipcdetail::atomic_write32(&global_error, 1);
+         }
+      }
+   }
+};
+
+bool test_concurrent_find()
+{
+   const char *const shm_name = test::get_process_id_name();
+   shared_memory_object::remove(shm_name);
+   {
+      my_managed_shared_memory segment(create_only, shm_name, 1024*1024);
+      global_segment = &segment;
+      char name[32];
+      for(std::size_t i = 0; i != NumPermanent; ++i){
+         make_name(name, "permanent", i);
+         segment.construct<std::size_t>(name)(i);
+      }
+
+      std::vector<ipcdetail::OS_thread_t> threads(NumReaders);
+      for(std::size_t i = 0; i != NumReaders; ++i){
+         ipcdetail::thread_launch(threads[i], reader());
+      }
+
+      //Create and destroy objects forcing table rehashes and erased slots
+      for(std::size_t i = 0; i != NumIterations; ++i){
+         make_name(name, "temporary", i % 8);
+         //The object is published once constructed, so it must have its final value
+         segment.find_or_construct<std::size_t>(name)[4](i % 8);
+         if(i % 3 == 0){
+            segment.destroy<std::size_t>(name);
+         }
+         make_name(name, "extra", i);
+         segment.construct<std::size_t>(name)(i);
+         if(i % 64 == 63){
+            for(std::size_t j = i - 63; j <= i; ++j){
+               make_name(name, "extra", j);
+               segment.destroy<std::size_t>(name);
+            }
+         }
+      }
+
+      ipcdetail::atomic_write32(&global_stop, 1);
+      for(std::size_t i = 0; i != NumReaders; ++i){
+         ipcdetail::thread_join(threads[i]);
+      }
+   }
+   shared_memory_object::remove(shm_name);
+   return global_error == 0;
+}
+
+int main ()
+{
+   if(!test::test_named_allocation<seqlock_index>()){
+      return 1;
+   }
+
+   if(!test_concurrent_find()){
+      return 1;
+   }
+
+   return 0;
+}
+
+#include <boost/interprocess/detail/config_end.hpp>
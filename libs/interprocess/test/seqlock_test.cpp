@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2015-2015. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/sync/interprocess_seqlock.hpp>
+#include <boost/interprocess/sync/versioned.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include "mutex_test_template.hpp"
+
+#include <cstddef>
+#include <vector>
+
+using namespace boost::interprocess;
+
+//A value that is inconsistent if it's read while it's being modified
+struct price_entry
+{
+   static const std::size_t NumFields = 16;
+   boost::uint32_t version;
+   boost::uint32_t fields[NumFields];
+
+   bool is_consistent() const
+   {
+      for(std::size_t i = 0; i != NumFields; ++i){
+         if(fields[i] != version + i)
+            return false;
+      }
+      return true;
+   }
+};
+
+struct set_price_entry
+{
+   explicit set_price_entry(boost::uint32_t v)
+      : v_(v)
+   {}
+
+   void operator()(price_entry &e) const
+   {
+      e.version = v_;
+      for(std::size_t i = 0; i != price_entry::NumFields; ++i){
+         e.fields[i] = v_ + boost::uint32_t(i);
+      }
+   }
+
+   boost::uint32_t v_;
+};
+
+static versioned<price_entry> *global_entry = 0;
+static volatile boost::uint32_t global_stop = 0;
+static volatile boost::uint32_t global_error = 0;
+static const std::size_t NumReaders = 3;
+static const boost::uint32_t NumWrites = 200000;
+
+struct reader
+{
+   void operator()()
+   {
+      boost::uint32_t last_version = 0;
+      while(!ipcdetail::atomic_read32(&global_stop)){
+         const price_entry e = global_entry->load();
+         //Snapshots must be consistent and versions can't go back
+         if(!e.is_consistent() || e.version < last_version){
+            ipcdetail::atomic_write32(&global_error, 1);
+         }
+         last_version = e.version;
+      }
+   }
+};
+
+bool test_versioned()
+{
+   price_entry initial;
+   set_price_entry(0)(initial);
+   versioned<price_entry> entry(initial);
+   global_entry = &entry;
+
+   //Single thread
+   if(!entry.load().is_consistent() || entry.load().version != 0)
+      return false;
+   const boost::uint32_t v0 = entry.version();
+   entry.modify(set_price_entry(1));
+   if(entry.version() == v0 || entry.load().version != 1)
+      return false;
+   set_price_entry(2)(initial);
+   entry.store(initial);
+   price_entry copy;
+   if(entry.load(copy) != entry.version() || copy.version != 2 || !copy.is_consistent())
+      return false;
+
+   //Readers take snapshots while the writer modifies the value
+   std::vector<ipcdetail::OS_thread_t> threads(NumReaders);
+   for(std::size_t i = 0; i != NumReaders; ++i){
+      ipcdetail::thread_launch(threads[i], reader());
+   }
+   for(boost::uint32_t i = 3; i != NumWrites; ++i){
+      entry.modify(set_price_entry(i));
+   }
+   ipcdetail::atomic_write32(&global_stop, 1);
+   for(std::size_t i = 0; i != NumReaders; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+   return global_error == 0 && entry.load().version == NumWrites - 1;
+}
+
+int main ()
+{
+   //Writers use the seqlock as a mutex
+   test::test_all_lock<interprocess_seqlock>();
+   test::test_all_mutex<interprocess_seqlock>();
+
+   if(!test_versioned()){
+      return 1;
+   }
+   return 0;
+}
+
+#include <boost/interprocess/detail/config_end.hpp>
@@ -175,6 +175,24 @@ int main ()
          }
          #endif
 
+         //Huge page advice depends on kernel configuration, so just
+         //check that it can be called
+         std::cout << "Advice huge page" << std::endl;
+         region.advise(mapped_region::advice_hugepage);
+         region.advise(mapped_region::advice_nohugepage);
+
+         //Now prefault
+         std::cout << "Prefault" << std::endl;
+         if(!region.prefault()){
+            return 1;
+         }
+         if(!region.prefault(region.get_size()/2)){
+            return 1;
+         }
+         if(region.prefault(region.get_size())){
+            return 1;
+         }
+
       }
       {
          //Check for busy address space
@@ -75,7 +75,7 @@ struct hooks
 
 static const std::size_t BucketSize = 8;
 
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
 struct test_unordered_multiset
 {
    typedef typename ValueTraits::value_type value_type;
@@ -90,8 +90,8 @@ struct test_unordered_multiset
    static void test_clone(std::vector<value_type>& values);
 };
 
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>::
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::
    test_all (std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -102,6 +102,7 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>:
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_multiset_type;
    {
       typedef typename unordered_multiset_type::bucket_traits bucket_traits;
@@ -131,8 +132,8 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>:
 }
 
 //test case due to an error in tree implementation:
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>
    ::test_impl()
 {
    typedef typename ValueTraits::value_type value_type;
@@ -143,6 +144,7 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_multiset_type;
    typedef typename unordered_multiset_type::bucket_traits bucket_traits;
 
@@ -167,8 +169,8 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
 }
 
 //test: constructor, iterator, clear, reverse_iterator, front, back, size:
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>
    ::test_sort(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -179,6 +181,7 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_multiset_type;
    typedef typename unordered_multiset_type::bucket_traits bucket_traits;
 
@@ -201,8 +204,8 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
 }
 
 //test: insert, const_iterator, const_reverse_iterator, erase, iterator_to:
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>
    ::test_insert(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -213,6 +216,7 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_multiset_type;
    typedef typename unordered_multiset_type::bucket_traits bucket_traits;
    typedef typename unordered_multiset_type::iterator iterator;
@@ -399,8 +403,8 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
 }
 
 //test: insert (seq-version), swap, erase (seq-version), size:
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>::
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::
    test_swap(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -411,6 +415,7 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>:
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_multiset_type;
    typedef typename unordered_multiset_type::bucket_traits bucket_traits;
    typename unordered_multiset_type::bucket_type buckets [BucketSize];
@@ -454,8 +459,8 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>:
 
 //test: rehash:
 
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>
    ::test_rehash(std::vector<typename ValueTraits::value_type>& values, detail::true_)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -466,6 +471,7 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_multiset_type;
    typedef typename unordered_multiset_type::bucket_traits bucket_traits;
    //Build a uset
@@ -584,8 +590,8 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
    {  int init_values [] = { 4, 5, 1, 2, 2, 3 };
    TEST_INTRUSIVE_SEQUENCE( init_values, testset1.begin() );  }
 }
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>
    ::test_rehash(std::vector<typename ValueTraits::value_type>& values, detail::false_)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -596,6 +602,7 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_multiset_type;
    typedef typename unordered_multiset_type::bucket_traits bucket_traits;
 
@@ -642,8 +649,8 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
 }
 
 //test: find, equal_range (lower_bound, upper_bound):
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>::
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::
    test_find(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -654,6 +661,7 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>:
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_multiset_type;
    typedef typename unordered_multiset_type::bucket_traits bucket_traits;
 
@@ -680,8 +688,8 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>:
 }
 
 
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>
    ::test_clone(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -692,6 +700,7 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_multiset_type;
    typedef typename unordered_multiset_type::bucket_traits bucket_traits;
    {
@@ -759,7 +768,7 @@ void test_unordered_multiset<ValueTraits, CacheBegin, CompareHash, Incremental>
    }
 }
 
-template<class VoidPointer, bool constant_time_size, bool Incremental>
+template<class VoidPointer, bool constant_time_size, bool Incremental, bool Fingerprints>
 class test_main_template
 {
    public:
@@ -777,7 +786,7 @@ class test_main_template
                   >::type
                 , true
                 , false
-                , Incremental
+                , Incremental, Fingerprints
                 >::test_all(data);
 
       test_unordered_multiset < typename detail::get_member_value_traits
@@ -788,7 +797,7 @@ class test_main_template
                   >::type
                 , false
                 , false
-                , Incremental
+                , Incremental, Fingerprints
                 >::test_all(data);
       test_unordered_multiset < nonhook_node_member_value_traits< value_type,
                                                                   typename hooks<VoidPointer>::nonhook_node_member_type,
@@ -797,14 +806,14 @@ class test_main_template
                                                                 >,
                                 false,
                                 false,
-                                Incremental
+                                Incremental, Fingerprints
                               >::test_all(data);
       return 0;
    }
 };
 
-template<class VoidPointer, bool Incremental>
-class test_main_template<VoidPointer, false, Incremental>
+template<class VoidPointer, bool Incremental, bool Fingerprints>
+class test_main_template<VoidPointer, false, Incremental, Fingerprints>
 {
    public:
    int operator()()
@@ -821,7 +830,7 @@ class test_main_template<VoidPointer, false, Incremental>
                   >::type
                 , false
                 , false
-                , Incremental
+                , Incremental, Fingerprints
                 >::test_all(data);
 
       test_unordered_multiset < typename detail::get_member_value_traits
@@ -832,7 +841,7 @@ class test_main_template<VoidPointer, false, Incremental>
                   >::type
                 , true
                 , false
-                , Incremental
+                , Incremental, Fingerprints
                 >::test_all(data);
 
       test_unordered_multiset < typename detail::get_base_value_traits
@@ -841,7 +850,7 @@ class test_main_template<VoidPointer, false, Incremental>
                   >::type
                 , false
                 , false
-                , Incremental
+                , Incremental, Fingerprints
                 >::test_all(data);
 
       test_unordered_multiset < typename detail::get_member_value_traits
@@ -852,7 +861,7 @@ class test_main_template<VoidPointer, false, Incremental>
                   >::type
                 , false
                 , true
-                , Incremental
+                , Incremental, Fingerprints
                 >::test_all(data);
       return 0;
    }
@@ -860,13 +869,16 @@ class test_main_template<VoidPointer, false, Incremental>
 
 int main()
 {
-   test_main_template<void*, false, true>()();
-   test_main_template<smart_ptr<void>, false, true>()();
-   test_main_template<void*, true, true>()();
-   test_main_template<smart_ptr<void>, true, true>()();
-   test_main_template<void*, false, false>()();
-   test_main_template<smart_ptr<void>, false, false>()();
-   test_main_template<void*, true, true>()();
-   test_main_template<smart_ptr<void>, true, false>()();
+   test_main_template<void*, false, true, false>()();
+   test_main_template<smart_ptr<void>, false, true, false>()();
+   test_main_template<void*, true, true, false>()();
+   test_main_template<smart_ptr<void>, true, true, false>()();
+   test_main_template<void*, false, false, false>()();
+   test_main_template<smart_ptr<void>, false, false, false>()();
+   test_main_template<void*, true, true, false>()();
+   test_main_template<smart_ptr<void>, true, false, false>()();
+   test_main_template<void*, false, true, true>()();
+   test_main_template<void*, true, false, true>()();
+   test_main_template<smart_ptr<void>, true, true, true>()();
    return boost::report_errors();
 }
@@ -73,7 +73,7 @@ struct hooks
 
 static const std::size_t BucketSize = 8;
 
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
 struct test_unordered_set
 {
    typedef typename ValueTraits::value_type value_type;
@@ -88,8 +88,8 @@ struct test_unordered_set
    static void test_clone(std::vector<value_type>& values);
 };
 
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::
    test_all(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -100,6 +100,7 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_set_type;
    typedef typename unordered_set_type::bucket_traits bucket_traits;
    {
@@ -129,8 +130,8 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
 }
 
 //test case due to an error in tree implementation:
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::test_impl()
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::test_impl()
 {
    typedef typename ValueTraits::value_type value_type;
    typedef unordered_set
@@ -140,6 +141,7 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::test
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_set_type;
    typedef typename unordered_set_type::bucket_traits bucket_traits;
 
@@ -162,8 +164,8 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::test
 }
 
 //test: constructor, iterator, clear, reverse_iterator, front, back, size:
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::
    test_sort(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -174,6 +176,7 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_set_type;
    typedef typename unordered_set_type::bucket_traits bucket_traits;
 
@@ -197,8 +200,8 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
 }
 
 //test: insert, const_iterator, const_reverse_iterator, erase, iterator_to:
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::
    test_insert(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -209,6 +212,7 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_set_type;
    typedef typename unordered_set_type::bucket_traits bucket_traits;
 
@@ -257,8 +261,8 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
 }
 
 //test: insert (seq-version), swap, erase (seq-version), size:
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::
    test_swap(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -269,6 +273,7 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_set_type;
    typedef typename unordered_set_type::bucket_traits bucket_traits;
 
@@ -305,8 +310,8 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
 }
 
 //test: rehash:
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::
    test_rehash(std::vector<typename ValueTraits::value_type>& values, detail::true_)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -317,6 +322,7 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_set_type;
    typedef typename unordered_set_type::bucket_traits bucket_traits;
    //Build a uset
@@ -437,8 +443,8 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
 }
 
 //test: rehash:
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::
    test_rehash(std::vector<typename ValueTraits::value_type>& values, detail::false_)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -449,6 +455,7 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_set_type;
    typedef typename unordered_set_type::bucket_traits bucket_traits;
 
@@ -496,8 +503,8 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
 
 
 //test: find, equal_range (lower_bound, upper_bound):
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>::
    test_find(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -508,6 +515,7 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_set_type;
    typedef typename unordered_set_type::bucket_traits bucket_traits;
 
@@ -532,8 +540,8 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>::
    BOOST_TEST (testset.find (cmp_val) == testset.end());
 }
 
-template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental>
-void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>
+template<class ValueTraits, bool CacheBegin, bool CompareHash, bool Incremental, bool Fingerprints>
+void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental, Fingerprints>
    ::test_clone(std::vector<typename ValueTraits::value_type>& values)
 {
    typedef typename ValueTraits::value_type value_type;
@@ -544,6 +552,7 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>
       , cache_begin<CacheBegin>
       , compare_hash<CompareHash>
       , incremental<Incremental>
+      , bucket_fingerprints<Fingerprints>
       > unordered_set_type;
    typedef typename unordered_set_type::bucket_traits bucket_traits;
    {
@@ -611,7 +620,7 @@ void test_unordered_set<ValueTraits, CacheBegin, CompareHash, Incremental>
    }
 }
 
-template<class VoidPointer, bool constant_time_size, bool incremental>
+template<class VoidPointer, bool constant_time_size, bool incremental, bool Fingerprints>
 class test_main_template
 {
    public:
@@ -629,7 +638,7 @@ class test_main_template
                   >::type
                 , true
                 , false
-                , incremental
+                , incremental, Fingerprints
                 >::test_all(data);
       test_unordered_set < typename detail::get_member_value_traits
                   < member_hook< value_type
@@ -639,7 +648,7 @@ class test_main_template
                   >::type
                 , false
                 , false
-                , incremental
+                , incremental, Fingerprints
                 >::test_all(data);
       test_unordered_set < nonhook_node_member_value_traits< value_type,
                                                              typename hooks<VoidPointer>::nonhook_node_member_type,
@@ -648,15 +657,15 @@ class test_main_template
                                                            >,
                            false,
                            false,
-                           incremental
+                           incremental, Fingerprints
                          >::test_all(data);
 
       return 0;
    }
 };
 
-template<class VoidPointer, bool incremental>
-class test_main_template<VoidPointer, false, incremental>
+template<class VoidPointer, bool incremental, bool Fingerprints>
+class test_main_template<VoidPointer, false, incremental, Fingerprints>
 {
    public:
    int operator()()
@@ -673,7 +682,7 @@ class test_main_template<VoidPointer, false, incremental>
                   >::type
                 , true
                 , false
-                , incremental
+                , incremental, Fingerprints
                 >::test_all(data);
 
       test_unordered_set < typename detail::get_member_value_traits
@@ -684,7 +693,7 @@ class test_main_template<VoidPointer, false, incremental>
                   >::type
                 , false
                 , false
-                , incremental
+                , incremental, Fingerprints
                 >::test_all(data);
 
       test_unordered_set < typename detail::get_base_value_traits
@@ -693,7 +702,7 @@ class test_main_template<VoidPointer, false, incremental>
                   >::type
                 , false
                 , true
-                , incremental
+                , incremental, Fingerprints
                 >::test_all(data);
 
       test_unordered_set < typename detail::get_member_value_traits
@@ -704,7 +713,7 @@ class test_main_template<VoidPointer, false, incremental>
                   >::type
                 , false
                 , true
-                , incremental
+                , incremental, Fingerprints
                 >::test_all(data);
       return 0;
    }
@@ -712,13 +721,16 @@ class test_main_template<VoidPointer, false, incremental>
 
 int main()
 {
-   test_main_template<void*, false, true>()();
-   test_main_template<smart_ptr<void>, false, true>()();
-   test_main_template<void*, true, true>()();
-   test_main_template<smart_ptr<void>, true, true>()();
-   test_main_template<void*, false, false>()();
-   test_main_template<smart_ptr<void>, false, false>()();
-   test_main_template<void*, true, true>()();
-   test_main_template<smart_ptr<void>, true, false>()();
+   test_main_template<void*, false, true, false>()();
+   test_main_template<smart_ptr<void>, false, true, false>()();
+   test_main_template<void*, true, true, false>()();
+   test_main_template<smart_ptr<void>, true, true, false>()();
+   test_main_template<void*, false, false, false>()();
+   test_main_template<smart_ptr<void>, false, false, false>()();
+   test_main_template<void*, true, true, false>()();
+   test_main_template<smart_ptr<void>, true, false, false>()();
+   test_main_template<void*, false, true, true>()();
+   test_main_template<void*, true, false, true>()();
+   test_main_template<smart_ptr<void>, true, true, true>()();
    return boost::report_errors();
 }
@@ -0,0 +1,280 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+// To configure Boost to work with liblz4, see the
+// installation instructions here:
+// http://boost.org/libs/iostreams/doc/index.html?path=7
+
+// Define BOOST_IOSTREAMS_SOURCE so that <boost/iostreams/detail/config.hpp>
+// knows that we are building the library (possibly exporting code), rather
+// than using it (possibly importing code).
+#define BOOST_IOSTREAMS_SOURCE
+
+#include <algorithm>                                // min.
+#include <cstddef>                                  // ptrdiff_t.
+#include <cstring>                                  // memcpy, memset.
+#include <new>                                      // bad_alloc.
+#include <vector>
+#include <boost/throw_exception.hpp>
+#include <boost/iostreams/detail/config/dyn_link.hpp>
+#include <boost/iostreams/filter/lz4.hpp>
+
+// Only the error enumeration is used from the unstable part of lz4frame.h;
+// dictionaries use functions which are stable from lz4 1.10.
+#define LZ4F_STATIC_LINKING_ONLY
+#include "lz4.h"            // Yann Collet's "lz4.h", "lz4hc.h" and
+#include "lz4hc.h"          // "lz4frame.h" headers, version 1.8.3 or later.
+#include "lz4frame.h"       // To configure Boost to work with liblz4, see the
+                            // installation instructions here:
+                            // http://boost.org/libs/iostreams/doc/index.html?path=7
+
+#if LZ4_VERSION_NUMBER >= 11000
+# define BOOST_IOSTREAMS_LZ4_HAS_DICTIONARY
+#endif
+
+namespace boost { namespace iostreams {
+
+namespace lz4 {
+
+                    // Compression levels
+
+const int default_compression       = 0;
+const int high_compression          = LZ4HC_CLEVEL_DEFAULT;
+const int best_compression          = LZ4HC_CLEVEL_MAX;
+
+                    // Block sizes
+
+const int block_64k                 = LZ4F_max64KB;
+const int block_256k                = LZ4F_max256KB;
+const int block_1m                  = LZ4F_max1MB;
+const int block_4m                  = LZ4F_max4MB;
+const int default_block_size        = LZ4F_max64KB;
+
+                    // Error codes
+
+const int generic_error             = LZ4F_ERROR_GENERIC;
+const int frame_type_unknown        = LZ4F_ERROR_frameType_unknown;
+const int header_checksum_invalid   = LZ4F_ERROR_headerChecksum_invalid;
+const int block_checksum_invalid    = LZ4F_ERROR_blockChecksum_invalid;
+const int content_checksum_invalid  = LZ4F_ERROR_contentChecksum_invalid;
+const int decompression_failed      = LZ4F_ERROR_decompressionFailed;
+const int unexpected_eof            = LZ4F_ERROR_frameSize_wrong;
+
+} // End namespace lz4.
+
+//------------------Implementation of lz4_error-------------------------------//
+
+namespace {
+
+// Converts between error codes and function results as LZ4F_getErrorCode(),
+// which shared libraries don't export before lz4 1.10.
+int lz4_error_code(std::size_t result)
+{ return static_cast<int>(-static_cast<std::ptrdiff_t>(result)); }
+
+std::size_t lz4_error_result(int error)
+{ return static_cast<std::size_t>(-static_cast<std::ptrdiff_t>(error)); }
+
+} // End unnamed namespace.
+
+lz4_error::lz4_error(int error)
+    : BOOST_IOSTREAMS_FAILURE(
+          std::string("lz4 error: ") +
+          LZ4F_getErrorName(lz4_error_result(error)) ),
+      error_(error)
+    { }
+
+void lz4_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(std::size_t result)
+{
+    if (!LZ4F_isError(result))
+        return;
+    int error = lz4_error_code(result);
+    if (error == LZ4F_ERROR_allocation_failed)
+        boost::throw_exception(std::bad_alloc());
+    boost::throw_exception(lz4_error(error));
+}
+
+//------------------Implementation of lz4_base--------------------------------//
+
+namespace detail {
+
+namespace {
+
+struct lz4_stream {
+    lz4_stream() : cctx(0), dctx(0), cdict(0), pos(0), chunk(0), done(false)
+    { std::memset(&prefs, 0, sizeof(prefs)); }
+    LZ4F_cctx*          cctx;
+    LZ4F_dctx*          dctx;
+#ifdef BOOST_IOSTREAMS_LZ4_HAS_DICTIONARY
+    LZ4F_CDict*         cdict;
+#else
+    void*               cdict;
+#endif
+    LZ4F_preferences_t  prefs;
+    std::vector<char>   buf;    // Compressed data not yet written.
+    std::size_t         pos;
+    std::size_t         chunk;  // Input passed to LZ4F_compressUpdate.
+    bool                done;
+};
+
+} // End unnamed namespace.
+
+lz4_base::lz4_base(bool compress, const lz4_params& params)
+    : params_(params), stream_(new lz4_stream),
+      compress_(compress), ready_(false)
+    { }
+
+lz4_base::~lz4_base()
+{
+    lz4_stream* s = static_cast<lz4_stream*>(stream_);
+    LZ4F_freeCompressionContext(s->cctx);
+    LZ4F_freeDecompressionContext(s->dctx);
+#ifdef BOOST_IOSTREAMS_LZ4_HAS_DICTIONARY
+    LZ4F_freeCDict(s->cdict);
+#endif
+    delete s;
+}
+
+void lz4_base::init()
+{
+    // The contexts are created by the first frame and reused by the
+    // following ones.
+    lz4_stream* s = static_cast<lz4_stream*>(stream_);
+#ifndef BOOST_IOSTREAMS_LZ4_HAS_DICTIONARY
+    if (!params_.dictionary.empty())
+        boost::throw_exception(lz4_error(lz4::generic_error));
+#endif
+    if (compress_) {
+        if (!s->cctx) {
+            lz4_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(
+                LZ4F_createCompressionContext(&s->cctx, LZ4F_VERSION) );
+            s->prefs.compressionLevel = params_.level;
+            s->prefs.frameInfo.blockSizeID =
+                static_cast<LZ4F_blockSizeID_t>(params_.block_size);
+            s->prefs.frameInfo.contentChecksumFlag =
+                params_.checksum ? LZ4F_contentChecksumEnabled :
+                                   LZ4F_noContentChecksum;
+            s->chunk = static_cast<std::size_t>(64 * 1024)
+                << (2 * (params_.block_size - lz4::block_64k));
+            s->buf.reserve(LZ4F_compressBound(s->chunk, &s->prefs));
+#ifdef BOOST_IOSTREAMS_LZ4_HAS_DICTIONARY
+            if (!params_.dictionary.empty()) {
+                s->cdict = LZ4F_createCDict( params_.dictionary.data(),
+                                             params_.dictionary.size() );
+                if (!s->cdict)
+                    boost::throw_exception(std::bad_alloc());
+            }
+#endif
+        }
+
+        // The frame header is written by the first call to compress()
+        s->buf.resize(LZ4F_HEADER_SIZE_MAX);
+#ifdef BOOST_IOSTREAMS_LZ4_HAS_DICTIONARY
+        std::size_t result =
+            LZ4F_compressBegin_usingCDict( s->cctx, &s->buf[0], s->buf.size(),
+                                           s->cdict, &s->prefs );
+#else
+        std::size_t result =
+            LZ4F_compressBegin(s->cctx, &s->buf[0], s->buf.size(), &s->prefs);
+#endif
+        lz4_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(result);
+        s->buf.resize(result);
+        s->pos = 0;
+        s->done = false;
+    } else if (!s->dctx) {
+        lz4_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(
+            LZ4F_createDecompressionContext(&s->dctx, LZ4F_VERSION) );
+    }
+    ready_ = true;
+}
+
+bool lz4_base::compress( const char*& src_begin, const char* src_end,
+                         char*& dest_begin, char* dest_end, bool flush )
+{
+    // LZ4F_compressUpdate needs room for a whole compressed block, so the
+    // output goes through buf
+    lz4_stream* s = static_cast<lz4_stream*>(stream_);
+    while (true) {
+        std::size_t amt =
+            (std::min)( s->buf.size() - s->pos,
+                        static_cast<std::size_t>(dest_end - dest_begin) );
+        if (amt) {
+            std::memcpy(dest_begin, &s->buf[s->pos], amt);
+            dest_begin += amt;
+            s->pos += amt;
+        }
+        if (s->pos != s->buf.size())
+            return false;
+        if (s->done)
+            return true;
+        std::size_t result;
+        if (src_begin != src_end) {
+            std::size_t size =
+                (std::min)( s->chunk,
+                            static_cast<std::size_t>(src_end - src_begin) );
+            s->buf.resize(LZ4F_compressBound(size, &s->prefs));
+            result = LZ4F_compressUpdate( s->cctx, &s->buf[0], s->buf.size(),
+                                          src_begin, size, 0 );
+            lz4_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(result);
+            src_begin += size;
+        } else if (flush) {
+            s->buf.resize(LZ4F_compressBound(0, &s->prefs));
+            result = LZ4F_compressEnd(s->cctx, &s->buf[0], s->buf.size(), 0);
+            lz4_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(result);
+            s->done = true;
+        } else {
+            return false;
+        }
+        s->buf.resize(result);
+        s->pos = 0;
+    }
+}
+
+std::size_t lz4_base::decompress( const char*& src_begin, const char* src_end,
+                                  char*& dest_begin, char* dest_end )
+{
+    // Continues with the next frame at once, since symmetric_filter
+    // discards unconsumed input if there is room for more output.
+    lz4_stream* s = static_cast<lz4_stream*>(stream_);
+    std::size_t result;
+    do {
+        std::size_t src_size = static_cast<std::size_t>(src_end - src_begin);
+        std::size_t dest_size = static_cast<std::size_t>(dest_end - dest_begin);
+#ifdef BOOST_IOSTREAMS_LZ4_HAS_DICTIONARY
+        if (!params_.dictionary.empty())
+            result =
+                LZ4F_decompress_usingDict( s->dctx, dest_begin, &dest_size,
+                                           src_begin, &src_size,
+                                           params_.dictionary.data(),
+                                           params_.dictionary.size(), 0 );
+        else
+#endif
+            result = LZ4F_decompress( s->dctx, dest_begin, &dest_size,
+                                      src_begin, &src_size, 0 );
+        lz4_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(result);
+        src_begin += src_size;
+        dest_begin += dest_size;
+    } while (result == 0 && src_begin != src_end && dest_begin != dest_end);
+    return result;
+}
+
+void lz4_base::reset()
+{
+    if (!ready_) return;
+    ready_ = false;
+    lz4_stream* s = static_cast<lz4_stream*>(stream_);
+    // An unfinished frame can't be continued.
+    if (s->dctx)
+        LZ4F_resetDecompressionContext(s->dctx);
+    s->buf.clear();
+    s->pos = 0;
+    s->done = false;
+}
+
+} // End namespace detail.
+
+//----------------------------------------------------------------------------//
+
+} } // End namespaces iostreams, boost.
@@ -0,0 +1,52 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+// To configure Boost to work with libbz2, see the
+// installation instructions here:
+// http://boost.org/libs/iostreams/doc/index.html?path=7
+
+// Define BOOST_IOSTREAMS_SOURCE so that <boost/iostreams/detail/config.hpp>
+// knows that we are building the library (possibly exporting code), rather
+// than using it (possibly importing code).
+#define BOOST_IOSTREAMS_SOURCE
+
+#include <new>                                      // bad_alloc.
+#include <boost/throw_exception.hpp>
+#include <boost/iostreams/detail/config/dyn_link.hpp>
+#include <boost/iostreams/filter/parallel_bzip2.hpp>
+#include "bzlib.h"  // Julian Seward's "bzip.h" header.
+                    // To configure Boost to work with libbz2, see the
+                    // installation instructions here:
+                    // http://boost.org/libs/iostreams/doc/index.html?path=7
+
+namespace boost { namespace iostreams { namespace detail {
+
+//------------------Implementation of parallel_bzip2_codec--------------------//
+
+void parallel_bzip2_codec::compress(parallel_block& b) const
+{
+    // Worst case expansion documented by libbz2.
+    std::size_t size = b.input.size();
+    b.output.resize(size + size / 100 + 600);
+    unsigned int dest_size = static_cast<unsigned int>(b.output.size());
+    char empty = 0;  // libbz2 rejects null sources, even if empty.
+    b.error =
+        BZ2_bzBuffToBuffCompress( &b.output[0], &dest_size,
+                                  size ? &b.input[0] : &empty,
+                                  static_cast<unsigned int>(size),
+                                  params_.block_size, 0,
+                                  params_.work_factor );
+    b.output.resize(b.error == BZ_OK ? dest_size : 0);
+}
+
+void parallel_bzip2_codec::consume(const parallel_block& b)
+{
+    if (b.error == BZ_MEM_ERROR)
+        boost::throw_exception(std::bad_alloc());
+    bzip2_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(b.error);
+}
+
+} } } // End namespaces detail, iostreams, boost.
@@ -0,0 +1,145 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+// To configure Boost to work with zlib, see the
+// installation instructions here:
+// http://boost.org/libs/iostreams/doc/index.html?path=7
+
+// Define BOOST_IOSTREAMS_SOURCE so that <boost/iostreams/detail/config.hpp>
+// knows that we are building the library (possibly exporting code), rather
+// than using it (possibly importing code).
+#define BOOST_IOSTREAMS_SOURCE
+
+#include <cstring>                                  // memset.
+#include <boost/iostreams/detail/config/dyn_link.hpp>
+#include <boost/iostreams/filter/parallel_gzip.hpp>
+#include "zlib.h"   // Jean-loup Gailly's and Mark Adler's "zlib.h" header.
+                    // To configure Boost to work with zlib, see the
+                    // installation instructions here:
+                    // http://boost.org/libs/iostreams/doc/index.html?path=7
+
+namespace boost { namespace iostreams { namespace detail {
+
+namespace {
+
+void append_long(boost::uint32_t n, std::string& out)
+{
+    out += static_cast<char>(0xFF & n);
+    out += static_cast<char>(0xFF & (n >> 8));
+    out += static_cast<char>(0xFF & (n >> 16));
+    out += static_cast<char>(0xFF & (n >> 24));
+}
+
+} // End unnamed namespace.
+
+//------------------Implementation of parallel_gzip_codec---------------------//
+
+parallel_gzip_codec::parallel_gzip_codec(const gzip_params& p)
+    : params_(p), crc_(0), length_(0)
+{ }
+
+std::size_t parallel_gzip_codec::dictionary_size() const
+{ return static_cast<std::size_t>(1) << params_.window_bits; }
+
+void parallel_gzip_codec::header(std::string& out)
+{
+    crc_ = 0;
+    length_ = 0;
+    bool has_name = !params_.file_name.empty();
+    bool has_comment = !params_.comment.empty();
+    int flags =
+        (has_name ? gzip::flags::name : 0) +
+        (has_comment ? gzip::flags::comment : 0);
+    int extra_flags =
+        ( params_.level == zlib::best_compression ?
+              gzip::extra_flags::best_compression :
+              0 ) +
+        ( params_.level == zlib::best_speed ?
+              gzip::extra_flags::best_speed :
+              0 );
+    out += static_cast<char>(gzip::magic::id1);         // ID1.
+    out += static_cast<char>(gzip::magic::id2);         // ID2.
+    out += static_cast<char>(gzip::method::deflate);    // CM.
+    out += static_cast<char>(flags);                    // FLG.
+    append_long(static_cast<boost::uint32_t>(params_.mtime), out); // MTIME.
+    out += static_cast<char>(extra_flags);              // XFL.
+    out += static_cast<char>(gzip::os_unknown);         // OS.
+    if (has_name) {
+        out += params_.file_name;
+        out += '\0';
+    }
+    if (has_comment) {
+        out += params_.comment;
+        out += '\0';
+    }
+}
+
+void parallel_gzip_codec::compress(parallel_block& b) const
+{
+    z_stream s;
+    std::memset(&s, 0, sizeof(s));
+    int result = deflateInit2( &s, params_.level, params_.method,
+                               -params_.window_bits, params_.mem_level,
+                               params_.strategy );
+    if (result != Z_OK) {
+        b.error = result;
+        return;
+    }
+    uInt in_size = static_cast<uInt>(b.input.size());
+    if (!b.dictionary.empty()) {
+        result = deflateSetDictionary
+            ( &s, reinterpret_cast<const Bytef*>(&b.dictionary[0]),
+              static_cast<uInt>(b.dictionary.size()) );
+    }
+    if (result == Z_OK) {
+        // The sync flush marker needs a few bytes beyond deflateBound.
+        b.output.resize(deflateBound(&s, in_size) + 16);
+        s.next_in =
+            in_size ? reinterpret_cast<Bytef*>(&b.input[0]) : Z_NULL;
+        s.avail_in = in_size;
+        int flush = b.last ? Z_FINISH : Z_SYNC_FLUSH;
+        while (true) {
+            s.next_out = reinterpret_cast<Bytef*>(&b.output[s.total_out]);
+            s.avail_out = static_cast<uInt>(b.output.size() - s.total_out);
+            result = deflate(&s, flush);
+            if (result == Z_STREAM_ERROR)
+                break;
+            if ( b.last ? result == Z_STREAM_END :
+                          s.avail_in == 0 && s.avail_out != 0 )
+            {
+                result = Z_OK;
+                break;
+            }
+            b.output.resize(b.output.size() * 2);
+        }
+        b.output.resize(s.total_out);
+        b.check = static_cast<boost::uint32_t>(
+            crc32( crc32(0L, Z_NULL, 0),
+                   in_size ? reinterpret_cast<const Bytef*>(&b.input[0]) : Z_NULL,
+                   in_size ) );
+    }
+    deflateEnd(&s);
+    b.error = result;
+}
+
+void parallel_gzip_codec::consume(const parallel_block& b)
+{
+    if (b.error == Z_MEM_ERROR)
+        boost::throw_exception(std::bad_alloc());
+    else if (b.error != Z_OK)
+        boost::throw_exception(gzip_error(zlib_error(b.error)));
+    crc_ = static_cast<boost::uint32_t>(
+        crc32_combine(crc_, b.check, static_cast<z_off_t>(b.input.size())) );
+    length_ += static_cast<boost::uint32_t>(b.input.size());
+}
+
+void parallel_gzip_codec::trailer(std::string& out)
+{
+    append_long(crc_, out);
+    append_long(length_, out);
+}
+
+} } } // End namespaces detail, iostreams, boost.
@@ -0,0 +1,191 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+// To configure Boost to work with libzstd, see the
+// installation instructions here:
+// http://boost.org/libs/iostreams/doc/index.html?path=7
+
+// Define BOOST_IOSTREAMS_SOURCE so that <boost/iostreams/detail/config.hpp>
+// knows that we are building the library (possibly exporting code), rather
+// than using it (possibly importing code).
+#define BOOST_IOSTREAMS_SOURCE
+
+#include <new>                                      // bad_alloc.
+#include <boost/throw_exception.hpp>
+#include <boost/iostreams/detail/config/dyn_link.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include "zstd.h"           // Yann Collet's "zstd.h" header, version 1.4 or
+#include "zstd_errors.h"    // later. To configure Boost to work with libzstd,
+                            // see the installation instructions here:
+                            // http://boost.org/libs/iostreams/doc/index.html?path=7
+
+namespace boost { namespace iostreams {
+
+namespace zstd {
+
+                    // Compression levels
+
+const int best_speed                   = 1;
+const int best_compression             = ZSTD_maxCLevel();
+const int default_compression          = ZSTD_CLEVEL_DEFAULT;
+
+                    // Error codes
+
+const int generic_error                = ZSTD_error_GENERIC;
+const int prefix_unknown               = ZSTD_error_prefix_unknown;
+const int frame_parameter_unsupported  = ZSTD_error_frameParameter_unsupported;
+const int corruption_detected          = ZSTD_error_corruption_detected;
+const int checksum_wrong               = ZSTD_error_checksum_wrong;
+const int dictionary_wrong             = ZSTD_error_dictionary_wrong;
+const int parameter_unsupported        = ZSTD_error_parameter_unsupported;
+const int unexpected_eof               = ZSTD_error_srcSize_wrong;
+
+                    // Flush codes
+
+const int run                          = ZSTD_e_continue;
+const int finish                       = ZSTD_e_end;
+
+} // End namespace zstd.
+
+//------------------Implementation of zstd_error------------------------------//
+
+zstd_error::zstd_error(int error)
+    : BOOST_IOSTREAMS_FAILURE(
+          std::string("zstd error: ") +
+          ZSTD_getErrorString(static_cast<ZSTD_ErrorCode>(error)) ),
+      error_(error)
+    { }
+
+void zstd_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(std::size_t result)
+{
+    if (!ZSTD_isError(result))
+        return;
+    int error = ZSTD_getErrorCode(result);
+    if (error == ZSTD_error_memory_allocation)
+        boost::throw_exception(std::bad_alloc());
+    boost::throw_exception(zstd_error(error));
+}
+
+//------------------Implementation of zstd_base-------------------------------//
+
+namespace detail {
+
+namespace {
+
+struct zstd_stream {
+    zstd_stream() : cctx(0), dctx(0) { }
+    ZSTD_CCtx*      cctx;
+    ZSTD_DCtx*      dctx;
+    ZSTD_inBuffer   in;
+    ZSTD_outBuffer  out;
+};
+
+} // End unnamed namespace.
+
+zstd_base::zstd_base(bool compress, const zstd_params& params)
+    : params_(params), stream_(new zstd_stream),
+      compress_(compress), ready_(false)
+    { }
+
+zstd_base::~zstd_base()
+{
+    zstd_stream* s = static_cast<zstd_stream*>(stream_);
+    ZSTD_freeCCtx(s->cctx);
+    ZSTD_freeDCtx(s->dctx);
+    delete s;
+}
+
+void zstd_base::init()
+{
+    // The context is created by the first stream and reused by the
+    // following ones with the same parameters and dictionary.
+    zstd_stream* s = static_cast<zstd_stream*>(stream_);
+    const void* dict = params_.dictionary.data();
+    std::size_t dict_size = params_.dictionary.size();
+    if (compress_ && !s->cctx) {
+        if (!(s->cctx = ZSTD_createCCtx()))
+            boost::throw_exception(std::bad_alloc());
+        zstd_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(
+            ZSTD_CCtx_setParameter( s->cctx, ZSTD_c_compressionLevel,
+                                    params_.level ) );
+        zstd_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(
+            ZSTD_CCtx_setParameter( s->cctx, ZSTD_c_checksumFlag,
+                                    params_.checksum ? 1 : 0 ) );
+        if (dict_size)
+            zstd_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(
+                ZSTD_CCtx_loadDictionary(s->cctx, dict, dict_size) );
+    } else if (!compress_ && !s->dctx) {
+        if (!(s->dctx = ZSTD_createDCtx()))
+            boost::throw_exception(std::bad_alloc());
+        if (dict_size)
+            zstd_error::check BOOST_PREVENT_MACRO_SUBSTITUTION(
+                ZSTD_DCtx_loadDictionary(s->dctx, dict, dict_size) );
+    }
+    ready_ = true;
+}
+
+void zstd_base::before( const char*& src_begin, const char* src_end,
+                        char*& dest_begin, char* dest_end )
+{
+    zstd_stream* s = static_cast<zstd_stream*>(stream_);
+    s->in.src = src_begin;
+    s->in.size = static_cast<std::size_t>(src_end - src_begin);
+    s->in.pos = 0;
+    s->out.dst = dest_begin;
+    s->out.size = static_cast<std::size_t>(dest_end - dest_begin);
+    s->out.pos = 0;
+}
+
+void zstd_base::after(const char*& src_begin, char*& dest_begin)
+{
+    zstd_stream* s = static_cast<zstd_stream*>(stream_);
+    src_begin += s->in.pos;
+    dest_begin += s->out.pos;
+}
+
+bool zstd_base::no_progress() const
+{
+    zstd_stream* s = static_cast<zstd_stream*>(stream_);
+    return s->in.pos == 0 && s->out.pos == 0;
+}
+
+std::size_t zstd_base::compress(int flush)
+{
+    zstd_stream* s = static_cast<zstd_stream*>(stream_);
+    return ZSTD_compressStream2( s->cctx, &s->out, &s->in,
+                                 static_cast<ZSTD_EndDirective>(flush) );
+}
+
+std::size_t zstd_base::decompress()
+{
+    // Continues with the next frame at once, since symmetric_filter
+    // discards unconsumed input if there is room for more output.
+    zstd_stream* s = static_cast<zstd_stream*>(stream_);
+    std::size_t result;
+    do {
+        result = ZSTD_decompressStream(s->dctx, &s->out, &s->in);
+    } while ( result == 0 && s->in.pos < s->in.size &&
+              s->out.pos < s->out.size );
+    return result;
+}
+
+void zstd_base::reset()
+{
+    if (!ready_) return;
+    ready_ = false;
+    zstd_stream* s = static_cast<zstd_stream*>(stream_);
+    // Keeps the parameters and the dictionary.
+    if (s->cctx)
+        ZSTD_CCtx_reset(s->cctx, ZSTD_reset_session_only);
+    if (s->dctx)
+        ZSTD_DCtx_reset(s->dctx, ZSTD_reset_session_only);
+}
+
+} // End namespace detail.
+
+//----------------------------------------------------------------------------//
+
+} } // End namespaces iostreams, boost.
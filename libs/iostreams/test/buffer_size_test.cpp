@@ -5,10 +5,15 @@
 
 // See http://www.boost.org/libs/iostreams for documentation.
 
+#include <algorithm>           // min.
+#include <cctype>              // toupper.
+#include <string>
 #include "detail/filters.hpp"  // Must come before operations.hpp for VC6.
 #include <boost/iostreams/categories.hpp>
 #include <boost/iostreams/constants.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/device/null.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/operations.hpp>
 #include <boost/test/test_tools.hpp>
 #include <boost/test/unit_test.hpp>
@@ -28,6 +33,75 @@ struct optimally_buffered_filter {
     { return default_filter_buffer_size + 1; }
 };
 
+// Source which records the largest number of characters requested
+// by a single call to read.
+class recording_source : public source {
+public:
+    recording_source(const std::string& data, std::streamsize& largest)
+        : data_(data), pos_(0), largest_(&largest)
+        { }
+    std::streamsize read(char* s, std::streamsize n)
+    {
+        *largest_ = (std::max)(*largest_, n);
+        std::streamsize avail =
+            static_cast<std::streamsize>(data_.size() - pos_);
+        if (avail == 0)
+            return -1;
+        std::streamsize amt = (std::min)(n, avail);
+        data_.copy(s, static_cast<std::string::size_type>(amt), pos_);
+        pos_ += static_cast<std::string::size_type>(amt);
+        return amt;
+    }
+private:
+    std::string             data_;
+    std::string::size_type  pos_;
+    std::streamsize*        largest_;
+};
+
+// Sink which records the largest number of characters passed to a
+// single call to write.
+class recording_sink : public sink {
+public:
+    recording_sink(std::string& data, std::streamsize& largest)
+        : data_(&data), largest_(&largest)
+        { }
+    std::streamsize write(const char* s, std::streamsize n)
+    {
+        *largest_ = (std::max)(*largest_, n);
+        data_->append(s, static_cast<std::string::size_type>(n));
+        return n;
+    }
+private:
+    std::string*      data_;
+    std::streamsize*  largest_;
+};
+
+// Output filter which passes its input to the sink in a single call.
+struct identity_multichar_output_filter : multichar_output_filter {
+    template<typename Sink>
+    std::streamsize write(Sink& snk, const char* s, std::streamsize n)
+    { return boost::iostreams::write(snk, s, n); }
+};
+
+struct optimally_buffered_source : recording_source {
+    struct category
+        : source_tag,
+          optimally_buffered_tag
+        { };
+    optimally_buffered_source(const std::string& data, std::streamsize& largest)
+        : recording_source(data, largest)
+        { }
+    std::streamsize optimal_buffer_size() const { return 30; }
+};
+
+std::string test_data(std::streamsize size)
+{
+    std::string result;
+    for (std::streamsize z = 0; z < size; ++z)
+        result += static_cast<char>('a' + z % 26);
+    return result;
+}
+
 void buffer_size_test()
 {
     // Test   device buffer sizes.
@@ -74,9 +148,137 @@ void buffer_size_test()
     );
 }
 
+void chain_buffer_size_test()
+{
+    const std::string data = test_data(1000);
+
+    // Test   buffer sizes set for the devices and filters of a chain.
+
+    {
+        std::streamsize largest = 0;
+        filtering_istream in;
+        in.set_device_buffer_size(100);
+        in.set_filter_buffer_size(10);
+        in.push(toupper_filter());
+        in.push(recording_source(data, largest));
+        in.get();
+        BOOST_CHECK_EQUAL(largest, 100);
+        BOOST_CHECK_EQUAL(in.rdbuf()->in_avail(), 9);
+    }
+
+    // Test   explicit buffer size.
+
+    {
+        std::streamsize largest = 0;
+        filtering_istream in;
+        in.set_device_buffer_size(100);
+        in.push(toupper_filter());
+        in.push(recording_source(data, largest), 50);
+        in.get();
+        BOOST_CHECK_EQUAL(largest, 50);
+    }
+
+    // Test   custom buffer size, which takes precedence.
+
+    {
+        std::streamsize largest = 0;
+        filtering_istream in;
+        in.set_device_buffer_size(100);
+        in.push(optimally_buffered_source(data, largest));
+        in.get();
+        BOOST_CHECK_EQUAL(largest, 30);
+    }
+}
+
+void direct_transfer_test()
+{
+    const std::streamsize size = 100000;
+    const std::string data = test_data(size);
+    std::string upper;
+    for (std::string::size_type z = 0; z < data.size(); ++z)
+        upper += static_cast<char>(std::toupper(data[z]));
+
+    // Test   reads larger than the buffers of a chain.
+
+    {
+        std::streamsize largest = 0;
+        filtering_istream in;
+        in.push(toupper_multichar_filter(), 256);
+        in.push(recording_source(data, largest), 1024);
+        std::string result(static_cast<std::string::size_type>(size), '\0');
+        in.read(&result[0], 10);
+        in.read(&result[10], size - 10);
+        BOOST_CHECK_EQUAL(in.gcount(), size - 10);
+        BOOST_CHECK(result == upper);
+        BOOST_CHECK_MESSAGE(
+            largest > 1024,
+            "large read was not passed to the device"
+        );
+
+        // The putback buffer is still available
+        in.clear();
+        BOOST_CHECK(in.unget());
+        BOOST_CHECK_EQUAL(in.get(), upper[upper.size() - 1]);
+        BOOST_CHECK_EQUAL(in.get(), EOF);
+    }
+
+    // Test   mixed small and large reads.
+
+    {
+        std::streamsize largest = 0;
+        filtering_istream in;
+        in.push(toupper_multichar_filter(), 256);
+        in.push(recording_source(data, largest), 1024);
+        std::string result;
+        char buf[5000];
+        std::streamsize amt = 1;
+        while (in.read(buf, amt), in.gcount() > 0) {
+            result.append(buf, static_cast<std::string::size_type>(in.gcount()));
+            amt = amt * 7 % 4999 + 1;
+        }
+        BOOST_CHECK(result == upper);
+    }
+
+    // Test   writes larger than the buffers of a chain.
+
+    {
+        std::streamsize largest = 0;
+        std::string result;
+        {
+            filtering_ostream out;
+            out.push(identity_multichar_output_filter(), 256);
+            out.push(recording_sink(result, largest), 1024);
+            out.write(data.data(), 10);
+            out.write(data.data() + 10, size - 10);
+            out.put(data[0]);
+        }
+        BOOST_CHECK(result == data + data[0]);
+        BOOST_CHECK_MESSAGE(
+            largest > 1024,
+            "large write was not passed to the device"
+        );
+    }
+
+    // Test   unbuffered writes.
+
+    {
+        std::streamsize largest = 0;
+        std::string result;
+        {
+            filtering_ostream out;
+            out.push(recording_sink(result, largest), 0);
+            out.write(data.data(), size);
+        }
+        BOOST_CHECK(result == data);
+        BOOST_CHECK_EQUAL(largest, size);
+    }
+}
+
 test_suite* init_unit_test_suite(int, char* [])
 {
     test_suite* test = BOOST_TEST_SUITE("buffer_size test");
     test->add(BOOST_TEST_CASE(&buffer_size_test));
+    test->add(BOOST_TEST_CASE(&chain_buffer_size_test));
+    test->add(BOOST_TEST_CASE(&direct_transfer_test));
     return test;
 }
@@ -0,0 +1,80 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+#include <string>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/parallel_bzip2.hpp>
+#include <boost/iostreams/filter/test.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+#include "detail/sequence.hpp"
+
+using namespace std;
+using namespace boost::iostreams;
+using namespace boost::iostreams::test;
+using boost::unit_test::test_suite;
+namespace io = boost::iostreams;
+
+std::string decompress(const std::string& src)
+{
+    std::string dest;
+    io::copy(
+        array_source(src.data(), src.size()),
+        io::compose(bzip2_decompressor(), io::back_inserter(dest)) );
+    return dest;
+}
+
+void check_round_trip(const std::string& data, const parallel_params& pp)
+{
+    std::string temp;
+    io::copy(
+        array_source(data.data(), data.size()),
+        io::compose( parallel_bzip2_compressor(bzip2::default_block_size, pp),
+                     non_blocking_sink(temp, default_increment) ) );
+    BOOST_CHECK(decompress(temp) == data);
+}
+
+void round_trip_test()
+{
+    text_sequence  seq;
+    std::string    data(seq.begin(), seq.end());
+    std::string    big;
+    for (int i = 0; i < 20; ++i)
+        big += data;
+    check_round_trip(data, parallel_params());
+    check_round_trip(std::string(), parallel_params());
+    check_round_trip(data, parallel_params(1000, 1));
+    check_round_trip(data, parallel_params(1000, 4));
+    check_round_trip(big, parallel_params(4096, 3));
+    check_round_trip(big, parallel_params(big.size(), 2));
+}
+
+void reuse_test()
+{
+    text_sequence              seq;
+    std::string                data(seq.begin(), seq.end());
+    parallel_bzip2_compressor  bz(bzip2::default_block_size,
+                                  parallel_params(2000, 2));
+    for (int i = 0; i < 3; ++i) {
+        std::string temp;
+        io::copy(
+            array_source(data.data(), data.size()),
+            io::compose(bz, io::back_inserter(temp)) );
+        BOOST_CHECK(decompress(temp) == data);
+    }
+}
+
+test_suite* init_unit_test_suite(int, char* [])
+{
+    test_suite* test = BOOST_TEST_SUITE("parallel bzip2 test");
+    test->add(BOOST_TEST_CASE(&round_trip_test));
+    test->add(BOOST_TEST_CASE(&reuse_test));
+    return test;
+}
@@ -0,0 +1,109 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+#include <string>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/parallel_gzip.hpp>
+#include <boost/iostreams/filter/test.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+#include "detail/sequence.hpp"
+
+using namespace std;
+using namespace boost::iostreams;
+using namespace boost::iostreams::test;
+using boost::unit_test::test_suite;
+namespace io = boost::iostreams;
+
+std::string decompress(const std::string& src)
+{
+    std::string dest;
+    io::copy(
+        array_source(src.data(), src.size()),
+        io::compose(gzip_decompressor(), io::back_inserter(dest)) );
+    return dest;
+}
+
+void check_round_trip(const std::string& data, const parallel_params& pp)
+{
+    std::string temp;
+    io::copy(
+        array_source(data.data(), data.size()),
+        io::compose( parallel_gzip_compressor(gzip::default_compression, pp),
+                     non_blocking_sink(temp, default_increment) ) );
+    BOOST_CHECK(decompress(temp) == data);
+}
+
+void round_trip_test()
+{
+    text_sequence  seq;
+    std::string    data(seq.begin(), seq.end());
+    std::string    big;
+    for (int i = 0; i < 20; ++i)
+        big += data;
+    check_round_trip(data, parallel_params());
+    check_round_trip(std::string(), parallel_params());
+    check_round_trip(std::string(), parallel_params(1000, 2));
+    check_round_trip(data, parallel_params(1000, 1));
+    check_round_trip(data, parallel_params(1000, 4));
+    check_round_trip(big, parallel_params(4096, 3));
+    check_round_trip(big, parallel_params(big.size(), 2));
+    check_round_trip(big, parallel_params(40000, 2));
+}
+
+void header_test()
+{
+    text_sequence  seq;
+    std::string    data(seq.begin(), seq.end());
+    std::string    temp;
+    gzip_params    p;
+    p.file_name = "original.txt";
+    p.comment = "parallel";
+    p.mtime = 1234567;
+    {
+        filtering_ostream out;
+        out.push(parallel_gzip_compressor(p, parallel_params(500, 2)));
+        out.push(io::back_inserter(temp));
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    gzip_decompressor gz;
+    std::string dest;
+    io::copy(
+        array_source(temp.data(), temp.size()),
+        io::compose(boost::ref(gz), io::back_inserter(dest)) );
+    BOOST_CHECK(dest == data);
+    BOOST_CHECK_EQUAL(gz.file_name(), "original.txt");
+    BOOST_CHECK_EQUAL(gz.comment(), "parallel");
+    BOOST_CHECK_EQUAL(static_cast<long>(gz.mtime()), 1234567L);
+}
+
+void reuse_test()
+{
+    text_sequence             seq;
+    std::string               data(seq.begin(), seq.end());
+    parallel_gzip_compressor  gz(gzip::default_compression,
+                                 parallel_params(2000, 2));
+    for (int i = 0; i < 3; ++i) {
+        std::string temp;
+        io::copy(
+            array_source(data.data(), data.size()),
+            io::compose(gz, io::back_inserter(temp)) );
+        BOOST_CHECK(decompress(temp) == data);
+    }
+}
+
+test_suite* init_unit_test_suite(int, char* [])
+{
+    test_suite* test = BOOST_TEST_SUITE("parallel gzip test");
+    test->add(BOOST_TEST_CASE(&round_trip_test));
+    test->add(BOOST_TEST_CASE(&header_test));
+    test->add(BOOST_TEST_CASE(&reuse_test));
+    return test;
+}
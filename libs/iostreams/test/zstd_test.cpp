@@ -0,0 +1,160 @@
+// (C) Copyright 2015 Boost.Iostreams contributors
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.)
+
+// See http://www.boost.org/libs/iostreams for documentation.
+
+#include <string>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/test.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+#include "detail/sequence.hpp"
+
+using namespace std;
+using namespace boost::iostreams;
+using namespace boost::iostreams::test;
+using boost::unit_test::test_suite;
+namespace io = boost::iostreams;
+
+struct zstd_alloc : std::allocator<char> { };
+
+void zstd_test()
+{
+    text_sequence data;
+    BOOST_CHECK(
+        test_filter_pair( zstd_compressor(),
+                          zstd_decompressor(),
+                          std::string(data.begin(), data.end()) )
+    );
+    BOOST_CHECK(
+        test_filter_pair( basic_zstd_compressor<zstd_alloc>(),
+                          basic_zstd_decompressor<zstd_alloc>(),
+                          std::string(data.begin(), data.end()) )
+    );
+    BOOST_CHECK(
+        test_filter_pair( zstd_compressor(),
+                          zstd_decompressor(),
+                          std::string() )
+    );
+    BOOST_CHECK(
+        test_filter_pair( zstd_compressor(zstd::best_speed),
+                          zstd_decompressor(),
+                          std::string(data.begin(), data.end()) )
+    );
+    BOOST_CHECK(
+        test_filter_pair( zstd_compressor(zstd_params(19, true)),
+                          zstd_decompressor(),
+                          std::string(data.begin(), data.end()) )
+    );
+    {
+        filtering_istream strm;
+        strm.push( zstd_compressor() );
+        strm.push( null_source() );
+    }
+    {
+        filtering_istream strm;
+        strm.push( zstd_decompressor() );
+        strm.push( null_source() );
+    }
+}
+
+void dictionary_test()
+{
+    text_sequence  data;
+    std::string    str(data.begin(), data.end());
+    zstd_params    p(zstd::default_compression, false,
+                     str.substr(0, str.size() / 2));
+    BOOST_CHECK(
+        test_filter_pair(zstd_compressor(p), zstd_decompressor(p), str)
+    );
+
+    // The dictionary improves compression of similar data
+    std::string with_dict, without_dict;
+    io::copy( array_source(str.data(), str.size() / 2),
+              io::compose(zstd_compressor(p), io::back_inserter(with_dict)) );
+    io::copy( array_source(str.data(), str.size() / 2),
+              io::compose(zstd_compressor(), io::back_inserter(without_dict)) );
+    BOOST_CHECK(with_dict.size() < without_dict.size());
+
+    // Decompression without the dictionary fails
+    std::string dest;
+    BOOST_CHECK_THROW(
+        io::copy( array_source(with_dict.data(), with_dict.size()),
+                  io::compose(zstd_decompressor(), io::back_inserter(dest)) ),
+        zstd_error
+    );
+}
+
+void multiple_frame_test()
+{
+    text_sequence      data;
+    std::vector<char>  temp, dest;
+
+    // Write compressed data to temp, twice in succession
+    filtering_ostream out;
+    out.push(zstd_compressor());
+    out.push(io::back_inserter(temp));
+    io::copy(boost::make_iterator_range(data), out);
+    out.push(io::back_inserter(temp));
+    io::copy(boost::make_iterator_range(data), out);
+
+    // Read compressed data from temp into dest
+    filtering_istream in;
+    in.push(zstd_decompressor());
+    in.push(array_source(&temp[0], temp.size()));
+    io::copy(in, io::back_inserter(dest));
+
+    // Check that dest consists of two copies of data
+    BOOST_REQUIRE_EQUAL(data.size() * 2, dest.size());
+    BOOST_CHECK(std::equal(data.begin(), data.end(), dest.begin()));
+    BOOST_CHECK(std::equal(data.begin(), data.end(), dest.begin() + dest.size() / 2));
+
+    dest.clear();
+    io::copy(
+        array_source(&temp[0], temp.size()),
+        io::compose(zstd_decompressor(), io::back_inserter(dest)));
+
+    // Check that dest consists of two copies of data
+    BOOST_REQUIRE_EQUAL(data.size() * 2, dest.size());
+    BOOST_CHECK(std::equal(data.begin(), data.end(), dest.begin()));
+    BOOST_CHECK(std::equal(data.begin(), data.end(), dest.begin() + dest.size() / 2));
+}
+
+void error_test()
+{
+    text_sequence  data;
+    std::string    temp, dest;
+    io::copy( boost::make_iterator_range(data),
+              io::compose(zstd_compressor(), io::back_inserter(temp)) );
+
+    // Truncated input
+    BOOST_CHECK_THROW(
+        io::copy( array_source(temp.data(), temp.size() - 1),
+                  io::compose(zstd_decompressor(), io::back_inserter(dest)) ),
+        zstd_error
+    );
+
+    // Not a zstd frame
+    try {
+        io::copy( array_source(&data[0], data.size()),
+                  io::compose(zstd_decompressor(), io::back_inserter(dest)) );
+        BOOST_ERROR("zstd_error not thrown");
+    } catch (const zstd_error& e) {
+        BOOST_CHECK_EQUAL(e.error(), zstd::prefix_unknown);
+    }
+}
+
+test_suite* init_unit_test_suite(int, char* [])
+{
+    test_suite* test = BOOST_TEST_SUITE("zstd test");
+    test->add(BOOST_TEST_CASE(&zstd_test));
+    test->add(BOOST_TEST_CASE(&dictionary_test));
+    test->add(BOOST_TEST_CASE(&multiple_frame_test));
+    test->add(BOOST_TEST_CASE(&error_test));
+    return test;
+}
@@ -0,0 +1,44 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   char_search.cpp
+ * \author Andrey Semashev
+ * \date   25.07.2015
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/doc/libs/release/libs/log/doc/html/index.html.
+ */
+
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/char_search.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+const char* find_first_of_char_generic(const char* begin, const char* end, char_search_set const& set)
+{
+    for (; begin != end; ++begin)
+    {
+        const unsigned int c = static_cast< unsigned char >(*begin);
+        if ((set.low_nibble_masks[c & 0x0Fu] & set.high_nibble_masks[c >> 4]) != 0u)
+            break;
+    }
+
+    return begin;
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
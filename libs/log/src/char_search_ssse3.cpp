@@ -0,0 +1,84 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   char_search_ssse3.cpp
+ * \author Andrey Semashev
+ * \date   25.07.2015
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/doc/libs/release/libs/log/doc/html/index.html.
+ */
+
+// NOTE: You should generally avoid including headers as much as possible here, because this file
+//       is compiled with special compiler options, and any included header may result in generation of
+//       unintended code with these options and violation of ODR.
+#include <tmmintrin.h>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/char_search.hpp>
+#if defined(_MSC_VER)
+#include <intrin.h> // _BitScanForward
+#endif
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+extern const char* find_first_of_char_generic(const char* begin, const char* end, char_search_set const& set);
+
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+//! Returns the index of the least significant set bit of a non-zero mask
+BOOST_FORCEINLINE unsigned int find_first_bit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast< unsigned int >(index);
+#else
+    return static_cast< unsigned int >(__builtin_ctz(mask));
+#endif
+}
+
+} // namespace
+
+const char* find_first_of_char_ssse3(const char* begin, const char* end, char_search_set const& set)
+{
+    if (end - begin >= 16)
+    {
+        const __m128i mm_low_masks = _mm_loadu_si128(reinterpret_cast< const __m128i* >(set.low_nibble_masks));
+        const __m128i mm_high_masks = _mm_loadu_si128(reinterpret_cast< const __m128i* >(set.high_nibble_masks));
+        const __m128i mm_15 = _mm_set1_epi32(0x0F0F0F0F);
+        const __m128i mm_zero = _mm_setzero_si128();
+
+        do
+        {
+            const __m128i mm_chars = _mm_loadu_si128(reinterpret_cast< const __m128i* >(begin));
+            // Select the masks by the low and high nibbles of every character and check if they intersect
+            const __m128i mm_low = _mm_shuffle_epi8(mm_low_masks, _mm_and_si128(mm_chars, mm_15));
+            const __m128i mm_high = _mm_shuffle_epi8(mm_high_masks, _mm_and_si128(_mm_srli_epi16(mm_chars, 4), mm_15));
+            const unsigned int found = static_cast< unsigned int >(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(mm_low, mm_high), mm_zero))) ^ 0xFFFFu;
+            if (found != 0u)
+                return begin + find_first_bit(found);
+
+            begin += 16;
+        }
+        while (end - begin >= 16);
+    }
+
+    return find_first_of_char_generic(begin, end, set);
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
@@ -16,7 +16,10 @@
 #include <cstddef>
 #include <new>
 #include <memory>
+#include <map>
+#include <string>
 #include <vector>
+#include <limits>
 #include <algorithm>
 #include <boost/cstdint.hpp>
 #include <boost/assert.hpp>
@@ -33,8 +36,12 @@
 #include <boost/log/sinks/sink.hpp>
 #include <boost/log/attributes/attribute_value_set.hpp>
 #include <boost/log/detail/singleton.hpp>
+#include <boost/atomic/atomic.hpp>
 #if !defined(BOOST_LOG_NO_THREADS)
 #include <boost/thread/tss.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/thread.hpp>
 #include <boost/thread/exceptions.hpp>
 #include <boost/log/detail/locks.hpp>
 #include <boost/log/detail/light_rw_mutex.hpp>
@@ -48,6 +55,26 @@ namespace boost {
 
 BOOST_LOG_OPEN_NAMESPACE
 
+namespace aux {
+
+//! Severity level threshold of a module
+struct module_severity_threshold
+{
+    //! The threshold that applies to the loggers of the module
+    boost::atomic< int > m_threshold;
+    //! The flag indicates that the module has its own threshold, otherwise the global threshold is used
+    bool m_is_set;
+
+    explicit module_severity_threshold(int threshold) : m_threshold(threshold), m_is_set(false)
+    {
+    }
+
+    BOOST_DELETED_FUNCTION(module_severity_threshold(module_severity_threshold const&))
+    BOOST_DELETED_FUNCTION(module_severity_threshold& operator= (module_severity_threshold const&))
+};
+
+} // namespace aux
+
 //! Private record data information, with core-specific structures
 struct record_view::private_data :
     public public_data
@@ -203,26 +230,170 @@ public:
 
     //! Sinks container type
     typedef std::vector< shared_ptr< sinks::sink > > sink_list;
+    //! Module thresholds container type
+    typedef std::map< std::string, log::aux::module_severity_threshold* > module_threshold_map;
+
+    /*!
+     * Immutable snapshot of the core configuration. Threads that open log records use the current
+     * snapshot without locking. Every modification of the configuration publishes a new snapshot;
+     * the previous one is destroyed when no thread uses it anymore.
+     */
+    struct configuration
+    {
+        //! List of sinks involved into output
+        sink_list m_sinks;
+        //! Global attribute set
+        attribute_set m_global_attributes;
+        //! Global filter
+        filter m_filter;
+    };
+
+    struct thread_registry;
 
     //! Thread-specific data
     struct thread_data
     {
         //! Thread-specific attribute set
         attribute_set m_thread_attributes;
+        //! The configuration that is being used by the thread. Writers do not destroy the configuration while it is in use.
+        boost::atomic< configuration* > m_configuration;
+        //! The configurations that were replaced while being used by this thread
+        std::vector< configuration* > m_retired_configurations;
+#if !defined(BOOST_LOG_NO_THREADS)
+        //! The registry of all threads
+        const shared_ptr< thread_registry > m_registry;
+
+        explicit thread_data(shared_ptr< thread_registry > const& registry);
+#else
+        thread_data() : m_configuration(static_cast< configuration* >(NULL)) {}
+#endif
+        ~thread_data();
+
+        BOOST_DELETED_FUNCTION(thread_data(thread_data const&))
+        BOOST_DELETED_FUNCTION(thread_data& operator= (thread_data const&))
+    };
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! The registry of thread-specific data of all threads that use the core
+    struct thread_registry
+    {
+        //! Synchronization mutex
+        mutex m_mutex;
+        //! Thread-specific data
+        std::vector< thread_data* > m_threads;
+    };
+#endif
+
+    class configuration_update;
+    friend class configuration_update;
+
+    //! The guard marks the current configuration as being used by the current thread
+    class configuration_guard
+    {
+    private:
+        thread_data* const m_tsd;
+        configuration* m_configuration;
+        bool m_outermost;
+
+    public:
+        configuration_guard(thread_data* tsd, boost::atomic< configuration* > const& current) :
+            m_tsd(tsd),
+            m_configuration(tsd->m_configuration.load(boost::memory_order_relaxed)),
+            m_outermost(m_configuration == NULL)
+        {
+            // Nested guards (e.g. when a filter writes log records) reuse the configuration of the outer guard
+            if (m_outermost)
+            {
+                configuration* p = current.load(boost::memory_order_acquire);
+                while (true)
+                {
+                    tsd->m_configuration.store(p, boost::memory_order_seq_cst);
+                    configuration* q = current.load(boost::memory_order_seq_cst);
+                    if (q == p)
+                        break;
+                    p = q;
+                }
+                m_configuration = p;
+            }
+        }
+        ~configuration_guard()
+        {
+            if (m_outermost)
+            {
+                m_tsd->m_configuration.store(static_cast< configuration* >(NULL), boost::memory_order_seq_cst);
+                if (!m_tsd->m_retired_configurations.empty())
+                {
+                    // Other threads may have pinned the configurations before they were replaced
+                    std::vector< configuration* >::iterator it = m_tsd->m_retired_configurations.begin(), end = m_tsd->m_retired_configurations.end();
+                    for (; it != end; ++it)
+                    {
+#if !defined(BOOST_LOG_NO_THREADS)
+                        wait_until_released(*m_tsd->m_registry, m_tsd, *it);
+#endif
+                        delete *it;
+                    }
+                    m_tsd->m_retired_configurations.clear();
+                }
+            }
+        }
+
+        configuration* operator-> () const BOOST_NOEXCEPT { return m_configuration; }
+
+        BOOST_DELETED_FUNCTION(configuration_guard(configuration_guard const&))
+        BOOST_DELETED_FUNCTION(configuration_guard& operator= (configuration_guard const&))
+    };
+
+    //! The helper class creates a modified copy of the configuration and publishes it
+    class configuration_update
+    {
+    private:
+        implementation* const m_impl;
+#if !defined(BOOST_LOG_NO_THREADS)
+        //! Writers are serialized
+        unique_lock< log::aux::light_rw_mutex > m_lock;
+#endif
+        //! The new configuration
+        std::auto_ptr< configuration > m_configuration;
+
+    public:
+        explicit configuration_update(implementation* impl) :
+            m_impl(impl),
+#if !defined(BOOST_LOG_NO_THREADS)
+            m_lock(impl->m_mutex),
+#endif
+            m_configuration(new configuration(*impl->m_configuration.load(boost::memory_order_relaxed)))
+        {
+        }
+
+        configuration* operator-> () const BOOST_NOEXCEPT { return m_configuration.get(); }
+
+        //! Publishes the new configuration and destroys the previous one once it is no longer used
+        void commit()
+        {
+            configuration* old = m_impl->m_configuration.exchange(m_configuration.release(), boost::memory_order_seq_cst);
+            BOOST_LOG_EXPR_IF_MT(m_lock.unlock();)
+            m_impl->retire_configuration(old);
+        }
+
+        BOOST_DELETED_FUNCTION(configuration_update(configuration_update const&))
+        BOOST_DELETED_FUNCTION(configuration_update& operator= (configuration_update const&))
     };
 
 public:
 #if !defined(BOOST_LOG_NO_THREADS)
-    //! Synchronization mutex
+    //! Synchronization mutex for configuration modifications
     log::aux::light_rw_mutex m_mutex;
+    //! The registry of all threads that use the core
+    const shared_ptr< thread_registry > m_thread_registry;
 #endif
 
-    //! List of sinks involved into output
-    sink_list m_sinks;
+    //! The current configuration snapshot
+    boost::atomic< configuration* > m_configuration;
+
     //! Default sink
     const shared_ptr< sinks::sink > m_default_sink;
 
-    //! Global attribute set
+    //! Global attribute set. The set is copied to the configuration snapshot on every modification.
     attribute_set m_global_attributes;
 #if !defined(BOOST_LOG_NO_THREADS)
     //! Thread-specific data
@@ -239,9 +410,11 @@ public:
 #endif
 
     //! The global state of logging
-    volatile bool m_enabled;
-    //! Global filter
-    filter m_filter;
+    boost::atomic< bool > m_enabled;
+    //! Severity level threshold
+    boost::atomic< int > m_severity_threshold;
+    //! Severity level thresholds of the modules. Protected by m_mutex.
+    module_threshold_map m_module_thresholds;
 
     //! Exception handler
     exception_handler_type m_exception_handler;
@@ -249,11 +422,54 @@ public:
 public:
     //! Constructor
     implementation() :
+#if !defined(BOOST_LOG_NO_THREADS)
+        m_thread_registry(boost::make_shared< thread_registry >()),
+#endif
+        m_configuration(new configuration()),
         m_default_sink(boost::make_shared< sinks::aux::default_sink >()),
-        m_enabled(true)
+        m_enabled(true),
+        m_severity_threshold((std::numeric_limits< int >::min)())
     {
     }
 
+    //! Destructor
+    ~implementation()
+    {
+        delete m_configuration.load(boost::memory_order_acquire);
+        for (module_threshold_map::iterator it = m_module_thresholds.begin(), end = m_module_thresholds.end(); it != end; ++it)
+            delete it->second;
+    }
+
+    //! Updates the thresholds of the modules that do not have their own threshold. Must be called with m_mutex locked.
+    void update_module_thresholds(int level)
+    {
+        for (module_threshold_map::iterator it = m_module_thresholds.begin(), end = m_module_thresholds.end(); it != end; ++it)
+        {
+            if (!it->second->m_is_set)
+                it->second->m_threshold.store(level, boost::memory_order_relaxed);
+        }
+    }
+
+    //! Returns the threshold of the module, registering the module if needed. Must be called with m_mutex locked.
+    log::aux::module_severity_threshold* get_module_threshold(std::string const& module)
+    {
+        module_threshold_map::iterator it = m_module_thresholds.find(module);
+        if (it == m_module_thresholds.end())
+        {
+            log::aux::module_severity_threshold* p = new log::aux::module_severity_threshold(m_severity_threshold.load(boost::memory_order_relaxed));
+            try
+            {
+                it = m_module_thresholds.insert(module_threshold_map::value_type(module, p)).first;
+            }
+            catch (...)
+            {
+                delete p;
+                throw;
+            }
+        }
+        return it->second;
+    }
+
     //! Invokes sink-specific filter and adds the sink to the record if the filter passes the log record
     void apply_sink_filter(shared_ptr< sinks::sink > const& sink, record& rec, attribute_value_set*& attr_values, uint32_t remaining_capacity)
     {
@@ -279,6 +495,7 @@ public:
 #endif // !defined(BOOST_LOG_NO_THREADS)
         catch (...)
         {
+            BOOST_LOG_EXPR_IF_MT(scoped_read_lock lock(m_mutex);)
             if (m_exception_handler.empty())
                 throw;
             m_exception_handler();
@@ -290,50 +507,47 @@ public:
     BOOST_FORCEINLINE record open_record(BOOST_FWD_REF(SourceAttributesT) source_attributes)
     {
         // Try a quick win first
-        if (m_enabled) try
+        if (m_enabled.load(boost::memory_order_relaxed)) try
         {
             thread_data* tsd = get_thread_data();
 
-            // Lock the core to be safe against any attribute or sink set modifications
-            BOOST_LOG_EXPR_IF_MT(scoped_read_lock lock(m_mutex);)
+            // Pin the current configuration to be safe against any attribute or sink set modifications
+            configuration_guard config(tsd, m_configuration);
 
-            if (m_enabled)
+            // Compose a view of attribute values (unfrozen, yet)
+            attribute_value_set attr_values(boost::forward< SourceAttributesT >(source_attributes), tsd->m_thread_attributes, config->m_global_attributes);
+            if (config->m_filter(attr_values))
             {
-                // Compose a view of attribute values (unfrozen, yet)
-                attribute_value_set attr_values(boost::forward< SourceAttributesT >(source_attributes), tsd->m_thread_attributes, m_global_attributes);
-                if (m_filter(attr_values))
-                {
-                    // The global filter passed, trying the sinks
-                    record rec;
-                    attribute_value_set* values = &attr_values;
+                // The global filter passed, trying the sinks
+                record rec;
+                attribute_value_set* values = &attr_values;
 
-                    if (!m_sinks.empty())
-                    {
-                        uint32_t remaining_capacity = static_cast< uint32_t >(m_sinks.size());
-                        sink_list::iterator it = m_sinks.begin(), end = m_sinks.end();
-                        for (; it != end; ++it, --remaining_capacity)
-                        {
-                            apply_sink_filter(*it, rec, values, remaining_capacity);
-                        }
-                    }
-                    else
+                if (!config->m_sinks.empty())
+                {
+                    uint32_t remaining_capacity = static_cast< uint32_t >(config->m_sinks.size());
+                    sink_list::iterator it = config->m_sinks.begin(), end = config->m_sinks.end();
+                    for (; it != end; ++it, --remaining_capacity)
                     {
-                        // Use the default sink
-                        apply_sink_filter(m_default_sink, rec, values, 1);
+                        apply_sink_filter(*it, rec, values, remaining_capacity);
                     }
+                }
+                else
+                {
+                    // Use the default sink
+                    apply_sink_filter(m_default_sink, rec, values, 1);
+                }
 
-                    record_view::private_data* rec_impl = static_cast< record_view::private_data* >(rec.m_impl);
-                    if (rec_impl && rec_impl->accepting_sink_count() == 0)
-                    {
-                        // No sinks accepted the record
-                        return record();
-                    }
+                record_view::private_data* rec_impl = static_cast< record_view::private_data* >(rec.m_impl);
+                if (rec_impl && rec_impl->accepting_sink_count() == 0)
+                {
+                    // No sinks accepted the record
+                    return record();
+                }
 
-                    // Some sinks have accepted the record
-                    values->freeze();
+                // Some sinks have accepted the record
+                values->freeze();
 
-                    return boost::move(rec);
-                }
+                return boost::move(rec);
             }
         }
     #if !defined(BOOST_LOG_NO_THREADS)
@@ -385,10 +599,13 @@ private:
     //! The method initializes thread-specific data
     void init_thread_data()
     {
-        BOOST_LOG_EXPR_IF_MT(scoped_write_lock lock(m_mutex);)
         if (!m_thread_data.get())
         {
+#if !defined(BOOST_LOG_NO_THREADS)
+            std::auto_ptr< thread_data > p(new thread_data(m_thread_registry));
+#else
             std::auto_ptr< thread_data > p(new thread_data());
+#endif
             m_thread_data.reset(p.get());
 #if defined(BOOST_LOG_USE_COMPILER_TLS)
             m_thread_data_cache = p.release();
@@ -397,8 +614,91 @@ private:
 #endif
         }
     }
+
+    //! The method destroys the configuration when no thread uses it
+    void retire_configuration(configuration* old)
+    {
+        // If the current thread is using the configuration (i.e. the configuration is being modified from a filter),
+        // the configuration will be destroyed when the thread releases it
+        thread_data* tsd = m_thread_data.get();
+        if (tsd && tsd->m_configuration.load(boost::memory_order_relaxed) == old)
+        {
+            try
+            {
+                tsd->m_retired_configurations.push_back(old);
+            }
+            catch (...)
+            {
+                // The configuration is leaked, which is better than crashing
+            }
+            return;
+        }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+        wait_until_released(*m_thread_registry, tsd, old);
+#endif
+
+        delete old;
+    }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    /*!
+     * The method waits until threads other than \a self stop using the configuration. Since the configuration is not current anymore,
+     * threads will not start using it again, and the wait is bounded by the duration of opening a record.
+     */
+    static void wait_until_released(thread_registry& registry, const thread_data* self, configuration* old)
+    {
+        while (true)
+        {
+            bool in_use = false;
+            {
+                lock_guard< mutex > lock(registry.m_mutex);
+                std::vector< thread_data* >::const_iterator it = registry.m_threads.begin(), end = registry.m_threads.end();
+                for (; it != end; ++it)
+                {
+                    if (*it != self && (*it)->m_configuration.load(boost::memory_order_seq_cst) == old)
+                    {
+                        in_use = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!in_use)
+                break;
+
+            this_thread::yield();
+        }
+    }
+#endif // !defined(BOOST_LOG_NO_THREADS)
 };
 
+#if !defined(BOOST_LOG_NO_THREADS)
+
+core::implementation::thread_data::thread_data(shared_ptr< thread_registry > const& registry) :
+    m_configuration(static_cast< configuration* >(NULL)),
+    m_registry(registry)
+{
+    lock_guard< mutex > lock(m_registry->m_mutex);
+    m_registry->m_threads.push_back(this);
+}
+
+core::implementation::thread_data::~thread_data()
+{
+    lock_guard< mutex > lock(m_registry->m_mutex);
+    std::vector< thread_data* >::iterator it = std::find(m_registry->m_threads.begin(), m_registry->m_threads.end(), this);
+    if (it != m_registry->m_threads.end())
+        m_registry->m_threads.erase(it);
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+core::implementation::thread_data::~thread_data()
+{
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
 #if defined(BOOST_LOG_USE_COMPILER_TLS)
 //! Cached pointer to the thread-specific data
 BOOST_LOG_TLS core::implementation::thread_data* core::implementation::m_thread_data_cache = NULL;
@@ -426,45 +726,112 @@ BOOST_LOG_API core_ptr core::get()
 //! The method enables or disables logging and returns the previous state of logging flag
 BOOST_LOG_API bool core::set_logging_enabled(bool enabled)
 {
-    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
-    const bool old_value = m_impl->m_enabled;
-    m_impl->m_enabled = enabled;
-    return old_value;
+    return m_impl->m_enabled.exchange(enabled, boost::memory_order_relaxed);
 }
 
 //! The method allows to detect if logging is enabled
 BOOST_LOG_API bool core::get_logging_enabled() const
 {
-    // Should have a read barrier here, but for performance reasons it is omitted.
     // The function should be used as a quick check and doesn't need to be reliable.
-    return m_impl->m_enabled;
+    return m_impl->m_enabled.load(boost::memory_order_relaxed);
+}
+
+//! The method sets the severity level threshold
+BOOST_LOG_API void core::set_severity_threshold(int level)
+{
+    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    m_impl->m_severity_threshold.store(level, boost::memory_order_relaxed);
+    m_impl->update_module_thresholds(level);
+}
+
+//! The method removes the severity level threshold
+BOOST_LOG_API void core::reset_severity_threshold()
+{
+    set_severity_threshold((std::numeric_limits< int >::min)());
+}
+
+//! The method returns the severity level threshold
+BOOST_LOG_API int core::get_severity_threshold() const
+{
+    return m_impl->m_severity_threshold.load(boost::memory_order_relaxed);
+}
+
+//! The method sets the severity level threshold of the module
+BOOST_LOG_API void core::set_severity_threshold(std::string const& module, int level)
+{
+    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    aux::module_severity_threshold* p = m_impl->get_module_threshold(module);
+    p->m_is_set = true;
+    p->m_threshold.store(level, boost::memory_order_relaxed);
+}
+
+//! The method removes the severity level threshold of the module
+BOOST_LOG_API void core::reset_severity_threshold(std::string const& module)
+{
+    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    implementation::module_threshold_map::iterator it = m_impl->m_module_thresholds.find(module);
+    if (it != m_impl->m_module_thresholds.end())
+    {
+        it->second->m_is_set = false;
+        it->second->m_threshold.store(m_impl->m_severity_threshold.load(boost::memory_order_relaxed), boost::memory_order_relaxed);
+    }
+}
+
+//! The method returns the severity level threshold of the module
+BOOST_LOG_API int core::get_severity_threshold(std::string const& module) const
+{
+    BOOST_LOG_EXPR_IF_MT(implementation::scoped_read_lock lock(m_impl->m_mutex);)
+    implementation::module_threshold_map::const_iterator it = m_impl->m_module_thresholds.find(module);
+    if (it != m_impl->m_module_thresholds.end())
+        return it->second->m_threshold.load(boost::memory_order_relaxed);
+    return m_impl->m_severity_threshold.load(boost::memory_order_relaxed);
+}
+
+//! The method returns the threshold of the module, registering the module if needed
+BOOST_LOG_API aux::module_severity_threshold const* core::get_module_severity_threshold(std::string const& module)
+{
+    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    return m_impl->get_module_threshold(module);
+}
+
+//! The method returns the severity level threshold that applies to the module
+BOOST_LOG_API int core::get_severity_threshold(aux::module_severity_threshold const* module) const
+{
+    return module->m_threshold.load(boost::memory_order_relaxed);
 }
 
 //! The method adds a new sink
 BOOST_LOG_API void core::add_sink(shared_ptr< sinks::sink > const& s)
 {
-    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    implementation::configuration_update update(m_impl);
     implementation::sink_list::iterator it =
-        std::find(m_impl->m_sinks.begin(), m_impl->m_sinks.end(), s);
-    if (it == m_impl->m_sinks.end())
-        m_impl->m_sinks.push_back(s);
+        std::find(update->m_sinks.begin(), update->m_sinks.end(), s);
+    if (it == update->m_sinks.end())
+    {
+        update->m_sinks.push_back(s);
+        update.commit();
+    }
 }
 
 //! The method removes the sink from the output
 BOOST_LOG_API void core::remove_sink(shared_ptr< sinks::sink > const& s)
 {
-    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    implementation::configuration_update update(m_impl);
     implementation::sink_list::iterator it =
-        std::find(m_impl->m_sinks.begin(), m_impl->m_sinks.end(), s);
-    if (it != m_impl->m_sinks.end())
-        m_impl->m_sinks.erase(it);
+        std::find(update->m_sinks.begin(), update->m_sinks.end(), s);
+    if (it != update->m_sinks.end())
+    {
+        update->m_sinks.erase(it);
+        update.commit();
+    }
 }
 
 //! The method removes all registered sinks from the output
 BOOST_LOG_API void core::remove_all_sinks()
 {
-    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
-    m_impl->m_sinks.clear();
+    implementation::configuration_update update(m_impl);
+    update->m_sinks.clear();
+    update.commit();
 }
 
 
@@ -472,15 +839,27 @@ BOOST_LOG_API void core::remove_all_sinks()
 BOOST_LOG_API std::pair< attribute_set::iterator, bool >
 core::add_global_attribute(attribute_name const& name, attribute const& attr)
 {
-    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
-    return m_impl->m_global_attributes.insert(name, attr);
+    implementation::configuration_update update(m_impl);
+    std::pair< attribute_set::iterator, bool > res = update->m_global_attributes.insert(name, attr);
+    if (res.second)
+    {
+        res = m_impl->m_global_attributes.insert(name, attr);
+        update.commit();
+    }
+    else
+    {
+        res.first = m_impl->m_global_attributes.find(name);
+    }
+    return res;
 }
 
 //! The method removes an attribute from the global attribute set
 BOOST_LOG_API void core::remove_global_attribute(attribute_set::iterator it)
 {
-    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    implementation::configuration_update update(m_impl);
+    update->m_global_attributes.erase(it->first);
     m_impl->m_global_attributes.erase(it);
+    update.commit();
 }
 
 //! The method returns the complete set of currently registered global attributes
@@ -493,8 +872,10 @@ BOOST_LOG_API attribute_set core::get_global_attributes() const
 //! The method replaces the complete set of currently registered global attributes with the provided set
 BOOST_LOG_API void core::set_global_attributes(attribute_set const& attrs)
 {
-    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    implementation::configuration_update update(m_impl);
+    update->m_global_attributes = attrs;
     m_impl->m_global_attributes = attrs;
+    update.commit();
 }
 
 //! The method adds an attribute to the thread-specific attribute set
@@ -528,15 +909,17 @@ BOOST_LOG_API void core::set_thread_attributes(attribute_set const& attrs)
 //! An internal method to set the global filter
 BOOST_LOG_API void core::set_filter(filter const& filter)
 {
-    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
-    m_impl->m_filter = filter;
+    implementation::configuration_update update(m_impl);
+    update->m_filter = filter;
+    update.commit();
 }
 
 //! The method removes the global logging filter
 BOOST_LOG_API void core::reset_filter()
 {
-    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
-    m_impl->m_filter.reset();
+    implementation::configuration_update update(m_impl);
+    update->m_filter.reset();
+    update.commit();
 }
 
 //! The method sets exception handler function
@@ -549,9 +932,13 @@ BOOST_LOG_API void core::set_exception_handler(exception_handler_type const& han
 //! The method performs flush on all registered sinks.
 BOOST_LOG_API void core::flush()
 {
-    // Acquire exclusive lock to prevent any logging attempts while flushing
-    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
-    implementation::sink_list::iterator it = m_impl->m_sinks.begin(), end = m_impl->m_sinks.end();
+    implementation::sink_list sinks;
+    {
+        BOOST_LOG_EXPR_IF_MT(implementation::scoped_read_lock lock(m_impl->m_mutex);)
+        sinks = m_impl->m_configuration.load(boost::memory_order_acquire)->m_sinks;
+    }
+
+    implementation::sink_list::iterator it = sinks.begin(), end = sinks.end();
     for (; it != end; ++it)
     {
         try
@@ -566,6 +953,7 @@ BOOST_LOG_API void core::flush()
 #endif // !defined(BOOST_LOG_NO_THREADS)
         catch (...)
         {
+            BOOST_LOG_EXPR_IF_MT(implementation::scoped_read_lock lock(m_impl->m_mutex);)
             if (m_impl->m_exception_handler.empty())
                 throw;
             m_impl->m_exception_handler();
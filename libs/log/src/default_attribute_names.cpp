@@ -48,6 +48,7 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         const attribute_name timestamp;
         const attribute_name process_id;
         const attribute_name thread_id;
+        const attribute_name suppressed;
 
     private:
         names() :
@@ -57,7 +58,8 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             line_id("LineID"),
             timestamp("TimeStamp"),
             process_id("ProcessID"),
-            thread_id("ThreadID")
+            thread_id("ThreadID"),
+            suppressed("Suppressed")
         {
         }
 
@@ -110,6 +112,11 @@ BOOST_LOG_API attribute_name thread_id()
     return names::get().thread_id;
 }
 
+BOOST_LOG_API attribute_name suppressed()
+{
+    return names::get().suppressed;
+}
+
 } // namespace default_attribute_names
 
 } // namespace aux
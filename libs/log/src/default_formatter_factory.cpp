@@ -18,7 +18,16 @@
 #undef BOOST_MPL_LIMIT_VECTOR_SIZE
 #define BOOST_MPL_LIMIT_VECTOR_SIZE 50
 
+#include <utility>
+#include <typeinfo>
+#include <algorithm>
+#include <boost/array.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/utility/addressof.hpp>
 #include <boost/mpl/vector.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/begin.hpp>
+#include <boost/mpl/end.hpp>
 #include <boost/mpl/copy.hpp>
 #include <boost/mpl/push_back.hpp>
 #include <boost/mpl/back_inserter.hpp>
@@ -28,8 +37,15 @@
 #include <boost/phoenix/core.hpp>
 #include <boost/phoenix/operator.hpp>
 #include <boost/log/exceptions.hpp>
-#include <boost/log/expressions/attr.hpp>
-#include <boost/log/expressions/formatters/stream.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/attributes/attribute_name.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/utility/once_block.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include <boost/log/utility/type_info_wrapper.hpp>
+#include <boost/log/utility/manipulators/to_log.hpp>
+#include <boost/log/utility/type_dispatch/type_dispatcher.hpp>
+#include <boost/log/utility/type_dispatch/static_type_dispatcher.hpp>
 #include <boost/log/utility/type_dispatch/standard_types.hpp>
 #include <boost/log/utility/type_dispatch/date_time_types.hpp>
 #include <boost/log/utility/string_literal.hpp>
@@ -48,6 +64,152 @@ BOOST_LOG_OPEN_NAMESPACE
 
 namespace aux {
 
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+//! The function object outputs the attribute value to the stream
+template< typename CharT >
+struct value_output
+{
+    typedef void result_type;
+    typedef basic_formatting_ostream< CharT > stream_type;
+
+    explicit value_output(stream_type& strm) : m_strm(strm)
+    {
+    }
+
+    template< typename T >
+    result_type operator() (T const& value) const
+    {
+        m_strm << log::to_log(value);
+    }
+
+private:
+    stream_type& m_strm;
+};
+
+/*!
+ * The formatter outputs attribute values of any of the supported types. Unlike the \c attr formatter, it
+ * remembers the position of the last dispatched value type in the dispatching map, so that as long as
+ * the attribute values have the same type, they are dispatched without searching the map.
+ */
+template< typename CharT, typename TypeSequenceT >
+class default_formatter
+{
+public:
+    typedef void result_type;
+    typedef basic_formatting_ostream< CharT > stream_type;
+
+private:
+    typedef value_output< CharT > visitor_type;
+    typedef std::pair< type_info_wrapper, void* > dispatching_map_element;
+    typedef boost::array< dispatching_map_element, mpl::size< TypeSequenceT >::value > dispatching_map;
+
+    //! The dispatcher checks the cached dispatching map element before searching the map
+    class caching_dispatcher :
+        public type_dispatcher
+    {
+    private:
+        dispatching_map const& m_map;
+        boost::atomic< unsigned int >& m_cached_index;
+        void* m_visitor;
+
+    public:
+        caching_dispatcher(dispatching_map const& map, boost::atomic< unsigned int >& cached_index, visitor_type& visitor) BOOST_NOEXCEPT :
+            type_dispatcher(&caching_dispatcher::get_callback),
+            m_map(map),
+            m_cached_index(cached_index),
+            m_visitor((void*)boost::addressof(visitor))
+        {
+        }
+
+    private:
+        //! The get_callback method implementation
+        static callback_base get_callback(type_dispatcher* p, std::type_info const& type)
+        {
+            caching_dispatcher* const self = static_cast< caching_dispatcher* >(p);
+            const unsigned int cached_index = self->m_cached_index.load(boost::memory_order_relaxed);
+            if (cached_index < dispatching_map::static_size && self->m_map[cached_index].first.get() == type)
+                return callback_base(self->m_visitor, self->m_map[cached_index].second);
+
+            const type_info_wrapper wrapper(type);
+            typename dispatching_map::const_iterator it = std::lower_bound
+            (
+                self->m_map.begin(),
+                self->m_map.end(),
+                dispatching_map_element(wrapper, (void*)0),
+                dispatching_map_order()
+            );
+
+            if (it != self->m_map.end() && it->first == wrapper)
+            {
+                self->m_cached_index.store(static_cast< unsigned int >(it - self->m_map.begin()), boost::memory_order_relaxed);
+                return callback_base(self->m_visitor, it->second);
+            }
+            else
+                return callback_base();
+        }
+    };
+
+private:
+    //! Attribute name
+    attribute_name m_name;
+    //! The index of the last dispatched type in the dispatching map
+    mutable boost::atomic< unsigned int > m_cached_index;
+
+public:
+    explicit default_formatter(attribute_name const& name) :
+        m_name(name),
+        m_cached_index(static_cast< unsigned int >(dispatching_map::static_size))
+    {
+    }
+
+    default_formatter(default_formatter const& that) :
+        m_name(that.m_name),
+        m_cached_index(that.m_cached_index.load(boost::memory_order_relaxed))
+    {
+    }
+
+    result_type operator() (record_view const& rec, stream_type& strm) const
+    {
+        attribute_value_set const& values = rec.attribute_values();
+        attribute_value_set::const_iterator it = values.find(m_name);
+        if (it != values.end())
+        {
+            visitor_type visitor(strm);
+            caching_dispatcher dispatcher(get_dispatching_map(), m_cached_index, visitor);
+            it->second.dispatch(dispatcher);
+        }
+    }
+
+private:
+    //! The method returns the dispatching map instance
+    static dispatching_map const& get_dispatching_map()
+    {
+        static const dispatching_map* pinstance = NULL;
+
+        BOOST_LOG_ONCE_BLOCK()
+        {
+            static dispatching_map instance;
+            typename dispatching_map::value_type* p = &*instance.begin();
+
+            typedef typename mpl::begin< TypeSequenceT >::type begin_iterator_type;
+            typedef typename mpl::end< TypeSequenceT >::type end_iterator_type;
+            typedef dispatching_map_initializer< visitor_type > initializer;
+            initializer::init(static_cast< begin_iterator_type* >(0), static_cast< end_iterator_type* >(0), p);
+
+            std::sort(instance.begin(), instance.end(), dispatching_map_order());
+
+            pinstance = &instance;
+        }
+
+        return *pinstance;
+    }
+
+    BOOST_DELETED_FUNCTION(default_formatter& operator= (default_formatter const&))
+};
+
+} // namespace
+
 //! The callback for equality relation filter
 template< typename CharT >
 typename default_formatter_factory< CharT >::formatter_type
@@ -79,7 +241,7 @@ default_formatter_factory< CharT >::create_formatter(attribute_name const& name,
         mpl::back_inserter< default_attribute_types >
     >::type supported_types;
 
-    return formatter_type(expressions::stream << expressions::attr< supported_types::type >(name));
+    return formatter_type(default_formatter< char_type, supported_types::type >(name));
 }
 
 //  Explicitly instantiate factory implementation
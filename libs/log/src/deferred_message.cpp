@@ -0,0 +1,261 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   deferred_message.cpp
+ * \author Andrey Semashev
+ * \date   14.06.2015
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/doc/libs/release/libs/log/doc/html/index.html.
+ */
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/format.hpp>
+#include <boost/log/detail/singleton.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include <boost/log/utility/deferred_message.hpp>
+#include <boost/log/sources/deferred_record.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/thread/tss.hpp>
+#endif
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+//! The cache of parsed format strings. Format strings have static storage duration, so their addresses identify them.
+template< typename CharT >
+class deferred_format_cache :
+    public log::aux::lazy_singleton<
+        deferred_format_cache< CharT >,
+#if !defined(BOOST_LOG_NO_THREADS)
+        thread_specific_ptr< deferred_format_cache< CharT > >
+#else
+        std::auto_ptr< deferred_format_cache< CharT > >
+#endif
+    >
+{
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Thread-specific pointer type
+    typedef thread_specific_ptr< deferred_format_cache > tls_ptr_type;
+#else
+    //! Thread-specific pointer type
+    typedef std::auto_ptr< deferred_format_cache > tls_ptr_type;
+#endif
+    //! Singleton base type
+    typedef log::aux::lazy_singleton<
+        deferred_format_cache,
+        tls_ptr_type
+    > base_type;
+
+public:
+    //! Parsed format description type
+    typedef format_description< CharT > format_description_type;
+
+private:
+    //! Cache key: the format string and its length
+    typedef std::pair< const CharT*, std::size_t > key_type;
+    //! Parsed format strings
+    typedef std::map< key_type, format_description_type > cache_type;
+
+private:
+    cache_type m_Cache;
+
+public:
+    //! The method returns the parsed format string, parsing it on the first request
+    format_description_type const& get_description(const CharT* fmt, std::size_t fmt_size)
+    {
+        const key_type key(fmt, fmt_size);
+        typename cache_type::iterator it = m_Cache.find(key);
+        if (it == m_Cache.end())
+            it = m_Cache.insert(typename cache_type::value_type(key, parse_format(fmt, fmt + fmt_size))).first;
+        return it->second;
+    }
+
+    //! The method returns cache instance
+    static deferred_format_cache& get()
+    {
+        tls_ptr_type& ptr = base_type::get();
+        deferred_format_cache* p = ptr.get();
+        if (!p)
+        {
+            std::auto_ptr< deferred_format_cache > pNew(new deferred_format_cache());
+            ptr.reset(pNew.get());
+            p = pNew.release();
+        }
+        return *p;
+    }
+};
+
+} // namespace
+
+} // namespace aux
+
+//! Formats the message into the stream
+template< typename CharT >
+BOOST_LOG_API void basic_deferred_message< CharT >::format_to(stream_type& strm) const
+{
+    if (!m_format)
+        return;
+
+    // Locate the encoded arguments
+    std::vector< const argument_header* > args;
+    const unsigned char* p = this->data();
+    const unsigned char* const end = p + m_data.size();
+    while (p < end)
+    {
+        const argument_header* header = reinterpret_cast< const argument_header* >(p);
+        args.push_back(header);
+        p += sizeof(argument_header) + aligned_size(header->size);
+    }
+
+    typedef aux::deferred_format_cache< char_type > format_cache_type;
+    typedef typename format_cache_type::format_description_type format_description_type;
+    format_description_type const& descr = format_cache_type::get().get_description(m_format, m_format_size);
+    typename format_description_type::format_element_list::const_iterator it = descr.format_elements.begin(), it_end = descr.format_elements.end();
+    for (; it != it_end; ++it)
+    {
+        if (it->arg_number >= 0)
+        {
+            // This is a placeholder
+            if (static_cast< std::size_t >(it->arg_number) < args.size())
+            {
+                const argument_header* header = args[it->arg_number];
+                header->decoder(strm, header + 1, header->size);
+            }
+        }
+        else
+        {
+            // This is a literal
+            strm.write(descr.literal_chars.c_str() + it->literal_start_pos, static_cast< std::streamsize >(it->literal_len));
+        }
+    }
+}
+
+//! Returns the formatted message
+template< typename CharT >
+BOOST_LOG_API typename basic_deferred_message< CharT >::string_type basic_deferred_message< CharT >::str() const
+{
+    string_type result;
+    stream_type strm(result);
+    format_to(strm);
+    strm.flush();
+    return boost::move(result);
+}
+
+//! Explicitly instantiate basic_deferred_message implementation
+#ifdef BOOST_LOG_USE_CHAR
+template class basic_deferred_message< char >;
+#endif
+#ifdef BOOST_LOG_USE_WCHAR_T
+template class basic_deferred_message< wchar_t >;
+#endif
+
+namespace aux {
+
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+//! The pool of argument buffers
+class deferred_buffer_pool :
+    public log::aux::lazy_singleton<
+        deferred_buffer_pool,
+#if !defined(BOOST_LOG_NO_THREADS)
+        thread_specific_ptr< deferred_buffer_pool >
+#else
+        std::auto_ptr< deferred_buffer_pool >
+#endif
+    >
+{
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Thread-specific pointer type
+    typedef thread_specific_ptr< deferred_buffer_pool > tls_ptr_type;
+#else
+    //! Thread-specific pointer type
+    typedef std::auto_ptr< deferred_buffer_pool > tls_ptr_type;
+#endif
+    //! Singleton base type
+    typedef log::aux::lazy_singleton<
+        deferred_buffer_pool,
+        tls_ptr_type
+    > base_type;
+    //! Buffer compound type
+    typedef deferred_buffer_provider::buffer_compound buffer_compound_t;
+
+public:
+    //! Pooled buffer compounds
+    buffer_compound_t* m_Top;
+
+    ~deferred_buffer_pool()
+    {
+        buffer_compound_t* p = NULL;
+        while ((p = m_Top) != NULL)
+        {
+            m_Top = p->next;
+            delete p;
+        }
+    }
+
+    //! The method returns pool instance
+    static deferred_buffer_pool& get()
+    {
+        tls_ptr_type& ptr = base_type::get();
+        deferred_buffer_pool* p = ptr.get();
+        if (!p)
+        {
+            std::auto_ptr< deferred_buffer_pool > pNew(new deferred_buffer_pool());
+            ptr.reset(pNew.get());
+            p = pNew.release();
+        }
+        return *p;
+    }
+
+private:
+    deferred_buffer_pool() : m_Top(NULL) {}
+};
+
+} // namespace
+
+//! The method returns an allocated buffer compound
+BOOST_LOG_API deferred_buffer_provider::buffer_compound* deferred_buffer_provider::allocate_compound()
+{
+    deferred_buffer_pool& pool = deferred_buffer_pool::get();
+    if (pool.m_Top)
+    {
+        buffer_compound* p = pool.m_Top;
+        pool.m_Top = p->next;
+        p->next = NULL;
+        return p;
+    }
+    else
+        return new buffer_compound();
+}
+
+//! The method releases a compound
+BOOST_LOG_API void deferred_buffer_provider::release_compound(buffer_compound* compound) BOOST_NOEXCEPT
+{
+    deferred_buffer_pool& pool = deferred_buffer_pool::get();
+    compound->buffer.clear();
+    compound->next = pool.m_Top;
+    pool.m_Top = compound;
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
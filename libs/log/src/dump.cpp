@@ -16,6 +16,7 @@
 #include <ostream>
 #include <boost/cstdint.hpp>
 #include <boost/log/utility/manipulators/dump.hpp>
+#include <boost/log/detail/char_search.hpp>
 #if defined(_MSC_VER)
 #include "windows_version.hpp"
 #include <windows.h>
@@ -29,6 +30,8 @@ BOOST_LOG_OPEN_NAMESPACE
 
 namespace aux {
 
+extern find_first_of_char_t find_first_of_char_generic;
+
 #if defined(BOOST_LOG_USE_SSSE3)
 extern dump_data_char_t dump_data_char_ssse3;
 extern dump_data_wchar_t dump_data_wchar_ssse3;
@@ -38,6 +41,7 @@ extern dump_data_char16_t dump_data_char16_ssse3;
 #if !defined(BOOST_NO_CXX11_CHAR32_T)
 extern dump_data_char32_t dump_data_char32_ssse3;
 #endif
+extern find_first_of_char_t find_first_of_char_ssse3;
 #endif
 #if defined(BOOST_LOG_USE_AVX2)
 extern dump_data_char_t dump_data_char_avx2;
@@ -48,6 +52,7 @@ extern dump_data_char16_t dump_data_char16_avx2;
 #if !defined(BOOST_NO_CXX11_CHAR32_T)
 extern dump_data_char32_t dump_data_char32_avx2;
 #endif
+extern find_first_of_char_t find_first_of_char_avx2;
 #endif
 
 enum { stride = 256 };
@@ -116,6 +121,10 @@ BOOST_LOG_API dump_data_char16_t* dump_data_char16 = &dump_data_generic< char16_
 BOOST_LOG_API dump_data_char32_t* dump_data_char32 = &dump_data_generic< char32_t >;
 #endif
 
+// The character search is defined here so that the function pointers are initialized to the optimized implementations
+// below whenever the character search is used
+BOOST_LOG_API find_first_of_char_t* find_first_of_char = &find_first_of_char_generic;
+
 #if defined(BOOST_LOG_USE_SSSE3) || defined(BOOST_LOG_USE_AVX2)
 
 BOOST_LOG_ANONYMOUS_NAMESPACE {
@@ -235,6 +244,7 @@ private:
 #if !defined(BOOST_NO_CXX11_CHAR32_T)
         dump_data_char32 = &dump_data_char32_ssse3;
 #endif
+        find_first_of_char = &find_first_of_char_ssse3;
     }
 
 #if defined(BOOST_LOG_USE_AVX2)
@@ -248,6 +258,7 @@ private:
 #if !defined(BOOST_NO_CXX11_CHAR32_T)
         dump_data_char32 = &dump_data_char32_avx2;
 #endif
+        find_first_of_char = &find_first_of_char_avx2;
     }
 #endif // defined(BOOST_LOG_USE_AVX2)
 };
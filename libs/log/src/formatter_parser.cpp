@@ -17,14 +17,13 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include <sstream>
 #include <stdexcept>
 #include <boost/assert.hpp>
 #include <boost/bind.hpp>
 #include <boost/move/core.hpp>
 #include <boost/move/utility.hpp>
-#include <boost/optional/optional.hpp>
-#include <boost/utility/in_place_factory.hpp>
 #include <boost/log/expressions/formatter.hpp>
 #include <boost/log/attributes/attribute_name.hpp>
 #include <boost/log/exceptions.hpp>
@@ -117,59 +116,85 @@ private:
     }
 };
 
-//! Function object for formatter chaining
-template< typename CharT, typename SecondT >
-struct chained_formatter
+/*!
+ * The formatter composed of string literals and attribute formatters. The parsed formatter is compiled
+ * into a flat sequence of steps, each step outputs a literal and invokes an attribute formatter.
+ * This avoids nesting function objects for every placeholder and literal in the format string.
+ */
+template< typename CharT >
+class compiled_formatter
 {
+public:
     typedef void result_type;
-    typedef basic_formatter< CharT > formatter_type;
+    typedef CharT char_type;
+    typedef std::basic_string< char_type > string_type;
+    typedef basic_formatter< char_type > formatter_type;
     typedef typename formatter_type::stream_type stream_type;
 
-#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-    explicit chained_formatter(formatter_type&& first, SecondT&& second) :
-#else
-    template< typename T >
-    explicit chained_formatter(BOOST_RV_REF(formatter_type) first, T const& second) :
-#endif
-        m_first(boost::move(first)), m_second(boost::move(second))
+private:
+    //! Formatting step
+    struct step
     {
-    }
+        //! The literal to output before the attribute
+        string_type m_Literal;
+        //! The flag indicates that the step has an attribute formatter
+        bool m_HasFormatter;
+        //! Attribute formatter
+        formatter_type m_Formatter;
+
+        step() : m_HasFormatter(false)
+        {
+        }
+    };
 
-    result_type operator() (record_view const& rec, stream_type& strm) const
-    {
-        m_first(rec, strm);
-        m_second(rec, strm);
-    }
+    typedef std::vector< step > steps;
 
 private:
-    formatter_type m_first;
-    SecondT m_second;
-};
+    steps m_Steps;
 
-//! String literal formatter
-template< typename CharT >
-struct literal_formatter
-{
-    typedef void result_type;
-    typedef CharT char_type;
-    typedef std::basic_string< char_type > string_type;
-    typedef basic_formatting_ostream< char_type > stream_type;
+public:
+    //! Returns \c true if no steps have been added
+    bool empty() const { return m_Steps.empty(); }
 
-#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-    explicit literal_formatter(string_type&& str) : m_str(boost::move(str))
-#else
-    explicit literal_formatter(string_type const& str) : m_str(str)
-#endif
+    //! Appends a string literal
+    void append_literal(string_type const& str)
     {
+        if (m_Steps.empty() || m_Steps.back().m_HasFormatter)
+            m_Steps.push_back(step());
+        m_Steps.back().m_Literal.append(str);
     }
 
-    result_type operator() (record_view const& rec, stream_type& strm) const
+    //! Appends an attribute formatter
+    void append_formatter(BOOST_RV_REF(formatter_type) fmt)
     {
-        strm << m_str;
+        if (m_Steps.empty() || m_Steps.back().m_HasFormatter)
+            m_Steps.push_back(step());
+        step& s = m_Steps.back();
+        s.m_Formatter = boost::move(fmt);
+        s.m_HasFormatter = true;
     }
 
-private:
-    const string_type m_str;
+    //! If the formatter consists of a single attribute formatter, extracts it
+    bool extract_single_formatter(formatter_type& fmt)
+    {
+        if (m_Steps.size() == 1u && m_Steps.front().m_Literal.empty() && m_Steps.front().m_HasFormatter)
+        {
+            fmt = boost::move(m_Steps.front().m_Formatter);
+            return true;
+        }
+        return false;
+    }
+
+    result_type operator() (record_view const& rec, stream_type& strm) const
+    {
+        for (typename steps::const_iterator it = m_Steps.begin(), end = m_Steps.end(); it != end; ++it)
+        {
+            if (!it->m_Literal.empty())
+                strm << it->m_Literal;
+            if (it->m_HasFormatter)
+                it->m_Formatter(rec, strm);
+        }
+    }
 };
 
 //! Formatter parsing grammar
@@ -189,7 +214,7 @@ private:
 
 private:
     //! The formatter being constructed
-    optional< formatter_type > m_Formatter;
+    compiled_formatter< char_type > m_Formatter;
 
     //! Attribute name
     attribute_name m_AttrName;
@@ -274,13 +299,17 @@ public:
     //! Returns the parsed formatter
     formatter_type get_formatter()
     {
-        if (!m_Formatter)
+        if (m_Formatter.empty())
         {
             // This may happen if parser input is an empty string
             return formatter_type(nop());
         }
 
-        return boost::move(m_Formatter.get());
+        formatter_type fmt;
+        if (!m_Formatter.extract_single_formatter(fmt))
+            fmt = boost::move(m_Formatter);
+
+        return boost::move(fmt);
     }
 
 private:
@@ -391,14 +420,14 @@ private:
         if (m_AttrName == log::aux::default_attribute_names::message())
         {
             // We make a special treatment for the message text formatter
-            append_formatter(expressions::aux::message_formatter());
+            m_Formatter.append_formatter(formatter_type(expressions::aux::message_formatter()));
         }
         else
         {
             // Use the factory to create the formatter
             formatters_repository< char_type > const& repo = formatters_repository< char_type >::get();
             formatter_factory_type& factory = repo.get_factory(m_AttrName);
-            append_formatter(factory.create_formatter(m_AttrName, m_FactoryArgs));
+            m_Formatter.append_formatter(factory.create_formatter(m_AttrName, m_FactoryArgs));
         }
 
         // Eventually, clear all the auxiliary data
@@ -411,17 +440,7 @@ private:
     {
         string_type s(begin, end);
         constants::translate_escape_sequences(s);
-        append_formatter(literal_formatter< char_type >(boost::move(s)));
-    }
-
-    //! The method appends a formatter part to the final formatter
-    template< typename FormatterT >
-    void append_formatter(FormatterT fmt)
-    {
-        if (!!m_Formatter)
-            m_Formatter = boost::in_place(chained_formatter< char_type, FormatterT >(boost::move(m_Formatter.get()), boost::move(fmt)));
-        else
-            m_Formatter = boost::in_place(boost::move(fmt));
+        m_Formatter.append_literal(s);
     }
 
     //  Assignment and copying are prohibited
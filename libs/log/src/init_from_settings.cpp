@@ -465,6 +465,12 @@ public:
             backend->auto_flush(param_cast_to_bool("AutoFlush", auto_flush_param.get()));
         }
 
+        // Memory mapping
+        if (optional< string_type > mapping_chunk_size_param = params["MappingChunkSize"])
+        {
+            backend->set_mapping_chunk_size(param_cast_to_int< uintmax_t >("MappingChunkSize", mapping_chunk_size_param.get()));
+        }
+
         // Append
         if (optional< string_type > append_param = params["Append"])
         {
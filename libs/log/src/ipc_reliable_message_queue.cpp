@@ -0,0 +1,460 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   ipc_reliable_message_queue.cpp
+ * \author Andrey Semashev
+ * \date   09.08.2015
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/doc/libs/release/libs/log/doc/html/index.html.
+ */
+
+#include <new>
+#include <string>
+#include <cstddef>
+#include <cstring>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/interprocess/creation_tags.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/log/exceptions.hpp>
+#include <boost/log/utility/ipc/reliable_message_queue.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace ipc {
+
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+typedef boost::interprocess::scoped_lock< boost::interprocess::interprocess_mutex > scoped_lock;
+
+//! The queue header in the shared memory
+struct queue_header
+{
+    //! The tag identifying the queue layout. Set when the header is fully initialized.
+    boost::atomic< uint32_t > m_abi_tag;
+    //! The size of the queue storage, in bytes
+    uint32_t m_capacity;
+    //! The number of bytes occupied by the messages
+    uint32_t m_size;
+    //! The position to write the next message at
+    uint32_t m_put_pos;
+    //! The position to read the next message from
+    uint32_t m_get_pos;
+    //! The mutex that protects the queue
+    boost::interprocess::interprocess_mutex m_mutex;
+    //! The condition is signalled when a message is put into the queue
+    boost::interprocess::interprocess_condition m_nonempty_queue;
+    //! The condition is signalled when a message is taken from the queue
+    boost::interprocess::interprocess_condition m_nonfull_queue;
+
+    explicit queue_header(uint32_t capacity) : m_capacity(capacity), m_size(0u), m_put_pos(0u), m_get_pos(0u)
+    {
+        // The tag is stored last to publish the initialized header to other processes
+        m_abi_tag.store(0u, boost::memory_order_relaxed);
+    }
+};
+
+//! The queue storage starts at a cache line boundary after the header
+const std::size_t data_offset = (sizeof(queue_header) + 63u) & ~static_cast< std::size_t >(63u);
+//! The message header contains the message size
+const uint32_t message_header_size = sizeof(uint32_t);
+//! The tag depends on the header size so that processes built with incompatible synchronization primitives do not share the queue
+const uint32_t abi_tag = 0x424C5100u + static_cast< uint32_t >(sizeof(queue_header));
+//! The maximum supported queue capacity
+const uint32_t max_capacity = 0x7FFFFFFFu;
+//! The number of attempts to wait for another process to initialize the queue, one scheduler tick each
+const unsigned int max_init_wait_attempts = 1000u;
+
+} // namespace
+
+//! Queue implementation
+struct reliable_message_queue::implementation
+{
+    //! The shared memory object
+    boost::interprocess::shared_memory_object m_SharedMemory;
+    //! The mapped shared memory
+    boost::interprocess::mapped_region m_Region;
+    //! The queue name
+    std::string m_Name;
+    //! The overflow policy of this object
+    overflow_policy m_OverflowPolicy;
+    //! The flag indicates that the blocking operations must be interrupted. Protected by the queue mutex.
+    bool m_Stop;
+
+    implementation(std::string const& name, overflow_policy policy) :
+        m_Name(name),
+        m_OverflowPolicy(policy),
+        m_Stop(false)
+    {
+    }
+
+    queue_header* get_header() const
+    {
+        return static_cast< queue_header* >(m_Region.get_address());
+    }
+
+    unsigned char* get_data() const
+    {
+        return static_cast< unsigned char* >(m_Region.get_address()) + data_offset;
+    }
+
+    //! Creates a new queue
+    void create(uint32_t capacity)
+    {
+        boost::interprocess::shared_memory_object shm(boost::interprocess::create_only, m_Name.c_str(), boost::interprocess::read_write);
+        shm.truncate(static_cast< boost::interprocess::offset_t >(data_offset + capacity));
+        boost::interprocess::mapped_region region(shm, boost::interprocess::read_write);
+        m_SharedMemory.swap(shm);
+        m_Region.swap(region);
+
+        queue_header* const hdr = new (m_Region.get_address()) queue_header(capacity);
+        hdr->m_abi_tag.store(abi_tag, boost::memory_order_release);
+    }
+
+    //! Opens an existing queue
+    void open()
+    {
+        boost::interprocess::shared_memory_object shm(boost::interprocess::open_only, m_Name.c_str(), boost::interprocess::read_write);
+
+        // The creating process may not have sized the shared memory yet
+        boost::interprocess::offset_t size = 0;
+        for (unsigned int i = 0; shm.get_size(size) && static_cast< std::size_t >(size) < data_offset && i < max_init_wait_attempts; ++i)
+            boost::interprocess::ipcdetail::thread_sleep_tick();
+        if (static_cast< std::size_t >(size) < data_offset)
+            BOOST_LOG_THROW_DESCR(setup_error, "Interprocess message queue " + m_Name + " is not initialized");
+
+        boost::interprocess::mapped_region region(shm, boost::interprocess::read_write);
+        m_SharedMemory.swap(shm);
+        m_Region.swap(region);
+
+        queue_header* const hdr = get_header();
+        uint32_t tag = hdr->m_abi_tag.load(boost::memory_order_acquire);
+        for (unsigned int i = 0; tag == 0u && i < max_init_wait_attempts; ++i)
+        {
+            boost::interprocess::ipcdetail::thread_sleep_tick();
+            tag = hdr->m_abi_tag.load(boost::memory_order_acquire);
+        }
+        if (tag != abi_tag)
+            BOOST_LOG_THROW_DESCR(setup_error, "Interprocess message queue " + m_Name + " is not initialized or has incompatible layout");
+        if (static_cast< std::size_t >(size) < data_offset + hdr->m_capacity)
+            BOOST_LOG_THROW_DESCR(setup_error, "Interprocess message queue " + m_Name + " is corrupted");
+    }
+
+    //! Copies bytes into the queue storage at the specified position, wrapping around the storage end
+    void put_bytes(uint32_t pos, const void* data, uint32_t size) const
+    {
+        const uint32_t capacity = get_header()->m_capacity;
+        const uint32_t tail_size = capacity - pos;
+        const unsigned char* const p = static_cast< const unsigned char* >(data);
+        if (size <= tail_size)
+        {
+            std::memcpy(get_data() + pos, p, size);
+        }
+        else
+        {
+            std::memcpy(get_data() + pos, p, tail_size);
+            std::memcpy(get_data(), p + tail_size, size - tail_size);
+        }
+    }
+
+    //! Copies bytes from the queue storage at the specified position, wrapping around the storage end
+    void get_bytes(uint32_t pos, void* data, uint32_t size) const
+    {
+        const uint32_t capacity = get_header()->m_capacity;
+        const uint32_t tail_size = capacity - pos;
+        unsigned char* const p = static_cast< unsigned char* >(data);
+        if (size <= tail_size)
+        {
+            std::memcpy(p, get_data() + pos, size);
+        }
+        else
+        {
+            std::memcpy(p, get_data() + pos, tail_size);
+            std::memcpy(p + tail_size, get_data(), size - tail_size);
+        }
+    }
+
+    //! Advances the position in the queue storage
+    uint32_t advance(uint32_t pos, uint32_t size) const
+    {
+        const uint32_t capacity = get_header()->m_capacity;
+        pos += size;
+        if (pos >= capacity)
+            pos -= capacity;
+        return pos;
+    }
+
+    //! Puts the message into the queue. The queue must have enough free space for the message.
+    void put_message(void const* message_data, uint32_t message_size)
+    {
+        queue_header* const hdr = get_header();
+        put_bytes(hdr->m_put_pos, &message_size, message_header_size);
+        const uint32_t pos = advance(hdr->m_put_pos, message_header_size);
+        put_bytes(pos, message_data, message_size);
+        hdr->m_put_pos = advance(pos, message_size);
+        hdr->m_size += message_header_size + message_size;
+
+        hdr->m_nonempty_queue.notify_one();
+    }
+
+    //! Takes a message from the queue. The queue must not be empty.
+    void get_message(std::string& message)
+    {
+        queue_header* const hdr = get_header();
+        uint32_t message_size = 0u;
+        get_bytes(hdr->m_get_pos, &message_size, message_header_size);
+        BOOST_ASSERT(message_header_size + message_size <= hdr->m_size);
+
+        const uint32_t pos = advance(hdr->m_get_pos, message_header_size);
+        message.resize(message_size);
+        if (message_size > 0u)
+            get_bytes(pos, &message[0], message_size);
+        hdr->m_get_pos = advance(pos, message_size);
+        hdr->m_size -= message_header_size + message_size;
+
+        // Senders may be waiting for different amounts of free space
+        hdr->m_nonfull_queue.notify_all();
+    }
+
+    //! Checks that the message can ever be put into the queue
+    void check_message_size(uint32_t message_size) const
+    {
+        if (message_size > get_header()->m_capacity - message_header_size)
+            BOOST_LOG_THROW_DESCR(limitation_error, "Message size exceeds the interprocess message queue capacity");
+    }
+
+    //! Checks if the queue has enough free space for the message
+    bool has_space_for(uint32_t message_size) const
+    {
+        queue_header* const hdr = get_header();
+        return hdr->m_capacity - hdr->m_size >= message_header_size + message_size;
+    }
+};
+
+BOOST_LOG_API reliable_message_queue::reliable_message_queue(open_mode mode, std::string const& name, size_type capacity, overflow_policy policy) :
+    m_pImpl(NULL)
+{
+    open(mode, name, capacity, policy);
+}
+
+BOOST_LOG_API reliable_message_queue::~reliable_message_queue()
+{
+    close();
+}
+
+BOOST_LOG_API void reliable_message_queue::open(open_mode mode, std::string const& name, size_type capacity, overflow_policy policy)
+{
+    close();
+
+    if (mode != open_only && (capacity <= message_header_size || capacity > max_capacity))
+        BOOST_LOG_THROW_DESCR(limitation_error, "Interprocess message queue capacity is out of range");
+
+    implementation* p = new implementation(name, policy);
+    try
+    {
+        switch (mode)
+        {
+        case create_only:
+            p->create(capacity);
+            break;
+
+        case open_only:
+            p->open();
+            break;
+
+        default:
+            try
+            {
+                p->create(capacity);
+            }
+            catch (boost::interprocess::interprocess_exception& e)
+            {
+                if (e.get_error_code() != boost::interprocess::already_exists_error)
+                    throw;
+                p->open();
+            }
+            break;
+        }
+    }
+    catch (boost::interprocess::interprocess_exception& e)
+    {
+        delete p;
+        BOOST_LOG_THROW_DESCR(setup_error, "Failed to open interprocess message queue " + name + ": " + e.what());
+    }
+    catch (...)
+    {
+        delete p;
+        throw;
+    }
+
+    m_pImpl = p;
+}
+
+BOOST_LOG_API void reliable_message_queue::close() BOOST_NOEXCEPT
+{
+    delete m_pImpl;
+    m_pImpl = NULL;
+}
+
+BOOST_LOG_API std::string const& reliable_message_queue::name() const
+{
+    BOOST_ASSERT(m_pImpl != NULL);
+    return m_pImpl->m_Name;
+}
+
+BOOST_LOG_API reliable_message_queue::size_type reliable_message_queue::capacity() const
+{
+    BOOST_ASSERT(m_pImpl != NULL);
+    return m_pImpl->get_header()->m_capacity;
+}
+
+BOOST_LOG_API reliable_message_queue::size_type reliable_message_queue::max_message_size() const
+{
+    BOOST_ASSERT(m_pImpl != NULL);
+    return m_pImpl->get_header()->m_capacity - message_header_size;
+}
+
+BOOST_LOG_API reliable_message_queue::operation_result reliable_message_queue::send(void const* message_data, size_type message_size)
+{
+    BOOST_ASSERT(m_pImpl != NULL);
+    m_pImpl->check_message_size(message_size);
+
+    queue_header* const hdr = m_pImpl->get_header();
+    scoped_lock lock(hdr->m_mutex);
+    while (true)
+    {
+        if (m_pImpl->m_Stop)
+            return aborted;
+        if (m_pImpl->has_space_for(message_size))
+            break;
+
+        switch (m_pImpl->m_OverflowPolicy)
+        {
+        case drop_on_overflow:
+            return dropped;
+
+        case throw_on_overflow:
+            BOOST_LOG_THROW_DESCR(limitation_error, "Interprocess message queue is full");
+
+        default:
+            hdr->m_nonfull_queue.wait(lock);
+            break;
+        }
+    }
+
+    m_pImpl->put_message(message_data, message_size);
+    return succeeded;
+}
+
+BOOST_LOG_API bool reliable_message_queue::try_send(void const* message_data, size_type message_size)
+{
+    BOOST_ASSERT(m_pImpl != NULL);
+    m_pImpl->check_message_size(message_size);
+
+    queue_header* const hdr = m_pImpl->get_header();
+    scoped_lock lock(hdr->m_mutex);
+    if (!m_pImpl->has_space_for(message_size))
+        return false;
+
+    m_pImpl->put_message(message_data, message_size);
+    return true;
+}
+
+BOOST_LOG_API reliable_message_queue::operation_result reliable_message_queue::receive(std::string& message)
+{
+    BOOST_ASSERT(m_pImpl != NULL);
+
+    queue_header* const hdr = m_pImpl->get_header();
+    scoped_lock lock(hdr->m_mutex);
+    while (hdr->m_size == 0u)
+    {
+        if (m_pImpl->m_Stop)
+            return aborted;
+        hdr->m_nonempty_queue.wait(lock);
+    }
+
+    if (m_pImpl->m_Stop)
+    {
+        // Pass the notification on to another receiver so that the message is not left unnoticed
+        hdr->m_nonempty_queue.notify_one();
+        return aborted;
+    }
+
+    m_pImpl->get_message(message);
+    return succeeded;
+}
+
+BOOST_LOG_API bool reliable_message_queue::try_receive(std::string& message)
+{
+    BOOST_ASSERT(m_pImpl != NULL);
+
+    queue_header* const hdr = m_pImpl->get_header();
+    scoped_lock lock(hdr->m_mutex);
+    if (hdr->m_size == 0u)
+        return false;
+
+    m_pImpl->get_message(message);
+    return true;
+}
+
+BOOST_LOG_API void reliable_message_queue::stop_local()
+{
+    BOOST_ASSERT(m_pImpl != NULL);
+
+    queue_header* const hdr = m_pImpl->get_header();
+    scoped_lock lock(hdr->m_mutex);
+    m_pImpl->m_Stop = true;
+
+    // Threads of other processes will also wake up, but they will block again
+    hdr->m_nonempty_queue.notify_all();
+    hdr->m_nonfull_queue.notify_all();
+}
+
+BOOST_LOG_API void reliable_message_queue::reset_local()
+{
+    BOOST_ASSERT(m_pImpl != NULL);
+
+    queue_header* const hdr = m_pImpl->get_header();
+    scoped_lock lock(hdr->m_mutex);
+    m_pImpl->m_Stop = false;
+}
+
+BOOST_LOG_API void reliable_message_queue::clear()
+{
+    BOOST_ASSERT(m_pImpl != NULL);
+
+    queue_header* const hdr = m_pImpl->get_header();
+    scoped_lock lock(hdr->m_mutex);
+    hdr->m_size = 0u;
+    hdr->m_put_pos = 0u;
+    hdr->m_get_pos = 0u;
+    hdr->m_nonfull_queue.notify_all();
+}
+
+BOOST_LOG_API bool reliable_message_queue::remove(std::string const& name)
+{
+    return boost::interprocess::shared_memory_object::remove(name.c_str());
+}
+
+} // namespace ipc
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
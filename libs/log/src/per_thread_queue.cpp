@@ -0,0 +1,435 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   per_thread_queue.cpp
+ * \author Andrey Semashev
+ * \date   21.06.2015
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/doc/libs/release/libs/log/doc/html/index.html.
+ */
+
+#include <boost/log/detail/per_thread_queue.hpp>
+
+#ifndef BOOST_LOG_NO_THREADS
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/atomic/fences.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/log/detail/event.hpp>
+#include <boost/log/detail/singleton.hpp>
+#include <boost/log/detail/timestamp.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+//! Generator of unique queue identifiers
+struct queue_id_generator :
+    public lazy_singleton< queue_id_generator, boost::atomic< uintmax_t > >
+{
+};
+
+/*!
+ * Single-producer single-consumer ring of log records. The ring is shared between the queue and
+ * the thread-specific pointer of the producing thread, whichever releases it last destroys the ring.
+ */
+struct record_ring
+{
+    //! Reference counter
+    boost::atomic< unsigned int > ref_count;
+    //! The flag is set when the producing thread terminates
+    boost::atomic< bool > abandoned;
+    //! Identifier of the queue the ring belongs to
+    const uintmax_t owner_id;
+    //! Index mask
+    const std::size_t mask;
+    //! Records
+    record_view* const records;
+    //! Record timestamps
+    timestamp* const stamps;
+
+    unsigned char padding1[BOOST_LOG_CPU_CACHE_LINE_SIZE];
+
+    //! Producer position
+    boost::atomic< std::size_t > tail;
+    //! The last consumer position seen by the producer
+    std::size_t producer_head;
+
+    unsigned char padding2[BOOST_LOG_CPU_CACHE_LINE_SIZE];
+
+    //! Consumer position
+    boost::atomic< std::size_t > head;
+    //! The last producer position seen by the consumer
+    std::size_t consumer_tail;
+
+    unsigned char padding3[BOOST_LOG_CPU_CACHE_LINE_SIZE];
+
+    record_ring(uintmax_t id, std::size_t capacity) :
+        ref_count(2u),
+        abandoned(false),
+        owner_id(id),
+        mask(capacity - 1u),
+        records(new record_view[capacity]),
+        stamps(new timestamp[capacity]),
+        tail(0u),
+        producer_head(0u),
+        head(0u),
+        consumer_tail(0u)
+    {
+    }
+
+    ~record_ring()
+    {
+        delete[] stamps;
+        delete[] records;
+    }
+
+    //! Releases the reference to the ring
+    void release()
+    {
+        if (ref_count.fetch_sub(1u, boost::memory_order_release) == 1u)
+        {
+            boost::atomic_thread_fence(boost::memory_order_acquire);
+            delete this;
+        }
+    }
+
+    //! Producer: pushes a record, returns \c false if the ring is full
+    bool push(record_view const& rec, timestamp stamp)
+    {
+        const std::size_t t = tail.load(boost::memory_order_relaxed);
+        if ((t - producer_head) > mask)
+        {
+            producer_head = head.load(boost::memory_order_acquire);
+            if ((t - producer_head) > mask)
+                return false;
+        }
+
+        const std::size_t idx = t & mask;
+        records[idx] = rec;
+        stamps[idx] = stamp;
+        tail.store(t + 1u, boost::memory_order_release);
+        return true;
+    }
+
+    //! Consumer: checks if the ring is empty
+    bool empty()
+    {
+        const std::size_t h = head.load(boost::memory_order_relaxed);
+        if (h == consumer_tail)
+        {
+            consumer_tail = tail.load(boost::memory_order_acquire);
+            return h == consumer_tail;
+        }
+        return false;
+    }
+
+    //! Consumer: returns the timestamp of the oldest record. The ring must not be empty.
+    timestamp front_stamp() const
+    {
+        return stamps[head.load(boost::memory_order_relaxed) & mask];
+    }
+
+    //! Consumer: pops the oldest record. The ring must not be empty.
+    void pop(record_view& rec)
+    {
+        const std::size_t h = head.load(boost::memory_order_relaxed);
+        record_view temp;
+        temp.swap(records[h & mask]);
+        rec.swap(temp);
+        head.store(h + 1u, boost::memory_order_release);
+    }
+
+    //! Consumer: drops all records
+    void clear()
+    {
+        record_view rec;
+        while (!empty())
+            pop(rec);
+    }
+
+    //  Copying prohibited
+    BOOST_DELETED_FUNCTION(record_ring(record_ring const&))
+    BOOST_DELETED_FUNCTION(record_ring& operator= (record_ring const&))
+};
+
+//! The function is called when the producing thread terminates or switches to another ring
+void abandon_ring(record_ring* p)
+{
+    p->abandoned.store(true, boost::memory_order_release);
+    p->release();
+}
+
+} // namespace
+
+//! Queue implementation
+struct per_thread_record_queue::implementation
+{
+    typedef std::vector< record_ring* > ring_list;
+    typedef boost::mutex mutex_type;
+
+    //! Ring capacity
+    const std::size_t m_Capacity;
+    //! Unique queue identifier
+    const uintmax_t m_ID;
+    //! The ring of the current thread
+    thread_specific_ptr< record_ring > m_pCurrentRing;
+
+    //! The lock protects the list of rings
+    mutex_type m_RegistryMutex;
+    //! All rings of the queue
+    ring_list m_Registry;
+    //! The counter is incremented every time the list of rings is modified
+    boost::atomic< unsigned int > m_RegistryVersion;
+
+    //! The flag is set when the consumer is about to block
+    boost::atomic< bool > m_Waiting;
+    //! Interruption flag
+    boost::atomic< bool > m_InterruptionRequested;
+    //! The number of producers blocked on ring overflow
+    boost::atomic< std::size_t > m_BlockedProducers;
+    //! Event object to block on
+    event m_Event;
+
+    unsigned char m_Padding[BOOST_LOG_CPU_CACHE_LINE_SIZE];
+
+    //! The copy of the list of rings used by the consumer
+    ring_list m_Rings;
+    //! The version of the list of rings that is used by the consumer
+    unsigned int m_RingsVersion;
+    //! The index of the ring to start looking for records from
+    std::size_t m_NextRing;
+
+    explicit implementation(std::size_t capacity) :
+        m_Capacity(capacity),
+        m_ID(queue_id_generator::get().fetch_add(1u, boost::memory_order_relaxed) + 1u),
+        m_pCurrentRing(&abandon_ring),
+        m_RegistryVersion(0u),
+        m_Waiting(false),
+        m_InterruptionRequested(false),
+        m_BlockedProducers(0u),
+        m_RingsVersion(0u),
+        m_NextRing(0u)
+    {
+    }
+
+    ~implementation()
+    {
+        for (ring_list::const_iterator it = m_Registry.begin(), end = m_Registry.end(); it != end; ++it)
+        {
+            record_ring* p = *it;
+            p->clear();
+            p->release();
+        }
+    }
+
+    //! Returns the ring of the current thread
+    record_ring* get_current_ring()
+    {
+        record_ring* p = m_pCurrentRing.get();
+        if (BOOST_LIKELY(p != NULL && p->owner_id == m_ID))
+            return p;
+
+        // The ring may be left from a queue that was destroyed at the same address
+        p = new record_ring(m_ID, m_Capacity);
+        {
+            lock_guard< mutex_type > lock(m_RegistryMutex);
+            try
+            {
+                m_Registry.push_back(p);
+            }
+            catch (...)
+            {
+                delete p;
+                throw;
+            }
+            m_RegistryVersion.fetch_add(1u, boost::memory_order_release);
+        }
+        m_pCurrentRing.reset(p);
+        return p;
+    }
+
+    //! Updates the consumer copy of the list of rings
+    void update_rings()
+    {
+        lock_guard< mutex_type > lock(m_RegistryMutex);
+        m_Rings = m_Registry;
+        m_RingsVersion = m_RegistryVersion.load(boost::memory_order_relaxed);
+        if (m_NextRing >= m_Rings.size())
+            m_NextRing = 0u;
+    }
+
+    //! Removes the drained ring of a terminated thread
+    void remove_ring(record_ring* p)
+    {
+        {
+            lock_guard< mutex_type > lock(m_RegistryMutex);
+            m_Registry.erase(std::find(m_Registry.begin(), m_Registry.end(), p));
+            m_RegistryVersion.fetch_add(1u, boost::memory_order_release);
+        }
+        p->release();
+        update_rings();
+    }
+
+    //! Pops the oldest record
+    bool try_pop(record_view& rec)
+    {
+        if (m_RegistryVersion.load(boost::memory_order_acquire) != m_RingsVersion)
+            update_rings();
+
+        const std::size_t size = m_Rings.size();
+        record_ring* best = NULL;
+        std::size_t best_index = 0u;
+        timestamp best_stamp;
+        record_ring* drained = NULL;
+        for (std::size_t i = 0u, index = m_NextRing; i < size; ++i, ++index)
+        {
+            if (index >= size)
+                index = 0u;
+
+            record_ring* p = m_Rings[index];
+            if (p->empty())
+            {
+                if (p->abandoned.load(boost::memory_order_acquire) && p->empty())
+                    drained = p;
+                continue;
+            }
+
+            const timestamp stamp = p->front_stamp();
+            if (!best || stamp < best_stamp)
+            {
+                best = p;
+                best_index = index;
+                best_stamp = stamp;
+            }
+        }
+
+        if (best)
+        {
+            best->pop(rec);
+            m_NextRing = best_index + 1u;
+            if (m_NextRing >= size)
+                m_NextRing = 0u;
+        }
+
+        if (drained)
+            remove_ring(drained);
+
+        return best != NULL;
+    }
+};
+
+//! Constructor
+BOOST_LOG_API per_thread_record_queue::per_thread_record_queue(std::size_t ring_capacity)
+{
+    std::size_t capacity = 2u;
+    while (capacity < ring_capacity)
+        capacity *= 2u;
+    m_pImpl = new implementation(capacity);
+}
+
+//! Destructor
+BOOST_LOG_API per_thread_record_queue::~per_thread_record_queue()
+{
+    delete m_pImpl;
+}
+
+//! Pushes a record to the ring of the current thread
+BOOST_LOG_API bool per_thread_record_queue::try_push(record_view const& rec)
+{
+    record_ring* p = m_pImpl->get_current_ring();
+    if (!p->push(rec, get_timestamp()))
+        return false;
+
+    // Wake the consumer if it is blocked. The fence pairs with the one in the pop method.
+    boost::atomic_thread_fence(boost::memory_order_seq_cst);
+    if (m_pImpl->m_Waiting.load(boost::memory_order_relaxed))
+        m_pImpl->m_Event.set_signalled();
+
+    return true;
+}
+
+//! Pops the oldest record from the rings
+BOOST_LOG_API bool per_thread_record_queue::try_pop(record_view& rec)
+{
+    return m_pImpl->try_pop(rec);
+}
+
+//! Pops the oldest record from the rings, blocks if all rings are empty
+BOOST_LOG_API bool per_thread_record_queue::pop(record_view& rec)
+{
+    while (true)
+    {
+        if (m_pImpl->try_pop(rec))
+            return true;
+
+        m_pImpl->m_Waiting.store(true, boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        if (m_pImpl->try_pop(rec))
+        {
+            m_pImpl->m_Waiting.store(false, boost::memory_order_relaxed);
+            return true;
+        }
+
+        m_pImpl->m_Event.wait();
+        m_pImpl->m_Waiting.store(false, boost::memory_order_relaxed);
+        if (m_pImpl->m_InterruptionRequested.exchange(false, boost::memory_order_acquire))
+            return false;
+    }
+}
+
+//! Wakes the thread blocked in the pop method
+BOOST_LOG_API void per_thread_record_queue::interrupt()
+{
+    m_pImpl->m_InterruptionRequested.store(true, boost::memory_order_release);
+    m_pImpl->m_Event.set_signalled();
+}
+
+//! Registers a producer that is about to block because its ring is full
+BOOST_LOG_API void per_thread_record_queue::add_blocked_producer()
+{
+    m_pImpl->m_BlockedProducers.fetch_add(1u, boost::memory_order_relaxed);
+    // The fence pairs with the one in blocked_producers, so that either the producer sees the free space or the consumer sees the producer
+    boost::atomic_thread_fence(boost::memory_order_seq_cst);
+}
+
+//! Unregisters a blocked producer
+BOOST_LOG_API void per_thread_record_queue::remove_blocked_producer()
+{
+    m_pImpl->m_BlockedProducers.fetch_sub(1u, boost::memory_order_relaxed);
+}
+
+//! Returns the number of blocked producers
+BOOST_LOG_API std::size_t per_thread_record_queue::blocked_producers() const
+{
+    // The fence pairs with the one in add_blocked_producer
+    boost::atomic_thread_fence(boost::memory_order_seq_cst);
+    return m_pImpl->m_BlockedProducers.load(boost::memory_order_relaxed);
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_NO_THREADS
@@ -18,6 +18,8 @@
 #include "windows_version.hpp"
 #include <boost/log/detail/config.hpp>
 #include <memory>
+#include <vector>
+#include <cstddef>
 #include <algorithm>
 #include <stdexcept>
 #include <boost/limits.hpp>
@@ -109,6 +111,19 @@ struct syslog_backend::implementation
 
     //! The method sends the formatted message to the syslog host
     virtual void send(syslog::level lev, string_type const& formatted_message) = 0;
+
+    //! The method sends a batch of formatted messages to the syslog host
+    virtual void send_batch(std::vector< record_view > const& records, std::vector< string_type > const& formatted_messages)
+    {
+        for (std::size_t i = 0, n = formatted_messages.size(); i < n; ++i)
+            send(get_level(records[i]), formatted_messages[i]);
+    }
+
+    //! Returns the syslog level of the record
+    syslog::level get_level(record_view const& rec) const
+    {
+        return m_LevelMapper.empty() ? syslog::info : m_LevelMapper(rec);
+    }
 };
 
 
@@ -313,7 +328,15 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         }
 
         //! The method sends the syslog message to the specified endpoint
-        void send_message(int pri, const char* local_host_name, asio::ip::udp::endpoint const& target, const char* message);
+        void send_message(int pri, const char* local_host_name, asio::ip::udp::endpoint const& target, const char* message)
+        {
+            std::time_t t = std::time(NULL);
+            std::tm ts;
+            std::tm* time_stamp = boost::date_time::c_time::localtime(&t, &ts);
+            send_message(pri, *time_stamp, local_host_name, target, message);
+        }
+        //! The method sends the syslog message with the specified time stamp to the specified endpoint
+        void send_message(int pri, std::tm const& time_stamp, const char* local_host_name, asio::ip::udp::endpoint const& target, const char* message);
 
     private:
         syslog_udp_socket(syslog_udp_socket const&);
@@ -357,14 +380,10 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         }
     };
 
-    //! The method sends the syslog message to the specified endpoint
+    //! The method sends the syslog message with the specified time stamp to the specified endpoint
     void syslog_udp_socket::send_message(
-        int pri, const char* local_host_name, asio::ip::udp::endpoint const& target, const char* message)
+        int pri, std::tm const& time_stamp, const char* local_host_name, asio::ip::udp::endpoint const& target, const char* message)
     {
-        std::time_t t = std::time(NULL);
-        std::tm ts;
-        std::tm* time_stamp = boost::date_time::c_time::localtime(&t, &ts);
-
         // Month will have to be injected separately, as involving locale won't do here
         static const char months[12][4] =
         {
@@ -379,11 +398,11 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             sizeof(packet),
             "<%d> %s % 2d %02d:%02d:%02d %s %s",
             pri,
-            months[time_stamp->tm_mon],
-            time_stamp->tm_mday,
-            time_stamp->tm_hour,
-            time_stamp->tm_min,
-            time_stamp->tm_sec,
+            months[time_stamp.tm_mon],
+            time_stamp.tm_mday,
+            time_stamp.tm_hour,
+            time_stamp.tm_min,
+            time_stamp.tm_sec,
             local_host_name,
             message
         );
@@ -430,18 +449,45 @@ struct syslog_backend::implementation::udp_socket_based :
 
     //! The method sends the formatted message to the syslog host
     void send(syslog::level lev, string_type const& formatted_message)
+    {
+        get_socket()->send_message(
+            this->m_Facility | static_cast< int >(lev),
+            m_pService->m_LocalHostName.c_str(),
+            m_TargetHost,
+            formatted_message.c_str());
+    }
+
+    //! The method sends a batch of formatted messages to the syslog host
+    void send_batch(std::vector< record_view > const& records, std::vector< string_type > const& formatted_messages)
+    {
+        syslog_udp_socket* socket = get_socket();
+
+        // The time stamp has a resolution of one second, so it is acquired once for the whole batch
+        std::time_t t = std::time(NULL);
+        std::tm ts;
+        std::tm* time_stamp = boost::date_time::c_time::localtime(&t, &ts);
+
+        for (std::size_t i = 0, n = formatted_messages.size(); i < n; ++i)
+        {
+            socket->send_message(
+                this->m_Facility | static_cast< int >(this->get_level(records[i])),
+                *time_stamp,
+                m_pService->m_LocalHostName.c_str(),
+                m_TargetHost,
+                formatted_messages[i].c_str());
+        }
+    }
+
+private:
+    //! Returns the socket, creates one if needed
+    syslog_udp_socket* get_socket()
     {
         if (!m_pSocket.get())
         {
             asio::ip::udp::endpoint any_local_address;
             m_pSocket.reset(new syslog_udp_socket(m_pService->m_IOService, m_Protocol, any_local_address));
         }
-
-        m_pSocket->send_message(
-            this->m_Facility | static_cast< int >(lev),
-            m_pService->m_LocalHostName.c_str(),
-            m_TargetHost,
-            formatted_message.c_str());
+        return m_pSocket.get();
     }
 };
 
@@ -470,9 +516,13 @@ BOOST_LOG_API void syslog_backend::set_severity_mapper(severity_mapper_type cons
 //! The method writes the message to the sink
 BOOST_LOG_API void syslog_backend::consume(record_view const& rec, string_type const& formatted_message)
 {
-    m_pImpl->send(
-        m_pImpl->m_LevelMapper.empty() ? syslog::info : m_pImpl->m_LevelMapper(rec),
-        formatted_message);
+    m_pImpl->send(m_pImpl->get_level(rec), formatted_message);
+}
+
+//! The method writes a batch of messages to the sink
+BOOST_LOG_API void syslog_backend::consume_batch(std::vector< record_view > const& records, std::vector< string_type > const& formatted_messages)
+{
+    m_pImpl->send_batch(records, formatted_messages);
 }
 
 
@@ -20,6 +20,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstddef>
+#include <cstring>
 #include <list>
 #include <memory>
 #include <string>
@@ -46,6 +47,9 @@
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/list_hook.hpp>
 #include <boost/intrusive/options.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/gregorian/gregorian_types.hpp>
 #include <boost/spirit/home/qi/numeric/numeric_utils.hpp>
@@ -56,10 +60,20 @@
 #include <boost/log/sinks/text_file_backend.hpp>
 
 #if !defined(BOOST_LOG_NO_THREADS)
+#include <deque>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
 #endif // !defined(BOOST_LOG_NO_THREADS)
 
+#if defined(__linux__)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#define BOOST_LOG_HAS_POSIX_FALLOCATE
+#endif
+
 #include <boost/log/detail/header.hpp>
 
 namespace qi = boost::spirit::qi;
@@ -894,6 +908,320 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         }
     }
 
+    //! Extends the file to the specified size, allocating file system space for the added part if possible
+    void preallocate_file(filesystem::path const& name, uintmax_t size)
+    {
+        const uintmax_t current_size = filesystem::file_size(name);
+        if (current_size >= size)
+            return;
+
+#if defined(BOOST_LOG_HAS_POSIX_FALLOCATE)
+        const int fd = ::open(name.c_str(), O_WRONLY);
+        if (fd >= 0)
+        {
+            const int err = ::posix_fallocate(fd, static_cast< off_t >(current_size), static_cast< off_t >(size - current_size));
+            ::close(fd);
+            if (err == 0)
+                return;
+            if (err != EINVAL && err != EOPNOTSUPP)
+                BOOST_THROW_EXCEPTION(filesystem_error("Failed to preallocate file", name, system::error_code(err, system::system_category())));
+        }
+#endif // defined(BOOST_LOG_HAS_POSIX_FALLOCATE)
+
+        // Fall back to extending the file without allocating space
+        filesystem::resize_file(name, size);
+    }
+
+    //! Returns the size of the file, excluding the trailing zero bytes that may have been left from preallocation
+    uintmax_t get_contents_size(filesystem::path const& name)
+    {
+        uintmax_t size = filesystem::file_size(name);
+        filesystem::ifstream file(name, std::ios_base::in | std::ios_base::binary);
+        char buf[4096];
+        while (size > 0 && file.is_open())
+        {
+            const std::size_t block_size = static_cast< std::size_t >((std::min)(size, static_cast< uintmax_t >(sizeof(buf))));
+            file.seekg(static_cast< std::streamoff >(size - block_size));
+            if (!file.read(buf, static_cast< std::streamsize >(block_size)))
+                break;
+
+            std::size_t n = block_size;
+            while (n > 0 && buf[n - 1] == 0)
+                --n;
+            size -= block_size - n;
+            if (n > 0)
+                break;
+        }
+
+        return size;
+    }
+
+    //! The class writes a file through memory mapping
+    class mapped_file_writer
+    {
+    private:
+        //! File name
+        filesystem::path m_FileName;
+        //! The currently mapped part of the file
+        interprocess::mapped_region m_Region;
+        //! The size of the mapped part of the file
+        uintmax_t m_ChunkSize;
+        //! The offset of the mapped part of the file
+        uintmax_t m_ChunkOffset;
+        //! The size of the written file contents
+        uintmax_t m_Size;
+        //! The size of the file contents that has already been flushed
+        uintmax_t m_FlushedSize;
+        //! The flag indicates that the file is open
+        bool m_IsOpen;
+
+    public:
+        mapped_file_writer() : m_ChunkSize(0), m_ChunkOffset(0), m_Size(0), m_FlushedSize(0), m_IsOpen(false)
+        {
+        }
+        ~mapped_file_writer()
+        {
+            try
+            {
+                close();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        //! Returns \c true if the file is open
+        bool is_open() const { return m_IsOpen; }
+        //! Returns the size of the written file contents
+        uintmax_t size() const { return m_Size; }
+
+        //! Opens the file
+        void open(filesystem::path const& name, bool append, uintmax_t chunk_size)
+        {
+            const uintmax_t page_size = interprocess::mapped_region::get_page_size();
+            m_ChunkSize = (chunk_size + page_size - 1u) / page_size * page_size;
+
+            {
+                // Create the file if it doesn't exist
+                filesystem::ofstream file(name, std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+                if (!file.is_open())
+                {
+                    filesystem_error err(
+                        "Failed to open file for writing",
+                        name,
+                        system::error_code(system::errc::io_error, system::generic_category()));
+                    BOOST_THROW_EXCEPTION(err);
+                }
+            }
+
+            // Truncate the file or remove the preallocated space that was left in case of a crash
+            const uintmax_t size = append ? get_contents_size(name) : static_cast< uintmax_t >(0u);
+            filesystem::resize_file(name, size);
+
+            m_FileName = name;
+            m_Size = m_ChunkOffset = m_FlushedSize = size;
+            m_IsOpen = true;
+        }
+
+        //! Writes data to the file
+        void write(const char* p, std::size_t size)
+        {
+            while (size > 0)
+            {
+                if (m_Size == m_ChunkOffset + m_Region.get_size())
+                    map_chunk();
+
+                const std::size_t n = static_cast< std::size_t >((std::min)(static_cast< uintmax_t >(size), m_ChunkOffset + m_Region.get_size() - m_Size));
+                std::memcpy(static_cast< char* >(m_Region.get_address()) + static_cast< std::size_t >(m_Size - m_ChunkOffset), p, n);
+                m_Size += n;
+                p += n;
+                size -= n;
+            }
+        }
+
+        //! Initiates writing the mapped memory to the file. The method does not wait for the write to complete.
+        void flush()
+        {
+            flush_pending(true);
+        }
+
+        //! Closes the file and truncates it to the size of the written contents
+        void close()
+        {
+            if (m_IsOpen)
+            {
+                m_IsOpen = false;
+                // Unlike periodic flushes, closing the file waits for the contents to be written
+                if (m_Size > m_ChunkOffset && m_Region.get_size() > 0)
+                    m_Region.flush(0, static_cast< std::size_t >(m_Size - m_ChunkOffset), false);
+                m_FlushedSize = m_Size;
+                interprocess::mapped_region().swap(m_Region);
+                filesystem::resize_file(m_FileName, m_Size);
+            }
+        }
+
+    private:
+        //! Writes the part of the mapped memory that was written since the last flush to the file
+        void flush_pending(bool async)
+        {
+            if (m_Size == m_FlushedSize || m_Region.get_size() == 0)
+                return;
+
+            // The flushed range must start at a page boundary. The mapped part of the file starts at a page boundary as well.
+            const uintmax_t page_size = interprocess::mapped_region::get_page_size();
+            uintmax_t begin = m_FlushedSize > m_ChunkOffset ? m_FlushedSize - m_ChunkOffset : static_cast< uintmax_t >(0u);
+            begin -= begin % page_size;
+            const uintmax_t end = m_Size - m_ChunkOffset;
+            if (end > begin)
+                m_Region.flush(static_cast< std::size_t >(begin), static_cast< std::size_t >(end - begin), async);
+            m_FlushedSize = m_Size;
+        }
+
+        //! Maps the part of the file that follows the written contents
+        void map_chunk()
+        {
+            flush_pending(true);
+            interprocess::mapped_region().swap(m_Region);
+            // If mapping fails, the next write attempts to map the same part of the file
+            m_ChunkOffset = m_Size;
+
+            const uintmax_t offset = m_Size - m_Size % interprocess::mapped_region::get_page_size();
+            preallocate_file(m_FileName, offset + m_ChunkSize);
+            try
+            {
+                interprocess::file_mapping mapping(m_FileName.string().c_str(), interprocess::read_write);
+                interprocess::mapped_region(mapping, interprocess::read_write, static_cast< interprocess::offset_t >(offset), static_cast< std::size_t >(m_ChunkSize)).swap(m_Region);
+            }
+            catch (interprocess::interprocess_exception& e)
+            {
+                BOOST_THROW_EXCEPTION(filesystem_error("Failed to map file", m_FileName, system::error_code(e.get_native_error(), system::system_category())));
+            }
+            m_ChunkOffset = offset;
+        }
+
+        BOOST_DELETED_FUNCTION(mapped_file_writer(mapped_file_writer const&))
+        BOOST_DELETED_FUNCTION(mapped_file_writer& operator= (mapped_file_writer const&))
+    };
+
+    //! Compresses the rotated file and passes the compressed file to the file collector
+    void compress_and_store_file(
+        filesystem::path const& name,
+        text_file_backend::file_compressor_type const& compressor,
+        shared_ptr< file::collector > const& collector)
+    {
+        filesystem::path compressed_name;
+        try
+        {
+            compressed_name = compressor(name);
+        }
+        catch (...)
+        {
+        }
+
+        if (compressed_name.empty())
+            compressed_name = name;
+
+        if (!!collector)
+        {
+            try
+            {
+                collector->store_file(compressed_name);
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+    //! The queue of rotated files that are compressed in a background thread
+    class file_compression_queue
+    {
+    private:
+        //! Rotated file description
+        struct rotated_file
+        {
+            filesystem::path m_FileName;
+            text_file_backend::file_compressor_type m_Compressor;
+            shared_ptr< file::collector > m_pFileCollector;
+        };
+
+    private:
+        //! Synchronization mutex
+        mutex m_Mutex;
+        //! The condition is signalled when new files are queued or the queue is being destroyed
+        condition_variable m_Condition;
+        //! Rotated files
+        std::deque< rotated_file > m_Files;
+        //! The flag indicates that the queue is being destroyed
+        bool m_Stop;
+        //! Compression thread
+        thread m_Thread;
+
+    public:
+        file_compression_queue() : m_Stop(false)
+        {
+        }
+        //! Destructor. Waits until all queued files are compressed.
+        ~file_compression_queue()
+        {
+            {
+                lock_guard< mutex > lock(m_Mutex);
+                m_Stop = true;
+            }
+            m_Condition.notify_one();
+            if (m_Thread.joinable())
+                m_Thread.join();
+        }
+
+        //! Queues the file for compression
+        void push(
+            filesystem::path const& name,
+            text_file_backend::file_compressor_type const& compressor,
+            shared_ptr< file::collector > const& collector)
+        {
+            rotated_file file;
+            file.m_FileName = name;
+            file.m_Compressor = compressor;
+            file.m_pFileCollector = collector;
+
+            lock_guard< mutex > lock(m_Mutex);
+            if (!m_Thread.joinable())
+                thread(boost::bind(&file_compression_queue::run, this)).swap(m_Thread);
+            m_Files.push_back(file);
+            m_Condition.notify_one();
+        }
+
+    private:
+        //! Compression thread function
+        void run()
+        {
+            unique_lock< mutex > lock(m_Mutex);
+            while (true)
+            {
+                if (!m_Files.empty())
+                {
+                    rotated_file file = m_Files.front();
+                    m_Files.pop_front();
+
+                    lock.unlock();
+                    compress_and_store_file(file.m_FileName, file.m_Compressor, file.m_pFileCollector);
+                    lock.lock();
+                }
+                else if (m_Stop)
+                    break;
+                else
+                    m_Condition.wait(lock);
+            }
+        }
+
+        BOOST_DELETED_FUNCTION(file_compression_queue(file_compression_queue const&))
+        BOOST_DELETED_FUNCTION(file_compression_queue& operator= (file_compression_queue const&))
+    };
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
 } // namespace
 
 namespace file {
@@ -1078,8 +1406,12 @@ struct text_file_backend::implementation
     filesystem::path m_FileName;
     //! File stream
     filesystem::ofstream m_File;
+    //! Memory mapped file
+    mapped_file_writer m_MappedFile;
     //! Characters written
     uintmax_t m_CharactersWritten;
+    //! The size of the mapped chunks of the file, zero if memory mapping is not used
+    uintmax_t m_MappingChunkSize;
 
     //! File collector functional object
     shared_ptr< file::collector > m_pFileCollector;
@@ -1095,14 +1427,28 @@ struct text_file_backend::implementation
     //! The flag shows if every written record should be flushed
     bool m_AutoFlush;
 
-    implementation(uintmax_t rotation_size, bool auto_flush) :
+    //! Rotated file compressor
+    file_compressor_type m_FileCompressor;
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Rotated files that are being compressed
+    file_compression_queue m_CompressionQueue;
+#endif
+
+    implementation(uintmax_t rotation_size, bool auto_flush, uintmax_t mapping_chunk_size) :
         m_FileOpenMode(std::ios_base::trunc | std::ios_base::out),
         m_FileCounter(0),
         m_CharactersWritten(0),
+        m_MappingChunkSize(mapping_chunk_size),
         m_FileRotationSize(rotation_size),
         m_AutoFlush(auto_flush)
     {
     }
+
+    //! Returns \c true if a file is open
+    bool is_file_open() const
+    {
+        return m_File.is_open() || m_MappedFile.is_open();
+    }
 };
 
 //! Constructor. No streams attached to the constructed backend, auto flush feature disabled.
@@ -1117,7 +1463,7 @@ BOOST_LOG_API text_file_backend::~text_file_backend()
     try
     {
         // Attempt to put the temporary file into storage
-        if (m_pImpl->m_File.is_open() && m_pImpl->m_CharactersWritten > 0)
+        if (m_pImpl->is_file_open() && m_pImpl->m_CharactersWritten > 0)
             rotate_file();
     }
     catch (...)
@@ -1133,9 +1479,10 @@ BOOST_LOG_API void text_file_backend::construct(
     std::ios_base::openmode mode,
     uintmax_t rotation_size,
     time_based_rotation_predicate const& time_based_rotation,
-    bool auto_flush)
+    bool auto_flush,
+    uintmax_t mapping_chunk_size)
 {
-    m_pImpl = new implementation(rotation_size, auto_flush);
+    m_pImpl = new implementation(rotation_size, auto_flush, mapping_chunk_size);
     set_file_name_pattern_internal(pattern);
     set_time_based_rotation(time_based_rotation);
     set_open_mode(mode);
@@ -1160,7 +1507,58 @@ BOOST_LOG_API void text_file_backend::auto_flush(bool f)
 }
 
 //! The method writes the message to the sink
-BOOST_LOG_API void text_file_backend::consume(record_view const& rec, string_type const& formatted_message)
+BOOST_LOG_API void text_file_backend::consume(record_view const&, string_type const& formatted_message)
+{
+    write_message(formatted_message);
+
+    if (m_pImpl->m_AutoFlush)
+        flush();
+}
+
+//! The method writes a batch of messages to the sink
+BOOST_LOG_API void text_file_backend::consume_batch(std::vector< record_view > const&, std::vector< string_type > const& formatted_messages)
+{
+    std::vector< string_type >::const_iterator it = formatted_messages.begin(), end = formatted_messages.end();
+    try
+    {
+        for (; it != end; ++it)
+            write_message(*it);
+    }
+    catch (...)
+    {
+        // Write the rest of the batch, as if the records were passed to consume one by one,
+        // and then report the first failure. Subsequent failures most likely have the same cause.
+        for (++it; it != end; ++it)
+        {
+            try
+            {
+                write_message(*it);
+            }
+            catch (...)
+            {
+            }
+        }
+
+        if (m_pImpl->m_AutoFlush)
+        {
+            try
+            {
+                flush();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        throw;
+    }
+
+    if (m_pImpl->m_AutoFlush)
+        flush();
+}
+
+//! Writes the message to the file, rotates the file if needed
+void text_file_backend::write_message(string_type const& formatted_message)
 {
     typedef file_char_traits< string_type::value_type > traits_t;
 
@@ -1180,15 +1578,15 @@ BOOST_LOG_API void text_file_backend::consume(record_view const& rec, string_typ
             // To reuse the empty file avoid re-generating the new file name later
             no_new_filename = true;
         }
-        else if (!!m_pImpl->m_pFileCollector)
+        else
         {
             // Complete file rotation
-            m_pImpl->m_pFileCollector->store_file(m_pImpl->m_FileName);
+            store_file();
         }
     }
     else if
     (
-        m_pImpl->m_File.is_open() &&
+        m_pImpl->is_file_open() &&
         (
             m_pImpl->m_CharactersWritten + formatted_message.size() >= m_pImpl->m_FileRotationSize ||
             (!m_pImpl->m_TimeBasedRotation.empty() && m_pImpl->m_TimeBasedRotation())
@@ -1198,13 +1596,49 @@ BOOST_LOG_API void text_file_backend::consume(record_view const& rec, string_typ
         rotate_file();
     }
 
-    if (!m_pImpl->m_File.is_open())
+    if (!m_pImpl->is_file_open())
+        open_file(no_new_filename);
+
+    if (m_pImpl->m_MappedFile.is_open())
     {
-        if (!no_new_filename)
-            m_pImpl->m_FileName = m_pImpl->m_StorageDir / m_pImpl->m_FileNameGenerator(m_pImpl->m_FileCounter++);
+        // Bypass the stream and copy the message directly to the mapped memory
+        m_pImpl->m_MappedFile.write(formatted_message.data(), formatted_message.size());
+        const char_type newline = traits_t::newline;
+        m_pImpl->m_MappedFile.write(&newline, 1u);
+    }
+    else
+    {
+        m_pImpl->m_File.write(formatted_message.data(), static_cast< std::streamsize >(formatted_message.size()));
+        m_pImpl->m_File.put(traits_t::newline);
+    }
 
-        filesystem::create_directories(m_pImpl->m_FileName.parent_path());
+    m_pImpl->m_CharactersWritten += formatted_message.size() + 1;
+}
+
+//! Opens a new file
+void text_file_backend::open_file(bool no_new_filename)
+{
+    if (!no_new_filename)
+        m_pImpl->m_FileName = m_pImpl->m_StorageDir / m_pImpl->m_FileNameGenerator(m_pImpl->m_FileCounter++);
+
+    filesystem::create_directories(m_pImpl->m_FileName.parent_path());
+
+    if (m_pImpl->m_MappingChunkSize > 0)
+    {
+        m_pImpl->m_MappedFile.open(m_pImpl->m_FileName, (m_pImpl->m_FileOpenMode & std::ios_base::app) != 0, m_pImpl->m_MappingChunkSize);
 
+        if (!m_pImpl->m_OpenHandler.empty())
+        {
+            std::basic_ostringstream< char_type > strm;
+            m_pImpl->m_OpenHandler(strm);
+            const string_type header = strm.str();
+            m_pImpl->m_MappedFile.write(header.data(), header.size());
+        }
+
+        m_pImpl->m_CharactersWritten = m_pImpl->m_MappedFile.size();
+    }
+    else
+    {
         m_pImpl->m_File.open(m_pImpl->m_FileName, m_pImpl->m_FileOpenMode);
         if (!m_pImpl->m_File.is_open())
         {
@@ -1220,20 +1654,14 @@ BOOST_LOG_API void text_file_backend::consume(record_view const& rec, string_typ
 
         m_pImpl->m_CharactersWritten = static_cast< std::streamoff >(m_pImpl->m_File.tellp());
     }
-
-    m_pImpl->m_File.write(formatted_message.data(), static_cast< std::streamsize >(formatted_message.size()));
-    m_pImpl->m_File.put(traits_t::newline);
-
-    m_pImpl->m_CharactersWritten += formatted_message.size() + 1;
-
-    if (m_pImpl->m_AutoFlush)
-        m_pImpl->m_File.flush();
 }
 
 //! The method flushes the currently open log file
 BOOST_LOG_API void text_file_backend::flush()
 {
-    if (m_pImpl->m_File.is_open())
+    if (m_pImpl->m_MappedFile.is_open())
+        m_pImpl->m_MappedFile.flush();
+    else if (m_pImpl->m_File.is_open())
         m_pImpl->m_File.flush();
 }
 
@@ -1326,6 +1754,20 @@ BOOST_LOG_API void text_file_backend::set_file_name_pattern_internal(filesystem:
 //! Closes the currently open file
 void text_file_backend::close_file()
 {
+    if (m_pImpl->m_MappedFile.is_open())
+    {
+        if (!m_pImpl->m_CloseHandler.empty())
+        {
+            std::basic_ostringstream< char_type > strm;
+            m_pImpl->m_CloseHandler(strm);
+            const string_type footer = strm.str();
+            m_pImpl->m_MappedFile.write(footer.data(), footer.size());
+        }
+        m_pImpl->m_MappedFile.close();
+        m_pImpl->m_CharactersWritten = 0;
+        return;
+    }
+
     if (!m_pImpl->m_CloseHandler.empty())
     {
         // Rationale: We should call the close handler even if the stream is !good() because
@@ -1342,13 +1784,28 @@ void text_file_backend::close_file()
     m_pImpl->m_CharactersWritten = 0;
 }
 
+//! Passes the closed file to the file collector
+void text_file_backend::store_file()
+{
+    if (!m_pImpl->m_FileCompressor.empty())
+    {
+#if !defined(BOOST_LOG_NO_THREADS)
+        m_pImpl->m_CompressionQueue.push(m_pImpl->m_FileName, m_pImpl->m_FileCompressor, m_pImpl->m_pFileCollector);
+#else
+        compress_and_store_file(m_pImpl->m_FileName, m_pImpl->m_FileCompressor, m_pImpl->m_pFileCollector);
+#endif
+    }
+    else if (!!m_pImpl->m_pFileCollector)
+    {
+        m_pImpl->m_pFileCollector->store_file(m_pImpl->m_FileName);
+    }
+}
+
 //! The method rotates the file
 BOOST_LOG_API void text_file_backend::rotate_file()
 {
     close_file();
-
-    if (!!m_pImpl->m_pFileCollector)
-        m_pImpl->m_pFileCollector->store_file(m_pImpl->m_FileName);
+    store_file();
 }
 
 //! The method sets the file open mode
@@ -1379,6 +1836,18 @@ BOOST_LOG_API void text_file_backend::set_close_handler(close_handler_type const
     m_pImpl->m_CloseHandler = handler;
 }
 
+//! The method sets the size of the memory mapped file chunks
+BOOST_LOG_API void text_file_backend::set_mapping_chunk_size(uintmax_t size)
+{
+    m_pImpl->m_MappingChunkSize = size;
+}
+
+//! The method sets rotated file compressor
+BOOST_LOG_API void text_file_backend::set_file_compressor(file_compressor_type const& compressor)
+{
+    m_pImpl->m_FileCompressor = compressor;
+}
+
 //! Performs scanning of the target directory for log files
 BOOST_LOG_API uintmax_t text_file_backend::scan_for_files(file::scan_method method, bool update_counter)
 {
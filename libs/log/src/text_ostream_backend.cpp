@@ -24,6 +24,26 @@ BOOST_LOG_OPEN_NAMESPACE
 
 namespace sinks {
 
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+//! Writes the messages to the stream
+template< typename StreamT, typename StringT >
+void write_messages(StreamT& strm, std::vector< StringT > const& messages, bool auto_flush)
+{
+    typedef typename StreamT::char_type char_type;
+    typename std::vector< StringT >::const_iterator it = messages.begin(), end = messages.end();
+    for (; it != end && strm.good(); ++it)
+    {
+        strm.write(it->data(), static_cast< std::streamsize >(it->size()));
+        strm.put(static_cast< char_type >('\n'));
+    }
+
+    if (auto_flush && strm.good())
+        strm.flush();
+}
+
+} // namespace
+
 //! Sink implementation
 template< typename CharT >
 struct basic_text_ostream_backend< CharT >::implementation
@@ -106,6 +126,37 @@ BOOST_LOG_API void basic_text_ostream_backend< CharT >::consume(record_view cons
     }
 }
 
+//! The method writes a batch of messages to the sink
+template< typename CharT >
+BOOST_LOG_API void basic_text_ostream_backend< CharT >::consume_batch(std::vector< record_view > const&, std::vector< string_type > const& messages)
+{
+    typename implementation::ostream_sequence::const_iterator
+        it = m_pImpl->m_Streams.begin(), end = m_pImpl->m_Streams.end();
+    for (; it != end; ++it)
+    {
+        try
+        {
+            write_messages(**it, messages, m_pImpl->m_fAutoFlush);
+        }
+        catch (...)
+        {
+            // A stream that throws is left in a failed state and will not accept further messages,
+            // but the other streams should still receive the batch. Then the failure is reported.
+            for (++it; it != end; ++it)
+            {
+                try
+                {
+                    write_messages(**it, messages, m_pImpl->m_fAutoFlush);
+                }
+                catch (...)
+                {
+                }
+            }
+            throw;
+        }
+    }
+}
+
 //! The method flushes the associated streams
 template< typename CharT >
 BOOST_LOG_API void basic_text_ostream_backend< CharT >::flush()
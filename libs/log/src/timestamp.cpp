@@ -211,6 +211,11 @@ BOOST_LOG_API int64_t duration::milliseconds() const
     return m_ticks / 1000000LL;
 }
 
+BOOST_LOG_API int64_t duration::microseconds() const
+{
+    return m_ticks / 1000LL;
+}
+
 BOOST_LOG_ANONYMOUS_NAMESPACE {
 
 /*!
@@ -270,7 +275,10 @@ BOOST_LOG_API get_timestamp_t get_timestamp = &BOOST_LOG_DEFAULT_GET_TIMESTAMP;
 
 #elif defined(macintosh) || defined(__APPLE__) || defined(__APPLE_CC__)
 
-BOOST_LOG_API int64_t duration::milliseconds() const
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+//! The function converts MacOS X absolute time to time units of the given resolution (in nanoseconds)
+int64_t convert_mach_time(int64_t ticks, int64_t resolution)
 {
     static mach_timebase_info_data_t timebase_info = {};
     BOOST_LOG_ONCE_BLOCK()
@@ -287,14 +295,26 @@ BOOST_LOG_API int64_t duration::milliseconds() const
     if (timebase_info.numer == timebase_info.denom)
     {
         // Timestamps are in nanoseconds
-        return m_ticks / 1000000LL;
+        return ticks / resolution;
     }
     else
     {
-        return (m_ticks * timebase_info.numer) / (1000000LL * timebase_info.denom);
+        return (ticks * timebase_info.numer) / (resolution * timebase_info.denom);
     }
 }
 
+} // namespace
+
+BOOST_LOG_API int64_t duration::milliseconds() const
+{
+    return convert_mach_time(m_ticks, 1000000LL);
+}
+
+BOOST_LOG_API int64_t duration::microseconds() const
+{
+    return convert_mach_time(m_ticks, 1000LL);
+}
+
 BOOST_LOG_ANONYMOUS_NAMESPACE {
 
 //! \c get_timestamp implementation based on MacOS X absolute time
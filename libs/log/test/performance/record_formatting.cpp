@@ -0,0 +1,129 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   record_formatting.cpp
+ * \author Andrey Semashev
+ * \date   21.06.2015
+ *
+ * \brief  This code measures performance of log record formatting
+ */
+
+#include <iomanip>
+#include <string>
+#include <iostream>
+#include <boost/move/utility.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/smart_ptr/make_shared_object.hpp>
+#include <boost/date_time/microsec_time_clock.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <boost/log/core.hpp>
+#include <boost/log/common.hpp>
+#include <boost/log/attributes.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include <boost/log/utility/setup/formatter_parser.hpp>
+
+namespace logging = boost::log;
+namespace expr = boost::log::expressions;
+namespace sinks = boost::log::sinks;
+namespace attrs = boost::log::attributes;
+namespace src = boost::log::sources;
+
+const unsigned int base_loop_count = 10000;
+
+namespace {
+
+    //! A fake sink backend that receives log records
+    class fake_backend :
+        public sinks::basic_sink_backend< sinks::synchronized_feeding >
+    {
+    public:
+        void consume(logging::record_view const& rec)
+        {
+        }
+    };
+
+} // namespace
+
+void test(const char* title, logging::formatter const& fmt, logging::record_view const& rec)
+{
+    std::cout << title << ".";
+
+    std::string str;
+    logging::formatting_ostream strm(str);
+
+    boost::uint64_t records_formatted = 0, duration = 0;
+    boost::posix_time::ptime start, end;
+    start = boost::date_time::microsec_clock< boost::posix_time::ptime >::universal_time();
+    do
+    {
+        for (unsigned int i = 0; i < base_loop_count; ++i)
+        {
+            fmt(rec, strm);
+            strm.flush();
+            str.clear();
+        }
+        end = boost::date_time::microsec_clock< boost::posix_time::ptime >::universal_time();
+        records_formatted += base_loop_count;
+        duration = (end - start).total_microseconds();
+    }
+    while (duration < 2000000);
+
+    std::cout << " Test duration: " << duration << " us ("
+        << std::fixed << std::setprecision(3) << static_cast< double >(records_formatted) / (static_cast< double >(duration) / 1000000.0)
+        << " records per second)" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    logging::core::get()->add_sink(boost::make_shared< sinks::synchronous_sink< fake_backend > >());
+    logging::core::get()->add_global_attribute("LineID", attrs::counter< unsigned int >(1));
+    logging::core::get()->add_global_attribute("TimeStamp", attrs::local_clock());
+    logging::core::get()->add_global_attribute("Scope", attrs::named_scope());
+
+    src::logger lg;
+    lg.add_attribute("Severity", attrs::constant< int >(3));
+    lg.add_attribute("Channel", attrs::constant< std::string >("net"));
+
+    logging::record rec = lg.open_record();
+    {
+        logging::record_ostream strm(rec);
+        strm << "Test record";
+    }
+    const logging::record_view rec_view = rec.lock();
+
+    test("Expression formatter",
+        expr::stream
+            << expr::attr< unsigned int >("LineID") << ": <"
+            << expr::attr< int >("Severity") << "> ["
+            << expr::attr< std::string >("Channel") << "] "
+            << expr::smessage,
+        rec_view);
+
+    test("Parsed formatter",
+        logging::parse_formatter("%LineID%: <%Severity%> [%Channel%] %Message%"),
+        rec_view);
+
+    test("Expression formatter with time stamp",
+        expr::stream
+            << expr::attr< unsigned int >("LineID") << ": ["
+            << expr::attr< boost::posix_time::ptime >("TimeStamp") << "] <"
+            << expr::attr< int >("Severity") << "> ["
+            << expr::attr< std::string >("Channel") << "] "
+            << expr::smessage,
+        rec_view);
+
+    test("Parsed formatter with time stamp",
+        logging::parse_formatter("%LineID%: [%TimeStamp%] <%Severity%> [%Channel%] %Message%"),
+        rec_view);
+
+    return 0;
+}
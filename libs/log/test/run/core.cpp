@@ -15,6 +15,7 @@
 #define BOOST_TEST_MODULE core
 
 #include <cstddef>
+#include <limits>
 #include <map>
 #include <string>
 #include <boost/smart_ptr/shared_ptr.hpp>
@@ -27,8 +28,14 @@
 #include <boost/log/expressions.hpp>
 #include <boost/log/sinks/sink.hpp>
 #include <boost/log/core/record.hpp>
+#include <boost/log/sources/severity_logger.hpp>
 #ifndef BOOST_LOG_NO_THREADS
+#include <boost/atomic/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #endif // BOOST_LOG_NO_THREADS
 #include "char_definitions.hpp"
 #include "test_sink.hpp"
@@ -37,6 +44,7 @@ namespace logging = boost::log;
 namespace attrs = logging::attributes;
 namespace sinks = logging::sinks;
 namespace expr = logging::expressions;
+namespace src = logging::sources;
 
 // The test checks that message filtering works
 BOOST_AUTO_TEST_CASE(filtering)
@@ -241,3 +249,258 @@ BOOST_AUTO_TEST_CASE(attributes)
     pCore->remove_thread_attribute(itThread);
     pCore->remove_sink(pSink);
 }
+
+// The test checks that the severity threshold discards records of severity loggers
+BOOST_AUTO_TEST_CASE(severity_threshold)
+{
+    typedef logging::core core;
+    typedef logging::record record_type;
+
+    boost::shared_ptr< core > pCore = core::get();
+    boost::shared_ptr< test_sink > pSink(new test_sink());
+    pCore->add_sink(pSink);
+
+    BOOST_CHECK_EQUAL(pCore->get_severity_threshold(), (std::numeric_limits< int >::min)());
+
+    src::severity_logger< int > lg;
+    pCore->set_severity_threshold(3);
+    BOOST_CHECK_EQUAL(pCore->get_severity_threshold(), 3);
+    {
+        record_type rec = lg.open_record(logging::keywords::severity = 2);
+        BOOST_CHECK(!rec);
+    }
+    {
+        record_type rec = lg.open_record(logging::keywords::severity = 3);
+        BOOST_REQUIRE(rec);
+        lg.push_record(boost::move(rec));
+        BOOST_CHECK_EQUAL(pSink->m_RecordCounter, 1UL);
+        pSink->clear();
+    }
+
+    // Records that do not come from severity loggers are not affected
+    {
+        record_type rec = pCore->open_record(logging::attribute_set());
+        BOOST_CHECK(rec);
+    }
+
+    pCore->reset_severity_threshold();
+    BOOST_CHECK_EQUAL(pCore->get_severity_threshold(), (std::numeric_limits< int >::min)());
+    {
+        record_type rec = lg.open_record(logging::keywords::severity = 2);
+        BOOST_CHECK(rec);
+    }
+
+    pCore->remove_sink(pSink);
+}
+
+// The test checks that module severity thresholds override the global threshold
+BOOST_AUTO_TEST_CASE(module_severity_threshold)
+{
+    typedef logging::core core;
+    typedef logging::record record_type;
+
+    boost::shared_ptr< core > pCore = core::get();
+
+    src::severity_logger< int > net_lg(logging::keywords::module = "net"), db_lg(logging::keywords::module = "db"), lg;
+
+    pCore->set_severity_threshold(3);
+    pCore->set_severity_threshold("net", 1);
+    BOOST_CHECK_EQUAL(pCore->get_severity_threshold("net"), 1);
+    BOOST_CHECK_EQUAL(pCore->get_severity_threshold("db"), 3);
+    BOOST_CHECK_EQUAL(pCore->get_severity_threshold("unknown"), 3);
+
+    BOOST_CHECK(!!net_lg.open_record(logging::keywords::severity = 2));
+    BOOST_CHECK(!net_lg.open_record(logging::keywords::severity = 0));
+    BOOST_CHECK(!db_lg.open_record(logging::keywords::severity = 2));
+    BOOST_CHECK(!lg.open_record(logging::keywords::severity = 2));
+
+    // Loggers of the modules without their own threshold follow the global threshold
+    pCore->set_severity_threshold(2);
+    BOOST_CHECK(!!db_lg.open_record(logging::keywords::severity = 2));
+    BOOST_CHECK(!net_lg.open_record(logging::keywords::severity = 0));
+
+    // The module threshold applies to the loggers constructed after it was set and to the copies
+    pCore->set_severity_threshold("db", 5);
+    src::severity_logger< int > db_lg2(logging::keywords::module = "db"), db_lg3(db_lg);
+    BOOST_CHECK(!db_lg.open_record(logging::keywords::severity = 4));
+    BOOST_CHECK(!db_lg2.open_record(logging::keywords::severity = 4));
+    BOOST_CHECK(!db_lg3.open_record(logging::keywords::severity = 4));
+    BOOST_CHECK(!!db_lg3.open_record(logging::keywords::severity = 5));
+
+    pCore->reset_severity_threshold("net");
+    BOOST_CHECK_EQUAL(pCore->get_severity_threshold("net"), 2);
+    BOOST_CHECK(!net_lg.open_record(logging::keywords::severity = 1));
+
+    pCore->reset_severity_threshold("db");
+    pCore->reset_severity_threshold();
+    BOOST_CHECK_EQUAL(pCore->get_severity_threshold("db"), (std::numeric_limits< int >::min)());
+    BOOST_CHECK(!!net_lg.open_record(logging::keywords::severity = 0));
+}
+
+#ifndef BOOST_LOG_NO_THREADS
+namespace {
+
+    //! The sink detects being queried after it has been removed from the core
+    struct reconfiguration_sink :
+        public sinks::sink
+    {
+        boost::atomic< bool > m_Removed;
+        boost::atomic< unsigned int > m_QueriedAfterRemoval;
+
+        reconfiguration_sink() : sinks::sink(true), m_Removed(false), m_QueriedAfterRemoval(0u) {}
+
+        bool will_consume(logging::attribute_value_set const&)
+        {
+            if (m_Removed.load(boost::memory_order_acquire))
+                m_QueriedAfterRemoval.fetch_add(1u, boost::memory_order_relaxed);
+            return true;
+        }
+        void consume(logging::record_view const&) {}
+        void flush() {}
+    };
+
+    //! A test routine that emits log records until stopped
+    void logging_thread(boost::atomic< bool >& stop)
+    {
+        typedef logging::core core;
+        typedef logging::record record_type;
+
+        boost::shared_ptr< core > pCore = core::get();
+        logging::attribute_set set1;
+        while (!stop.load(boost::memory_order_relaxed))
+        {
+            record_type rec = pCore->open_record(set1);
+            if (rec)
+                pCore->push_record(boost::move(rec));
+        }
+    }
+
+} // namespace
+
+// The test checks that the core can be reconfigured while other threads are logging
+BOOST_AUTO_TEST_CASE(concurrent_reconfiguration)
+{
+    typedef logging::core core;
+    typedef test_data< char > data;
+
+    boost::shared_ptr< core > pCore = core::get();
+    boost::atomic< bool > stop(false);
+
+    boost::thread_group threads;
+    for (unsigned int i = 0; i < 4; ++i)
+        threads.create_thread(boost::bind(&logging_thread, boost::ref(stop)));
+
+    unsigned int queried_after_removal = 0;
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        boost::shared_ptr< reconfiguration_sink > pSink(new reconfiguration_sink());
+        pCore->add_sink(pSink);
+        if ((i & 1u) != 0u)
+            pCore->set_filter(!expr::has_attr(data::attr1()));
+        else
+            pCore->reset_filter();
+        logging::attribute_set::iterator it = pCore->add_global_attribute(data::attr2(), attrs::constant< int >(i)).first;
+        pCore->remove_global_attribute(it);
+        pCore->remove_sink(pSink);
+        pSink->m_Removed.store(true, boost::memory_order_release);
+
+        // Let the logging threads run for a while to make sure the removed sink is not used anymore
+        boost::this_thread::yield();
+        queried_after_removal += pSink->m_QueriedAfterRemoval.load(boost::memory_order_relaxed);
+    }
+
+    stop.store(true, boost::memory_order_relaxed);
+    threads.join_all();
+    pCore->reset_filter();
+
+    BOOST_CHECK_EQUAL(queried_after_removal, 0u);
+}
+
+namespace {
+
+    //! The state shared between the threads of the filter reconfiguration test
+    struct filter_reconfiguration_state
+    {
+        boost::atomic< bool > m_Pinned;
+        boost::atomic< bool > m_Reconfigured;
+        boost::atomic< bool > m_FilterDone;
+
+        filter_reconfiguration_state() : m_Pinned(false), m_Reconfigured(false), m_FilterDone(false) {}
+    };
+
+    //! The filter reconfigures the core in one thread while the other thread keeps using the previous configuration
+    struct reconfiguring_filter
+    {
+        typedef bool result_type;
+
+        filter_reconfiguration_state* m_State;
+
+        explicit reconfiguring_filter(filter_reconfiguration_state& state) : m_State(&state) {}
+
+        bool operator() (logging::attribute_value_set const& values) const
+        {
+            typedef test_data< char > data;
+
+            logging::value_ref< int > role = logging::extract< int >(data::attr1(), values);
+            if (role == 1)
+            {
+                // Keep the configuration pinned while the other thread replaces it
+                m_State->m_Pinned.store(true, boost::memory_order_release);
+                while (!m_State->m_Reconfigured.load(boost::memory_order_acquire))
+                    boost::this_thread::yield();
+                boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+                m_State->m_FilterDone.store(true, boost::memory_order_release);
+            }
+            else if (role == 2)
+            {
+                while (!m_State->m_Pinned.load(boost::memory_order_acquire))
+                    boost::this_thread::yield();
+                logging::core::get()->add_global_attribute(data::attr3(), attrs::constant< int >(3));
+                m_State->m_Reconfigured.store(true, boost::memory_order_release);
+            }
+            return true;
+        }
+    };
+
+    //! The thread opens a record with the specified role
+    void open_record_with_role(int role)
+    {
+        typedef test_data< char > data;
+
+        logging::attribute_set set1;
+        set1[data::attr1()] = attrs::constant< int >(role);
+        logging::record rec = logging::core::get()->open_record(set1);
+    }
+
+} // namespace
+
+// The test checks that the configuration that is replaced from a filter is not destroyed while other threads use it
+BOOST_AUTO_TEST_CASE(filter_reconfiguration)
+{
+    typedef logging::core core;
+    typedef test_data< char > data;
+
+    boost::shared_ptr< core > pCore = core::get();
+    boost::shared_ptr< test_sink > pSink(new test_sink());
+    pCore->add_sink(pSink);
+
+    filter_reconfiguration_state state;
+    pCore->set_filter(reconfiguring_filter(state));
+
+    boost::thread pinning_thread(boost::bind(&open_record_with_role, 1));
+    open_record_with_role(2);
+
+    // The thread that replaced the configuration waits for the other thread to release the previous configuration
+    BOOST_CHECK(state.m_FilterDone.load(boost::memory_order_acquire));
+
+    pinning_thread.join();
+    pCore->reset_filter();
+    pCore->remove_sink(pSink);
+    logging::attribute_set globals = pCore->get_global_attributes();
+    logging::attribute_set::iterator it = globals.find(data::attr3());
+    if (it != globals.end())
+        globals.erase(it);
+    pCore->set_global_attributes(globals);
+}
+
+#endif // BOOST_LOG_NO_THREADS
@@ -0,0 +1,198 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   form_char_decor.cpp
+ * \author Andrey Semashev
+ * \date   25.07.2015
+ *
+ * \brief  This header contains tests for the character decorators.
+ */
+
+#define BOOST_TEST_MODULE form_char_decor
+
+#include <string>
+#include <boost/range/iterator_range_core.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/expressions/formatters/char_decorator.hpp>
+#include <boost/log/expressions/formatters/xml_decorator.hpp>
+#include <boost/log/expressions/formatters/csv_decorator.hpp>
+#include <boost/log/expressions/formatters/c_decorator.hpp>
+#include <boost/log/detail/char_search.hpp>
+#include <boost/log/core/record.hpp>
+#include "make_record.hpp"
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace expr = logging::expressions;
+
+namespace {
+
+//! Source patterns and replacements
+struct decorations
+{
+    const char* const* from;
+    const char* const* to;
+    std::size_t size;
+};
+
+//! Reference implementation that applies the replacements one after another
+std::string replace_sequentially(std::string str, std::string::size_type start_pos, decorations const& decors)
+{
+    for (std::size_t i = 0; i < decors.size; ++i)
+    {
+        const std::string from = decors.from[i], to = decors.to[i];
+        for (std::string::size_type pos = str.find(from, start_pos); pos != std::string::npos; pos = str.find(from, pos))
+        {
+            str.replace(pos, from.size(), to);
+            pos += to.size();
+        }
+    }
+    return str;
+}
+
+//! Generates a string of the specified length with the characters from the alphabet
+std::string make_string(std::size_t size, std::string const& alphabet, unsigned int& seed)
+{
+    std::string str;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        str.push_back(alphabet[(seed >> 16) % alphabet.size()]);
+    }
+    return str;
+}
+
+std::string format_decorated(logging::formatter const& fmt, std::string const& value)
+{
+    logging::attribute_set set;
+    set["S"] = attrs::constant< std::string >(value);
+    logging::record_view rec = make_record_view(set);
+
+    std::string str;
+    logging::formatting_ostream strm(str);
+    fmt(rec, strm);
+    strm.flush();
+    return str;
+}
+
+} // namespace
+
+// The test checks the character search in strings of different lengths and alignments
+BOOST_AUTO_TEST_CASE(char_search)
+{
+    logging::aux::char_search_set set;
+    const char chars[] = "&<>\"'\x01\xF0";
+    BOOST_REQUIRE(logging::aux::init_char_search_set(set, chars, sizeof(chars) - 1u));
+
+    for (unsigned int c = 0; c < 256u; ++c)
+        BOOST_CHECK_EQUAL(set.contains(c), std::string(chars).find(static_cast< char >(c)) != std::string::npos);
+
+    // More than 8 distinct high nibbles cannot be represented
+    const char wide_chars[] = "\x01\x11\x21\x31\x41\x51\x61\x71\x81";
+    BOOST_CHECK(!logging::aux::init_char_search_set(set, wide_chars, sizeof(wide_chars) - 1u));
+
+    BOOST_REQUIRE(logging::aux::init_char_search_set(set, chars, sizeof(chars) - 1u));
+    std::string str(200u, 'a');
+    for (std::size_t size = 0; size <= str.size(); ++size)
+    {
+        const char* const begin = str.data() + (size % 7u);
+        const char* const end = str.data() + size;
+        if (begin > end)
+            continue;
+
+        BOOST_CHECK(logging::aux::find_first_of_char(begin, end, set) == end);
+        for (const char* p = begin; p != end; ++p)
+        {
+            str[p - str.data()] = (p - begin) % 2u ? '\xF0' : '<';
+            BOOST_CHECK(logging::aux::find_first_of_char(begin, end, set) == p);
+            str[p - str.data()] = 'a';
+        }
+    }
+}
+
+// The test checks that single character replacements produce the same result as the sequential replacements
+BOOST_AUTO_TEST_CASE(single_char_replacement)
+{
+    static const char* const xml_from[] = { "&", "<", ">", "\"" };
+    static const char* const xml_to[] = { "&amp;", "&lt;", "&gt;", "&quot;" };
+    static const char* const c_from[] = { "\\", "\n", "\t" };
+    static const char* const c_to[] = { "\\\\", "\\n", "\\t" };
+    // The second replacement inserts a character that is replaced by the third one, this requires sequential replacement
+    static const char* const overlapping_from[] = { "a", "c", "d" };
+    static const char* const overlapping_to[] = { "b", "xd", "e" };
+    // Replacements that make the string shorter
+    static const char* const removal_from[] = { "x", "&" };
+    static const char* const removal_to[] = { "", "+" };
+    // Multi-character patterns are also replaced sequentially
+    static const char* const multichar_from[] = { "ab", "x" };
+    static const char* const multichar_to[] = { "x", "yy" };
+    // Replacements that make the string both longer and shorter
+    static const char* const mixed_from[] = { "x", "&", "<" };
+    static const char* const mixed_to1[] = { "12", "", "" };
+    static const char* const mixed_to2[] = { "", "", "12345" };
+
+    const decorations decors[] =
+    {
+        { xml_from, xml_to, 4u },
+        { c_from, c_to, 3u },
+        { overlapping_from, overlapping_to, 3u },
+        { removal_from, removal_to, 2u },
+        { multichar_from, multichar_to, 2u },
+        { mixed_from, mixed_to1, 3u },
+        { mixed_from, mixed_to2, 3u }
+    };
+
+    const std::string alphabet = "abcdx&<>\"\\\n\t\xE9";
+    unsigned int seed = 17u;
+    for (unsigned int i = 0; i < sizeof(decors) / sizeof(*decors); ++i)
+    {
+        expr::pattern_replacer< char > replacer(
+            boost::make_iterator_range(decors[i].from, decors[i].from + decors[i].size),
+            boost::make_iterator_range(decors[i].to, decors[i].to + decors[i].size));
+        for (std::size_t size = 0; size < 100u; ++size)
+        {
+            const std::string original = make_string(size, alphabet, seed);
+            const std::string::size_type start_pos = size / 3u;
+
+            std::string str = original;
+            replacer(str, start_pos);
+            BOOST_CHECK_EQUAL(str, replace_sequentially(original, start_pos, decors[i]));
+        }
+    }
+
+    {
+        expr::pattern_replacer< char > replacer(boost::make_iterator_range(mixed_from), boost::make_iterator_range(mixed_to1));
+        std::string str = "px&q<r";
+        replacer(str);
+        BOOST_CHECK_EQUAL(str, "p12qr");
+    }
+    {
+        expr::pattern_replacer< char > replacer(boost::make_iterator_range(mixed_from), boost::make_iterator_range(mixed_to2));
+        std::string str = "pxq&r<s";
+        replacer(str);
+        BOOST_CHECK_EQUAL(str, "pqr12345s");
+    }
+}
+
+// The test checks the predefined decorators
+BOOST_AUTO_TEST_CASE(predefined_decorators)
+{
+    const std::string value = "<a href=\"x\">Tom & Jerry's \"cartoon\"</a>\n\tSee also: c:\\temp?";
+
+    BOOST_CHECK_EQUAL(format_decorated(expr::stream << expr::xml_decor[ expr::stream << expr::attr< std::string >("S") ], value),
+        "&lt;a href=&quot;x&quot;&gt;Tom &amp; Jerry&apos;s &quot;cartoon&quot;&lt;/a&gt;\n\tSee also: c:\\temp?");
+    BOOST_CHECK_EQUAL(format_decorated(expr::stream << expr::csv_decor[ expr::stream << expr::attr< std::string >("S") ], value),
+        "<a href=\"\"x\"\">Tom & Jerry's \"\"cartoon\"\"</a>\n\tSee also: c:\\temp?");
+    BOOST_CHECK_EQUAL(format_decorated(expr::stream << expr::c_decor[ expr::stream << expr::attr< std::string >("S") ], value),
+        "<a href=\\\"x\\\">Tom & Jerry\\'s \\\"cartoon\\\"</a>\\n\\tSee also: c:\\\\temp\\?");
+    BOOST_CHECK_EQUAL(format_decorated(expr::stream << "[" << expr::c_ascii_decor[ expr::stream << expr::attr< std::string >("S") ] << "]", "caf\xE9\x01"),
+        "[caf\\xE9\\x01]");
+}
@@ -0,0 +1,269 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_batched_records.cpp
+ * \author Andrey Semashev
+ * \date   23.06.2015
+ *
+ * \brief  This header contains tests for feeding log records to sink backends in batches.
+ */
+
+#define BOOST_TEST_MODULE sink_batched_records
+
+#include <boost/log/detail/config.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <ostream>
+#include <streambuf>
+#include <stdexcept>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/attributes/counter.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/frontend_requirements.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/text_ostream_backend.hpp>
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace expr = logging::expressions;
+namespace src = logging::sources;
+namespace sinks = logging::sinks;
+
+namespace {
+
+const unsigned int record_count = 1000u;
+
+//! The backend saves the sequence numbers of the records passed in batches
+struct unformatted_backend :
+    public sinks::basic_sink_backend<
+        sinks::combine_requirements< sinks::synchronized_feeding, sinks::batched_records >::type
+    >
+{
+    std::vector< unsigned int > m_Records;
+    unsigned int m_Batches;
+    bool m_BatchesBounded;
+
+    unformatted_backend() : m_Batches(0u), m_BatchesBounded(true) {}
+
+    void consume(logging::record_view const& rec)
+    {
+        m_Records.push_back(logging::extract_or_default< unsigned int >("Seq", rec, 0u));
+    }
+
+    void consume_batch(std::vector< logging::record_view > const& records)
+    {
+        ++m_Batches;
+        if (records.empty() || records.size() > BOOST_LOG_ASYNC_SINK_MAX_BATCH_SIZE)
+            m_BatchesBounded = false;
+        for (std::vector< logging::record_view >::const_iterator it = records.begin(), end = records.end(); it != end; ++it)
+            m_Records.push_back(logging::extract_or_default< unsigned int >("Seq", *it, 0u));
+    }
+};
+
+//! The backend saves the formatted records passed in batches
+struct formatted_backend :
+    public sinks::basic_formatted_sink_backend<
+        char,
+        sinks::combine_requirements< sinks::synchronized_feeding, sinks::batched_records >::type
+    >
+{
+    std::vector< std::string > m_Messages;
+    unsigned int m_Batches;
+    bool m_Consistent;
+
+    formatted_backend() : m_Batches(0u), m_Consistent(true) {}
+
+    void consume(logging::record_view const&, string_type const& formatted_message)
+    {
+        m_Messages.push_back(formatted_message);
+    }
+
+    void consume_batch(std::vector< logging::record_view > const& records, std::vector< string_type > const& formatted_messages)
+    {
+        ++m_Batches;
+        if (records.size() != formatted_messages.size())
+            m_Consistent = false;
+        m_Messages.insert(m_Messages.end(), formatted_messages.begin(), formatted_messages.end());
+    }
+};
+
+//! The formatter fails on every tenth record
+struct failing_formatter
+{
+    typedef void result_type;
+
+    void operator() (logging::record_view const& rec, logging::formatting_ostream& strm) const
+    {
+        const unsigned int seq = logging::extract_or_default< unsigned int >("Seq", rec, 0u);
+        if (seq % 10u == 0u)
+            throw std::runtime_error("formatting failed");
+        strm << seq;
+    }
+};
+
+//! The stream buffer fails to write anything
+struct failing_streambuf :
+    public std::streambuf
+{
+};
+
+//! The exception handler counts the exceptions
+struct counting_handler
+{
+    typedef void result_type;
+
+    unsigned int* m_Count;
+
+    explicit counting_handler(unsigned int& count) : m_Count(&count) {}
+
+    void operator() () const
+    {
+        ++*m_Count;
+    }
+};
+
+void log_records()
+{
+    src::logger lg;
+    lg.add_attribute("Seq", attrs::counter< unsigned int >(0u));
+    for (unsigned int i = 0; i < record_count; ++i)
+    {
+        BOOST_LOG(lg) << "record";
+    }
+}
+
+template< typename SinkT >
+void log_and_flush(boost::shared_ptr< SinkT > const& sink)
+{
+    logging::core::get()->add_sink(sink);
+    log_records();
+    logging::core::get()->remove_sink(sink);
+    sink->flush();
+}
+
+} // namespace
+
+// The test checks that records are passed to backends in batches and in order
+BOOST_AUTO_TEST_CASE(unformatted_records)
+{
+    typedef sinks::asynchronous_sink< unformatted_backend > sink_t;
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >(false);
+
+    log_and_flush(sink);
+
+    sink_t::locked_backend_ptr backend = sink->locked_backend();
+    BOOST_REQUIRE_EQUAL(backend->m_Records.size(), record_count);
+    for (unsigned int i = 0; i < record_count; ++i)
+        BOOST_CHECK_EQUAL(backend->m_Records[i], i);
+    BOOST_CHECK(backend->m_BatchesBounded);
+    BOOST_CHECK(backend->m_Batches >= record_count / BOOST_LOG_ASYNC_SINK_MAX_BATCH_SIZE);
+}
+
+// The test checks that records are formatted before being passed in batches
+BOOST_AUTO_TEST_CASE(formatted_records)
+{
+    typedef sinks::asynchronous_sink< formatted_backend > sink_t;
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >();
+    sink->set_formatter(expr::stream << expr::attr< unsigned int >("Seq"));
+
+    log_and_flush(sink);
+    sink->stop();
+
+    sink_t::locked_backend_ptr backend = sink->locked_backend();
+    BOOST_CHECK(backend->m_Consistent);
+    BOOST_CHECK(backend->m_Batches > 0u);
+    BOOST_REQUIRE_EQUAL(backend->m_Messages.size(), record_count);
+    for (unsigned int i = 0; i < record_count; ++i)
+    {
+        std::ostringstream strm;
+        strm << i;
+        BOOST_CHECK_EQUAL(backend->m_Messages[i], strm.str());
+    }
+}
+
+// The test checks that records that fail to be formatted are removed from the batch
+BOOST_AUTO_TEST_CASE(formatting_errors)
+{
+    typedef sinks::asynchronous_sink< formatted_backend > sink_t;
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >(false);
+    sink->set_formatter(failing_formatter());
+    unsigned int error_count = 0;
+    sink->set_exception_handler(counting_handler(error_count));
+
+    log_and_flush(sink);
+
+    BOOST_CHECK_EQUAL(error_count, record_count / 10u);
+    sink_t::locked_backend_ptr backend = sink->locked_backend();
+    BOOST_CHECK(backend->m_Consistent);
+    BOOST_REQUIRE_EQUAL(backend->m_Messages.size(), record_count - record_count / 10u);
+    BOOST_CHECK_EQUAL(backend->m_Messages[0], "1");
+    BOOST_CHECK_EQUAL(backend->m_Messages[9], "11");
+}
+
+// The test checks that the text stream backend writes batches
+BOOST_AUTO_TEST_CASE(text_ostream_backend)
+{
+    typedef sinks::asynchronous_sink< sinks::text_ostream_backend > sink_t;
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >(false);
+    boost::shared_ptr< std::ostringstream > strm = boost::make_shared< std::ostringstream >();
+    sink->locked_backend()->add_stream(strm);
+    sink->locked_backend()->auto_flush(true);
+    sink->set_formatter(expr::stream << expr::attr< unsigned int >("Seq"));
+
+    log_and_flush(sink);
+
+    std::ostringstream expected;
+    for (unsigned int i = 0; i < record_count; ++i)
+        expected << i << '\n';
+    BOOST_CHECK(strm->str() == expected.str());
+}
+
+// The test checks that a failing stream does not prevent other streams from receiving the batch
+BOOST_AUTO_TEST_CASE(text_ostream_backend_errors)
+{
+    typedef sinks::asynchronous_sink< sinks::text_ostream_backend > sink_t;
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >(false);
+    failing_streambuf buf;
+    boost::shared_ptr< std::ostream > failing_strm = boost::make_shared< std::ostream >(&buf);
+    failing_strm->exceptions(std::ios_base::badbit);
+    boost::shared_ptr< std::ostringstream > strm = boost::make_shared< std::ostringstream >();
+    sink->locked_backend()->add_stream(failing_strm);
+    sink->locked_backend()->add_stream(strm);
+    sink->set_formatter(expr::stream << expr::attr< unsigned int >("Seq"));
+    unsigned int error_count = 0;
+    sink->set_exception_handler(counting_handler(error_count));
+
+    log_and_flush(sink);
+
+    // The failing stream throws once, then it remains in the failed state and is skipped
+    BOOST_CHECK_EQUAL(error_count, 1u);
+    std::ostringstream expected;
+    for (unsigned int i = 0; i < record_count; ++i)
+        expected << i << '\n';
+    BOOST_CHECK(strm->str() == expected.str());
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+int main(int, char*[])
+{
+    return 0;
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -0,0 +1,171 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_per_thread_fifo_queue.cpp
+ * \author Andrey Semashev
+ * \date   21.06.2015
+ *
+ * \brief  This header contains tests for the per-thread FIFO queueing strategy of the asynchronous sink frontend.
+ */
+
+#define BOOST_TEST_MODULE sink_per_thread_fifo_queue
+
+#include <boost/log/detail/config.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <cstddef>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/counter.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/per_thread_fifo_queue.hpp>
+#include <boost/log/sinks/block_on_overflow.hpp>
+#include <boost/log/sinks/drop_on_overflow.hpp>
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace src = logging::sources;
+namespace sinks = logging::sinks;
+
+namespace {
+
+const unsigned int thread_count = 8u;
+const unsigned int record_count = 2000u;
+
+//! The backend checks that the records of every thread arrive in order
+struct ordering_backend :
+    public sinks::basic_sink_backend< sinks::synchronized_feeding >
+{
+    std::vector< unsigned int > m_NextSeq;
+    unsigned int m_Consumed;
+    bool m_Ordered;
+
+    ordering_backend() : m_NextSeq(thread_count, 0u), m_Consumed(0u), m_Ordered(true) {}
+
+    void consume(logging::record_view const& rec)
+    {
+        const unsigned int thread = logging::extract_or_default< unsigned int >("Thread", rec, 0u);
+        const unsigned int seq = logging::extract_or_default< unsigned int >("Seq", rec, 0u);
+        if (thread >= thread_count || seq < m_NextSeq[thread])
+            m_Ordered = false;
+        else
+            m_NextSeq[thread] = seq + 1u;
+        ++m_Consumed;
+    }
+};
+
+void log_records(unsigned int thread, boost::barrier& start)
+{
+    src::logger lg;
+    lg.add_attribute("Thread", attrs::constant< unsigned int >(thread));
+    lg.add_attribute("Seq", attrs::counter< unsigned int >(0u));
+
+    start.wait();
+    for (unsigned int i = 0; i < record_count; ++i)
+    {
+        BOOST_LOG(lg) << "record";
+    }
+}
+
+template< typename SinkT >
+void run_producers(boost::shared_ptr< SinkT > const& sink)
+{
+    logging::core::get()->add_sink(sink);
+
+    boost::barrier start(thread_count);
+    boost::thread_group threads;
+    for (unsigned int i = 0; i < thread_count; ++i)
+        threads.create_thread(boost::bind(&log_records, i, boost::ref(start)));
+    threads.join_all();
+
+    logging::core::get()->remove_sink(sink);
+    sink->stop();
+    sink->flush();
+}
+
+} // namespace
+
+// The test checks that no records are lost when the producers are blocked on overflow
+BOOST_AUTO_TEST_CASE(block_on_overflow)
+{
+    typedef sinks::asynchronous_sink<
+        ordering_backend,
+        sinks::per_thread_fifo_queue< 16u, sinks::block_on_overflow >
+    > sink_t;
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >();
+
+    run_producers(sink);
+
+    sink_t::locked_backend_ptr backend = sink->locked_backend();
+    BOOST_CHECK(backend->m_Ordered);
+    BOOST_CHECK_EQUAL(backend->m_Consumed, thread_count * record_count);
+}
+
+// The test checks that the records are dropped on overflow without breaking the order
+BOOST_AUTO_TEST_CASE(drop_on_overflow)
+{
+    typedef sinks::asynchronous_sink<
+        ordering_backend,
+        sinks::per_thread_fifo_queue< 4u, sinks::drop_on_overflow >
+    > sink_t;
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >();
+
+    run_producers(sink);
+
+    sink_t::locked_backend_ptr backend = sink->locked_backend();
+    BOOST_CHECK(backend->m_Ordered);
+    BOOST_CHECK(backend->m_Consumed > 0u);
+    BOOST_CHECK(backend->m_Consumed <= thread_count * record_count);
+}
+
+// The test checks that the records are fed to the backend when the sink is flushed without a dedicated thread
+BOOST_AUTO_TEST_CASE(manual_feeding)
+{
+    typedef sinks::asynchronous_sink<
+        ordering_backend,
+        sinks::per_thread_fifo_queue< 1024u, sinks::block_on_overflow >
+    > sink_t;
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >(false);
+    logging::core::get()->add_sink(sink);
+
+    src::logger lg;
+    lg.add_attribute("Thread", attrs::constant< unsigned int >(0u));
+    lg.add_attribute("Seq", attrs::counter< unsigned int >(0u));
+    for (unsigned int i = 0; i < 100u; ++i)
+    {
+        BOOST_LOG(lg) << "record";
+    }
+
+    logging::core::get()->remove_sink(sink);
+    sink->flush();
+
+    sink_t::locked_backend_ptr backend = sink->locked_backend();
+    BOOST_CHECK(backend->m_Ordered);
+    BOOST_CHECK_EQUAL(backend->m_Consumed, 100u);
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+int main(int, char*[])
+{
+    return 0;
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
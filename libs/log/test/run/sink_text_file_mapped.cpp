@@ -0,0 +1,163 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_text_file_mapped.cpp
+ * \author Andrey Semashev
+ * \date   19.06.2015
+ *
+ * \brief  This header contains tests for the memory mapped mode and rotated file compression of the text file sink backend.
+ */
+
+#define BOOST_TEST_MODULE sink_text_file_mapped
+
+#include <string>
+#include <sstream>
+#include <iterator>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/sinks/text_file_backend.hpp>
+
+namespace logging = boost::log;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+namespace fs = boost::filesystem;
+
+namespace {
+
+//! The fixture creates a temporary directory for the log files
+struct temp_directory
+{
+    fs::path m_Path;
+
+    temp_directory() : m_Path(fs::temp_directory_path() / fs::unique_path())
+    {
+        fs::create_directories(m_Path);
+    }
+    ~temp_directory()
+    {
+        boost::system::error_code ec;
+        fs::remove_all(m_Path, ec);
+    }
+};
+
+std::string read_file(fs::path const& name)
+{
+    fs::ifstream file(name, std::ios_base::in | std::ios_base::binary);
+    return std::string((std::istreambuf_iterator< char >(file)), std::istreambuf_iterator< char >());
+}
+
+void write_header(std::ostream& strm)
+{
+    strm << "header\n";
+}
+
+void write_footer(std::ostream& strm)
+{
+    strm << "footer\n";
+}
+
+//! The compressor renames the rotated file
+struct renaming_compressor
+{
+    typedef fs::path result_type;
+
+    unsigned int& m_Count;
+
+    explicit renaming_compressor(unsigned int& count) : m_Count(count) {}
+
+    fs::path operator() (fs::path const& name) const
+    {
+        ++m_Count;
+        fs::path compressed_name = name;
+        compressed_name += ".z";
+        fs::rename(name, compressed_name);
+        return compressed_name;
+    }
+};
+
+} // namespace
+
+// The test checks that the records written through memory mapping span across the mapped chunks
+BOOST_AUTO_TEST_CASE(mapped_writing)
+{
+    temp_directory dir;
+    const fs::path file_name = dir.m_Path / "mapped.log";
+
+    std::string expected = "header\n";
+    {
+        sinks::text_file_backend backend(
+            keywords::file_name = file_name,
+            keywords::mapping_chunk_size = 1u);
+        backend.set_open_handler(&write_header);
+        backend.set_close_handler(&write_footer);
+
+        for (unsigned int i = 0; i < 10000u; ++i)
+        {
+            std::ostringstream strm;
+            strm << "Record " << i;
+            backend.consume(logging::record_view(), strm.str());
+            expected += strm.str();
+            expected += '\n';
+        }
+        backend.flush();
+    }
+    expected += "footer\n";
+
+    // The preallocated space must be truncated when the file is closed
+    BOOST_CHECK_EQUAL(fs::file_size(file_name), expected.size());
+    BOOST_CHECK(read_file(file_name) == expected);
+}
+
+// The test checks that the trailing zero bytes left after a crash are removed when the file is appended
+BOOST_AUTO_TEST_CASE(crash_recovery)
+{
+    temp_directory dir;
+    const fs::path file_name = dir.m_Path / "recovered.log";
+    {
+        fs::ofstream file(file_name, std::ios_base::out | std::ios_base::binary);
+        file << "abc\n";
+        file << std::string(10000u, '\0');
+    }
+
+    {
+        sinks::text_file_backend backend(
+            keywords::file_name = file_name,
+            keywords::open_mode = std::ios_base::out | std::ios_base::app,
+            keywords::mapping_chunk_size = 65536u);
+        backend.consume(logging::record_view(), "def");
+    }
+
+    BOOST_CHECK(read_file(file_name) == "abc\ndef\n");
+}
+
+// The test checks that the rotated files are compressed before being passed to the file collector
+BOOST_AUTO_TEST_CASE(rotated_file_compression)
+{
+    temp_directory dir;
+    const fs::path target_dir = dir.m_Path / "target";
+
+    unsigned int compressed_count = 0;
+    {
+        sinks::text_file_backend backend(keywords::file_name = dir.m_Path / "file_%N.log");
+        backend.set_file_collector(sinks::file::make_collector(keywords::target = target_dir));
+        backend.set_file_compressor(renaming_compressor(compressed_count));
+
+        backend.consume(logging::record_view(), "first");
+        backend.rotate_file();
+        backend.consume(logging::record_view(), "second");
+    }
+
+    BOOST_CHECK_EQUAL(compressed_count, 2u);
+    BOOST_CHECK(read_file(target_dir / "file_0.log.z") == "first\n");
+    BOOST_CHECK(read_file(target_dir / "file_1.log.z") == "second\n");
+    BOOST_CHECK(!fs::exists(target_dir / "file_0.log"));
+}
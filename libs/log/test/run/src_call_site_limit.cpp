@@ -0,0 +1,233 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   src_call_site_limit.cpp
+ * \author Andrey Semashev
+ * \date   18.07.2015
+ *
+ * \brief  This header contains tests for the rate limiting and sampling logger feature.
+ */
+
+#define BOOST_TEST_MODULE src_call_site_limit
+
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/sinks/sink.hpp>
+#include <boost/log/sources/features.hpp>
+#include <boost/log/sources/basic_logger.hpp>
+#include <boost/log/sources/severity_feature.hpp>
+#include <boost/log/sources/call_site_limit_feature.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/sources/threading_models.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#endif
+
+namespace logging = boost::log;
+namespace src = logging::sources;
+namespace expr = logging::expressions;
+
+namespace {
+
+//! The logger with the call site limiting feature
+class limited_logger :
+    public src::basic_composite_logger<
+        char,
+        limited_logger,
+        src::single_thread_model,
+        src::features< src::call_site_limit, src::severity< int > >
+    >
+{
+    BOOST_LOG_FORWARD_LOGGER_MEMBERS(limited_logger)
+};
+
+//! The sink saves the messages and the numbers of suppressed records
+struct message_sink :
+    public logging::sinks::sink
+{
+    std::vector< std::string > m_Messages;
+    std::vector< uintmax_t > m_Suppressed;
+
+    message_sink() : logging::sinks::sink(false) {}
+
+    bool will_consume(logging::attribute_value_set const&) { return true; }
+
+    void consume(logging::record_view const& rec)
+    {
+        m_Messages.push_back(logging::extract_or_default< std::string >(expr::tag::message::get_name(), rec, std::string()));
+        m_Suppressed.push_back(logging::extract_or_default< uintmax_t >("Suppressed", rec, static_cast< uintmax_t >(0u)));
+    }
+
+    void flush() {}
+};
+
+//! The guard registers the sink in the logging core
+struct sink_guard
+{
+    boost::shared_ptr< message_sink > m_Sink;
+
+    sink_guard() : m_Sink(boost::make_shared< message_sink >())
+    {
+        logging::core::get()->add_sink(m_Sink);
+    }
+    ~sink_guard()
+    {
+        logging::core::get()->remove_sink(m_Sink);
+        logging::core::get()->reset_filter();
+    }
+};
+
+void rate_limited_statement(limited_logger& lg, int n)
+{
+    BOOST_LOG_SEV_RATE_LIMITED(lg, 1, 1000.0, 1) << "rate " << n;
+}
+
+void sampled_statement(limited_logger& lg, double probability)
+{
+    BOOST_LOG_SAMPLED(lg, probability) << "sampled";
+}
+
+void sleep_ms(unsigned int ms)
+{
+#if !defined(BOOST_LOG_NO_THREADS)
+    boost::this_thread::sleep(boost::posix_time::milliseconds(ms));
+#endif
+}
+
+} // namespace
+
+// The test checks the token bucket rate limit
+BOOST_AUTO_TEST_CASE(rate_limit_bucket)
+{
+    src::rate_limit limit(1.0, 3);
+    BOOST_CHECK(limit.admit());
+    BOOST_CHECK(limit.admit());
+    BOOST_CHECK(limit.admit());
+    BOOST_CHECK(!limit.admit());
+    BOOST_CHECK(!limit.admit());
+    BOOST_CHECK_EQUAL(limit.take_suppressed_count(), 2u);
+    BOOST_CHECK_EQUAL(limit.take_suppressed_count(), 0u);
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    src::rate_limit fast_limit(200.0);
+    BOOST_CHECK(fast_limit.admit());
+    BOOST_CHECK(!fast_limit.admit());
+    sleep_ms(20);
+    BOOST_CHECK(fast_limit.admit());
+#endif
+}
+
+// The test checks that records are suppressed by the rate limit and the suppressed count is attached to the next record
+BOOST_AUTO_TEST_CASE(rate_limited_logging)
+{
+    sink_guard guard;
+    limited_logger lg;
+
+    for (int i = 0; i < 10; ++i)
+        rate_limited_statement(lg, i);
+
+    std::vector< std::string > const& msgs = guard.m_Sink->m_Messages;
+    BOOST_REQUIRE_EQUAL(msgs.size(), 1u);
+    BOOST_CHECK_EQUAL(msgs[0], "rate 0");
+    BOOST_CHECK_EQUAL(guard.m_Sink->m_Suppressed[0], 0u);
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    sleep_ms(20);
+    rate_limited_statement(lg, 10);
+
+    BOOST_REQUIRE_EQUAL(msgs.size(), 2u);
+    BOOST_CHECK_EQUAL(msgs[1], "rate 10");
+    BOOST_CHECK_EQUAL(guard.m_Sink->m_Suppressed[1], 9u);
+#endif
+}
+
+// The test checks that different logging statements have independent limits and unlimited statements are not affected
+BOOST_AUTO_TEST_CASE(independent_call_sites)
+{
+    sink_guard guard;
+    limited_logger lg;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        BOOST_LOG_RATE_LIMITED(lg, 0.001, 1) << "first";
+        BOOST_LOG_SEV_RATE_LIMITED(lg, 2, 0.001, 2) << "second";
+        BOOST_LOG_SEV(lg, 3) << "unlimited";
+    }
+
+    std::vector< std::string > const& msgs = guard.m_Sink->m_Messages;
+    BOOST_REQUIRE_EQUAL(msgs.size(), 8u);
+    BOOST_CHECK_EQUAL(msgs[0], "first");
+    BOOST_CHECK_EQUAL(msgs[1], "second");
+    BOOST_CHECK_EQUAL(msgs[2], "unlimited");
+    BOOST_CHECK_EQUAL(msgs[3], "second");
+    BOOST_CHECK_EQUAL(msgs[4], "unlimited");
+    BOOST_CHECK_EQUAL(msgs[5], "unlimited");
+}
+
+// The test checks that the limit is applied before filtering
+BOOST_AUTO_TEST_CASE(filtered_records)
+{
+    sink_guard guard;
+    limited_logger lg;
+    logging::core::get()->set_filter(expr::attr< int >("Severity") >= 2);
+
+    src::rate_limit limit(0.001, 2);
+    BOOST_LOG_STREAM_WITH_PARAMS(lg, (logging::keywords::severity = 1)(logging::keywords::call_site_limit = limit)) << "filtered";
+    BOOST_LOG_STREAM_WITH_PARAMS(lg, (logging::keywords::severity = 2)(logging::keywords::call_site_limit = limit)) << "passed";
+    BOOST_LOG_STREAM_WITH_PARAMS(lg, (logging::keywords::severity = 2)(logging::keywords::call_site_limit = limit)) << "suppressed";
+
+    std::vector< std::string > const& msgs = guard.m_Sink->m_Messages;
+    BOOST_REQUIRE_EQUAL(msgs.size(), 1u);
+    BOOST_CHECK_EQUAL(msgs[0], "passed");
+    BOOST_CHECK_EQUAL(limit.take_suppressed_count(), 1u);
+
+    src::sampling_limit none(0.0);
+    for (int i = 0; i < 3; ++i)
+    {
+        BOOST_LOG_STREAM_WITH_PARAMS(lg, (logging::keywords::severity = 2)(logging::keywords::call_site_limit = none)) << "never";
+    }
+    BOOST_CHECK_EQUAL(msgs.size(), 1u);
+    BOOST_CHECK_EQUAL(none.take_suppressed_count(), 3u);
+}
+
+// The test checks probabilistic sampling
+BOOST_AUTO_TEST_CASE(sampled_logging)
+{
+    sink_guard guard;
+    limited_logger lg;
+
+    const unsigned int count = 10000u;
+    for (unsigned int i = 0; i < count; ++i)
+        sampled_statement(lg, 0.25);
+
+    std::vector< std::string > const& msgs = guard.m_Sink->m_Messages;
+    BOOST_CHECK_GT(msgs.size(), count / 5u);
+    BOOST_CHECK_LT(msgs.size(), count * 3u / 10u);
+
+    // The suppressed counts of all records add up to the total number of suppressed records
+    uintmax_t suppressed = 0u;
+    for (std::size_t i = 0; i < guard.m_Sink->m_Suppressed.size(); ++i)
+        suppressed += guard.m_Sink->m_Suppressed[i];
+    BOOST_CHECK_LE(msgs.size() + suppressed, count);
+    BOOST_CHECK_GE(msgs.size() + suppressed + 100u, count);
+
+    src::sampling_limit all(1.0), none(0.0);
+    for (unsigned int i = 0; i < 1000u; ++i)
+    {
+        BOOST_CHECK(all.admit());
+        BOOST_CHECK(!none.admit());
+    }
+}
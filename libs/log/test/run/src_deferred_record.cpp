@@ -0,0 +1,243 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   src_deferred_record.cpp
+ * \author Andrey Semashev
+ * \date   14.06.2015
+ *
+ * \brief  This header contains tests for log records with deferred message formatting.
+ */
+
+#define BOOST_TEST_MODULE src_deferred_record
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/sinks/sink.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sources/severity_logger.hpp>
+#include <boost/log/sources/deferred_record.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/attributes/value_visitation.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include <boost/log/utility/deferred_message.hpp>
+#include <boost/log/utility/string_literal.hpp>
+
+namespace logging = boost::log;
+namespace src = logging::sources;
+namespace expr = logging::expressions;
+
+namespace {
+
+//! The sink formats and saves the messages of the consumed records
+template< typename CharT >
+struct message_sink :
+    public logging::sinks::sink
+{
+    typedef std::basic_string< CharT > string_type;
+
+    std::vector< string_type > m_Messages;
+
+    message_sink() : logging::sinks::sink(false) {}
+
+    bool will_consume(logging::attribute_value_set const&) { return true; }
+
+    void consume(logging::record_view const& rec)
+    {
+        string_type str;
+        logging::basic_formatting_ostream< CharT > strm(str);
+        logging::basic_formatter< CharT > f = expr::stream << expr::message;
+        f(rec, strm);
+        strm.flush();
+        m_Messages.push_back(str);
+    }
+
+    void flush() {}
+};
+
+//! The guard registers the sink in the logging core
+template< typename CharT >
+struct sink_guard
+{
+    boost::shared_ptr< message_sink< CharT > > m_Sink;
+
+    sink_guard() : m_Sink(boost::make_shared< message_sink< CharT > >())
+    {
+        logging::core::get()->add_sink(m_Sink);
+    }
+    ~sink_guard()
+    {
+        logging::core::get()->remove_sink(m_Sink);
+        logging::core::get()->reset_filter();
+    }
+};
+
+//! A type that is not captured by copying
+struct point
+{
+    int x, y;
+};
+
+template< typename CharT, typename TraitsT >
+inline std::basic_ostream< CharT, TraitsT >& operator<< (std::basic_ostream< CharT, TraitsT >& strm, point const& p)
+{
+    strm << p.x << ':' << p.y;
+    return strm;
+}
+
+enum color { red, green };
+
+unsigned int g_EvaluationCount = 0;
+
+int evaluate(int n)
+{
+    ++g_EvaluationCount;
+    return n;
+}
+
+//! The visitor checks the raw deferred message
+struct raw_message_checker
+{
+    typedef void result_type;
+
+    const char* m_Format;
+    bool& m_Visited;
+
+    raw_message_checker(const char* fmt, bool& visited) : m_Format(fmt), m_Visited(visited) {}
+
+    void operator() (logging::deferred_message const& msg) const
+    {
+        m_Visited = true;
+        BOOST_CHECK(msg.format() == m_Format);
+        BOOST_CHECK_EQUAL(msg.format_size(), std::char_traits< char >::length(m_Format));
+        BOOST_CHECK(msg.size() > 0u);
+        BOOST_CHECK_EQUAL(msg.str(), std::string("x = 7"));
+    }
+};
+
+//! The sink checks the raw deferred message
+struct raw_sink :
+    public logging::sinks::sink
+{
+    const char* m_Format;
+    bool m_Visited;
+    std::string m_Text;
+
+    explicit raw_sink(const char* fmt) : logging::sinks::sink(false), m_Format(fmt), m_Visited(false) {}
+
+    bool will_consume(logging::attribute_value_set const&) { return true; }
+
+    void consume(logging::record_view const& rec)
+    {
+        logging::visit< logging::deferred_message >(expr::tag::message::get_name(), rec, raw_message_checker(m_Format, m_Visited));
+        // The value is also available as a string
+        m_Text = logging::extract_or_default< std::string >(expr::tag::message::get_name(), rec, std::string());
+    }
+
+    void flush() {}
+};
+
+} // namespace
+
+// The test checks that the arguments are captured and formatted according to the format string
+BOOST_AUTO_TEST_CASE(narrow_formatting)
+{
+    sink_guard< char > guard;
+    src::logger lg;
+
+    const std::string str = "abc";
+    const char* cstr = "def";
+    BOOST_LOG_DEFERRED(lg, "int %1%, str %2%, cstr %3%, dbl %4%, chr %5%") % 10 % str % cstr % 1.5 % 'z';
+    BOOST_LOG_DEFERRED(lg, "%2% %1%%% %3%") % "a" % logging::str_literal("b");
+    BOOST_LOG_DEFERRED(lg, "no arguments");
+    BOOST_LOG_DEFERRED(lg, "enum %1%, ignored") % green % 5;
+
+    std::vector< std::string > const& msgs = guard.m_Sink->m_Messages;
+    BOOST_REQUIRE_EQUAL(msgs.size(), 4u);
+    BOOST_CHECK_EQUAL(msgs[0], "int 10, str abc, cstr def, dbl 1.5, chr z");
+    BOOST_CHECK_EQUAL(msgs[1], "b a% ");
+    BOOST_CHECK_EQUAL(msgs[2], "no arguments");
+    BOOST_CHECK_EQUAL(msgs[3], "enum 1, ignored");
+}
+
+// The test checks that the arguments that cannot be copied are formatted when captured
+BOOST_AUTO_TEST_CASE(eager_formatting)
+{
+    sink_guard< char > guard;
+    src::logger lg;
+
+    point p = { 1, 2 };
+    std::string str = "before";
+    {
+        logging::record rec = lg.open_record();
+        BOOST_REQUIRE(!!rec);
+        logging::aux::make_deferred_record_pump(lg, rec, "%1% %2%") % p % str;
+    }
+    p.x = 10;
+    str = "after";
+
+    std::vector< std::string > const& msgs = guard.m_Sink->m_Messages;
+    BOOST_REQUIRE_EQUAL(msgs.size(), 1u);
+    BOOST_CHECK_EQUAL(msgs[0], "1:2 before");
+}
+
+// The test checks that arguments are not evaluated if the record is filtered out
+BOOST_AUTO_TEST_CASE(filtering)
+{
+    sink_guard< char > guard;
+    src::severity_logger< int > lg;
+    logging::core::get()->set_filter(expr::attr< int >("Severity") >= 2);
+
+    g_EvaluationCount = 0;
+    BOOST_LOG_DEFERRED_SEV(lg, 1, "value %1%") % evaluate(1);
+    BOOST_LOG_DEFERRED_SEV(lg, 3, "value %1%") % evaluate(3);
+
+    BOOST_CHECK_EQUAL(g_EvaluationCount, 1u);
+    std::vector< std::string > const& msgs = guard.m_Sink->m_Messages;
+    BOOST_REQUIRE_EQUAL(msgs.size(), 1u);
+    BOOST_CHECK_EQUAL(msgs[0], "value 3");
+}
+
+// The test checks that sinks are able to access the raw message
+BOOST_AUTO_TEST_CASE(raw_message_access)
+{
+    static const char fmt[] = "x = %1%";
+    boost::shared_ptr< raw_sink > sink = boost::make_shared< raw_sink >(fmt);
+    logging::core::get()->add_sink(sink);
+
+    src::logger lg;
+    BOOST_LOG_DEFERRED(lg, fmt) % 7;
+
+    logging::core::get()->remove_sink(sink);
+
+    BOOST_CHECK(sink->m_Visited);
+    BOOST_CHECK_EQUAL(sink->m_Text, "x = 7");
+}
+
+#ifdef BOOST_LOG_USE_WCHAR_T
+
+// The test checks that wide-character messages are supported
+BOOST_AUTO_TEST_CASE(wide_formatting)
+{
+    sink_guard< wchar_t > guard;
+    src::wlogger lg;
+
+    const std::wstring str = L"abc";
+    BOOST_LOG_DEFERRED(lg, L"int %1%, str %2%, cstr %3%") % 10 % str % L"def";
+
+    std::vector< std::wstring > const& msgs = guard.m_Sink->m_Messages;
+    BOOST_REQUIRE_EQUAL(msgs.size(), 1u);
+    BOOST_CHECK(msgs[0] == L"int 10, str abc, cstr def");
+}
+
+#endif // BOOST_LOG_USE_WCHAR_T
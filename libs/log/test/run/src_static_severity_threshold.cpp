@@ -0,0 +1,151 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   src_static_severity_threshold.cpp
+ * \author Andrey Semashev
+ * \date   16.08.2015
+ *
+ * \brief  This header contains tests for the compile-time severity threshold.
+ */
+
+#define BOOST_TEST_MODULE src_static_severity_threshold
+
+#define BOOST_LOG_STATIC_SEVERITY_THRESHOLD 2
+
+#include <string>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/sources/severity_logger.hpp>
+#include <boost/log/sources/severity_channel_logger.hpp>
+#include <boost/log/sources/call_site_limit_feature.hpp>
+#include <boost/log/sources/deferred_record.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/trivial.hpp>
+#include "test_sink.hpp"
+
+namespace logging = boost::log;
+namespace src = logging::sources;
+
+namespace {
+
+//! The function counts its calls
+int counted(int& count)
+{
+    return ++count;
+}
+
+//! The function counts its calls and returns the level
+int counted_level(int& count, int level)
+{
+    ++count;
+    return level;
+}
+
+//! Severity level type that is not implicitly convertible to int
+class custom_level
+{
+private:
+    int m_value;
+
+public:
+    custom_level() : m_value(0) {}
+    explicit custom_level(int value) : m_value(value) {}
+
+    friend bool operator< (custom_level const& left, custom_level const& right)
+    {
+        return left.m_value < right.m_value;
+    }
+};
+
+} // namespace
+
+// The test checks that the statements below the threshold are not executed
+BOOST_AUTO_TEST_CASE(disabled_statements)
+{
+    boost::shared_ptr< test_sink > pSink(new test_sink());
+    logging::core::get()->add_sink(pSink);
+
+    src::severity_logger< int > lg;
+    src::severity_channel_logger< int > chan_lg;
+
+    int count = 0;
+    BOOST_LOG_SEV(lg, 1) << counted(count);
+    BOOST_LOG_CHANNEL_SEV(chan_lg, "net", 0) << counted(count);
+    BOOST_LOG_SEV_RATE_LIMITED(lg, 1, 1000.0, 10) << counted(count);
+    BOOST_LOG_DEFERRED_SEV(lg, 1, "%1%") % counted(count);
+    BOOST_LOG_TRIVIAL(debug) << counted(count);
+    BOOST_CHECK_EQUAL(count, 0);
+    BOOST_CHECK_EQUAL(pSink->m_RecordCounter, 0UL);
+
+    BOOST_LOG_SEV(lg, 2) << counted(count);
+    BOOST_LOG_CHANNEL_SEV(chan_lg, "net", 3) << counted(count);
+    BOOST_LOG_SEV_RATE_LIMITED(lg, 2, 1000.0, 10) << counted(count);
+    BOOST_LOG_DEFERRED_SEV(lg, 2, "%1%") % counted(count);
+    BOOST_LOG_TRIVIAL(info) << counted(count);
+    BOOST_CHECK_EQUAL(count, 5);
+    BOOST_CHECK_EQUAL(pSink->m_RecordCounter, 5UL);
+
+    // The levels that are not known at compile time are also checked
+    for (int level = 0; level < 4; ++level)
+    {
+        BOOST_LOG_SEV(lg, level) << counted(count);
+    }
+    BOOST_CHECK_EQUAL(count, 7);
+
+    // The macros can be used in conditional statements without braces
+    bool condition = true;
+    if (condition)
+        BOOST_LOG_SEV(lg, 1) << counted(count);
+    else
+        BOOST_LOG_SEV(lg, 3) << counted(count);
+    BOOST_CHECK_EQUAL(count, 7);
+
+    logging::core::get()->remove_sink(pSink);
+}
+
+// The test checks that the severity level is evaluated once
+BOOST_AUTO_TEST_CASE(level_evaluation)
+{
+    boost::shared_ptr< test_sink > pSink(new test_sink());
+    logging::core::get()->add_sink(pSink);
+
+    src::severity_logger< int > lg;
+    src::severity_channel_logger< int > chan_lg;
+
+    int level_count = 0, count = 0;
+    BOOST_LOG_SEV(lg, counted_level(level_count, 1)) << counted(count);
+    BOOST_CHECK_EQUAL(level_count, 1);
+    BOOST_LOG_SEV(lg, counted_level(level_count, 3)) << counted(count);
+    BOOST_CHECK_EQUAL(level_count, 2);
+    BOOST_LOG_CHANNEL_SEV(chan_lg, "net", counted_level(level_count, 3)) << counted(count);
+    BOOST_CHECK_EQUAL(level_count, 3);
+    BOOST_LOG_DEFERRED_SEV(lg, counted_level(level_count, 3), "%1%") % counted(count);
+    BOOST_CHECK_EQUAL(level_count, 4);
+    BOOST_CHECK_EQUAL(count, 3);
+    BOOST_CHECK_EQUAL(pSink->m_RecordCounter, 3UL);
+
+    logging::core::get()->remove_sink(pSink);
+}
+
+// The test checks that the severity levels of class types are compared with their own ordering
+BOOST_AUTO_TEST_CASE(custom_level_type)
+{
+    boost::shared_ptr< test_sink > pSink(new test_sink());
+    logging::core::get()->add_sink(pSink);
+
+    src::severity_logger< custom_level > lg;
+
+    int count = 0;
+    BOOST_LOG_SEV(lg, custom_level(1)) << counted(count);
+    BOOST_CHECK_EQUAL(count, 0);
+    BOOST_LOG_SEV(lg, custom_level(2)) << counted(count);
+    BOOST_CHECK_EQUAL(count, 1);
+    BOOST_CHECK_EQUAL(pSink->m_RecordCounter, 1UL);
+
+    logging::core::get()->remove_sink(pSink);
+}
@@ -0,0 +1,219 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2015.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   util_ipc_reliable_mq.cpp
+ * \author Andrey Semashev
+ * \date   09.08.2015
+ *
+ * \brief  The test verifies that the interprocess message queue and the corresponding sink backend work.
+ */
+
+#define BOOST_TEST_MODULE util_ipc_reliable_mq
+
+#include <string>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/smart_ptr/make_shared_object.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/log/exceptions.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/text_ipc_message_queue_backend.hpp>
+#include <boost/log/utility/ipc/reliable_message_queue.hpp>
+#include <boost/log/expressions.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#endif
+
+namespace logging = boost::log;
+namespace keywords = logging::keywords;
+namespace sinks = logging::sinks;
+namespace expr = logging::expressions;
+namespace src = logging::sources;
+
+typedef logging::ipc::reliable_message_queue queue_t;
+
+namespace {
+
+const char queue_name[] = "boost_log_test_ipc_reliable_mq";
+
+//! The guard removes the queue before and after the test
+struct queue_remover
+{
+    queue_remover() { queue_t::remove(queue_name); }
+    ~queue_remover() { queue_t::remove(queue_name); }
+};
+
+void send_string(queue_t& queue, std::string const& str)
+{
+    BOOST_CHECK_EQUAL(queue.send(str.data(), static_cast< queue_t::size_type >(str.size())), queue_t::succeeded);
+}
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+//! The function receives a message in a separate thread
+void receive_message(queue_t& queue, queue_t::operation_result& result, std::string& message)
+{
+    result = queue.receive(message);
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+} // namespace
+
+// The test checks that messages are received in the same order they were sent, including the ones that wrap around the storage end
+BOOST_AUTO_TEST_CASE(send_receive)
+{
+    queue_remover remover;
+    queue_t queue(queue_t::create_only, queue_name, 64u);
+    BOOST_CHECK(queue.is_open());
+    BOOST_CHECK_EQUAL(queue.name(), queue_name);
+    BOOST_CHECK_EQUAL(queue.capacity(), 64u);
+    BOOST_CHECK_EQUAL(queue.max_message_size(), 60u);
+
+    std::string message;
+    BOOST_CHECK(!queue.try_receive(message));
+
+    for (unsigned int i = 0; i < 100u; ++i)
+    {
+        const std::string msg1(i % 23u, static_cast< char >('a' + i % 26u));
+        const std::string msg2(i % 7u, static_cast< char >('A' + i % 26u));
+        send_string(queue, msg1);
+        send_string(queue, msg2);
+
+        BOOST_CHECK_EQUAL(queue.receive(message), queue_t::succeeded);
+        BOOST_CHECK_EQUAL(message, msg1);
+        BOOST_CHECK(queue.try_receive(message));
+        BOOST_CHECK_EQUAL(message, msg2);
+    }
+
+    BOOST_CHECK(!queue.try_receive(message));
+
+    queue.close();
+    BOOST_CHECK(!queue.is_open());
+}
+
+// The test checks the overflow policies
+BOOST_AUTO_TEST_CASE(overflow)
+{
+    queue_remover remover;
+    queue_t queue(queue_t::create_only, queue_name, 32u, queue_t::drop_on_overflow);
+
+    // The message can never fit into the queue
+    BOOST_CHECK_THROW(queue.send("0123456789012345678901234567890", 29u), logging::limitation_error);
+
+    BOOST_CHECK_EQUAL(queue.send("0123456789", 10u), queue_t::succeeded);
+    BOOST_CHECK_EQUAL(queue.send("0123456789", 10u), queue_t::succeeded);
+    BOOST_CHECK_EQUAL(queue.send("0123456789", 10u), queue_t::dropped);
+    BOOST_CHECK(!queue.try_send("0", 1u));
+    // An empty message only occupies its header
+    BOOST_CHECK(queue.try_send("", 0u));
+
+    queue_t throwing_queue(queue_t::open_only, queue_name, 0u, queue_t::throw_on_overflow);
+    BOOST_CHECK_THROW(throwing_queue.send("0", 1u), logging::limitation_error);
+
+    queue.clear();
+    BOOST_CHECK_EQUAL(throwing_queue.send("0123456789", 10u), queue_t::succeeded);
+}
+
+// The test checks that different queue objects with the same name share the same queue
+BOOST_AUTO_TEST_CASE(open_modes)
+{
+    queue_remover remover;
+    BOOST_CHECK_THROW(queue_t(queue_t::open_only, queue_name), logging::setup_error);
+
+    queue_t sender(queue_t::open_or_create, queue_name, 128u);
+    BOOST_CHECK_EQUAL(sender.capacity(), 128u);
+    BOOST_CHECK_THROW(queue_t(queue_t::create_only, queue_name), logging::setup_error);
+
+    queue_t receiver;
+    receiver.open(queue_t::open_or_create, queue_name, 1024u);
+    BOOST_CHECK_EQUAL(receiver.capacity(), 128u);
+
+    send_string(sender, "Hello");
+    std::string message;
+    BOOST_CHECK(receiver.try_receive(message));
+    BOOST_CHECK_EQUAL(message, "Hello");
+    BOOST_CHECK(!sender.try_receive(message));
+}
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+// The test checks that blocked operations are interrupted by stop_local
+BOOST_AUTO_TEST_CASE(stop_local)
+{
+    queue_remover remover;
+    queue_t queue(queue_t::create_only, queue_name, 64u);
+
+    queue_t::operation_result result = queue_t::succeeded;
+    std::string message;
+    boost::thread receiver(&receive_message, boost::ref(queue), boost::ref(result), boost::ref(message));
+    boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+    queue.stop_local();
+    receiver.join();
+    BOOST_CHECK_EQUAL(result, queue_t::aborted);
+
+    // The queue remains stopped until reset
+    BOOST_CHECK_EQUAL(queue.send("0", 1u), queue_t::aborted);
+    queue.reset_local();
+
+    receiver = boost::thread(&receive_message, boost::ref(queue), boost::ref(result), boost::ref(message));
+    send_string(queue, "Hello");
+    receiver.join();
+    BOOST_CHECK_EQUAL(result, queue_t::succeeded);
+    BOOST_CHECK_EQUAL(message, "Hello");
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+// The test checks that the sink backend sends formatted records to the queue
+BOOST_AUTO_TEST_CASE(sink_backend)
+{
+    queue_remover remover;
+    queue_t collector(queue_t::create_only, queue_name, 1024u);
+
+    typedef sinks::text_ipc_message_queue_backend< > backend_t;
+    typedef sinks::synchronous_sink< backend_t > sink_t;
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >(keywords::name = queue_name, keywords::open_mode = queue_t::open_only, keywords::capacity = 16u);
+    BOOST_REQUIRE(sink->locked_backend()->is_open());
+    sink->set_formatter(expr::stream << "[" << expr::smessage << "]");
+    logging::core::get()->add_sink(sink);
+
+    src::logger lg;
+    BOOST_LOG(lg) << "Hello";
+    BOOST_LOG(lg) << "World";
+
+    logging::core::get()->remove_sink(sink);
+
+    std::string message;
+    BOOST_CHECK(collector.try_receive(message));
+    BOOST_CHECK_EQUAL(message, "[Hello]");
+    BOOST_CHECK(collector.try_receive(message));
+    BOOST_CHECK_EQUAL(message, "[World]");
+    BOOST_CHECK(!collector.try_receive(message));
+}
+
+// The test checks that the sink backend rejects messages that can never fit into the queue
+BOOST_AUTO_TEST_CASE(sink_backend_message_size)
+{
+    queue_remover remover;
+    queue_t collector(queue_t::create_only, queue_name, 64u);
+
+    typedef sinks::text_ipc_message_queue_backend< > backend_t;
+    backend_t backend(keywords::name = queue_name, keywords::open_mode = queue_t::open_only);
+    BOOST_REQUIRE(backend.is_open());
+
+    backend.consume(logging::record_view(), std::string(60u, 'x'));
+    BOOST_CHECK_THROW(backend.consume(logging::record_view(), std::string(61u, 'x')), logging::limitation_error);
+
+    std::string message;
+    BOOST_CHECK(collector.try_receive(message));
+    BOOST_CHECK_EQUAL(message.size(), 60u);
+    BOOST_CHECK(!collector.try_receive(message));
+}
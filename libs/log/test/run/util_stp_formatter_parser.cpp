@@ -97,6 +97,49 @@ BOOST_AUTO_TEST_CASE(attr_placeholders)
 
 namespace {
 
+//! A type that is not supported by the default formatter
+struct unsupported_type {};
+
+} // namespace
+
+// Tests that the same formatter outputs attribute values of different types in different records
+BOOST_AUTO_TEST_CASE(attr_value_types)
+{
+    attr_set set_int, set_str, set_unsupported;
+    set_int["MyAttr"] = attrs::constant< int >(10);
+    set_str["MyAttr"] = attrs::constant< std::string >("hello");
+    set_unsupported["MyAttr"] = attrs::constant< unsupported_type >(unsupported_type());
+
+    record_view rec_int = make_record_view(set_int);
+    record_view rec_str = make_record_view(set_str);
+    record_view rec_unsupported = make_record_view(set_unsupported);
+
+    formatter f = logging::parse_formatter("[%MyAttr%]");
+    record_view const* const records[] = { &rec_int, &rec_int, &rec_str, &rec_unsupported, &rec_int, &rec_str };
+    const char* const expected[] = { "[10]", "[10]", "[hello]", "[]", "[10]", "[hello]" };
+    for (unsigned int i = 0; i < sizeof(records) / sizeof(*records); ++i)
+    {
+        std::string str;
+        osstream strm(str);
+        f(*records[i], strm);
+        strm.flush();
+        BOOST_CHECK_EQUAL(str, expected[i]);
+    }
+
+    // Copies of the formatter are independent
+    formatter f2 = f;
+    {
+        std::string str;
+        osstream strm(str);
+        f2(rec_str, strm);
+        f(rec_int, strm);
+        strm.flush();
+        BOOST_CHECK_EQUAL(str, "[hello][10]");
+    }
+}
+
+namespace {
+
 class test_formatter_factory :
     public logging::formatter_factory< char >
 {